@@ -0,0 +1,156 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef BOT_BOT_HPP
+#define BOT_BOT_HPP
+
+#include "bot/Connection.hpp"
+#include "bot/Statistics.hpp"
+
+#include <boost/asio.hpp>
+
+#include <random>
+#include <string>
+
+namespace server::bot
+{
+
+//! A headless client logging into the server and generating the traffic of a player.
+//! The bot speaks the protocol of the game client from the login to the behaviour
+//! it was assigned, it is driven by a tick on its strand.
+class Bot final
+{
+public:
+  using Clock = Statistics::Clock;
+
+  //! A behaviour of the bot after it logs in.
+  enum class Behaviour
+  {
+    //! Stays in the lobby, sending heartbeats.
+    Idle,
+    //! Stays in its ranch, sending snapshots and occasional chat.
+    Ranch,
+    //! Races in its own room, repeatedly.
+    Race,
+    //! Logs into the messenger and chats in its ranch.
+    Chat
+  };
+
+  //! A configuration of the bot.
+  struct Config
+  {
+    //! Endpoint of the lobby director.
+    asio::ip::tcp::endpoint lobby{};
+    //! Name of the user.
+    std::string name{};
+    //! Token of the user.
+    std::string token{};
+    //! Behaviour after login.
+    Behaviour behaviour{Behaviour::Idle};
+    //! Duration of a race.
+    Clock::duration raceDuration{std::chrono::seconds(30)};
+  };
+
+  //! Constructor.
+  //! @param ioContext IO context the bot runs on.
+  //! @param config Configuration of the bot.
+  //! @param statistics Statistics shared by the bots.
+  Bot(asio::io_context& ioContext, Config config, Statistics& statistics);
+
+  //! Deleted copy constructor.
+  Bot(const Bot&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const Bot&) = delete;
+
+  //! Starts the bot by connecting to the lobby.
+  void Start();
+  //! Stops the bot by closing its connections.
+  //! The IO context must have finished running before the bot is destroyed.
+  void Stop();
+
+private:
+  //! A state of the bot.
+  enum class State
+  {
+    Stopped,
+    LoggingIn,
+    Lobby,
+    EnteringRanch,
+    Ranch,
+    EnteringRoom,
+    Racing,
+  };
+
+  //! Ticks the bot and schedules the next tick.
+  void TickLoop();
+  //! Ticks the bot.
+  void Tick();
+
+  //! Registers the handlers of the commands received from the directors.
+  void RegisterHandlers();
+
+  //! Begins the behaviour of the bot after it has logged in.
+  void BeginBehaviour();
+
+  //! Asks the lobby for the ranch of the bot.
+  void EnterRanch();
+  //! Ticks the bot in the ranch.
+  void TickRanch();
+
+  //! Asks the lobby for a new race room.
+  void BeginRace();
+  //! Ticks the bot in the race.
+  void TickRace();
+  //! Leaves the race room.
+  void EndRace();
+
+  //! Asks the lobby for the messenger.
+  void EnterMessenger();
+
+  Connection::Strand _strand;
+  asio::steady_timer _tickTimer;
+  Config _config;
+  Statistics& _statistics;
+
+  Connection _lobby;
+  Connection _ranch;
+  Connection _race;
+  Connection _messenger;
+
+  std::mt19937 _random;
+
+  State _state{State::Stopped};
+  //! UID of the character of the bot.
+  uint32_t _characterUid{0};
+  //! OID of the character in the ranch or the race.
+  uint16_t _oid{0};
+
+  //! Time point of the last heartbeat sent to the lobby.
+  Clock::time_point _lastHeartbeat{};
+  //! Time point at which the current race ends.
+  Clock::time_point _raceEnd{};
+  //! Time point at which the next race begins.
+  Clock::time_point _nextRace{};
+  //! Count of the ticks in the current ranch or race.
+  uint32_t _tickCount{0};
+};
+
+} // namespace server::bot
+
+#endif // BOT_BOT_HPP
@@ -0,0 +1,196 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef BOT_CONNECTION_HPP
+#define BOT_CONNECTION_HPP
+
+#include "bot/Statistics.hpp"
+
+#include <libserver/network/command/CommandServer.hpp>
+
+#include <boost/asio.hpp>
+
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace server::bot
+{
+
+namespace asio = boost::asio;
+
+//! A connection of a bot to a director of the server.
+//! All the operations of the connection must be performed on its strand.
+class Connection final
+{
+public:
+  using Clock = Statistics::Clock;
+  using Strand = asio::strand<asio::io_context::executor_type>;
+
+  //! A protocol spoken by the director.
+  enum class Protocol
+  {
+    //! The command protocol with the message magic and the rolling XOR code.
+    Command,
+    //! The chatter protocol scrambled with a constant XOR code.
+    Chatter
+  };
+
+  //! A handler of a command received from the director.
+  using CommandHandler = std::function<void(SourceStream&)>;
+  //! A handler of the outcome of a connect.
+  using ConnectHandler = std::function<void(bool)>;
+
+  //! Constructor.
+  //! @param strand Strand of the bot.
+  //! @param protocol Protocol of the director.
+  //! @param director Director, used for the statistics.
+  //! @param statistics Statistics.
+  Connection(
+    Strand strand,
+    Protocol protocol,
+    Statistics::Director director,
+    Statistics& statistics);
+
+  //! Deleted copy constructor.
+  Connection(const Connection&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const Connection&) = delete;
+
+  //! Connects to the director.
+  //! @param endpoint Endpoint of the director.
+  //! @param handler Handler of the outcome of the connect.
+  void Connect(const asio::ip::tcp::endpoint& endpoint, ConnectHandler handler);
+
+  //! Closes the connection.
+  //! The pending requests are recorded as failed.
+  void Close();
+
+  //! Returns whether the connection is open.
+  //! @returns `true` if the connection is open, `false` otherwise.
+  [[nodiscard]] bool IsOpen() const;
+
+  //! Resets the rolling code.
+  //! The directors reset the code of the client when its session is established.
+  void ResetCode();
+
+  //! Sets the handler of a command received from the director.
+  //! @param commandId ID of the command.
+  //! @param handler Handler of the command.
+  void SetHandler(uint16_t commandId, CommandHandler handler);
+
+  //! Sends a command.
+  //! @param command Command.
+  template <typename C>
+  void Send(const C& command)
+  {
+    Send(
+      static_cast<uint16_t>(C::GetCommand()),
+      [&command](SinkStream& stream)
+      {
+        C::Write(command, stream);
+      });
+  }
+
+  //! Sends a request and measures the latency until its response is received.
+  //! @param command Command of the request.
+  //! @param responseId ID of the response command.
+  //! @param cancelId ID of the command rejecting the request, or zero.
+  template <typename C>
+  void Request(const C& command, uint16_t responseId, uint16_t cancelId = 0)
+  {
+    _pendingRequests.emplace_back(PendingRequest{
+      .name = GetCommandName(static_cast<uint16_t>(C::GetCommand())),
+      .responseId = responseId,
+      .cancelId = cancelId,
+      .sentAt = Clock::now()});
+
+    Send(command);
+  }
+
+  //! Records the requests which are pending for longer than the timeout as failed.
+  //! @param timeout Timeout of a request.
+  void ExpireRequests(Clock::duration timeout);
+
+private:
+  //! A request waiting for its response.
+  struct PendingRequest
+  {
+    std::string_view name;
+    uint16_t responseId{};
+    uint16_t cancelId{};
+    Clock::time_point sentAt{};
+  };
+
+  //! Returns the name of a command of the protocol.
+  //! @param commandId ID of the command.
+  //! @returns Name of the command.
+  [[nodiscard]] std::string_view GetCommandName(uint16_t commandId) const;
+
+  //! Frames a command and queues it for writing.
+  //! @param commandId ID of the command.
+  //! @param supplier Supplier of the command data.
+  void Send(uint16_t commandId, const CommandSupplier& supplier);
+
+  //! Reads the data from the director.
+  void ReadLoop();
+  //! Writes the queued data to the director.
+  void WriteLoop();
+
+  //! Handles the data received from the director.
+  //! @param data Received data.
+  //! @returns Count of the bytes consumed.
+  std::size_t HandleData(std::span<std::byte> data);
+  //! Handles a command received from the director.
+  //! @param commandId ID of the command.
+  //! @param data Data of the command.
+  void HandleCommand(uint16_t commandId, std::span<const std::byte> data);
+
+  Strand _strand;
+  asio::ip::tcp::socket _socket;
+  Protocol _protocol;
+  Statistics::Director _director;
+  Statistics& _statistics;
+
+  //! Session of the connection, incremented by every connect.
+  //! Completions of the operations started by an older session are ignored.
+  uint32_t _session{0};
+  //! Rolling code of the command protocol.
+  CommandClient _commandClient;
+
+  std::unordered_map<uint16_t, CommandHandler> _handlers;
+  std::vector<PendingRequest> _pendingRequests;
+
+  //! Buffer for the received data.
+  std::vector<std::byte> _readBuffer;
+  //! Size of the data in the read buffer.
+  std::size_t _readSize{0};
+
+  //! Data queued for writing.
+  std::vector<std::byte> _writeQueue;
+  //! Data being written.
+  std::vector<std::byte> _writeBuffer;
+  //! Whether a write is in progress.
+  bool _isWriting{false};
+};
+
+} // namespace server::bot
+
+#endif // BOT_CONNECTION_HPP
@@ -0,0 +1,103 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef BOT_STATISTICS_HPP
+#define BOT_STATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace server::bot
+{
+
+//! Statistics of the commands the bots exchange with the server.
+class Statistics final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  //! A director of the server.
+  enum class Director
+  {
+    Lobby,
+    Ranch,
+    Race,
+    Messenger,
+    Count
+  };
+
+  //! Records the latency of a request.
+  //! @param request Name of the request command.
+  //! @param latency Duration between sending the request and receiving its response.
+  void RecordLatency(std::string_view request, Clock::duration latency);
+
+  //! Records a request which was rejected, timed out or lost with its connection.
+  //! @param request Name of the request command.
+  void RecordFailure(std::string_view request);
+
+  //! Records a command sent to a director.
+  //! @param director Director.
+  //! @param size Size of the command.
+  void RecordSent(Director director, std::size_t size);
+
+  //! Records a command received from a director.
+  //! @param director Director.
+  //! @param size Size of the command.
+  void RecordReceived(Director director, std::size_t size);
+
+  //! Prints the latency percentiles per request and the throughput per director.
+  //! @param elapsed Duration the statistics were collected for.
+  void PrintReport(Clock::duration elapsed);
+
+private:
+  //! Traffic of a director.
+  struct Traffic
+  {
+    std::atomic_uint64_t sentCommands{0};
+    std::atomic_uint64_t sentBytes{0};
+    std::atomic_uint64_t receivedCommands{0};
+    std::atomic_uint64_t receivedBytes{0};
+  };
+
+  //! Latencies of a request.
+  struct Latencies
+  {
+    //! Latency samples in microseconds.
+    std::vector<uint32_t> samples;
+    //! Count of the failed requests.
+    std::size_t failures{0};
+  };
+
+  std::array<Traffic, static_cast<std::size_t>(Director::Count)> _traffic{};
+
+  std::mutex _latenciesMutex;
+  //! Latencies mapped by the name of the request.
+  std::map<std::string, Latencies, std::less<>> _latencies;
+};
+
+} // namespace server::bot
+
+#endif // BOT_STATISTICS_HPP
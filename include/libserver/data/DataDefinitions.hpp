@@ -374,6 +374,46 @@ struct Egg
   dao::Field<uint32_t> boostsUsed;
 };
 
+//! A leaderboard of the characters ranked by their score.
+struct Leaderboard
+{
+  //! A key of the leaderboard.
+  dao::Field<Uid> uid{InvalidUid};
+
+  struct Entry
+  {
+    //! An UID of the character.
+    Uid characterUid{InvalidUid};
+    //! A score of the character.
+    uint32_t score{};
+  };
+
+  //! Entries of the leaderboard.
+  dao::Field<std::vector<Entry>> entries{};
+};
+
+//! A breeding market with the stallions listed for mating.
+struct BreedingMarket
+{
+  //! A key of the breeding market.
+  dao::Field<Uid> uid{InvalidUid};
+
+  struct Listing
+  {
+    //! An UID of the stallion.
+    Uid horseUid{InvalidUid};
+    //! An UID of the character owning the stallion.
+    Uid ownerUid{InvalidUid};
+    //! A price of the mating.
+    uint32_t matePrice{};
+    //! A time point when the listing expires.
+    Clock::time_point expiresAt{};
+  };
+
+  //! Listings of the stallions.
+  dao::Field<std::vector<Listing>> listings{};
+};
+
 } // namespace data
 
 } // namespace server
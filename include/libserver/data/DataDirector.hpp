@@ -42,6 +42,8 @@ public:
   using StorageItemStorage = DataStorage<data::Uid, data::StorageItem>;
   using HousingStorage = DataStorage<data::Uid, data::Housing>;
   using GuildStorage = DataStorage<data::Uid, data::Guild>;
+  using LeaderboardStorage = DataStorage<data::Uid, data::Leaderboard>;
+  using BreedingMarketStorage = DataStorage<data::Uid, data::BreedingMarket>;
 
   //! Default constructor.
   explicit DataDirector(const std::filesystem::path& basePath);
@@ -56,6 +58,10 @@ public:
   //! Ticks the director.
   void Tick();
 
+  //! Queues a task to be executed on the data director thread.
+  //! @param task Task to execute.
+  void QueueTask(const Scheduler::Task& task);
+
   //! Requests a load of user data.
   //! @param userName Name of the user.
   void RequestLoadUserData(const std::string& userName);
@@ -115,6 +121,10 @@ public:
   [[nodiscard]] Record<data::Housing> CreateHousing() noexcept;
   [[nodiscard]] HousingStorage& GetHousingCache();
 
+  [[nodiscard]] LeaderboardStorage& GetLeaderboardCache();
+
+  [[nodiscard]] BreedingMarketStorage& GetBreedingMarketCache();
+
 private:
   //! An underlying data source of the data director.
   std::unique_ptr<FileDataSource> _primaryDataSource;
@@ -162,6 +172,10 @@ private:
   HousingStorage _housingStorage;
   //! A guild storage.
   GuildStorage _guildStorage;
+  //! A leaderboard storage.
+  LeaderboardStorage _leaderboardStorage;
+  //! A breeding market storage.
+  BreedingMarketStorage _breedingMarketStorage;
 };
 
 } // namespace server
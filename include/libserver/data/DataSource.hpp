@@ -176,6 +176,32 @@ public:
   //! Deletes the guild from the data source.
   //! @param uid UID of the guild.
   virtual void DeleteGuild(data::Uid uid) = 0;
+
+  //! Retrieves the leaderboard from the data source.
+  //! A leaderboard not yet stored on the data source is retrieved empty.
+  //! @param uid Key of the leaderboard.
+  //! @param leaderboard Leaderboard to retrieve.
+  virtual void RetrieveLeaderboard(data::Uid uid, data::Leaderboard& leaderboard) = 0;
+  //! Stores the leaderboard on the data source.
+  //! @param uid Key of the leaderboard.
+  //! @param leaderboard Leaderboard to store.
+  virtual void StoreLeaderboard(data::Uid uid, const data::Leaderboard& leaderboard) = 0;
+  //! Deletes the leaderboard from the data source.
+  //! @param uid Key of the leaderboard.
+  virtual void DeleteLeaderboard(data::Uid uid) = 0;
+
+  //! Retrieves the breeding market from the data source.
+  //! A breeding market not yet stored on the data source is retrieved empty.
+  //! @param uid Key of the breeding market.
+  //! @param breedingMarket Breeding market to retrieve.
+  virtual void RetrieveBreedingMarket(data::Uid uid, data::BreedingMarket& breedingMarket) = 0;
+  //! Stores the breeding market on the data source.
+  //! @param uid Key of the breeding market.
+  //! @param breedingMarket Breeding market to store.
+  virtual void StoreBreedingMarket(data::Uid uid, const data::BreedingMarket& breedingMarket) = 0;
+  //! Deletes the breeding market from the data source.
+  //! @param uid Key of the breeding market.
+  virtual void DeleteBreedingMarket(data::Uid uid) = 0;
 };
 
 } // namespace server
@@ -20,6 +20,9 @@
 #ifndef DATASTORAGE_HPP
 #define DATASTORAGE_HPP
 
+#include "libserver/util/Metrics.hpp"
+#include "libserver/util/Trace.hpp"
+
 #include <atomic>
 #include <functional>
 #include <mutex>
@@ -28,11 +31,39 @@
 #include <shared_mutex>
 #include <span>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace server
 {
 
+//! Counters of the operations the data storages performed on the data source.
+struct DataStorageOperationCounters
+{
+  metrics::Counter& retrieve;
+  metrics::Counter& store;
+  metrics::Counter& flush;
+  metrics::Counter& remove;
+};
+
+//! Returns the counters of the operations the data storages performed on the data source.
+//! @returns Reference to the counters.
+inline DataStorageOperationCounters& GetDataStorageOperationCounters()
+{
+  static const auto getCounter = [](std::string_view operation) -> metrics::Counter&
+  {
+    return metrics::GetRegistry().GetCounter(
+      "alicia_data_storage_operations_total",
+      "Count of the operations the data storages performed on the data source.",
+      {{"operation", operation}});
+  };
+
+  static DataStorageOperationCounters counters{
+    .retrieve = getCounter("retrieve"),
+    .store = getCounter("store"),
+    .flush = getCounter("flush"),
+    .remove = getCounter("delete")};
+  return counters;
+}
+
 //! Record holds a non-owning pointer to any value along with the access mutex of that value.
 //! A record provies two access methods to the underlying value:
 //! - A mutable access which requests an exclusive lock of the value.
@@ -182,6 +213,7 @@ public:
   void Terminate()
   {
     _storeQueue.clear();
+    _flushQueue.clear();
     _retrieveQueue.clear();
 
     for (auto& entry : _entries)
@@ -296,11 +328,28 @@ public:
     RequestStore(key);
   }
 
+  //! Requests a store of the datum on the data source.
+  //! Unlike `Save` the datum stays available once stored.
+  //! @param key Key of the datum.
+  void Flush(const Key& key)
+  {
+    _flushQueue.try_emplace(key, trace::GetCurrentTraceId());
+  }
+
   void Tick()
   {
+    auto& operationCounters = GetDataStorageOperationCounters();
+    operationCounters.retrieve.Increment(_retrieveQueue.size());
+    operationCounters.store.Increment(_storeQueue.size());
+    operationCounters.flush.Increment(_flushQueue.size());
+    operationCounters.remove.Increment(_deleteQueue.size());
+
     // Perform retrieve operations.
-    for (const auto& key : _retrieveQueue)
+    for (const auto& [key, traceId] : _retrieveQueue)
     {
+      const trace::Scope traceScope(traceId);
+      const trace::Span traceSpan("DataStorage::Retrieve");
+
       auto& entry = _entries[key];
 
       if (_dataSourceRetrieveListener(key, entry.value))
@@ -309,8 +358,11 @@ public:
     _retrieveQueue.clear();
 
     // Perform store operations.
-    for (const auto& key : _storeQueue)
+    for (const auto& [key, traceId] : _storeQueue)
     {
+      const trace::Scope traceScope(traceId);
+      const trace::Span traceSpan("DataStorage::Store");
+
       auto& entry = _entries[key];
 
       if (entry.available)
@@ -319,9 +371,31 @@ public:
     }
     _storeQueue.clear();
 
+    // Perform flush operations.
+    for (const auto& [key, traceId] : _flushQueue)
+    {
+      const trace::Scope traceScope(traceId);
+      const trace::Span traceSpan("DataStorage::Flush");
+
+      const auto entryIter = _entries.find(key);
+      if (entryIter == _entries.end())
+        continue;
+
+      auto& entry = entryIter->second;
+      if (entry.available)
+      {
+        std::shared_lock lock(entry.mutex);
+        _dataSourceStoreListener(key, entry.value);
+      }
+    }
+    _flushQueue.clear();
+
     // Perform delete operations.
-    for (const auto& key : _deleteQueue)
+    for (const auto& [key, traceId] : _deleteQueue)
     {
+      const trace::Scope traceScope(traceId);
+      const trace::Span traceSpan("DataStorage::Delete");
+
       auto& entry = _entries[key];
 
       if (entry.available)
@@ -334,17 +408,17 @@ public:
 private:
   void RequestRetrieve(const Key& key)
   {
-    _retrieveQueue.insert(key);
+    _retrieveQueue.try_emplace(key, trace::GetCurrentTraceId());
   }
 
   void RequestStore(const Key& key)
   {
-    _storeQueue.insert(key);
+    _storeQueue.try_emplace(key, trace::GetCurrentTraceId());
   }
 
   void RequestDelete(const Key& key)
   {
-    _deleteQueue.insert(key);
+    _deleteQueue.try_emplace(key, trace::GetCurrentTraceId());
   }
 
   struct Entry
@@ -355,9 +429,14 @@ private:
     Data value;
   };
 
-  std::unordered_set<Key> _retrieveQueue;
-  std::unordered_set<Key> _storeQueue;
-  std::unordered_set<Key> _deleteQueue;
+  //! A queue of the data source operations,
+  //! mapping the keys to the trace the operation was requested within.
+  using OperationQueue = std::unordered_map<Key, trace::TraceId>;
+
+  OperationQueue _retrieveQueue;
+  OperationQueue _storeQueue;
+  OperationQueue _flushQueue;
+  OperationQueue _deleteQueue;
   std::unordered_map<Key, Entry> _entries{};
 
   DataSourceRetrieveListener _dataSourceRetrieveListener;
@@ -83,6 +83,14 @@ public:
   void StoreGuild(data::Uid uid, const data::Guild& guild) override;
   void DeleteGuild(data::Uid uid) override;
 
+  void RetrieveLeaderboard(data::Uid uid, data::Leaderboard& leaderboard) override;
+  void StoreLeaderboard(data::Uid uid, const data::Leaderboard& leaderboard) override;
+  void DeleteLeaderboard(data::Uid uid) override;
+
+  void RetrieveBreedingMarket(data::Uid uid, data::BreedingMarket& breedingMarket) override;
+  void StoreBreedingMarket(data::Uid uid, const data::BreedingMarket& breedingMarket) override;
+  void DeleteBreedingMarket(data::Uid uid) override;
+
 private:
   //! A root data path.
   std::filesystem::path _dataPath;
@@ -107,6 +115,10 @@ private:
   std::filesystem::path _housingDataPath;
   //! A path to the guild data files.
   std::filesystem::path _guildDataPath;
+  //! A path to the leaderboard data files.
+  std::filesystem::path _leaderboardDataPath;
+  //! A path to the breeding market data files.
+  std::filesystem::path _breedingMarketDataPath;
 
   //! A path to meta-data file.
   std::filesystem::path _metaFilePath;
@@ -20,10 +20,15 @@
 #ifndef SERVER_HPP
 #define SERVER_HPP
 
+#include "libserver/util/MpscQueue.hpp"
+
+#include <atomic>
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 #include <span>
 #include <queue>
+#include <vector>
 
 #include <boost/asio.hpp>
 
@@ -61,24 +66,45 @@ public:
     const std::span<const std::byte>& data) = 0;
 };
 
-//! Client with event driven reads and writes
-//! to the underlying socket connection.
+//! A client connected to the server through a transport.
 class Client : public std::enable_shared_from_this<Client>
 {
+public:
+  virtual ~Client() = default;
+
+  //! Begins the client's I/O and notifies the connection.
+  virtual void Begin() = 0;
+  //! Ends the client's I/O and notifies the disconnection.
+  virtual void End() = 0;
+  //! Queues a write.
+  //! @param writeSupplier Supplier writing the data to the write buffer.
+  virtual void QueueWrite(WriteSupplier writeSupplier) = 0;
+
+  //! Returns the remote address of the client.
+  //! @returns Remote address of the client.
+  [[nodiscard]] virtual asio::ip::address GetAddress() const = 0;
+};
+
+//! Client with event driven reads and writes
+//! to the underlying TCP socket connection.
+class TcpClient final : public Client
+{
 public:
   //! Default constructor.
   //! @param socket Underlying socket.
-  explicit Client(
+  explicit TcpClient(
     ClientId clientId,
     asio::ip::tcp::socket&& socket,
     EventHandlerInterface& networkEventHandler) noexcept;
 
   //! Begins the client's asynchronous read loop.
-  void Begin();
+  void Begin() override;
   //! Ends the client's asynchronous read loop.
-  void End();
+  void End() override;
   //! Queues a write.
-  void QueueWrite(WriteSupplier writeSupplier);
+  void QueueWrite(WriteSupplier writeSupplier) override;
+
+  [[nodiscard]] asio::ip::address GetAddress() const override;
 
 private:
   void WriteLoop() noexcept;
@@ -108,6 +134,63 @@ private:
   EventHandlerInterface& _networkEventHandler;
 };
 
+//! Client connected through an in-memory loopback instead of a socket.
+//! The peer end of the loopback is driven by the owner of the client,
+//! which sends the data to the server and receives the data written by the server.
+//! The writes are queued without locking and are written to the receive buffer
+//! of the peer only when the peer receives them.
+class LoopbackClient final : public Client
+{
+public:
+  //! Default constructor.
+  explicit LoopbackClient(
+    ClientId clientId,
+    EventHandlerInterface& networkEventHandler) noexcept;
+
+  void Begin() override;
+  void End() override;
+  void QueueWrite(WriteSupplier writeSupplier) override;
+
+  //! Returns the loopback address.
+  //! @returns Loopback address.
+  [[nodiscard]] asio::ip::address GetAddress() const override;
+
+  //! Sends data to the server as if they were received from a socket.
+  //! The data are passed to the event handler on the calling thread.
+  //! Must not be called concurrently for the same client.
+  //! @param data Data to send.
+  void Send(std::span<const std::byte> data);
+
+  //! Receives the data written by the server.
+  //! Must not be called concurrently for the same client.
+  //! @returns Received data, valid until the next receive.
+  [[nodiscard]] std::span<const std::byte> Receive();
+
+  //! Returns the ID of the client.
+  //! @returns ID of the client.
+  [[nodiscard]] ClientId GetId() const;
+
+  //! Returns whether the client is connected.
+  //! @returns `true` if the client is connected, `false` otherwise.
+  [[nodiscard]] bool IsConnected() const;
+
+private:
+  //! Indicates whether the client is connected.
+  std::atomic<bool> _isConnected = false;
+
+  //! A queue of write suppliers.
+  MpscQueue<WriteSupplier> _writeQueue;
+  //! A buffer of the data received by the peer.
+  asio::streambuf _receiveBuffer{};
+  //! A buffer of the data sent by the peer and not yet consumed by the server.
+  std::vector<std::byte> _sendBuffer;
+
+  //! A unique-identifier of the client.
+  ClientId _clientId;
+  //! A network event handling interface
+  EventHandlerInterface& _networkEventHandler;
+};
+
 //! Server with event-driven acceptor, reads and writes.
 class Server :
   public EventHandlerInterface
@@ -129,6 +212,12 @@ public:
   //! Ends the server thread.
   void End();
 
+  //! Connects a client through an in-memory loopback.
+  //! The connection is notified on the calling thread.
+  //! Does not require the server to be begun.
+  //! @returns Loopback client.
+  std::shared_ptr<LoopbackClient> ConnectLoopback();
+
   //! Get client.
   std::shared_ptr<Client> GetClient(ClientId clientId);
 
@@ -143,7 +232,10 @@ private:
   asio::ip::tcp::acceptor _acceptor;
 
   //! Sequential client ID.
-  ClientId _client_id = 0;
+  std::atomic<ClientId> _client_id = 0;
+  //! A mutex for the clients, which are connected and accessed
+  //! from outside the server thread.
+  std::mutex _clientsMutex;
   //! Map of clients.
   std::unordered_map<ClientId, std::shared_ptr<Client>> _clients;
 
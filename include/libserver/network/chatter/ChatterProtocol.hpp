@@ -20,11 +20,20 @@
 #ifndef CHATTERPROTOCOL_HPP
 #define CHATTERPROTOCOL_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace server::protocol
 {
 
+//! The XOR code the chatter commands are scrambled with, it does not roll.
+constexpr std::array ChatterXorCode{
+  static_cast<std::byte>(0x2B),
+  static_cast<std::byte>(0xFE),
+  static_cast<std::byte>(0xB8),
+  static_cast<std::byte>(0x02)};
+
 struct ChatterCommandHeader
 {
   //! A length of the command payload.
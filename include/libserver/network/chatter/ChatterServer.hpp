@@ -98,17 +98,11 @@ public:
 
       bufferSink.Seek(0);
 
-      constexpr std::array XorCode{
-        static_cast<std::byte>(0x2B),
-        static_cast<std::byte>(0xFE),
-        static_cast<std::byte>(0xB8),
-        static_cast<std::byte>(0x02)};
-
       while (bufferSource.GetCursor() != bufferSource.Size())
       {
         std::byte val;
         bufferSource.Read(val);
-        val ^= XorCode[(bufferSource.GetCursor() - 1) % 4];
+        val ^= protocol::ChatterXorCode[(bufferSource.GetCursor() - 1) % 4];
         bufferSink.Write(val);
       }
 
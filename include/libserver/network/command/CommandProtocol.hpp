@@ -22,6 +22,7 @@
 
 #include <array>
 #include <cstdint>
+#include <span>
 #include <string_view>
 
 namespace server::protocol
@@ -71,6 +72,14 @@ MessageMagic decode_message_magic(uint32_t value);
 //! @return Encoded message magic value.
 uint32_t encode_message_magic(MessageMagic magic);
 
+//! Applies the XOR code to the message data in place.
+//! Every byte is XORed with the byte of the code at the same offset modulo the code size,
+//! so applying the same code twice restores the data.
+//!
+//! @param code XOR code.
+//! @param data Message data.
+void ApplyXorCode(const XorCode& code, std::span<std::byte> data);
+
 //! IDs of the commands in the protocol.
 enum class Command : uint16_t
 {
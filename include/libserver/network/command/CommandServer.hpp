@@ -21,12 +21,21 @@
 #define COMMAND_SERVER_HPP
 
 #include "CommandProtocol.hpp"
+#include "CommandTrace.hpp"
 #include "libserver/Constants.hpp"
 #include "libserver/network/Server.hpp"
 #include "libserver/util/Stream.hpp"
+#include "libserver/util/Trace.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace server
 {
@@ -40,6 +49,14 @@ using RawCommandHandler = std::function<void(ClientId, SourceStream&)>;
 //! A command supplier.
 using CommandSupplier = std::function<void(SinkStream&)>;
 
+//! A command router.
+//! Decides where the handler of a command received from a client is executed.
+//! Commands are routed on the network thread in the order they were received in.
+using CommandRouter = std::function<void(ClientId, protocol::Command, std::function<void()>)>;
+
+//! A supplier of a command mapped by the key of the sender of the command.
+using SenderCommandSupplier = std::pair<uint32_t, CommandSupplier>;
+
 //! A command client.
 class CommandClient
 {
@@ -50,9 +67,28 @@ public:
   [[nodiscard]] const protocol::XorCode& GetRollingCode() const;
   [[nodiscard]] int32_t GetRollingCodeInt() const;
 
+  //! Stores the latest suppliers of conflated commands of one type.
+  //! An unsent command of the same type and sender is replaced.
+  //! @param commandId ID of the commands.
+  //! @param suppliers Suppliers of the commands with the keys of their senders.
+  //! @returns `true` if unsent commands of the type were already waiting for a write, `false` otherwise.
+  bool ConflateCommands(
+    protocol::Command commandId,
+    std::span<const SenderCommandSupplier> suppliers);
+  //! Takes the latest suppliers of the conflated commands of one type.
+  //! @param commandId ID of the commands.
+  //! @returns Suppliers of the commands ordered by the keys of their senders,
+  //!          or no suppliers if there are none.
+  [[nodiscard]] std::vector<CommandSupplier> TakeConflatedCommands(protocol::Command commandId);
+  //! Clears the suppliers of the conflated commands.
+  void ClearConflatedCommands();
+
 private:
   std::queue<CommandSupplier> _commandQueue;
   protocol::XorCode _rollingCode{};
+  //! Latest suppliers of the unsent conflated commands,
+  //! mapped by the command ID and the key of the sender.
+  std::unordered_map<protocol::Command, std::map<uint32_t, CommandSupplier>> _conflatedCommands;
 };
 
 template <typename T>
@@ -94,21 +130,66 @@ public:
 
   void DisconnectClient(ClientId clientId);
 
+  //! Connects a client through an in-memory loopback instead of a socket.
+  //! The commands sent by the loopback client are handled as if they were received
+  //! from a socket and the commands queued for it are received by its peer end.
+  //! Does not require the server to be hosted.
+  //! @returns Loopback client.
+  [[nodiscard]] std::shared_ptr<network::LoopbackClient> ConnectLoopback();
+
+  //! Returns the remote address of a client.
+  //! @param clientId ID of the client.
+  //! @returns Remote address of the client.
+  [[nodiscard]] asio::ip::address GetClientAddress(ClientId clientId);
+
   //! Registers a command handler.
+  //! The handler is executed within a new trace.
   //! @param commandId ID of the command to register the handler for.
   //! @param handler Handler of the command.
   template <ReadableCommandStruct C>
   void RegisterCommandHandler(
     std::function<void(ClientId clientId, const C& command)> handler)
   {
-    _handlers[C::GetCommand()] = [handler](ClientId clientId, SourceStream& source)
+    _handlers[C::GetCommand()] = [this, handler](ClientId clientId, SourceStream& source)
     {
       C command;
       C::Read(command, source);
-      handler(clientId, command);
+
+      // Every handled command begins a new trace.
+      const auto traceId = trace::GenerateTraceId();
+
+      if (not _commandRouter)
+      {
+        const trace::Scope traceScope(traceId);
+        const trace::Span traceSpan(protocol::GetCommandName(C::GetCommand()));
+
+        const auto beginning = Clock::now();
+        handler(clientId, command);
+        ProfileHandler(C::GetCommand(), clientId, Clock::now() - beginning);
+        return;
+      }
+
+      _commandRouter(
+        clientId,
+        C::GetCommand(),
+        [this, handler, clientId, traceId, command = std::move(command)]()
+        {
+          const trace::Scope traceScope(traceId);
+          const trace::Span traceSpan(protocol::GetCommandName(C::GetCommand()));
+
+          const auto beginning = Clock::now();
+          handler(clientId, command);
+          ProfileHandler(C::GetCommand(), clientId, Clock::now() - beginning);
+        });
     };
   }
 
+  //! Sets the command router.
+  //! Without a router the command handlers are executed on the network thread.
+  //! Must be set before the server is hosted.
+  //! @param router Router of the commands.
+  void SetCommandRouter(CommandRouter router);
+
   //! Queues a command for sending.
   //! @param clientId ID of the client to send the command to.
   //! @param commandId ID of the command.
@@ -118,14 +199,172 @@ public:
     ClientId clientId,
     std::function<C()> supplier)
   {
-    SendCommand(clientId, C::GetCommand(), [supplier](SinkStream& sink){
+    SendCommand(clientId, C::GetCommand(), [this, clientId, supplier](SinkStream& sink){
+      const auto beginning = Clock::now();
       C::Write(supplier(), sink);
+      ProfileSupplier(C::GetCommand(), std::span(&clientId, 1), Clock::now() - beginning);
+    });
+  }
+
+  //! Queues a command for sending to multiple clients.
+  //! The command is written only once and the written data are shared by all the clients.
+  //! @param clientIds IDs of the clients to send the command to.
+  //! @param command Command.
+  template <WritableStruct C>
+  void QueueCommand(
+    std::span<const ClientId> clientIds,
+    const C& command)
+  {
+    SendCommand(clientIds, C::GetCommand(), [this, clientIds, &command](SinkStream& sink){
+      const auto beginning = Clock::now();
+      C::Write(command, sink);
+      ProfileSupplier(C::GetCommand(), clientIds, Clock::now() - beginning);
+    });
+  }
+
+  //! Queues a state command for sending, conflated per sender.
+  //! Only the latest state matters, so a command of the same type and sender
+  //! which is still waiting to be sent is replaced in place by this command.
+  //! The unsent commands of the same type are sent in a single write.
+  //! @param clientId ID of the client to send the command to.
+  //! @param senderKey Key of the sender of the state.
+  //! @param supplier Supplier of the command.
+  template <WritableStruct C>
+  void QueueConflatedCommand(
+    ClientId clientId,
+    uint32_t senderKey,
+    std::function<C()> supplier)
+  {
+    const SenderCommandSupplier senderSupplier{
+      senderKey,
+      [this, clientId, supplier](SinkStream& sink){
+        const auto beginning = Clock::now();
+        C::Write(supplier(), sink);
+        ProfileSupplier(C::GetCommand(), std::span(&clientId, 1), Clock::now() - beginning);
+      }};
+
+    SendConflatedCommands(clientId, C::GetCommand(), std::span(&senderSupplier, 1));
+  }
+
+  //! Queues state commands of multiple senders for sending, conflated per sender.
+  //! The commands are sent in a single write along with the unsent commands of the same type.
+  //! @param clientId ID of the client to send the commands to.
+  //! @param suppliers Suppliers of the commands with the keys of their senders,
+  //!                  usually the ones returned by `ShareCommand`.
+  template <WritableCommandStruct C>
+  void QueueConflatedCommands(
+    ClientId clientId,
+    std::span<const SenderCommandSupplier> suppliers)
+  {
+    SendConflatedCommands(clientId, C::GetCommand(), suppliers);
+  }
+
+  //! Writes a command once, so that the written data can be shared by multiple clients.
+  //! @param command Command.
+  //! @returns Supplier writing the shared command data.
+  template <WritableStruct C>
+  [[nodiscard]] CommandSupplier ShareCommand(const C& command)
+  {
+    return ShareCommandData([this, &command](SinkStream& sink){
+      const auto beginning = Clock::now();
+      C::Write(command, sink);
+      ProfileSupplier(C::GetCommand(), {}, Clock::now() - beginning);
+    });
+  }
+
+  //! Queues a state command for sending to multiple clients, conflated per sender.
+  //! The command is written only once and the written data are shared by all the clients.
+  //! @param clientIds IDs of the clients to send the command to.
+  //! @param senderKey Key of the sender of the state.
+  //! @param command Command.
+  template <WritableStruct C>
+  void QueueConflatedCommand(
+    std::span<const ClientId> clientIds,
+    uint32_t senderKey,
+    const C& command)
+  {
+    SendConflatedCommand(clientIds, C::GetCommand(), senderKey, [this, clientIds, &command](SinkStream& sink){
+      const auto beginning = Clock::now();
+      C::Write(command, sink);
+      ProfileSupplier(C::GetCommand(), clientIds, Clock::now() - beginning);
     });
   }
 
   void SetCode(ClientId client, protocol::XorCode code);
 
+  //! Sets the duration of a command handler or supplier invocation
+  //! over which the invocation is logged as slow.
+  //! Must be set before the server is hosted.
+  //! @param threshold Threshold of the duration, zero disables the logging.
+  void SetSlowCommandThreshold(std::chrono::microseconds threshold);
+
+  //! Begins capturing the commands received from the clients to a trace file.
+  //! The commands are captured descrambled, along with the connects and disconnects.
+  //! @param path Path of the trace file.
+  void BeginCapture(const std::filesystem::path& path);
+  //! Ends capturing the commands and flushes the trace file.
+  void EndCapture();
+  //! Captures a state the received commands depend on, if the commands are captured.
+  //! @param stateId ID of the state.
+  //! @param data Data of the state.
+  void CaptureState(uint16_t stateId, std::span<const std::byte> data);
+
+  //! Dispatches a command to its handler as if it was received from a client.
+  //! Used by the handling of the received data and by the in-process replay of a trace.
+  //! @param clientId ID of the client.
+  //! @param commandId ID of the command.
+  //! @param data Descrambled data of the command.
+  void DispatchCommand(
+    ClientId clientId,
+    protocol::Command commandId,
+    std::span<const std::byte> data);
+  //! Dispatches a client connect to the event handler.
+  //! @param clientId ID of the client.
+  void DispatchClientConnected(ClientId clientId);
+  //! Dispatches a client disconnect to the event handler.
+  //! @param clientId ID of the client.
+  void DispatchClientDisconnected(ClientId clientId);
+
+  //! Handles the data received from a client.
+  //! Every command buffered whole is descrambled, read and passed to its handler.
+  //! @param clientId ID of the client.
+  //! @param data Received data.
+  //! @returns Count of the bytes consumed.
+  std::size_t HandleClientData(
+    ClientId clientId,
+    std::span<const std::byte> data);
+
+  //! Writes a command prefixed with its message magic to the write buffer.
+  //! @param writeBuffer Write buffer.
+  //! @param commandId ID of the command.
+  //! @param supplier Supplier of the command.
+  //! @returns Size of the written command.
+  std::size_t WriteCommand(
+    asio::streambuf& writeBuffer,
+    protocol::Command commandId,
+    const CommandSupplier& supplier);
+
 private:
+  using Clock = std::chrono::steady_clock;
+
+  //! Records the duration of a command handler invocation.
+  //! @param commandId ID of the command.
+  //! @param clientId ID of the client the command was received from.
+  //! @param duration Duration of the invocation.
+  void ProfileHandler(
+    protocol::Command commandId,
+    ClientId clientId,
+    Clock::duration duration);
+
+  //! Records the duration of a command supplier invocation.
+  //! @param commandId ID of the command.
+  //! @param clientIds IDs of the clients the command is sent to.
+  //! @param duration Duration of the invocation.
+  void ProfileSupplier(
+    protocol::Command commandId,
+    std::span<const ClientId> clientIds,
+    Clock::duration duration);
+
   class NetworkEventHandler
     : public network::EventHandlerInterface
   {
@@ -146,13 +385,49 @@ private:
     protocol::Command commandId,
     CommandSupplier supplier);
 
+  //!
+  void SendCommand(
+    std::span<const ClientId> clientIds,
+    protocol::Command commandId,
+    const CommandSupplier& supplier);
+
+  //!
+  void SendConflatedCommands(
+    ClientId clientId,
+    protocol::Command commandId,
+    std::span<const SenderCommandSupplier> suppliers);
+
+  //!
+  void SendConflatedCommand(
+    std::span<const ClientId> clientIds,
+    protocol::Command commandId,
+    uint32_t senderKey,
+    const CommandSupplier& supplier);
+
+  //! Writes the command data once.
+  //! @param supplier Supplier of the command.
+  //! @returns Supplier writing the shared command data.
+  static CommandSupplier ShareCommandData(const CommandSupplier& supplier);
+
   bool debugIncomingCommandData = constants::DebugCommands;
   bool debugOutgoingCommandData = constants::DebugCommands;
   bool debugCommands = constants::DebugCommands;
 
   std::unordered_map<protocol::Command, RawCommandHandler> _handlers{};
+  CommandRouter _commandRouter{};
+  //! Duration of an invocation over which the invocation is logged as slow.
+  std::chrono::microseconds _slowCommandThreshold{0};
+  //! A mutex for the clients, which are accessed from the command handlers
+  //! that may be executed outside the network thread.
+  std::mutex _clientsMutex;
   std::unordered_map<ClientId, CommandClient> _clients{};
 
+  //! Whether the received commands are captured.
+  std::atomic_bool _isCapturing{false};
+  //! A mutex for the capture writer.
+  std::mutex _captureMutex;
+  std::unique_ptr<CommandTraceWriter> _captureWriter;
+
   EventHandlerInterface& _eventHandler;
   NetworkEventHandler _serverNetworkEventHandler;
 
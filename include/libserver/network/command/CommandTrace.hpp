@@ -0,0 +1,170 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef COMMAND_TRACE_HPP
+#define COMMAND_TRACE_HPP
+
+#include "CommandProtocol.hpp"
+#include "libserver/network/Server.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+namespace server
+{
+
+//! A record of a command trace.
+struct CommandTraceRecord
+{
+  //! A type of the record.
+  enum class Type : uint8_t
+  {
+    //! A client connected.
+    Connected = 0,
+    //! A client disconnected.
+    Disconnected = 1,
+    //! A client sent a command.
+    Command = 2,
+    //! A state the commands depend on was created outside of the captured server,
+    //! such as a one-time code granted by another director.
+    State = 3,
+  };
+
+  Type type{Type::Command};
+  //! Time since the beginning of the capture.
+  std::chrono::microseconds timestamp{};
+  network::ClientId clientId{};
+  //! ID of the command, valid only for the command records.
+  protocol::Command commandId{};
+  //! ID of the state, defined by the capturing server, valid only for the state records.
+  uint16_t stateId{};
+  //! Descrambled data of the command without the padding for the command records,
+  //! data of the state for the state records.
+  std::vector<std::byte> data;
+};
+
+//! Writes the commands received from the clients to a binary trace file.
+//!
+//! The trace file begins with the trace magic and the trace version.
+//! Each record is the record type followed by the time since the previous record
+//! and the client ID, both as variable-length integers.
+//! The command records continue with the command ID and the command data prefixed
+//! with their variable-length size, the state records alike with the state ID and data.
+class CommandTraceWriter final
+{
+public:
+  //! Constructor.
+  //! @param path Path of the trace file, the file is truncated.
+  //! @throws std::runtime_error If the trace file can't be opened.
+  explicit CommandTraceWriter(const std::filesystem::path& path);
+  //! Destructor.
+  //! Flushes the buffered records.
+  ~CommandTraceWriter();
+
+  //! Deleted copy constructor.
+  CommandTraceWriter(const CommandTraceWriter&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const CommandTraceWriter&) = delete;
+
+  //! Records a client connecting.
+  //! @param clientId ID of the client.
+  void RecordConnected(network::ClientId clientId);
+  //! Records a client disconnecting.
+  //! @param clientId ID of the client.
+  void RecordDisconnected(network::ClientId clientId);
+  //! Records a command received from a client.
+  //! @param clientId ID of the client.
+  //! @param commandId ID of the command.
+  //! @param data Descrambled data of the command.
+  void RecordCommand(
+    network::ClientId clientId,
+    protocol::Command commandId,
+    std::span<const std::byte> data);
+  //! Records a state the commands depend on.
+  //! @param stateId ID of the state.
+  //! @param data Data of the state.
+  void RecordState(
+    uint16_t stateId,
+    std::span<const std::byte> data);
+
+  //! Writes the buffered records to the trace file.
+  void Flush();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  //! Size of the buffered records at which they are written to the trace file.
+  static constexpr std::size_t FlushSize = 64 * 1024;
+
+  //! Writes the common part of a record.
+  //! @param type Type of the record.
+  //! @param clientId ID of the client.
+  void WriteRecordHeader(CommandTraceRecord::Type type, network::ClientId clientId);
+  //! Writes a variable-length integer.
+  //! @param value Value.
+  void WriteVarInt(uint64_t value);
+
+  std::ofstream _file;
+  //! Buffered records.
+  std::vector<std::byte> _buffer;
+
+  //! Time point of the beginning of the capture.
+  Clock::time_point _beginning;
+  //! Timestamp of the previous record.
+  std::chrono::microseconds _lastTimestamp{};
+};
+
+//! Reads the records of a binary trace file written by the CommandTraceWriter.
+class CommandTraceReader final
+{
+public:
+  //! Constructor.
+  //! @param path Path of the trace file.
+  //! @throws std::runtime_error If the trace file can't be opened or is not a trace.
+  explicit CommandTraceReader(const std::filesystem::path& path);
+
+  //! Reads the next record.
+  //! @param record Record to read into.
+  //! @returns `true` if a record was read, `false` at the end of the trace.
+  //! @throws std::runtime_error If the record is truncated.
+  bool Read(CommandTraceRecord& record);
+
+private:
+  //! Reads a variable-length integer.
+  //! @returns Value.
+  uint64_t ReadVarInt();
+
+  std::ifstream _file;
+  //! Timestamp of the previous record.
+  std::chrono::microseconds _lastTimestamp{};
+};
+
+//! Magic of the trace file, "ACTR".
+constexpr uint32_t CommandTraceMagic = 0x52544341;
+//! Version of the trace file format.
+//! Version 2 added the state records.
+constexpr uint16_t CommandTraceVersion = 2;
+
+} // namespace server
+
+#endif // COMMAND_TRACE_HPP
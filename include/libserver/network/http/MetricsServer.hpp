@@ -0,0 +1,75 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef METRICSSERVER_HPP
+#define METRICSSERVER_HPP
+
+#include "libserver/util/Metrics.hpp"
+
+#include <boost/asio.hpp>
+
+#include <thread>
+
+namespace server::network
+{
+
+namespace asio = boost::asio;
+
+//! An HTTP server exposing the metrics of a registry in the Prometheus text format.
+//! Serves `GET /metrics`, every other request is answered with 404.
+class MetricsServer final
+{
+public:
+  //! Constructor.
+  //! @param registry Registry of the exposed metrics.
+  explicit MetricsServer(metrics::Registry& registry);
+  //! Destructor.
+  ~MetricsServer();
+
+  //! Deleted copy constructor.
+  MetricsServer(const MetricsServer&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const MetricsServer&) = delete;
+
+  //! Begins the metrics server on a separate thread.
+  //! @param address Address of the interface to bind to.
+  //! @param port Port to bind to.
+  void BeginHost(const asio::ip::address& address, uint16_t port);
+
+  //! Ends the metrics server and waits for its thread to finish.
+  void EndHost();
+
+private:
+  //! Accepts the connections.
+  void AcceptLoop();
+
+  //! Serves the requests of a connection.
+  //! @param socket Socket of the connection.
+  void Serve(asio::ip::tcp::socket socket);
+
+  metrics::Registry& _registry;
+
+  asio::io_context _ioContext;
+  asio::ip::tcp::acceptor _acceptor;
+  std::thread _thread;
+};
+
+} // namespace server::network
+
+#endif // METRICSSERVER_HPP
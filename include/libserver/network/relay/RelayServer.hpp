@@ -0,0 +1,213 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef RELAYSERVER_HPP
+#define RELAYSERVER_HPP
+
+#include <boost/asio.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <span>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace server::network
+{
+
+namespace asio = boost::asio;
+
+//! A relay server forwarding the datagrams of a P2P peer to the other peers of its room.
+//! Peer endpoints are bound to the room members reserved for the address of the peer.
+//! Members which are inactive for longer than the idle timeout are forgotten.
+class RelayServer final
+{
+public:
+  //! Room ID.
+  using RoomId = uint32_t;
+  //! Member ID, the P2P ID of the peer in its room.
+  using MemberId = uint16_t;
+
+  //! Default constructor.
+  RelayServer();
+  //! Destructor.
+  ~RelayServer();
+
+  //! Deleted copy constructor.
+  RelayServer(const RelayServer&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const RelayServer&) = delete;
+
+  //! Begins the relay server on a separate thread.
+  //! @param address Address of the interface to bind to.
+  //! @param port Port to bind to.
+  //! @param idleTimeout Duration of inactivity after which a member is forgotten,
+  //!                    members are never forgotten if zero.
+  void BeginHost(
+    const asio::ip::address& address,
+    uint16_t port,
+    std::chrono::milliseconds idleTimeout);
+
+  //! Ends the relay server and waits for its thread to finish.
+  void EndHost();
+
+  //! Reserves a room membership for a peer with the specified address.
+  //! Replaces the previous membership of the member along with its bound endpoint.
+  //! Does nothing if the relay server is not hosting.
+  //! @param roomId ID of the room.
+  //! @param memberId ID of the member.
+  //! @param address Address of the peer.
+  void ReserveMember(
+    RoomId roomId,
+    MemberId memberId,
+    const asio::ip::address& address);
+
+  //! Removes a room membership along with its bound endpoint.
+  //! Does nothing if the relay server is not hosting.
+  //! @param roomId ID of the room.
+  //! @param memberId ID of the member.
+  void RemoveMember(RoomId roomId, MemberId memberId);
+
+  //! Removes a room along with its members and reservations.
+  //! Does nothing if the relay server is not hosting.
+  //! @param roomId ID of the room.
+  void RemoveRoom(RoomId roomId);
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  //! Max size of a datagram.
+  static constexpr std::size_t MaxDatagramSize = 2048;
+  //! Max count of datagrams received or sent at once.
+  static constexpr std::size_t BatchSize = 32;
+
+  //! A header prefixed to every relayed datagram.
+  struct RelayHeader
+  {
+    uint16_t member0{};
+    uint16_t member1{};
+    uint16_t member2{1};
+  };
+
+  //! A reference to a room member.
+  struct MemberRef
+  {
+    RoomId roomId{};
+    MemberId memberId{};
+
+    bool operator==(const MemberRef&) const = default;
+  };
+
+  //! A room member.
+  struct Member
+  {
+    //! Reserved address of the member.
+    asio::ip::address address{};
+    //! Endpoint bound to the member, if any.
+    std::optional<asio::ip::udp::endpoint> endpoint{};
+    //! Time point of the reservation or of the last datagram of the member.
+    Clock::time_point lastActivity{};
+  };
+
+  //! A room.
+  struct Room
+  {
+    std::unordered_map<MemberId, Member> members;
+  };
+
+  //! A datagram queued for sending.
+  struct Datagram
+  {
+    asio::ip::udp::endpoint endpoint{};
+    //! Offset of the datagram data in the send buffer.
+    std::size_t offset{};
+    //! Size of the datagram data.
+    std::size_t size{};
+  };
+
+  //! Waits for the socket to become readable and receives the datagrams.
+  void ReadLoop();
+  //! Periodically expires idle members.
+  void ExpiryLoop();
+
+  //! Receives all the pending datagrams.
+  void ReceiveDatagrams();
+  //! Sends all the queued datagrams.
+  void SendDatagrams();
+
+  //! Handles a datagram received from a peer.
+  //! @param sender Endpoint of the peer.
+  //! @param data Data of the datagram.
+  void HandleDatagram(
+    const asio::ip::udp::endpoint& sender,
+    std::span<const std::byte> data);
+
+  //! Binds an unknown endpoint to the member reserved for its address.
+  //! An address with a single reservation is bound on the address alone. Peers sharing
+  //! an address are told apart by the member ID the first datagram is assumed to begin with,
+  //! the layout of the P2P datagrams is unverified.
+  //! @param sender Endpoint of the peer.
+  //! @param data Data of the first datagram of the peer.
+  //! @returns Reference to the bound member, or empty if the datagram claims no reservation.
+  std::optional<MemberRef> BindMember(
+    const asio::ip::udp::endpoint& sender,
+    std::span<const std::byte> data);
+
+  //! Removes a member along with its bound endpoint and reservation.
+  //! @param roomIter Iterator of the room of the member.
+  //! @param memberIter Iterator of the member.
+  //! @returns Iterator following the removed member.
+  std::unordered_map<MemberId, Member>::iterator EraseMember(
+    std::unordered_map<RoomId, Room>::iterator roomIter,
+    std::unordered_map<MemberId, Member>::iterator memberIter);
+
+  //! Removes members that are idle and rooms that are left empty.
+  void ExpireIdle();
+
+  asio::io_context _ioContext;
+  asio::ip::udp::socket _socket;
+  asio::steady_timer _expiryTimer;
+  std::thread _thread;
+  //! Whether the relay server is hosting.
+  std::atomic_bool _isHosting{false};
+
+  //! Duration of inactivity after which a member is forgotten.
+  Clock::duration _idleTimeout{};
+
+  //! Members mapped by their bound endpoint.
+  std::unordered_map<asio::ip::udp::endpoint, MemberRef> _peers;
+  //! Members mapped by their reserved address.
+  std::unordered_map<asio::ip::address, std::vector<MemberRef>> _reservations;
+  //! Rooms mapped by their ID.
+  std::unordered_map<RoomId, Room> _rooms;
+
+  //! Buffers for the received datagrams.
+  std::vector<std::array<std::byte, MaxDatagramSize>> _receiveBuffers;
+  //! Buffer holding the data of the queued datagrams.
+  std::vector<std::byte> _sendBuffer;
+  //! Queue of the datagrams to send.
+  std::vector<Datagram> _sendQueue;
+};
+
+} // namespace server::network
+
+#endif // RELAYSERVER_HPP
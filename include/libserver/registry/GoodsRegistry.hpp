@@ -0,0 +1,86 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef GOODSREGISTRY_HPP
+#define GOODSREGISTRY_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace server::registry
+{
+
+//! Goods sold in the shop.
+struct Goods
+{
+  //! A price of the goods.
+  struct Price
+  {
+    uint32_t priceId{};
+    //! Count or duration of the item bought for the price.
+    uint32_t priceRange{};
+    uint32_t goodsPrice{};
+  };
+
+  //! A sequential number of the goods.
+  uint32_t goodsSq{};
+  uint32_t setType{};
+  uint32_t moneyType{};
+  uint32_t goodsType{};
+  uint32_t recommendType{};
+  uint32_t recommendNo{};
+  uint32_t giftType{};
+  uint32_t salesRank{};
+  uint32_t bonusGameMoney{};
+  std::string name;
+  std::string description;
+  std::string capacityDescription;
+  uint32_t sellState{};
+  //! A TID of the item sold.
+  uint32_t itemTid{};
+  std::vector<Price> prices;
+};
+
+//! A registry of the goods, the config may be reloaded while the goods are read.
+class GoodsRegistry final
+{
+public:
+  //! Reads the goods from the config and replaces the current goods.
+  //! @param configPath Path of the config.
+  void ReadConfig(const std::filesystem::path& configPath);
+
+  //! Returns the goods in the order they are listed in the config.
+  //! @returns Snapshot of the goods, not affected by the later reloads.
+  [[nodiscard]] std::shared_ptr<const std::vector<Goods>> GetGoods() const;
+
+private:
+  //! A mutex for the goods.
+  mutable std::mutex _goodsMutex;
+  //! Current goods.
+  std::shared_ptr<const std::vector<Goods>> _goods
+    = std::make_shared<const std::vector<Goods>>();
+};
+
+} // namespace server::registry
+
+#endif // GOODSREGISTRY_HPP
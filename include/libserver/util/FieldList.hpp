@@ -0,0 +1,218 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef FIELDLIST_HPP
+#define FIELDLIST_HPP
+
+#include "libserver/util/Stream.hpp"
+
+#include <array>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace server
+{
+
+namespace detail
+{
+
+//! Traits of a pointer to a data member.
+template <typename T>
+struct MemberPointerTraits;
+
+template <typename C, typename T>
+struct MemberPointerTraits<T C::*>
+{
+  using Class = C;
+  using Type = T;
+};
+
+//! Whether the type is written to the stream as its raw bytes.
+template <typename T>
+struct IsTrivialField : std::bool_constant<Numeric<T>> {};
+
+template <typename T, std::size_t N>
+struct IsTrivialField<std::array<T, N>> : std::bool_constant<Numeric<T>> {};
+
+//! Returns the values of a trivial field.
+template <Numeric T>
+std::span<T> FieldValues(T& field)
+{
+  return std::span(&field, 1);
+}
+
+template <Numeric T, std::size_t N>
+std::span<T> FieldValues(std::array<T, N>& field)
+{
+  return std::span(field);
+}
+
+template <Numeric T>
+std::span<const T> FieldValues(const T& field)
+{
+  return std::span(&field, 1);
+}
+
+template <Numeric T, std::size_t N>
+std::span<const T> FieldValues(const std::array<T, N>& field)
+{
+  return std::span(field);
+}
+
+} // namespace detail
+
+//! A list of the fields of a struct, serialized in the order they are listed in.
+//! Generates the `Read` and `Write` of the struct from its fields.
+//! Adjacent numeric fields, and arrays of numerics, are copied to or from one region
+//! of the stream reserved with a single bounds check.
+//! Other fields are read and written through the stream.
+//! @tparam Members Pointers to the data members of the struct.
+template <auto... Members>
+class FieldList final
+{
+  static_assert(sizeof...(Members) > 0, "Field list must not be empty");
+
+  //! Count of the fields.
+  static constexpr std::size_t Count = sizeof...(Members);
+
+  //! Pointer to the data member of a field.
+  template <std::size_t Idx>
+  static constexpr auto Member = std::get<Idx>(std::tuple{Members...});
+
+  //! Whether the fields are trivial.
+  static constexpr std::array<bool, Count> IsTrivial{
+    detail::IsTrivialField<typename detail::MemberPointerTraits<decltype(Members)>::Type>::value...};
+  //! Sizes of the field types.
+  static constexpr std::array<std::size_t, Count> Sizes{
+    sizeof(typename detail::MemberPointerTraits<decltype(Members)>::Type)...};
+
+  //! Returns the end of a run of trivial fields.
+  //! @param begin Index of the first field of the run.
+  //! @returns Index past the last field of the run.
+  static constexpr std::size_t RunEnd(std::size_t begin)
+  {
+    while (begin < Count && IsTrivial[begin])
+      ++begin;
+    return begin;
+  }
+
+  //! Returns the offset of a field within a run of trivial fields.
+  //! @param begin Index of the first field of the run.
+  //! @param idx Index of the field.
+  //! @returns Offset of the field in bytes.
+  static constexpr std::size_t RunOffset(std::size_t begin, std::size_t idx)
+  {
+    std::size_t offset = 0;
+    for (; begin < idx; ++begin)
+      offset += Sizes[begin];
+    return offset;
+  }
+
+public:
+  //! Struct the fields belong to.
+  using Struct = typename detail::MemberPointerTraits<
+    std::tuple_element_t<0, std::tuple<decltype(Members)...>>>::Class;
+
+  //! Whether all the fields are trivial and the serialized size is known at compile time.
+  static constexpr bool IsFixedSize = RunEnd(0) == Count;
+  //! Serialized size of the fields in bytes, valid only if `IsFixedSize`.
+  static constexpr std::size_t FixedSize = RunOffset(0, RunEnd(0));
+
+  //! Writes the fields of a struct to the sink stream.
+  //! @param value Struct to write.
+  //! @param stream Sink stream.
+  static void Write(const Struct& value, SinkStream& stream)
+  {
+    WriteFrom<0>(value, stream);
+  }
+
+  //! Reads the fields of a struct from the source stream.
+  //! @param value Struct to read.
+  //! @param stream Source stream.
+  static void Read(Struct& value, SourceStream& stream)
+  {
+    ReadFrom<0>(value, stream);
+  }
+
+private:
+  template <std::size_t Idx>
+  static void WriteFrom(const Struct& value, SinkStream& stream)
+  {
+    if constexpr (Idx == Count)
+    {
+      return;
+    }
+    else if constexpr (IsTrivial[Idx])
+    {
+      constexpr std::size_t End = RunEnd(Idx);
+      WriteRun<Idx>(value, stream, std::make_index_sequence<End - Idx>{});
+      WriteFrom<End>(value, stream);
+    }
+    else
+    {
+      stream.Write(value.*Member<Idx>);
+      WriteFrom<Idx + 1>(value, stream);
+    }
+  }
+
+  template <std::size_t Idx>
+  static void ReadFrom(Struct& value, SourceStream& stream)
+  {
+    if constexpr (Idx == Count)
+    {
+      return;
+    }
+    else if constexpr (IsTrivial[Idx])
+    {
+      constexpr std::size_t End = RunEnd(Idx);
+      ReadRun<Idx>(value, stream, std::make_index_sequence<End - Idx>{});
+      ReadFrom<End>(value, stream);
+    }
+    else
+    {
+      stream.Read(value.*Member<Idx>);
+      ReadFrom<Idx + 1>(value, stream);
+    }
+  }
+
+  //! Writes a run of trivial fields to one reserved region of the stream.
+  template <std::size_t Begin, std::size_t... Idxs>
+  static void WriteRun(const Struct& value, SinkStream& stream, std::index_sequence<Idxs...>)
+  {
+    std::byte* const region = stream.Reserve(RunOffset(Begin, Begin + sizeof...(Idxs)));
+    (detail::CopyToStream(
+      region + RunOffset(Begin, Begin + Idxs),
+      detail::FieldValues(value.*Member<Begin + Idxs>)), ...);
+  }
+
+  //! Reads a run of trivial fields from one reserved region of the stream.
+  template <std::size_t Begin, std::size_t... Idxs>
+  static void ReadRun(Struct& value, SourceStream& stream, std::index_sequence<Idxs...>)
+  {
+    const std::byte* const region = stream.Reserve(RunOffset(Begin, Begin + sizeof...(Idxs)));
+    (detail::CopyFromStream(
+      detail::FieldValues(value.*Member<Begin + Idxs>),
+      region + RunOffset(Begin, Begin + Idxs)), ...);
+  }
+};
+
+} // namespace server
+
+#endif // FIELDLIST_HPP
@@ -21,6 +21,7 @@
 #define LOCALE_HPP
 
 #include <string>
+#include <string_view>
 
 namespace server
 {
@@ -28,13 +29,21 @@ namespace server
 namespace locale
 {
 
+//! Checks whether the string consists of ASCII characters only.
+//! ASCII strings are encoded the same in EUC-KR and UTF-8 and need no conversion.
+//! @param input Input string.
+//! @returns `true` if the string is ASCII, `false` otherwise.
+[[nodiscard]] bool IsAscii(std::string_view input);
+
 //! Converts EUC-KR encoded string into a UTF-8 encoded string.
+//! ASCII strings are copied and recent conversions of short strings are cached.
 //! @param input Input string in the EUC-KR encoding.
 //! @returns Output string encoded in UTF8 encoding.
 //! @throws std::runtime_error If the conversion fails for any reason.
 [[nodiscard]] std::string ToUtf8(const std::string& input);
 
 //! Converts UTF-8 encoded string into a EUC-KR encoded string.
+//! ASCII strings are copied and recent conversions of short strings are cached.
 //! @param input Input string in the UTF8 encoding.
 //! @returns Output string encoded in EUC-KR encoding.
 //! @throws std::runtime_error If the conversion fails for any reason.
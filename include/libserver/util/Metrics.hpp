@@ -0,0 +1,242 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace server::metrics
+{
+
+//! Count of the shards the values of a metric are split into.
+//! Threads update the shard they are assigned to, so that they do not contend over a cache line.
+constexpr std::size_t ShardCount = 8;
+
+//! Returns the shard of the calling thread.
+//! @returns Index of the shard.
+[[nodiscard]] std::size_t GetThreadShard();
+
+//! Labels of a metric.
+using Labels = std::initializer_list<std::pair<std::string_view, std::string_view>>;
+
+//! A monotonically increasing counter.
+class Counter final
+{
+public:
+  //! Increments the counter.
+  //! @param value Value to increment the counter by.
+  void Increment(uint64_t value = 1)
+  {
+    _shards[GetThreadShard()].value.fetch_add(value, std::memory_order::relaxed);
+  }
+
+  //! Returns the value of the counter.
+  //! @returns Value of the counter.
+  [[nodiscard]] uint64_t GetValue() const;
+
+private:
+  struct alignas(64) Shard
+  {
+    std::atomic_uint64_t value{0};
+  };
+
+  std::array<Shard, ShardCount> _shards{};
+};
+
+//! A gauge which can go up and down.
+class Gauge final
+{
+public:
+  //! Sets the value of the gauge.
+  //! @param value Value.
+  void Set(int64_t value)
+  {
+    _value.store(value, std::memory_order::relaxed);
+  }
+
+  //! Increments the gauge.
+  //! @param value Value to increment the gauge by.
+  void Increment(int64_t value = 1)
+  {
+    _value.fetch_add(value, std::memory_order::relaxed);
+  }
+
+  //! Decrements the gauge.
+  //! @param value Value to decrement the gauge by.
+  void Decrement(int64_t value = 1)
+  {
+    _value.fetch_sub(value, std::memory_order::relaxed);
+  }
+
+  //! Returns the value of the gauge.
+  //! @returns Value of the gauge.
+  [[nodiscard]] int64_t GetValue() const
+  {
+    return _value.load(std::memory_order::relaxed);
+  }
+
+private:
+  std::atomic_int64_t _value{0};
+};
+
+//! A histogram of durations with a bounded relative error, in the manner of HdrHistogram.
+//! Durations are counted in nanoseconds, in buckets which are linear within every power of two,
+//! which bounds the relative error of the quantiles to 1/16.
+//! Durations longer than the max duration are counted as the max duration.
+class Histogram final
+{
+public:
+  //! Count of the linear sub-buckets of a power of two, as a power of two.
+  static constexpr uint32_t SubBucketBits = 4;
+  //! Max duration in nanoseconds as a power of two, about 18 minutes.
+  static constexpr uint32_t MaxValueBits = 40;
+  //! Count of the buckets.
+  static constexpr std::size_t BucketCount =
+    (MaxValueBits - SubBucketBits + 1) << SubBucketBits;
+
+  //! A snapshot of the histogram.
+  struct Snapshot
+  {
+    //! Counts of the durations in the buckets.
+    std::array<uint64_t, BucketCount> buckets{};
+    //! Count of the durations.
+    uint64_t count{0};
+    //! Sum of the durations in nanoseconds.
+    uint64_t sum{0};
+
+    //! Returns the duration at a quantile.
+    //! @param quantile Quantile between 0 and 1.
+    //! @returns Highest duration in nanoseconds equivalent to the duration at the quantile.
+    [[nodiscard]] uint64_t GetQuantile(double quantile) const;
+  };
+
+  //! Default constructor.
+  Histogram();
+
+  //! Observes a duration.
+  //! @param duration Duration.
+  void Observe(std::chrono::nanoseconds duration)
+  {
+    const uint64_t value = duration.count() > 0
+      ? static_cast<uint64_t>(duration.count())
+      : 0;
+
+    auto& shard = *_shards[GetThreadShard()];
+    shard.buckets[GetBucket(value)].fetch_add(1, std::memory_order::relaxed);
+    shard.sum.fetch_add(value, std::memory_order::relaxed);
+  }
+
+  //! Returns a snapshot of the histogram.
+  //! @returns Snapshot.
+  [[nodiscard]] Snapshot GetSnapshot() const;
+
+  //! Returns the bucket of a value.
+  //! @param value Value in nanoseconds.
+  //! @returns Index of the bucket.
+  [[nodiscard]] static std::size_t GetBucket(uint64_t value);
+  //! Returns the highest value of a bucket.
+  //! @param bucket Index of the bucket.
+  //! @returns Highest value in nanoseconds.
+  [[nodiscard]] static uint64_t GetBucketHighestValue(std::size_t bucket);
+
+private:
+  struct alignas(64) Shard
+  {
+    std::array<std::atomic_uint64_t, BucketCount> buckets{};
+    std::atomic_uint64_t sum{0};
+  };
+
+  //! Shards, allocated separately as they are large.
+  std::array<std::unique_ptr<Shard>, ShardCount> _shards{};
+};
+
+//! A registry of the metrics.
+//! Metrics are registered once, under a mutex, and are never removed.
+//! The registered metrics are updated without any locking.
+class Registry final
+{
+public:
+  //! Returns a counter, registering it if it does not exist yet.
+  //! @param name Name of the counter.
+  //! @param help Description of the counter.
+  //! @param labels Labels of the counter.
+  //! @returns Reference to the counter, valid for the lifetime of the registry.
+  Counter& GetCounter(std::string_view name, std::string_view help, Labels labels = {});
+  //! Returns a gauge, registering it if it does not exist yet.
+  //! @param name Name of the gauge.
+  //! @param help Description of the gauge.
+  //! @param labels Labels of the gauge.
+  //! @returns Reference to the gauge, valid for the lifetime of the registry.
+  Gauge& GetGauge(std::string_view name, std::string_view help, Labels labels = {});
+  //! Returns a histogram, registering it if it does not exist yet.
+  //! @param name Name of the histogram.
+  //! @param help Description of the histogram.
+  //! @param labels Labels of the histogram.
+  //! @returns Reference to the histogram, valid for the lifetime of the registry.
+  Histogram& GetHistogram(std::string_view name, std::string_view help, Labels labels = {});
+
+  //! Writes the metrics in the Prometheus text exposition format.
+  //! Histograms are exposed as summaries of quantiles in seconds.
+  //! @returns Text exposition of the metrics.
+  [[nodiscard]] std::string Expose() const;
+
+private:
+  //! A metric.
+  using Metric = std::variant<
+    std::unique_ptr<Counter>,
+    std::unique_ptr<Gauge>,
+    std::unique_ptr<Histogram>>;
+
+  //! A family of the metrics with the same name.
+  struct Family
+  {
+    std::string help;
+    //! Metrics mapped by their formatted labels.
+    std::map<std::string, Metric, std::less<>> metrics;
+  };
+
+  //! Returns a metric, registering it if it does not exist yet.
+  template <typename T>
+  T& GetMetric(std::string_view name, std::string_view help, Labels labels);
+
+  //! A mutex for the families.
+  mutable std::mutex _familiesMutex;
+  //! Families mapped by their name.
+  std::map<std::string, Family, std::less<>> _families;
+};
+
+//! Returns the registry of the process.
+//! @returns Reference to the registry.
+Registry& GetRegistry();
+
+} // namespace server::metrics
+
+#endif // METRICS_HPP
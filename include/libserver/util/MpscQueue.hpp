@@ -0,0 +1,106 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef MPSCQUEUE_HPP
+#define MPSCQUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace server
+{
+
+//! A lock-free, unbounded queue with multiple producers and a single consumer.
+//! Producers push with a single atomic exchange and never wait for each other
+//! or for the consumer. A value being pushed may not be visible to the consumer
+//! until the producer links it, the queue may briefly appear empty in that case.
+template <typename T>
+class MpscQueue final
+{
+public:
+  //! Default constructor.
+  MpscQueue()
+    : _head(new Node())
+    , _tail(_head.load(std::memory_order::relaxed))
+  {
+  }
+
+  //! Destructor.
+  ~MpscQueue()
+  {
+    while (_tail != nullptr)
+    {
+      Node* const next = _tail->next.load(std::memory_order::relaxed);
+      delete _tail;
+      _tail = next;
+    }
+  }
+
+  //! Deleted copy constructor.
+  MpscQueue(const MpscQueue&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const MpscQueue&) = delete;
+
+  //! Pushes a value to the queue.
+  //! May be called from any thread.
+  //! @param value Value to push.
+  void Push(T value)
+  {
+    Node* const node = new Node();
+    node->value = std::move(value);
+
+    Node* const previous = _head.exchange(node, std::memory_order::acq_rel);
+    previous->next.store(node, std::memory_order::release);
+  }
+
+  //! Pops a value from the queue.
+  //! Must be called only from the consumer thread.
+  //! @param value Popped value.
+  //! @returns `true` if a value was popped, `false` if the queue is empty.
+  bool Pop(T& value)
+  {
+    Node* const next = _tail->next.load(std::memory_order::acquire);
+    if (next == nullptr)
+      return false;
+
+    // The popped node becomes the new stub node of the queue.
+    value = std::move(next->value);
+    delete _tail;
+    _tail = next;
+
+    return true;
+  }
+
+private:
+  //! A node of the queue.
+  struct Node
+  {
+    std::atomic<Node*> next{nullptr};
+    T value{};
+  };
+
+  //! The node pushed last, shared by the producers.
+  std::atomic<Node*> _head;
+  //! The stub node preceding the node popped next, owned by the consumer.
+  Node* _tail;
+};
+
+} // namespace server
+
+#endif // MPSCQUEUE_HPP
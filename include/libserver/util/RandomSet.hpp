@@ -0,0 +1,139 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef RANDOMSET_HPP
+#define RANDOMSET_HPP
+
+#include <optional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+
+//! A set of values supporting a uniform random pick in a constant time.
+//! Values are kept in a dense vector, a removed value is swapped with the last one.
+//! @tparam Value Type of the value.
+template <typename Value>
+class RandomSet final
+{
+public:
+  //! Inserts a value.
+  //! @param value Value.
+  //! @returns `true` if the value was inserted, `false` if it already was in the set.
+  bool Insert(const Value& value)
+  {
+    const auto [indexIter, inserted] = _indices.try_emplace(value, _values.size());
+    if (not inserted)
+      return false;
+
+    _values.emplace_back(value);
+    return true;
+  }
+
+  //! Removes a value.
+  //! @param value Value.
+  //! @returns `true` if the value was removed, `false` if it was not in the set.
+  bool Remove(const Value& value)
+  {
+    const auto indexIter = _indices.find(value);
+    if (indexIter == _indices.cend())
+      return false;
+
+    // Fill the place of the removed value with the last value.
+    const std::size_t index = indexIter->second;
+    _indices.erase(indexIter);
+
+    if (index != _values.size() - 1)
+    {
+      _values[index] = std::move(_values.back());
+      _indices[_values[index]] = index;
+    }
+
+    _values.pop_back();
+    return true;
+  }
+
+  //! Returns whether the set contains a value.
+  //! @param value Value.
+  //! @returns `true` if the set contains the value, `false` otherwise.
+  [[nodiscard]] bool Contains(const Value& value) const
+  {
+    return _indices.contains(value);
+  }
+
+  //! Returns the count of the values.
+  //! @returns Count of the values.
+  [[nodiscard]] std::size_t GetSize() const
+  {
+    return _values.size();
+  }
+
+  //! Returns whether the set is empty.
+  //! @returns `true` if the set is empty, `false` otherwise.
+  [[nodiscard]] bool IsEmpty() const
+  {
+    return _values.empty();
+  }
+
+  //! Picks a value uniformly at random.
+  //! @param generator Random number generator.
+  //! @param excluded Value never picked.
+  //! @returns Picked value, or empty if there is no value to pick.
+  template <typename Generator>
+  [[nodiscard]] std::optional<Value> Pick(
+    Generator& generator,
+    const std::optional<Value>& excluded = std::nullopt) const
+  {
+    std::size_t candidateCount = _values.size();
+
+    // Pick from the values without the excluded one and skip over its index.
+    std::optional<std::size_t> excludedIndex;
+    if (excluded)
+    {
+      const auto indexIter = _indices.find(*excluded);
+      if (indexIter != _indices.cend())
+      {
+        excludedIndex = indexIter->second;
+        --candidateCount;
+      }
+    }
+
+    if (candidateCount == 0)
+      return std::nullopt;
+
+    std::uniform_int_distribution<std::size_t> indexDistribution(0, candidateCount - 1);
+    std::size_t index = indexDistribution(generator);
+    if (excludedIndex && index >= *excludedIndex)
+      ++index;
+
+    return _values[index];
+  }
+
+private:
+  //! Values of the set.
+  std::vector<Value> _values;
+  //! Indices of the values mapped by the value.
+  std::unordered_map<Value, std::size_t> _indices;
+};
+
+} // namespace server
+
+#endif // RANDOMSET_HPP
@@ -0,0 +1,118 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef RANKING_HPP
+#define RANKING_HPP
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+
+//! A ranking of keys by their score.
+//! Scores are counted in buckets of a Fenwick tree,
+//! the rank and percentile of a key are looked up in a logarithmic time.
+//! Keys with scores in the same bucket share the rank.
+class Ranking final
+{
+public:
+  //! A ranked key.
+  using Key = uint32_t;
+  //! A score.
+  using Score = uint32_t;
+
+  //! An order of the scores.
+  enum class Order
+  {
+    //! Lower scores rank better.
+    Ascending,
+    //! Higher scores rank better.
+    Descending
+  };
+
+  //! Constructor.
+  //! @param order Order of the scores.
+  //! @param maxScore Max score, greater scores are counted as the max score.
+  //! @param bucketSize Size of a score bucket.
+  Ranking(Order order, Score maxScore, Score bucketSize = 1);
+
+  //! Sets the score of a key.
+  //! @param key Key.
+  //! @param score Score.
+  void Set(Key key, Score score);
+  //! Sets the score of a key if it ranks better than the current score of the key.
+  //! @param key Key.
+  //! @param score Score.
+  //! @returns `true` if the score was set, `false` otherwise.
+  bool Submit(Key key, Score score);
+  //! Removes a key.
+  //! @param key Key.
+  void Remove(Key key);
+
+  //! Returns the score of a key.
+  //! @param key Key.
+  //! @returns Score of the key, or empty if the key is not ranked.
+  [[nodiscard]] std::optional<Score> GetScore(Key key) const;
+  //! Returns the rank of a key.
+  //! @param key Key.
+  //! @returns One-based rank of the key, or empty if the key is not ranked.
+  [[nodiscard]] std::optional<uint32_t> GetRank(Key key) const;
+  //! Returns the percentile of a key.
+  //! @param key Key.
+  //! @returns Percentage of the ranked keys the key ranks better than or equal to,
+  //!          or empty if the key is not ranked.
+  [[nodiscard]] std::optional<uint8_t> GetPercentile(Key key) const;
+
+  //! Returns the count of the ranked keys.
+  //! @returns Count of the ranked keys.
+  [[nodiscard]] std::size_t GetSize() const;
+  //! Returns the scores of the ranked keys.
+  //! @returns Scores mapped by their key.
+  [[nodiscard]] const std::unordered_map<Key, Score>& GetScores() const;
+
+private:
+  //! Returns the bucket of a score ordered from the best to the worst.
+  //! @param score Score.
+  //! @returns Index of the bucket.
+  [[nodiscard]] std::size_t GetBucket(Score score) const;
+
+  //! Adds to the count of a bucket.
+  //! @param bucket Index of the bucket.
+  //! @param delta Delta to add.
+  void AddToBucket(std::size_t bucket, int32_t delta);
+  //! Returns the count of the keys in the buckets preceding a bucket.
+  //! @param bucket Index of the bucket.
+  //! @returns Count of the keys.
+  [[nodiscard]] uint32_t CountPreceding(std::size_t bucket) const;
+
+  Order _order;
+  Score _bucketSize;
+
+  //! A Fenwick tree of the key counts per score bucket, indexed from one.
+  std::vector<uint32_t> _tree;
+  //! Scores mapped by their key.
+  std::unordered_map<Key, Score> _scores;
+};
+
+} // namespace server
+
+#endif // RANKING_HPP
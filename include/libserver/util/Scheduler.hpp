@@ -20,6 +20,8 @@
 #ifndef SERVER_SCHEDULER_HPP
 #define SERVER_SCHEDULER_HPP
 
+#include "libserver/util/Trace.hpp"
+
 #include <chrono>
 #include <functional>
 #include <list>
@@ -37,12 +39,11 @@ public:
   //! An alias for the standard steady-clock.
   using Clock = std::chrono::steady_clock;
 
-  Scheduler();
-
-  //! Tick the scheduler.
+  //! Tick the scheduler, executes all the jobs which are due.
   void Tick();
 
   //! Queue a task to be executed in the next tick.
+  //! The task is executed within the trace of the calling thread.
   //! @param task Task to queue execution of.
   //! @param when A time point of when to execute the task. Defaults to immediate execution.
   void Queue(
@@ -57,14 +58,14 @@ protected:
     Clock::time_point when{};
     //! A task the job has to execute.
     Task task{};
+    //! A trace ID of the thread which queued the job.
+    trace::TraceId traceId{trace::InvalidTraceId};
   };
 
   //! A mutex to the job list.
   std::mutex _jobsMutex;
   //! A job list.
   std::list<Job> _jobs;
-  //! An iterator to the job to execute in the next tick cycle.
-  decltype(_jobs)::const_iterator _jobIterator;
 };
 
 } // namespace server
@@ -0,0 +1,171 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef SHARDPOOL_HPP
+#define SHARDPOOL_HPP
+
+#include "libserver/util/Trace.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+
+//! A pool of worker threads (shards) executing the tasks of partitions.
+//! Every partition is pinned to one shard, the tasks of a partition are executed
+//! in the order they were queued in and never concurrently.
+//! Partitions can be migrated between the shards to balance the load.
+class ShardPool final
+{
+public:
+  //! A task to perform.
+  using Task = std::function<void()>;
+  //! A partition key.
+  using Key = uint32_t;
+
+  //! Default constructor.
+  ShardPool() = default;
+  //! Destructor.
+  ~ShardPool();
+
+  //! Deleted copy constructor.
+  ShardPool(const ShardPool&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const ShardPool&) = delete;
+
+  //! Starts the shard threads.
+  //! @param shardCount Count of the shards.
+  //!                   Zero uses the count of the hardware threads.
+  void Start(std::size_t shardCount);
+  //! Stops the shard threads and waits for them to finish.
+  //! Tasks that were not executed yet are discarded.
+  void Stop();
+
+  //! Queues a task of a partition.
+  //! A partition not yet known is pinned to the least loaded shard.
+  //! The task is executed within the trace of the calling thread.
+  //! @param key Key of the partition.
+  //! @param task Task to queue.
+  void Queue(Key key, Task task);
+
+  //! Removes a partition.
+  //! Tasks of the partition that were already queued are still executed,
+  //! the partition is forgotten once it runs out of tasks.
+  //! Tasks queued with the same key before that are executed by the same partition.
+  //! @param key Key of the partition.
+  void Remove(Key key);
+
+  //! Balances the load of the shards by migrating a partition
+  //! from the most loaded shard to the least loaded one.
+  //! The load is the count of the tasks executed since the last balance.
+  //! @returns `true` if a partition was migrated, `false` otherwise.
+  bool Balance();
+
+  //! Returns the count of the shards.
+  //! @returns Count of the shards.
+  [[nodiscard]] std::size_t GetShardCount() const;
+
+  //! Returns the shard the partition is pinned to.
+  //! @param key Key of the partition.
+  //! @returns Index of the shard, or shard count if the partition is not known.
+  [[nodiscard]] std::size_t GetShard(Key key);
+
+private:
+  //! Max count of tasks of a partition executed before other partitions get their turn.
+  static constexpr std::size_t MaxTasksPerTurn = 64;
+  //! Min difference of the shard loads to consider the shards imbalanced.
+  static constexpr std::size_t MinLoadImbalance = 128;
+
+  //! A task queued along with the trace it was queued within.
+  struct QueuedTask
+  {
+    //! A task to execute.
+    Task task{};
+    //! A trace ID of the thread which queued the task.
+    trace::TraceId traceId{trace::InvalidTraceId};
+  };
+
+  //! A partition.
+  struct Partition
+  {
+    //! A key of the partition.
+    Key key{};
+
+    //! A mutex for the task queue.
+    std::mutex tasksMutex;
+    //! A queue of the tasks to execute.
+    std::queue<QueuedTask> tasks;
+    //! Whether the partition is in the run queue of its shard.
+    bool isScheduled{false};
+    //! Whether the partition is to be forgotten once it runs out of tasks.
+    bool isRemoved{false};
+
+    //! Index of the shard the partition is pinned to.
+    std::atomic_size_t shard{0};
+    //! Count of the tasks executed since the last balance.
+    std::atomic_size_t load{0};
+  };
+
+  //! A shard.
+  struct Shard
+  {
+    //! A mutex for the run queue.
+    std::mutex runQueueMutex;
+    //! A condition variable notified when a partition is scheduled.
+    std::condition_variable runQueueCv;
+    //! A queue of partitions scheduled for execution.
+    std::queue<std::shared_ptr<Partition>> runQueue;
+    //! A thread of the shard.
+    std::thread thread;
+  };
+
+  //! Schedules a partition for execution on its shard.
+  //! @param partition Partition.
+  void Schedule(const std::shared_ptr<Partition>& partition);
+
+  //! Forgets a removed partition which ran out of tasks.
+  //! @param partition Partition.
+  void Forget(const std::shared_ptr<Partition>& partition);
+
+  //! Executes the partitions scheduled on a shard.
+  //! @param shard Shard.
+  void RunShard(Shard& shard);
+
+  //! Whether the shards are running.
+  std::atomic_bool _isRunning{false};
+  //! Shards.
+  std::vector<std::unique_ptr<Shard>> _shards;
+
+  //! A mutex for the partitions.
+  std::mutex _partitionsMutex;
+  //! Partitions mapped by their key.
+  std::unordered_map<Key, std::shared_ptr<Partition>> _partitions;
+};
+
+} // namespace server
+
+#endif // SHARDPOOL_HPP
@@ -20,6 +20,10 @@
 #ifndef STREAM_HPP
 #define STREAM_HPP
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
 #include <format>
 #include <span>
 #include <stdexcept>
@@ -28,6 +32,9 @@
 namespace server
 {
 
+//! A base of the streams.
+//! The streams are final and their members are not virtual,
+//! so that the calls of the hot serialization paths can be inlined.
 template <typename StorageType>
 class StreamBase
 {
@@ -43,12 +50,9 @@ public:
   explicit StreamBase(std::nullptr_t) noexcept
     : _storage() {}
 
-  //! Virtual destructor.
-  virtual ~StreamBase() = default;
-
   //! Seeks to the cursor specified.
   //! @param cursor Cursor position.
-  virtual void Seek(std::size_t cursor)
+  void Seek(std::size_t cursor)
   {
     if (cursor > _storage.size())
     {
@@ -61,13 +65,36 @@ public:
 
   //! Gets the size of the underlying storage.
   //! @returns Size fo the underlying storage.
-  [[nodiscard]] virtual std::size_t Size() const { return _storage.size(); }
+  [[nodiscard]] std::size_t Size() const { return _storage.size(); }
 
   //! Gets the cursor of the storage.
   //! @returns Cursor position.
-  [[nodiscard]] virtual std::size_t GetCursor() const { return _cursor; }
+  [[nodiscard]] std::size_t GetCursor() const { return _cursor; }
 
 protected:
+  //! Destructor.
+  ~StreamBase() = default;
+
+  //! Reserves a region of the storage at the cursor and advances the cursor past it.
+  //! @param size Size of the region.
+  //! @returns Offset of the region in the storage.
+  //! @throws std::overflow_error If the storage does not have enough space.
+  std::size_t ReserveRegion(std::size_t size)
+  {
+    if (size > _storage.size() - _cursor)
+    {
+      throw std::overflow_error(std::format(
+        "Couldn't reserve {} bytes of the buffer (cursor: {}, available: {}). Not enough space.",
+        size,
+        _cursor,
+        _storage.size()));
+    }
+
+    const std::size_t offset = _cursor;
+    _cursor += size;
+    return offset;
+  }
+
   Storage _storage;
   std::size_t _cursor{};
 };
@@ -96,6 +123,42 @@ concept ReadableStruct = requires(T value, SourceStream& stream) {
   { T::Read(value, stream) };
 };
 
+namespace detail
+{
+
+//! Copies numerics to the stream data in the little endian byte order of the protocol.
+//! @param data Stream data.
+//! @param values Values to copy.
+template <Numeric T>
+void CopyToStream(std::byte* data, std::span<const T> values)
+{
+  std::memcpy(data, values.data(), values.size_bytes());
+
+  if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+  {
+    for (std::size_t offset = 0; offset < values.size_bytes(); offset += sizeof(T))
+      std::reverse(data + offset, data + offset + sizeof(T));
+  }
+}
+
+//! Copies numerics from the stream data in the little endian byte order of the protocol.
+//! @param values Values to copy to.
+//! @param data Stream data.
+template <Numeric T>
+void CopyFromStream(std::span<T> values, const std::byte* data)
+{
+  std::memcpy(values.data(), data, values.size_bytes());
+
+  if constexpr (std::endian::native == std::endian::big && sizeof(T) > 1)
+  {
+    auto* bytes = reinterpret_cast<std::byte*>(values.data());
+    for (std::size_t offset = 0; offset < values.size_bytes(); offset += sizeof(T))
+      std::reverse(bytes + offset, bytes + offset + sizeof(T));
+  }
+}
+
+} // namespace detail
+
 //! Buffered stream sink.
 class SinkStream final
   : public StreamBase<std::span<std::byte>>
@@ -125,6 +188,17 @@ public:
   //! @param size Size of data.
   void Write(const void* data, std::size_t size);
 
+  //! Reserves bytes of the buffer storage for writing and advances the cursor past them.
+  //! The reserved bytes are written without any further bounds checks.
+  //! Fails if the operation can't be completed wholly.
+  //!
+  //! @param size Count of bytes to reserve.
+  //! @returns Pointer to the reserved bytes.
+  [[nodiscard]] std::byte* Reserve(std::size_t size)
+  {
+    return _storage.data() + ReserveRegion(size);
+  }
+
   //! Write a value to the sink stream.
   //!
   //! @param value Value to write.
@@ -133,11 +207,33 @@ public:
   template <Numeric T>
   SinkStream& Write(const T& value)
   {
-    const auto requiredByteCount = sizeof(value);
-    Write(reinterpret_cast<const void*>(&value), requiredByteCount);
+    detail::CopyToStream(Reserve(sizeof(T)), std::span(&value, 1));
+    return *this;
+  }
+
+  //! Write values to the sink stream in bulk.
+  //!
+  //! @param values Values to write.
+  //! @tparam T Type of values.
+  //! @return Reference to this.
+  template <Numeric T>
+  SinkStream& Write(std::span<const T> values)
+  {
+    detail::CopyToStream(Reserve(values.size_bytes()), values);
     return *this;
   }
 
+  //! Write an array of values to the sink stream in bulk.
+  //!
+  //! @param values Values to write.
+  //! @tparam T Type of values.
+  //! @return Reference to this.
+  template <Numeric T, std::size_t N>
+  SinkStream& Write(const std::array<T, N>& values)
+  {
+    return Write(std::span<const T>(values));
+  }
+
   //! Write a string to the stream.
   //! Fails if the operation can'
   SinkStream& Write(const std::string& value);
@@ -179,6 +275,17 @@ public:
   //! @param size Size of data.
   void Read(void* data, std::size_t size);
 
+  //! Reserves bytes of the buffer storage for reading and advances the cursor past them.
+  //! The reserved bytes are read without any further bounds checks.
+  //! Fails if the operation can't be completed wholly.
+  //!
+  //! @param size Count of bytes to reserve.
+  //! @returns Pointer to the reserved bytes.
+  [[nodiscard]] const std::byte* Reserve(std::size_t size)
+  {
+    return _storage.data() + ReserveRegion(size);
+  }
+
   //! Read a value from the source stream.
   //!
   //! @param value Value to read.
@@ -187,11 +294,33 @@ public:
   template <Numeric T>
   SourceStream& Read(T& value)
   {
-    const auto byteCount = sizeof(value);
-    Read(reinterpret_cast<void*>(&value), byteCount);
+    detail::CopyFromStream(std::span(&value, 1), Reserve(sizeof(T)));
     return *this;
   }
 
+  //! Read values from the source stream in bulk.
+  //!
+  //! @param values Values to read.
+  //! @tparam T Type of values.
+  //! @return Reference to this.
+  template <Numeric T>
+  SourceStream& Read(std::span<T> values)
+  {
+    detail::CopyFromStream(values, Reserve(values.size_bytes()));
+    return *this;
+  }
+
+  //! Read an array of values from the source stream in bulk.
+  //!
+  //! @param values Values to read.
+  //! @tparam T Type of values.
+  //! @return Reference to this.
+  template <Numeric T, std::size_t N>
+  SourceStream& Read(std::array<T, N>& values)
+  {
+    return Read(std::span<T>(values));
+  }
+
   SourceStream& Read(std::string& value);
 
   template <ReadableStruct T>
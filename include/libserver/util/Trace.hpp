@@ -0,0 +1,146 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string_view>
+
+namespace server::trace
+{
+
+//! An ID of a trace, shared by all the spans of one request.
+using TraceId = uint64_t;
+//! An invalid trace ID, the work outside of a trace is not recorded.
+constexpr TraceId InvalidTraceId = 0;
+
+//! Count of the spans kept per thread, the oldest spans are overwritten.
+constexpr std::size_t SpanBufferCapacity = 8192;
+
+//! An alias for the standard steady-clock.
+using Clock = std::chrono::steady_clock;
+
+//! Generates a new trace ID.
+//! @returns Trace ID.
+[[nodiscard]] TraceId GenerateTraceId();
+
+//! Returns the trace ID of the calling thread.
+//! @returns Trace ID, or invalid trace ID if the thread is not within a trace.
+[[nodiscard]] TraceId GetCurrentTraceId();
+
+//! Sets the name of the calling thread as shown in the exported traces.
+//! @param name Name of the thread.
+void SetThreadName(std::string_view name);
+
+//! Records a span to the buffer of the calling thread.
+//! @param name Name of the span, must have a static storage duration.
+//! @param traceId Trace ID of the span.
+//! @param beginning Time point of when the span began.
+//! @param end Time point of when the span ended.
+void RecordSpan(
+  std::string_view name,
+  TraceId traceId,
+  Clock::time_point beginning,
+  Clock::time_point end);
+
+//! Sets the trace ID of the calling thread for the lifetime of the scope.
+//! Used to carry a trace over to the work queued to another thread.
+class Scope final
+{
+public:
+  //! Constructor.
+  //! @param traceId Trace ID.
+  explicit Scope(TraceId traceId)
+    : _previousTraceId(Exchange(traceId))
+  {
+  }
+
+  //! Destructor, restores the previous trace ID of the thread.
+  ~Scope()
+  {
+    Exchange(_previousTraceId);
+  }
+
+  //! Deleted copy constructor.
+  Scope(const Scope&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const Scope&) = delete;
+
+private:
+  //! Exchanges the trace ID of the calling thread.
+  //! @param traceId Trace ID.
+  //! @returns Previous trace ID.
+  static TraceId Exchange(TraceId traceId);
+
+  TraceId _previousTraceId;
+};
+
+//! A span of work within the current trace of the thread, recorded when the span ends.
+//! Spans outside of a trace are not recorded.
+class Span final
+{
+public:
+  //! Constructor.
+  //! @param name Name of the span, must have a static storage duration.
+  explicit Span(std::string_view name)
+    : _name(name)
+    , _traceId(GetCurrentTraceId())
+  {
+    if (_traceId != InvalidTraceId)
+      _beginning = Clock::now();
+  }
+
+  //! Destructor.
+  ~Span()
+  {
+    if (_traceId != InvalidTraceId)
+      RecordSpan(_name, _traceId, _beginning, Clock::now());
+  }
+
+  //! Deleted copy constructor.
+  Span(const Span&) = delete;
+  //! Deleted copy assignment operator.
+  void operator=(const Span&) = delete;
+
+private:
+  std::string_view _name;
+  TraceId _traceId;
+  Clock::time_point _beginning{};
+};
+
+//! Writes the spans recorded by all the threads in the Chrome trace-event format.
+//! Spans of one trace are linked with flow events across the threads.
+//! @param stream Stream to write to.
+//! @returns Count of the written spans.
+std::size_t WriteChromeTrace(std::ostream& stream);
+
+//! Dumps the spans recorded by all the threads to a Chrome trace-event file,
+//! which can be opened in `chrome://tracing` or Perfetto.
+//! @param path Path of the file.
+//! @returns Count of the dumped spans.
+//! @throws std::runtime_error if the file can't be written.
+std::size_t DumpChromeTrace(const std::filesystem::path& path);
+
+} // namespace server::trace
+
+#endif // TRACE_HPP
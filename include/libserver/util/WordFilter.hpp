@@ -0,0 +1,142 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef WORDFILTER_HPP
+#define WORDFILTER_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace server
+{
+
+//! A filter of words compiled into an Aho-Corasick automaton.
+//! A text is scanned in a single pass regardless of the count of the words.
+//! The words and the text are expected in UTF-8 and are normalized before matching:
+//! letters are case-folded and full-width forms are mapped to their ASCII counterparts.
+class WordFilter final
+{
+public:
+  //! A match of a word in a text.
+  struct Match
+  {
+    //! Offset of the match in the text, in bytes.
+    std::size_t offset{};
+    //! Length of the match in the text, in bytes.
+    std::size_t length{};
+  };
+
+  //! Default constructor of a filter without words.
+  WordFilter() = default;
+  //! Constructor compiling the words into the automaton.
+  //! @param words Words to filter, empty words are ignored.
+  explicit WordFilter(std::span<const std::string> words);
+
+  //! Scans a text for the words.
+  //! Only the longest word ending at a character is matched, matches may overlap.
+  //! @param text Text to scan.
+  //! @returns Matches of the words in the order of their end.
+  [[nodiscard]] std::vector<Match> Scan(std::string_view text) const;
+  //! Returns whether a text contains any of the words.
+  //! @param text Text to scan.
+  //! @returns `true` if the text contains a word, `false` otherwise.
+  [[nodiscard]] bool Contains(std::string_view text) const;
+  //! Masks the words in a text.
+  //! @param text Text to mask.
+  //! @param mask Character replacing every character of a matched word.
+  //! @returns Masked text.
+  [[nodiscard]] std::string Mask(std::string_view text, char mask = '*') const;
+
+  //! Returns the count of the compiled words.
+  //! @returns Count of the words.
+  [[nodiscard]] std::size_t GetWordCount() const;
+
+private:
+  //! An index of a node.
+  using NodeIndex = uint32_t;
+
+  //! A transition to a child node.
+  using Transition = std::pair<char32_t, NodeIndex>;
+
+  //! A node of the automaton.
+  struct Node
+  {
+    //! Offset of the transitions of the node, sorted by the character.
+    uint32_t transitionOffset{0};
+    //! Count of the transitions of the node.
+    uint32_t transitionCount{0};
+    //! A node of the longest proper suffix which is present in the automaton.
+    NodeIndex failure{0};
+    //! Length of the longest word which is a suffix of the node, in characters.
+    uint32_t matchLength{0};
+  };
+
+  //! A character of a text.
+  struct Character
+  {
+    //! Normalized code point of the character.
+    char32_t codePoint{};
+    //! Offset of the character in the text, in bytes.
+    std::size_t offset{};
+    //! Length of the character in the text, in bytes.
+    std::size_t length{};
+  };
+
+  //! Decodes and normalizes the characters of a text.
+  //! Invalid UTF-8 sequences are decoded byte by byte.
+  //! @param text Text.
+  //! @returns Characters of the text.
+  [[nodiscard]] static std::vector<Character> DecodeText(std::string_view text);
+
+  //! Scans decoded characters of a text for the words.
+  //! @param characters Characters of the text.
+  //! @returns Matches of the words in the order of their end.
+  [[nodiscard]] std::vector<Match> ScanCharacters(std::span<const Character> characters) const;
+
+  //! Finds a transition of a node.
+  //! @param nodeIndex Index of the node.
+  //! @param codePoint Code point.
+  //! @returns Index of the child node, or zero (root) if there is no transition.
+  [[nodiscard]] NodeIndex FindTransition(NodeIndex nodeIndex, char32_t codePoint) const;
+  //! Follows the automaton from a node by a code point.
+  //! @param nodeIndex Index of the current node.
+  //! @param codePoint Code point.
+  //! @returns Index of the next node.
+  [[nodiscard]] NodeIndex Advance(NodeIndex nodeIndex, char32_t codePoint) const;
+
+  //! Max code point looked up in the root transition table.
+  static constexpr char32_t RootTableSize = 128;
+
+  //! Nodes of the automaton, the first node is the root.
+  std::vector<Node> _nodes{1};
+  //! Transitions of all the nodes stored contiguously.
+  std::vector<Transition> _transitions;
+  //! Transitions of the root node indexed by the code point, the scan starts there most often.
+  std::vector<NodeIndex> _rootTable = std::vector<NodeIndex>(RootTableSize, 0);
+  //! Count of the compiled words.
+  std::size_t _wordCount{0};
+};
+
+} // namespace server
+
+#endif // WORDFILTER_HPP
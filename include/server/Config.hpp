@@ -36,6 +36,9 @@ public:
       .port = 10030};
 
     std::string motd;
+    //! Path of the trace file the received commands are captured to.
+    //! Empty disables the capture.
+    std::string capturePath{};
 
     struct Advertisement
     {
@@ -57,6 +60,15 @@ public:
     bool enabled{true};
     Listen listen{
       .port = 10031};
+    //! Radius around a character in which the other clients receive all of its snapshots.
+    //! Zero disables the filtering. The position of a character is read from
+    //! a snapshot field of unverified layout, so the filtering is disabled by default.
+    float interestRadius{0.0f};
+    //! The clients outside of the interest radius receive every n-th snapshot of a character.
+    uint32_t farSnapshotInterval{8};
+    //! Path of the trace file the received commands are captured to.
+    //! Empty disables the capture.
+    std::string capturePath{};
   } ranch{};
 
   //!
@@ -65,6 +77,31 @@ public:
     bool enabled{true};
     Listen listen{
       .port = 10032};
+    //! Rate at which the racer states are published to the rooms, in hertz.
+    //! Zero disables the publishing.
+    uint32_t snapshotRate{20};
+    //! Count of the worker threads simulating the rooms.
+    //! Zero uses the count of the hardware threads.
+    uint32_t shardCount{0};
+    //! Path of the trace file the received commands are captured to.
+    //! Empty disables the capture.
+    std::string capturePath{};
+
+    //! P2P relay of the race.
+    struct Relay
+    {
+      bool enabled{true};
+      Listen listen{
+        .address = asio::ip::address_v4::loopback(),
+        .port = 10500};
+      //! Address and port of the relay advertised to the racers.
+      Listen advertisement{
+        .address = asio::ip::address_v4::loopback(),
+        .port = 10500};
+      //! Duration of inactivity after which a relay peer is forgotten, in seconds.
+      //! Relay peers are never forgotten if zero.
+      uint32_t idleTimeout{30};
+    } relay{};
   } race{};
 
   //!
@@ -75,6 +112,23 @@ public:
       .port = 10033};
   } messenger{};
 
+  //! Profiling of the command handling.
+  struct Profiling
+  {
+    //! Duration of a command handler or supplier invocation in milliseconds
+    //! over which the invocation is logged as slow. Zero disables the logging.
+    uint32_t slowCommandThreshold{50};
+  } profiling{};
+
+  //! Exposition of the metrics.
+  struct Metrics
+  {
+    bool enabled{false};
+    Listen listen{
+      .address = asio::ip::address_v4::loopback(),
+      .port = 10090};
+  } metrics{};
+
   //!
   struct Data
   {
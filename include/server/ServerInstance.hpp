@@ -10,16 +10,23 @@
 #include "server/messenger/MessengerDirector.hpp"
 #include "server/race/RaceDirector.hpp"
 #include "server/ranch/RanchDirector.hpp"
+#include "server/system/BreedingMarketSystem.hpp"
 #include "server/system/ChatSystem.hpp"
 #include "server/system/InfractionSystem.hpp"
 #include "server/system/OtpSystem.hpp"
+#include "server/system/PresenceSystem.hpp"
+#include "server/system/RankingSystem.hpp"
 #include "server/system/RoomSystem.hpp"
+#include "server/system/ShopSystem.hpp"
 
 #include <libserver/data/DataDirector.hpp>
+#include <libserver/network/http/MetricsServer.hpp>
 #include <libserver/registry/CourseRegistry.hpp>
+#include <libserver/registry/GoodsRegistry.hpp>
 #include <libserver/registry/HorseRegistry.hpp>
 #include <libserver/registry/ItemRegistry.hpp>
 #include <libserver/registry/PetRegistry.hpp>
+#include <libserver/util/Trace.hpp>
 
 #include <spdlog/spdlog.h>
 
@@ -39,6 +46,20 @@ public:
   //! Terminates the server instance.
   void Terminate();
 
+  //! Reloads the goods and recompiles the shop catalogue.
+  void ReloadShopCatalogue();
+  //! Reloads the banned words of the chat moderation.
+  void ReloadChatModeration();
+
+  //! Captures the codes granted and the rooms created along with the commands
+  //! received by a command server, so that its capture can be replayed without the lobby.
+  //! @param commandServer Command server capturing the received commands.
+  void CaptureStates(CommandServer& commandServer);
+  //! Restores a state captured along with the commands.
+  //! @param stateId ID of the state.
+  //! @param data Data of the state.
+  void RestoreState(uint16_t stateId, std::span<const std::byte> data);
+
   //! Returns reference to the data director.
   //! @returns Reference to the data director.
   DataDirector& GetDataDirector();
@@ -59,6 +80,10 @@ public:
   //! @returns Reference to the Course registry.
   registry::CourseRegistry& GetCourseRegistry();
 
+  //! Returns reference to the Goods registry.
+  //! @returns Reference to the Goods registry.
+  registry::GoodsRegistry& GetGoodsRegistry();
+
   //! Returns reference to the Horse registry.
   //! @returns Reference to the Horse registry.
   registry::HorseRegistry& GetHorseRegistry();
@@ -71,6 +96,10 @@ public:
   //! @returns Reference to the Pet registry.
   registry::PetRegistry& GetPetRegistry();
 
+  //! Returns reference to the breeding market system.
+  //! @returns Reference to the breeding market system.
+  BreedingMarketSystem& GetBreedingMarketSystem();
+
   //! Returns reference to the chat system.
   //! @returns Reference to the chat system.
   ChatSystem& GetChatSystem();
@@ -83,10 +112,22 @@ public:
   //! @returns Reference to the OTP system.
   OtpSystem& GetOtpSystem();
 
+  //! Returns reference to the presence system.
+  //! @returns Reference to the presence system.
+  PresenceSystem& GetPresenceSystem();
+
+  //! Returns reference to the ranking system.
+  //! @returns Reference to the ranking system.
+  RankingSystem& GetRankingSystem();
+
   //! Returns reference to the room system.
   //! @returns Reference to the room system.
   RoomSystem& GetRoomSystem();
 
+  //! Returns reference to the shop system.
+  //! @returns Reference to the shop system.
+  ShopSystem& GetShopSystem();
+
   //! Returns reference to the settings.
   //! @returns Reference to the settings.
   Config& GetSettings();
@@ -94,10 +135,17 @@ public:
 private:
 
   template<typename T>
-  void RunDirectorTaskLoop(T& director)
+  void RunDirectorTaskLoop(T& director, std::string_view directorName)
   {
     using Clock = std::chrono::steady_clock;
 
+    auto& tickHistogram = metrics::GetRegistry().GetHistogram(
+      "alicia_director_tick_seconds",
+      "Duration of the ticks of the directors.",
+      {{"director", directorName}});
+
+    trace::SetThreadName(directorName);
+
     constexpr float TicksPerSecond = 50;
     constexpr uint64_t millisPerTick = 1000ull / TicksPerSecond;
 
@@ -122,6 +170,7 @@ private:
       try
       {
         director.Tick();
+        tickHistogram.Observe(Clock::now() - timeNow);
       }
       catch (const std::exception& x)
       {
@@ -166,6 +215,8 @@ private:
 
   //! A registry of courses.
   registry::CourseRegistry _courseRegistry;
+  //! A registry of goods.
+  registry::GoodsRegistry _goodsRegistry;
   //! A registry of horses.
   registry::HorseRegistry _horseRegistry;
   //! A registry of items.
@@ -173,14 +224,25 @@ private:
   //! A registry of pets.
   registry::PetRegistry _petRegistry;
 
+  //! A breeding market system.
+  BreedingMarketSystem _breedingMarketSystem;
   //! A chat system.
   ChatSystem _chatSystem;
   //! An infraction system.
   InfractionSystem _infractionSystem;
   //! An OTP system.
   OtpSystem _otpSystem;
+  //! A presence system.
+  PresenceSystem _presenceSystem;
+  //! A ranking system.
+  RankingSystem _rankingSystem;
   //! A room system.
   RoomSystem _roomSystem;
+  //! A shop system.
+  ShopSystem _shopSystem;
+
+  //! A metrics server.
+  network::MetricsServer _metricsServer;
 };
 
 } // namespace server
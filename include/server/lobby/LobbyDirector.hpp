@@ -27,7 +27,9 @@
 #include "libserver/data/DataDefinitions.hpp"
 #include "libserver/network/command/CommandServer.hpp"
 #include "libserver/network/command/proto/LobbyMessageDefinitions.hpp"
+#include "libserver/util/RandomSet.hpp"
 
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -70,15 +72,19 @@ public:
   //! @return Lobby config.
   Config::Lobby& GetConfig();
 
+  //! Returns the command server of the director.
+  //! @returns Reference to the command server.
+  CommandServer& GetCommandServer();
+
   void RequestCharacterCreator(data::Uid characterUid);
 
   void Disconnect(data::Uid characterUid);
   void Mute(data::Uid characterUid, data::Clock::time_point expiration);
   void Notice(data::Uid characterUid, const std::string& message);
-
-  // todo: refactor
-  std::vector<std::string> GetOnlineUsers();
-  std::vector<data::Uid> GetOnlineCharacters();
+  //! Sends a notice to multiple clients, the notice is written only once.
+  //! @param clientIds IDs of the clients.
+  //! @param message Message of the notice.
+  void BroadcastNotice(std::span<const ClientId> clientIds, const std::string& message);
 
   // prototype function
   [[deprecated]] void UpdateVisitPreference(
@@ -192,6 +198,23 @@ private:
   void HandleRequestMountInfo(
     ClientId clientId,
     const protocol::AcCmdCLRequestMountInfo& command);
+
+  //! Indexes the ranch of a character for the random ranch selection.
+  //! @param characterUid UID of the character owning the ranch.
+  //! @param isLocked Whether the ranch is locked.
+  //! @param isOnline Whether the character is online.
+  void IndexRanch(data::Uid characterUid, bool isLocked, bool isOnline);
+  //! Keeps the unlocked ranch of a character going offline visitable.
+  //! @param characterUid UID of the character owning the ranch.
+  void UnindexOnlineRanch(data::Uid characterUid);
+  //! Picks a random ranch to visit, ranches of online characters are preferred.
+  //! @param characterUid UID of the visiting character.
+  //! @returns UID of the character owning the ranch, or empty if there is no ranch to visit.
+  [[nodiscard]] std::optional<data::Uid> PickRandomRanch(data::Uid characterUid);
+  //! Inserts an offline ranch, a random offline ranch is evicted when there are too many.
+  //! Expects the ranches mutex to be locked.
+  //! @param characterUid UID of the character owning the ranch.
+  void InsertOfflineRanch(data::Uid characterUid);
     
   //!
   ServerInstance& _serverInstance;
@@ -228,6 +251,14 @@ protected:
   std::unordered_map<ClientId, ClientContext> _clients;
   //!
   std::unordered_set<data::Uid> _forcedCharacterCreator;
+
+  //! A mutex guarding the online and offline ranches.
+  std::mutex _ranchesMutex;
+  //! Unlocked ranches of the characters online in the lobby.
+  RandomSet<data::Uid> _onlineRanches;
+  //! Unlocked ranches of the characters that were online since the start,
+  //! capped at the max offline ranch count.
+  RandomSet<data::Uid> _offlineRanches;
 };
 
 } // namespace server
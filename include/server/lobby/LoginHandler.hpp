@@ -22,6 +22,7 @@
 
 #include "libserver/network/command/CommandServer.hpp"
 #include "libserver/network/command/proto/LobbyMessageDefinitions.hpp"
+#include "libserver/util/Trace.hpp"
 
 #include <chrono>
 #include <unordered_map>
@@ -66,6 +67,8 @@ private:
     ClientId clientId;
     std::string userName;
     std::string userToken;
+    //! Trace ID of the login request.
+    trace::TraceId traceId{trace::InvalidTraceId};
 
     //! Whether the load of the user was requested.
     bool userLoadRequested{false};
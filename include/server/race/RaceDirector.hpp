@@ -26,8 +26,12 @@
 
 #include "libserver/network/command/CommandServer.hpp"
 #include "libserver/network/command/proto/RaceMessageDefinitions.hpp"
+#include "libserver/network/relay/RelayServer.hpp"
 #include "libserver/util/Scheduler.hpp"
+#include "libserver/util/ShardPool.hpp"
 
+#include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -45,6 +49,41 @@ class RaceDirector final
   : public CommandServer::EventHandlerInterface
 {
 public:
+  //! Display data of a room participant.
+  struct Participant
+  {
+    std::string name;
+    uint32_t level{};
+    std::string mountName;
+  };
+
+  struct RoomInstance
+  {
+    std::unordered_set<ClientId> clients;
+
+    //! Display data of the participants mapped by their character UID.
+    //! Race events read these instead of the character and horse records.
+    std::unordered_map<data::Uid, Participant> participants;
+
+    tracker::RaceTracker tracker;
+
+    //! A leader character's UID.
+    data::Uid masterUid{data::InvalidUid};
+    
+    //! Countdown start time for race timing
+    std::optional<std::chrono::steady_clock::time_point> countdownStartTime;
+    
+    //! Actual race start timestamp (when countdown reaches 0)
+    std::optional<uint64_t> raceStartTimestamp;
+
+    //! ID of the map block of the current race.
+    uint16_t raceMapBlockId{};
+    //! Game mode of the current race.
+    uint8_t raceGameMode{};
+    //! Whether the results of the current race were recorded on the leaderboards.
+    bool resultsRecorded{false};
+  };
+
   //!
   explicit RaceDirector(ServerInstance& serverInstance);
 
@@ -55,33 +94,98 @@ public:
   void HandleClientConnected(ClientId clientId) override;
   void HandleClientDisconnected(ClientId clientId) override;
 
+  //! Sends a system chat message to multiple clients, the message is written only once.
+  //! @param clientIds IDs of the clients.
+  //! @param message Message.
+  void BroadcastNotice(std::span<const ClientId> clientIds, const std::string& message);
+
   ServerInstance& GetServerInstance();
   Config::Race& GetConfig();
 
+  //! Returns the command server of the director.
+  //! @returns Reference to the command server.
+  CommandServer& GetCommandServer();
+
+  //! Records the results of the finished race of a room on the leaderboards.
+  //! The results of a race are recorded only once, however many racers report them.
+  //! @param roomInstance Room instance.
+  //! @returns `true` if the results were recorded, `false` if they already were.
+  bool RecordRaceResults(RoomInstance& roomInstance);
+
 private:
   struct ClientContext
   {
     data::Uid characterUid{data::InvalidUid};
+    //! UID of the room the commands of the client are routed to.
+    //! Set on the network thread when the client enters the room,
+    //! reset on the shard of the room when the client leaves it.
     data::Uid roomUid{data::InvalidUid};
     bool authorized = false;
   };
   ;
 
-  struct RoomInstance
-  {
-    std::unordered_set<ClientId> clients;
-
-    tracker::RaceTracker tracker;
-
-    //! A leader character's UID.
-    data::Uid masterUid{data::InvalidUid};
-    
-    //! Countdown start time for race timing
-    std::optional<std::chrono::steady_clock::time_point> countdownStartTime;
-    
-    //! Actual race start timestamp (when countdown reaches 0)
-    std::optional<uint64_t> raceStartTimestamp;
-  };
+  //! Returns the context of a client.
+  //! @param clientId ID of the client.
+  //! @returns Copy of the context of the client.
+  ClientContext GetClientContext(ClientId clientId);
+
+  //! Returns the instance of a room.
+  //! @param roomUid UID of the room.
+  //! @returns Instance of the room.
+  std::shared_ptr<RoomInstance> GetRoomInstance(uint32_t roomUid);
+
+  //! Takes a snapshot of the display data of a room participant.
+  //! @param roomInstance Room instance.
+  //! @param characterUid UID of the character of the participant.
+  //! @returns Snapshot of the participant.
+  Participant& RefreshParticipant(
+    RoomInstance& roomInstance,
+    data::Uid characterUid);
+
+  //! Returns the snapshot of the display data of a room participant.
+  //! @param roomInstance Room instance.
+  //! @param characterUid UID of the character of the participant.
+  //! @returns Snapshot of the participant,
+  //!          or an empty snapshot if the character is not a participant of the room.
+  static const Participant& GetParticipant(
+    const RoomInstance& roomInstance,
+    data::Uid characterUid);
+
+  //! Routes the commands of a client to the shard of a room.
+  //! @param clientId ID of the client.
+  //! @param characterUid UID of the character of the client.
+  //! @param roomUid UID of the room.
+  //! @returns `true` if the client was routed to the room,
+  //!          `false` if the client is already in a room.
+  bool RouteToRoom(ClientId clientId, data::Uid characterUid, data::Uid roomUid);
+
+  //! Routes the commands of a client back to the network thread.
+  //! @param clientId ID of the client.
+  void ResetRoute(ClientId clientId);
+
+  //! Routes a command handler of a client to the shard of the room the client is in.
+  //! @param clientId ID of the client.
+  //! @param commandId ID of the command.
+  //! @param handler Handler of the command.
+  void RouteCommand(
+    ClientId clientId,
+    protocol::Command commandId,
+    std::function<void()> handler);
+
+  //! Queues a task to be executed on the shard of a room.
+  //! @param roomUid UID of the room.
+  //! @param task Task to queue.
+  //! @param when A time point of when to execute the task. Defaults to immediate execution.
+  void QueueRoomTask(
+    uint32_t roomUid,
+    Scheduler::Task task,
+    Scheduler::Clock::time_point when = Scheduler::Clock::now());
+
+  //! Publishes a snapshot of the kinematic states of the racers,
+  //! which changed since the last publish, to the racers in the room.
+  //! Every racer receives the snapshot without its own state in a single write.
+  //! @param roomUid UID of the room.
+  void PublishRacerSnapshot(uint32_t roomUid);
 
   void HandleEnterRoom(
     ClientId clientId,
@@ -212,20 +316,31 @@ private:
   //   ClientId clientId,
   //   const protocol::AcCmdCRActivateSkillEffect& command);
 
-  //!
-  std::thread test;
-  std::atomic_bool run_test{true};
-
   //! A scheduler instance.
   Scheduler _scheduler;
   //! A server instance.
   ServerInstance& _serverInstance;
   //! A command server instance.
   CommandServer _commandServer;
+  //! A P2P relay server instance.
+  network::RelayServer _relayServer;
+  //! A mutex for the map of client contexts.
+  std::shared_mutex _clientsMutex;
   //! A map of all client contexts.
   std::unordered_map<ClientId, ClientContext> _clients;
+  //! A mutex for the map of room instances.
+  std::shared_mutex _roomInstancesMutex;
   //! A map of all room instances.
-  std::unordered_map<uint32_t, RoomInstance> _roomInstances;
+  std::unordered_map<uint32_t, std::shared_ptr<RoomInstance>> _roomInstances;
+  //! A pool of the shards the room instances are simulated on.
+  //! Every room instance is accessed only from the shard it is pinned to.
+  ShardPool _roomShards;
+  //! Time point of the next balance of the room shards.
+  Scheduler::Clock::time_point _nextShardBalanceTime{};
+  //! Time point of the next tick of the ranking system.
+  Scheduler::Clock::time_point _nextRankingTickTime{};
+  //! Time point of the next racer snapshot publish.
+  Scheduler::Clock::time_point _nextSnapshotTime{};
 };
 
 } // namespace server
@@ -46,8 +46,6 @@ public:
   void Terminate();
   void Tick();
 
-  std::vector<data::Uid> GetOnlineCharacters();
-
   void HandleClientConnected(ClientId clientId) override;
   void HandleClientDisconnected(ClientId client) override;
 
@@ -81,9 +79,18 @@ public:
     const data::Uid rancherUid,
     protocol::AcCmdCRHideAge::Option option);
 
+  //! Sends a system chat message to multiple clients, the message is written only once.
+  //! @param clientIds IDs of the clients.
+  //! @param message Message.
+  void BroadcastNotice(std::span<const ClientId> clientIds, const std::string& message);
+
   ServerInstance& GetServerInstance();
   Config::Ranch& GetConfig();
 
+  //! Returns the command server of the director.
+  //! @returns Reference to the command server.
+  CommandServer& GetCommandServer();
+
 private:
   std::random_device _randomDevice;
 
@@ -98,6 +105,9 @@ private:
 
     
     uint8_t busyState{0};
+
+    //! Count of the snapshots sent by the client.
+    uint32_t snapshotCount{0};
   };
 
   struct RanchInstance
@@ -106,6 +116,8 @@ private:
     tracker::RanchTracker tracker;
     //! A set of clients connected to the ranch.
     std::unordered_set<ClientId> clients;
+    //! Clients connected to the ranch mapped by the OID of their character.
+    std::unordered_map<tracker::Oid, ClientId> characterClients;
   };
 
   //! Get client context.
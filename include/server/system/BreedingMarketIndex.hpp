@@ -0,0 +1,124 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef BREEDINGMARKETINDEX_HPP
+#define BREEDINGMARKETINDEX_HPP
+
+#include "libserver/data/DataDefinitions.hpp"
+#include "libserver/network/command/proto/RanchMessageDefinitions.hpp"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+
+//! An index of the stallions listed on the breeding market by the search criteria.
+//! The pages of the search results are precomputed and cached until the indexed stallions change.
+//! The index is not synchronized.
+class BreedingMarketIndex
+{
+public:
+  //! A listed stallion as presented to the clients.
+  using Stallion = protocol::RanchCommandSearchStallionOK::Stallion;
+
+  //! Max count of stallions on a page of the search results.
+  static constexpr std::size_t PageSize = 10;
+
+  //! A search query.
+  struct Query
+  {
+    //! A TID of the coat (skin) of the stallion.
+    std::optional<data::Tid> coat{};
+    //! A grade of the stallion.
+    std::optional<uint32_t> grade{};
+    //! Max price of the mating.
+    std::optional<uint32_t> maxPrice{};
+    //! A zero-based index of the page.
+    uint32_t page{};
+  };
+
+  //! A page of the search results.
+  struct Page
+  {
+    //! Count of the pages of the search results.
+    uint32_t pageCount{};
+    //! Stallions on the page.
+    std::vector<Stallion> stallions;
+  };
+
+  //! Indexes a stallion by its UID, replaces the previously indexed stallion with the same UID.
+  //! @param stallion Stallion.
+  //! @param coat TID of the coat of the stallion.
+  void Add(const Stallion& stallion, data::Tid coat);
+  //! Removes a stallion from the index.
+  //! @param horseUid UID of the stallion.
+  //! @returns `true` if the stallion was indexed, `false` otherwise.
+  bool Remove(data::Uid horseUid);
+  //! Returns the count of the indexed stallions.
+  //! @returns Count of the indexed stallions.
+  [[nodiscard]] std::size_t GetSize() const;
+
+  //! Searches the indexed stallions, cheapest first.
+  //! @param query Search query.
+  //! @returns Requested page of the search results.
+  [[nodiscard]] std::shared_ptr<const Page> Search(const Query& query);
+
+private:
+  //! A key of the price index, stallions are ordered by their price.
+  using PriceKey = std::pair<uint32_t, data::Uid>;
+  //! A key of the page cache.
+  using QueryKey = std::tuple<std::optional<data::Tid>, std::optional<uint32_t>, std::optional<uint32_t>>;
+
+  //! An indexed stallion.
+  struct Entry
+  {
+    Stallion stallion{};
+    //! A TID of the coat of the stallion.
+    data::Tid coat{};
+  };
+
+  //! Computes the pages of the search results.
+  //! @param queryKey Key of the query.
+  //! @returns Pages of the search results.
+  [[nodiscard]] std::vector<std::shared_ptr<const Page>> ComputePages(const QueryKey& queryKey) const;
+
+  //! Indexed stallions mapped by their UID.
+  std::unordered_map<data::Uid, Entry> _entries;
+
+  //! An index of all the stallions ordered by their price.
+  std::set<PriceKey> _priceIndex;
+  //! An index of the stallions by their coat.
+  std::unordered_map<data::Tid, std::set<PriceKey>> _coatIndex;
+  //! An index of the stallions by their grade.
+  std::unordered_map<uint32_t, std::set<PriceKey>> _gradeIndex;
+
+  //! Pages of the search results mapped by their query.
+  std::map<QueryKey, std::vector<std::shared_ptr<const Page>>> _pageCache;
+};
+
+} // namespace server
+
+#endif // BREEDINGMARKETINDEX_HPP
@@ -0,0 +1,127 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef BREEDINGMARKETSYSTEM_HPP
+#define BREEDINGMARKETSYSTEM_HPP
+
+#include "server/system/BreedingMarketIndex.hpp"
+
+#include "libserver/data/DataDefinitions.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace server
+{
+
+class ServerInstance;
+
+//! A breeding market system with the stallions listed for mating.
+//! The listings are persisted through the data director and indexed by the search criteria,
+//! the pages of the search results are precomputed and cached until the listings change.
+class BreedingMarketSystem
+{
+public:
+  //! A listed stallion as presented to the clients.
+  using Stallion = BreedingMarketIndex::Stallion;
+  //! A search query.
+  using Query = BreedingMarketIndex::Query;
+  //! A page of the search results.
+  using Page = BreedingMarketIndex::Page;
+
+  //! Duration for which a stallion is listed.
+  static constexpr auto ListingDuration = std::chrono::hours(24);
+
+  explicit BreedingMarketSystem(ServerInstance& serverInstance);
+
+  //! Lists a stallion on the market.
+  //! The records of the owner and the stallion must be available.
+  //! @param horseUid UID of the stallion.
+  //! @param ownerUid UID of the character owning the stallion.
+  //! @param matePrice Price of the mating.
+  //! @throws std::runtime_error if the stallion is already listed, not available
+  //!                            or not in the stable of the owner.
+  void RegisterStallion(data::Uid horseUid, data::Uid ownerUid, uint32_t matePrice);
+  //! Removes a stallion from the market.
+  //! @param horseUid UID of the stallion.
+  //! @param ownerUid UID of the character owning the listing.
+  //! @returns `true` if the stallion was listed by the owner, `false` otherwise.
+  bool UnregisterStallion(data::Uid horseUid, data::Uid ownerUid);
+  //! Returns whether a stallion is listed on the market.
+  //! @param horseUid UID of the stallion.
+  //! @returns `true` if the stallion is listed, `false` otherwise.
+  [[nodiscard]] bool IsListed(data::Uid horseUid);
+
+  //! Searches the listed stallions.
+  //! @param query Search query.
+  //! @returns Requested page of the search results.
+  [[nodiscard]] std::shared_ptr<const Page> Search(const Query& query);
+
+  //! Loads the listings, expires the old ones and flushes the changed listings.
+  void Tick();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  //! A key of the persisted breeding market.
+  static constexpr data::Uid MarketKey = 1;
+  //! Interval in which the changed listings are flushed.
+  static constexpr auto FlushInterval = std::chrono::seconds(30);
+
+  //! A listing.
+  struct Listing
+  {
+    data::BreedingMarket::Listing listing{};
+    //! Whether the listing is indexed, listings are indexed once their stallion record is available.
+    bool isIndexed{false};
+  };
+
+  //! Takes a snapshot of the stallion of a listing and indexes the listing.
+  //! @param listing Listing.
+  //! @param horse Stallion of the listing.
+  void IndexListing(Listing& listing, const data::Horse& horse);
+  //! Removes a listing.
+  //! @param horseUid UID of the stallion.
+  //! @returns `true` if the stallion was listed, `false` otherwise.
+  bool RemoveListing(data::Uid horseUid);
+
+  ServerInstance& _serverInstance;
+
+  //! A mutex for the listings.
+  std::mutex _listingsMutex;
+  //! Whether the listings were loaded from the data director.
+  bool _isLoaded{false};
+  //! Whether the listings changed since the last flush.
+  bool _isDirty{false};
+  //! Listings mapped by the UID of their stallion.
+  std::unordered_map<data::Uid, Listing> _listings;
+
+  //! An index of the listings by the search criteria.
+  BreedingMarketIndex _index;
+
+  //! Time point of the next flush of the changed listings.
+  Clock::time_point _nextFlushTime{};
+};
+
+} // namespace server
+
+#endif // BREEDINGMARKETSYSTEM_HPP
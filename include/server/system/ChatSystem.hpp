@@ -21,8 +21,12 @@
 #define COMMANDHANDLER_HPP
 
 #include "libserver/data/DataDefinitions.hpp"
+#include "libserver/util/WordFilter.hpp"
 
+#include <filesystem>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <span>
 #include <unordered_map>
@@ -83,16 +87,86 @@ public:
     data::Uid characterUid,
     const std::string& message);
 
+  //! Reads the moderation config and compiles its banned words.
+  //! The moderation is replaced atomically, messages in progress finish with the old one.
+  //! @param configPath Path to the moderation config.
+  //! @throws std::exception if the config could not be read.
+  void ReadModerationConfig(const std::filesystem::path& configPath);
+
+  //! An audience of a broadcast.
+  struct Audience
+  {
+    //! A scope of the audience.
+    enum class Scope
+    {
+      //! All the characters on the server.
+      Server,
+      //! Characters of a guild.
+      Guild,
+      //! Characters in a ranch.
+      Ranch,
+      //! Characters in a race room.
+      Room
+    } scope{Scope::Server};
+
+    //! A UID of the guild, ranch or room, unused for the server scope.
+    data::Uid uid{data::InvalidUid};
+  };
+
+  //! A report of a broadcast delivery.
+  struct BroadcastReport
+  {
+    //! Count of the lobby sessions the message was queued to.
+    std::size_t lobbySessions{};
+    //! Count of the ranch sessions the message was queued to.
+    std::size_t ranchSessions{};
+    //! Count of the race sessions the message was queued to.
+    std::size_t raceSessions{};
+  };
+
+  //! Broadcasts a system message to the sessions of an audience.
+  //! The sessions are collected in a single pass over the presences
+  //! and the message is written only once per director.
+  //! @param message Message to broadcast.
+  //! @param audience Audience of the message.
+  //! @returns Report of the delivery.
+  BroadcastReport Broadcast(
+    const std::string& message,
+    const Audience& audience);
+
 private:
+  //! A moderation of the chat messages.
+  struct Moderation
+  {
+    //! An action taken on a message containing a banned word.
+    enum class Action
+    {
+      //! Mask the banned words.
+      Mask,
+      //! Reject the message.
+      Reject
+    } action{Action::Mask};
+
+    //! A filter of the banned words.
+    WordFilter wordFilter;
+  };
+
+  //! Returns the current moderation.
+  //! @returns Current moderation.
+  [[nodiscard]] std::shared_ptr<const Moderation> GetModeration();
+
   void RegisterUserCommands();
   void RegisterAdminCommands();
 
-  void Broadcast(std::string message);
-
   //! A server instance.
   ServerInstance& _serverInstance;
   //! A command manager.
   CommandManager _commandManager;
+
+  //! A mutex for the moderation.
+  std::mutex _moderationMutex;
+  //! A moderation of the chat messages.
+  std::shared_ptr<const Moderation> _moderation = std::make_shared<const Moderation>();
 };
 
 } // namespace server
@@ -6,8 +6,11 @@
 #define OTPSYSTEM_HPP
 
 #include <chrono>
+#include <functional>
+#include <mutex>
 #include <random>
 #include <unordered_map>
+#include <vector>
 
 namespace server
 {
@@ -15,18 +18,37 @@ namespace server
 class OtpSystem
 {
 public:
+  //! A listener of the granted codes.
+  using GrantListener = std::function<void(uint32_t key, uint32_t code)>;
+
   uint32_t GrantCode(uint32_t key);
   bool AuthorizeCode(uint32_t key, uint32_t code);
 
+  //! Grants a specific code, such as a code granted in a captured session which is replayed.
+  //! @param key Key of the code.
+  //! @param code Code.
+  void RestoreCode(uint32_t key, uint32_t code);
+
+  //! Adds a listener of the granted codes.
+  //! @param listener Listener notified with every granted code.
+  void AddGrantListener(GrantListener listener);
+
 private:
+  //! Validity of a granted code.
+  static constexpr auto CodeValidity = std::chrono::seconds(30);
+
   struct Code
   {
     std::chrono::steady_clock::time_point expiry{};
     uint32_t code{};
   };
 
+  //! A mutex for the codes and the listeners,
+  //! the codes are granted and authorized by different directors.
+  std::mutex _codesMutex;
   std::random_device _rd;
   std::unordered_map<uint32_t, Code> _codes;
+  std::vector<GrantListener> _grantListeners;
 };
 
 } // namespace server
@@ -0,0 +1,185 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef PRESENCESYSTEM_HPP
+#define PRESENCESYSTEM_HPP
+
+#include "libserver/data/DataDefinitions.hpp"
+#include "libserver/network/Server.hpp"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace server
+{
+
+//! A presence system tracking the characters online on the directors.
+//! Directors update the presence of a character when its client connects,
+//! enters or leaves and the presence is looked up concurrently from any thread.
+//! Subscribers are notified of the presence changes of the characters they subscribed to.
+class PresenceSystem
+{
+public:
+  //! A director a character can be connected to.
+  enum class Director : uint8_t
+  {
+    Lobby,
+    Ranch,
+    Race,
+    Count
+  };
+
+  //! A presence of a character.
+  struct Presence
+  {
+    //! A UID of the character.
+    data::Uid characterUid{data::InvalidUid};
+    //! A name of the user owning the character.
+    std::string userName;
+    //! A name of the character.
+    std::string characterName;
+    //! Clients of the character indexed by the director, empty if not connected.
+    std::array<std::optional<network::ClientId>, static_cast<std::size_t>(Director::Count)> clients{};
+    //! A UID of the character whose ranch the character is in.
+    data::Uid ranchUid{data::InvalidUid};
+    //! A UID of the room the character is in.
+    data::Uid roomUid{data::InvalidUid};
+    //! A UID of the guild of the character.
+    data::Uid guildUid{data::InvalidUid};
+    //! A busy state of the character.
+    uint8_t busyState{};
+
+    //! Returns whether the character is connected to a director.
+    //! @param director Director.
+    //! @returns `true` if the character is connected, `false` otherwise.
+    [[nodiscard]] bool IsConnected(Director director) const;
+  };
+
+  //! Clients indexed by the director.
+  using DirectorClients = std::array<
+    std::vector<network::ClientId>,
+    static_cast<std::size_t>(Director::Count)>;
+
+  //! An updater of a presence.
+  using Updater = std::function<void(Presence& presence)>;
+  //! A listener of the presence changes.
+  //! The presence is empty if the character went offline.
+  using Listener = std::function<void(data::Uid characterUid, const std::optional<Presence>& presence)>;
+  //! A subscription ID.
+  using SubscriptionId = uint32_t;
+
+  //! Connects a character to a director.
+  //! @param characterUid UID of the character.
+  //! @param director Director the character connected to.
+  //! @param clientId ID of the client of the character.
+  //! @param updater Updater of the presence applied along with the connect.
+  void Connect(
+    data::Uid characterUid,
+    Director director,
+    network::ClientId clientId,
+    const Updater& updater = {});
+  //! Disconnects a character from a director.
+  //! The character goes offline once it is not connected to any director.
+  //! @param characterUid UID of the character.
+  //! @param director Director the character disconnected from.
+  void Disconnect(data::Uid characterUid, Director director);
+  //! Updates the presence of an online character.
+  //! @param characterUid UID of the character.
+  //! @param updater Updater of the presence.
+  void Update(data::Uid characterUid, const Updater& updater);
+
+  //! Returns whether a character is online.
+  //! @param characterUid UID of the character.
+  //! @returns `true` if the character is online, `false` otherwise.
+  [[nodiscard]] bool IsOnline(data::Uid characterUid) const;
+  //! Returns the presence of a character.
+  //! @param characterUid UID of the character.
+  //! @returns Presence of the character, or empty if the character is offline.
+  [[nodiscard]] std::optional<Presence> GetPresence(data::Uid characterUid) const;
+  //! Returns the characters connected to a director.
+  //! @param director Director.
+  //! @returns UIDs of the characters.
+  [[nodiscard]] std::vector<data::Uid> GetOnlineCharacters(Director director) const;
+  //! Returns the presences of the characters connected to a director.
+  //! @param director Director.
+  //! @returns Presences of the characters.
+  [[nodiscard]] std::vector<Presence> GetPresences(Director director) const;
+
+  //! Collects the clients of the characters in a single pass over the presences.
+  //! @param filter Filter of the presences, empty to collect the clients of all the characters.
+  //! @returns Clients of the characters indexed by the director.
+  [[nodiscard]] DirectorClients CollectClients(
+    const std::function<bool(const Presence&)>& filter = {}) const;
+
+  //! Subscribes to the presence changes of characters.
+  //! The listener is invoked on the thread which changed the presence.
+  //! @param characterUids UIDs of the characters.
+  //! @param listener Listener of the presence changes.
+  //! @returns ID of the subscription.
+  [[nodiscard]] SubscriptionId Subscribe(
+    std::span<const data::Uid> characterUids,
+    Listener listener);
+  //! Cancels a subscription.
+  //! @param subscriptionId ID of the subscription.
+  void Unsubscribe(SubscriptionId subscriptionId);
+
+private:
+  //! A subscription.
+  struct Subscription
+  {
+    //! UIDs of the characters subscribed to.
+    std::vector<data::Uid> characterUids;
+    //! A listener of the presence changes.
+    std::shared_ptr<const Listener> listener;
+  };
+
+  //! Notifies the subscribers of a character about its presence change.
+  //! @param characterUid UID of the character.
+  //! @param presence Presence of the character, or empty if the character went offline.
+  void Notify(data::Uid characterUid, const std::optional<Presence>& presence);
+
+  //! A mutex for the presences.
+  mutable std::shared_mutex _presencesMutex;
+  //! Presences mapped by the UID of the character.
+  std::unordered_map<data::Uid, Presence> _presences;
+  //! UIDs of the characters connected to a director indexed by the director.
+  std::array<std::unordered_set<data::Uid>, static_cast<std::size_t>(Director::Count)> _directorCharacters;
+
+  //! A mutex for the subscriptions.
+  std::mutex _subscriptionsMutex;
+  //! A sequential ID of the next subscription.
+  SubscriptionId _nextSubscriptionId{1};
+  //! Subscriptions mapped by their ID.
+  std::unordered_map<SubscriptionId, Subscription> _subscriptions;
+  //! IDs of the subscriptions mapped by the UID of the character subscribed to.
+  std::unordered_map<data::Uid, std::vector<SubscriptionId>> _subscribers;
+};
+
+} // namespace server
+
+#endif // PRESENCESYSTEM_HPP
@@ -0,0 +1,154 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef RANKINGSYSTEM_HPP
+#define RANKINGSYSTEM_HPP
+
+#include "libserver/data/DataDefinitions.hpp"
+#include "libserver/network/command/proto/CommonStructureDefinitions.hpp"
+#include "libserver/util/Ranking.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace server
+{
+
+class ServerInstance;
+
+//! A ranking system recording the race results on the leaderboards.
+//! Every course and game mode has its own leaderboard of the best course times,
+//! the league leaderboard ranks the characters by the league points earned in the races.
+//! The leaderboards are loaded from the data director on their first use
+//! and the changed leaderboards are periodically flushed back in batches.
+class RankingSystem
+{
+public:
+  //! A result of a racer.
+  struct RacerResult
+  {
+    //! An UID of the character of the racer.
+    data::Uid characterUid{data::InvalidUid};
+    //! A course time of the racer.
+    uint32_t courseTime{};
+  };
+
+  explicit RankingSystem(ServerInstance& serverInstance);
+
+  //! Records the results of a finished race.
+  //! @param mapBlockId ID of the map block of the course.
+  //! @param gameMode Game mode of the race.
+  //! @param results Results of the racers which finished the race.
+  void RecordRaceResults(
+    uint16_t mapBlockId,
+    uint8_t gameMode,
+    const std::vector<RacerResult>& results);
+
+  //! Returns the league of a character.
+  //! @param characterUid UID of the character.
+  //! @returns League of the character.
+  [[nodiscard]] League GetLeague(data::Uid characterUid);
+
+  //! Returns the league points of a character.
+  //! @param characterUid UID of the character.
+  //! @returns League points of the character, or empty if the character is not ranked.
+  [[nodiscard]] std::optional<uint32_t> GetLeaguePoints(data::Uid characterUid);
+
+  //! Returns the rank of a character in the league.
+  //! @param characterUid UID of the character.
+  //! @returns One-based rank of the character, or empty if the character is not ranked.
+  [[nodiscard]] std::optional<uint32_t> GetLeagueRank(data::Uid characterUid);
+
+  //! Returns the rank of a character on the leaderboard of a course.
+  //! @param mapBlockId ID of the map block of the course.
+  //! @param gameMode Game mode.
+  //! @param characterUid UID of the character.
+  //! @returns One-based rank of the character, or empty if the character is not ranked.
+  [[nodiscard]] std::optional<uint32_t> GetCourseRank(
+    uint16_t mapBlockId,
+    uint8_t gameMode,
+    data::Uid characterUid);
+
+  //! Loads the requested leaderboards and flushes the changed leaderboards.
+  //! Accesses the data storages, expected to be called on the data director thread.
+  void Tick();
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  //! A key of the league leaderboard.
+  static constexpr data::Uid LeagueBoardKey = 1;
+  //! League points awarded for every racer finishing behind.
+  static constexpr uint32_t LeaguePointsPerRacer = 10;
+  //! Max league points distinguished by the league leaderboard.
+  static constexpr uint32_t MaxLeaguePoints = 1'000'000;
+  //! Max course time [ms] distinguished by the course leaderboards.
+  static constexpr uint32_t MaxCourseTime = 30 * 60 * 1000;
+  //! Size of a course time bucket [ms].
+  static constexpr uint32_t CourseTimeBucketSize = 100;
+  //! Interval in which the changed leaderboards are flushed.
+  static constexpr auto FlushInterval = std::chrono::seconds(30);
+
+  //! A leaderboard.
+  struct Board
+  {
+    //! Ranking of the characters.
+    Ranking ranking;
+    //! Whether the leaderboard was loaded from the data director.
+    bool isLoaded{false};
+    //! Whether the leaderboard changed since the last flush.
+    bool isDirty{false};
+    //! Changes made before the leaderboard was loaded.
+    std::vector<std::function<void(Ranking&)>> pendingChanges;
+  };
+
+  //! Returns the key of the leaderboard of a course.
+  //! @param mapBlockId ID of the map block of the course.
+  //! @param gameMode Game mode.
+  //! @returns Key of the leaderboard.
+  [[nodiscard]] static data::Uid GetCourseBoardKey(uint16_t mapBlockId, uint8_t gameMode);
+
+  //! Returns a leaderboard, requesting its load if necessary.
+  //! @param key Key of the leaderboard.
+  //! @returns Leaderboard.
+  Board& GetBoard(data::Uid key);
+
+  //! Applies a change to a leaderboard, or defers it until the leaderboard is loaded.
+  //! @param key Key of the leaderboard.
+  //! @param change Change to apply.
+  void ChangeBoard(data::Uid key, std::function<void(Ranking&)> change);
+
+  ServerInstance& _serverInstance;
+
+  //! A mutex for the leaderboards.
+  std::mutex _boardsMutex;
+  //! Leaderboards mapped by their key.
+  std::unordered_map<data::Uid, Board> _boards;
+  //! Time point of the next flush of the changed leaderboards.
+  Clock::time_point _nextFlushTime{};
+};
+
+} // namespace server
+
+#endif // RANKINGSYSTEM_HPP
@@ -23,8 +23,11 @@
 #include "libserver/registry/CourseRegistry.hpp"
 
 #include <cstdint>
+#include <functional>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace server
 {
@@ -51,22 +54,85 @@ struct Room
   uint8_t unk3;
   uint16_t bitset;
   uint8_t unk4;
+
+  //! Count of the players currently in the room.
+  uint8_t occupantCount{};
+  //! Whether the race of the room is in progress.
+  bool isRacing{false};
 };
 
 class RoomSystem
 {
 public:
-  Room& CreateRoom();
-  Room& GetRoom(uint32_t uid);
+  //! Count of the rooms on a page of the room list.
+  static constexpr std::size_t RoomListPageSize = 8;
+
+  //! A listener of the created rooms.
+  using CreateListener = std::function<void(const Room& room)>;
+
+  //! Creates a room.
+  //! @param setup Function setting up the room before it is indexed.
+  //! @returns Created room.
+  Room CreateRoom(const std::function<void(Room&)>& setup);
+
+  //! Restores a room with its UID, such as a room created in a captured session which is replayed.
+  //! A room with the same UID is replaced.
+  //! @param room Room.
+  void RestoreRoom(const Room& room);
+
+  //! Adds a listener of the created rooms.
+  //! @param listener Listener notified with every created room.
+  void AddCreateListener(CreateListener listener);
+
+  //! Returns a room.
+  //! @param uid UID of the room.
+  //! @returns Copy of the room.
+  Room GetRoom(uint32_t uid);
+
+  //! Updates a room and its position in the room index.
+  //! @param uid UID of the room.
+  //! @param updater Function updating the room.
+  void UpdateRoom(uint32_t uid, const std::function<void(Room&)>& updater);
+
+  //! Deletes a room.
+  //! @param uid UID of the room.
   void DeleteRoom(uint32_t uid);
-  const std::unordered_map<uint32_t, Room>& GetRooms()
-  {
-    return _rooms;
-  }
+
+  //! Returns a page of the rooms with the specified modes, ordered by their UID.
+  //! @param gameMode Game mode of the rooms.
+  //! @param teamMode Team mode of the rooms.
+  //! @param page Index of the page, starting from zero.
+  //! @returns Copies of the rooms on the page.
+  std::vector<Room> GetRoomPage(
+    uint8_t gameMode,
+    TeamMode teamMode,
+    std::size_t page);
 
 private:
+  //! Key of the room index.
+  using IndexKey = uint16_t;
+
+  //! Returns the key of the room index for the specified modes.
+  //! @param gameMode Game mode.
+  //! @param teamMode Team mode.
+  //! @returns Key of the room index.
+  static IndexKey GetIndexKey(uint8_t gameMode, TeamMode teamMode);
+
+  //! Adds a room to the room index.
+  //! @param room Room.
+  void IndexRoom(const Room& room);
+  //! Removes a room from the room index.
+  //! @param room Room.
+  void UnindexRoom(const Room& room);
+
   uint32_t _sequencedId = 0;
+  //! A mutex for the rooms, which are accessed from the lobby and the race room shards.
+  std::shared_mutex _roomsMutex;
   std::unordered_map<uint32_t, Room> _rooms;
+  //! UIDs of the rooms sorted in ascending order, mapped by the modes of the rooms.
+  //! Rooms are created with increasing UIDs, so indexing a room is an append.
+  std::unordered_map<IndexKey, std::vector<uint32_t>> _roomIndex;
+  std::vector<CreateListener> _createListeners;
 };
 
 } // namespace server
@@ -0,0 +1,81 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#ifndef SHOPSYSTEM_HPP
+#define SHOPSYSTEM_HPP
+
+#include "libserver/network/command/CommandProtocol.hpp"
+#include "libserver/registry/GoodsRegistry.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace server
+{
+
+//! A shop system serving the goods catalogue to the clients.
+//! The catalogue is rendered and compressed once when it is compiled,
+//! the clients are served the cached compressed data.
+class ShopSystem
+{
+public:
+  //! Max size of the compressed catalogue data.
+  //! The data are sent in one command along with the message magic,
+  //! the 12 byte signature, two bytes and the 4 byte data size.
+  static constexpr std::size_t MaxDataSize = protocol::BufferSize - 4 - 12 - 2 - 4;
+
+  //! A compiled catalogue.
+  struct Catalogue
+  {
+    //! A version of the catalogue, incremented with every compilation.
+    uint32_t version{};
+    //! A signature of the catalogue sent to the clients.
+    //! Holds the CRC-32 of the compressed XML, the size of the XML and the size of the compressed XML,
+    //! so the same catalogue has the same signature across the server restarts.
+    std::array<uint8_t, 12> signature{};
+    //! The compressed catalogue XML.
+    std::vector<std::byte> data;
+  };
+
+  //! Compiles the catalogue from the goods and replaces the current catalogue.
+  //! @param goods Goods.
+  //! @throws std::runtime_error if the catalogue could not be compressed
+  //!                            or the compressed catalogue exceeds the max data size.
+  void CompileCatalogue(const std::vector<registry::Goods>& goods);
+
+  //! Returns the current catalogue.
+  //! @returns Current catalogue, or null if no catalogue was compiled yet.
+  [[nodiscard]] std::shared_ptr<const Catalogue> GetCatalogue();
+
+private:
+  //! A mutex for the catalogue.
+  std::mutex _catalogueMutex;
+  //! A current catalogue.
+  std::shared_ptr<const Catalogue> _catalogue;
+  //! A version of the current catalogue.
+  uint32_t _catalogueVersion{0};
+};
+
+} // namespace server
+
+#endif // SHOPSYSTEM_HPP
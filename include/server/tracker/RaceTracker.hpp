@@ -24,16 +24,40 @@
 
 #include <libserver/data/DataDefinitions.hpp>
 
-#include <map>
 #include <array>
+#include <limits>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace server::tracker
 {
 
 //! A race tracker.
+//! Racers and items are kept in dense storages, which are indexed by UID and OID.
+//! Removing a racer or an item moves the last element of the storage to its place,
+//! so the order of the elements is not stable, while their OIDs are.
 class RaceTracker
 {
 public:
+  //! A kinematic state of a racer.
+  struct Kinematics
+  {
+    //! Position.
+    std::array<float, 3> position{};
+    //! Rotation.
+    std::array<float, 3> rotation{};
+    //! Speed.
+    float speed{};
+    //! 1 = In the air
+    uint16_t airborne{};
+    //! Race track progress.
+    float progress{};
+    //! Timestamp reported by the racer.
+    uint32_t timestamp{};
+  };
+
   //! A racer.
   struct Racer
   {
@@ -53,6 +77,7 @@ public:
     };
 
     Oid oid{InvalidEntityOid};
+    data::Uid characterUid{data::InvalidUid};
     State state{State::Disconnected};
     Team team{Team::Solo};
     uint32_t starPointValue{};
@@ -73,50 +98,87 @@ public:
     std::array<float, 3> position{};
   };
 
-  //! An object map.
-  using ObjectMap = std::map<data::Uid, Racer>;
-  //! An item object map.
-  //! Maps itemId -> Item (in the race)
-  using ItemObjectMap = std::map<uint16_t, Item>;
-
   //! Adds a racer for tracking.
   //! @param characterUid Character UID.
   //! @returns A reference to the racer record.
+  //! @note The reference is invalidated when a racer is added or removed.
   Racer& AddRacer(data::Uid characterUid);
   //! Removes a racer from tracking.
   //! @param characterUid Character UID.
   void RemoveRacer(data::Uid characterUid);
+  //! Returns whether the character is a racer.
+  //! @param characterUid Character UID.
+  //! @returns `true` if the character is a racer, `false` otherwise.
+  [[nodiscard]] bool IsRacer(data::Uid characterUid) const;
+  //! Returns whether the object is a racer.
+  //! @param oid OID of the object.
+  //! @returns `true` if the object is a racer, `false` otherwise.
+  [[nodiscard]] bool IsRacerOid(Oid oid) const;
   //! Returns reference to the racer record.
+  //! @param characterUid Character UID.
   //! @returns Racer record.
   [[nodiscard]] Racer& GetRacer(data::Uid characterUid);
-  //! Returns a reference to all racer records.
-  //! @return Reference to racer records.
-  [[nodiscard]] ObjectMap& GetRacers();
+  //! Returns reference to the racer record.
+  //! @param oid OID of the racer.
+  //! @returns Racer record.
+  [[nodiscard]] Racer& GetRacerByOid(Oid oid);
+  //! Returns all racer records.
+  //! @return Racer records.
+  [[nodiscard]] std::span<Racer> GetRacers();
+
+  //! Returns reference to the kinematic state reported by the racer.
+  //! @param oid OID of the racer.
+  //! @returns Kinematic state.
+  [[nodiscard]] Kinematics& GetKinematics(Oid oid);
+  //! Returns the kinematic states reported by all racers,
+  //! in the same order as the racer records returned by `GetRacers()`.
+  //! @returns Kinematic states.
+  [[nodiscard]] std::span<Kinematics> GetKinematics();
+  //! Returns the kinematic states of all racers, which were last published to the room,
+  //! in the same order as the racer records returned by `GetRacers()`.
+  //! @returns Kinematic states.
+  [[nodiscard]] std::span<Kinematics> GetPublishedKinematics();
 
   //! Adds an item for tracking.
   //! @returns A reference to the new item record.
+  //! @note The reference is invalidated when an item is added or removed.
   Item& AddItem();
   //! Removes an item from tracking.
   //! @param itemId Item ID.
   void RemoveItem(uint16_t itemId);
+  //! Removes all items from tracking and starts the item IDs over.
+  void ClearItems();
   //! Returns reference to the item record.
   //! @param itemId Item ID.
   //! @returns Item record.
   [[nodiscard]] Item& GetItem(uint16_t itemId);
-  //! Returns a reference to all item records.
-  //! @return Reference to item records.
-  [[nodiscard]] ItemObjectMap& GetItems();
+  //! Returns all item records.
+  //! @return Item records.
+  [[nodiscard]] std::span<Item> GetItems();
 
 private:
+  //! An invalid index to the storage.
+  static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
   //! The next entity ID.
   Oid _nextObjectId = 1;
   //! Horse entities in the race.
-  ObjectMap _racers;
+  std::vector<Racer> _racers;
+  //! Kinematic states reported by the racers, parallel to the racers.
+  std::vector<Kinematics> _kinematics;
+  //! Kinematic states published to the room, parallel to the racers.
+  std::vector<Kinematics> _publishedKinematics;
+  //! Indices of the racers mapped by the character UID.
+  std::unordered_map<data::Uid, std::size_t> _racerIndices;
+  //! Indices of the racers indexed by the OID.
+  std::vector<std::size_t> _racerOidIndices;
 
   //! The next item ID.
   uint16_t _nextItemId = 1;
   //! Items in the race
-  ItemObjectMap _items;
+  std::vector<Item> _items;
+  //! Indices of the items indexed by the item ID.
+  std::vector<std::size_t> _itemIndices;
 };
 
 } // namespace server::tracker
@@ -24,17 +24,29 @@
 
 #include <libserver/data/DataDefinitions.hpp>
 
+#include <array>
 #include <map>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace server::tracker
 {
 
 //! A ranch tracker.
+//! Last known positions of the objects are kept in a uniform spatial grid over the ground (X/Z) plane.
 class RanchTracker
 {
 public:
   //! An object map.
   using ObjectMap = std::map<data::Uid, uint16_t>;
+  //! A position in the ranch.
+  using Position = std::array<float, 3>;
+
+  //! Size of a cell of the spatial grid.
+  //! Not smaller than the default interest radius of the ranch,
+  //! a query within that radius visits at most 3x3 cells.
+  static constexpr float CellSize = 500.0f;
 
   //! Adds a character for tracking.
   //! @param character Character UID.
@@ -58,6 +70,20 @@ public:
   //! @param horse Character UID.
   [[nodiscard]] Oid GetHorseOid(data::Uid horse) const;
 
+  //! Sets the last known position of an object.
+  //! @param oid OID of the object.
+  //! @param position Position of the object.
+  void SetPosition(Oid oid, const Position& position);
+  //! Returns the last known position of an object.
+  //! @param oid OID of the object.
+  //! @returns Position of the object, or empty if the position is not known.
+  [[nodiscard]] std::optional<Position> GetPosition(Oid oid) const;
+  //! Returns the objects with the last known position within a radius.
+  //! @param center Center of the radius.
+  //! @param radius Radius.
+  //! @returns OIDs of the objects.
+  [[nodiscard]] std::vector<Oid> GetObjectsInRadius(const Position& center, float radius) const;
+
   //! Returns tracked characters.
   //! @return Tracked characters.
   [[nodiscard]] const ObjectMap& GetCharacters() const;
@@ -66,12 +92,41 @@ public:
   [[nodiscard]] const ObjectMap& GetHorses() const;
 
 private:
+  //! A key of a grid cell.
+  using CellKey = uint64_t;
+
+  //! A positioned object.
+  struct PositionedObject
+  {
+    Position position{};
+    CellKey cell{};
+  };
+
+  //! Returns the key of the cell with the specified coordinates.
+  //! @param x X coordinate of the cell.
+  //! @param z Z coordinate of the cell.
+  //! @returns Key of the cell.
+  [[nodiscard]] static CellKey GetCellKey(int32_t x, int32_t z);
+  //! Returns the coordinate of the cell containing a coordinate of a position.
+  //! @param coordinate Coordinate of a position.
+  //! @returns Coordinate of the cell.
+  [[nodiscard]] static int32_t GetCellCoordinate(float coordinate);
+
+  //! Removes the last known position of an object.
+  //! @param oid OID of the object.
+  void RemovePosition(Oid oid);
+
   //! The next entity ID.
   Oid _nextObjectId = 1;
   //! Character entities in the ranch.
   ObjectMap _characters;
   //! Horse entities in the ranch.
   ObjectMap _horses;
+
+  //! Positioned objects mapped by their OID.
+  std::unordered_map<Oid, PositionedObject> _positionedObjects;
+  //! OIDs of the positioned objects mapped by the key of their cell.
+  std::unordered_map<CellKey, std::vector<Oid>> _cells;
 };
 
 } // namespace server::tracker
@@ -0,0 +1,514 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "bot/Bot.hpp"
+
+#include <libserver/network/chatter/ChatterProtocol.hpp>
+#include <libserver/network/chatter/proto/ChatterMessageDefinitions.hpp>
+#include <libserver/network/command/proto/LobbyMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RaceMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RanchMessageDefinitions.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <numbers>
+
+namespace server::bot
+{
+
+namespace
+{
+
+//! Interval of the bot tick, the snapshots and the race positions are sent every tick.
+constexpr auto TickInterval = std::chrono::milliseconds(100);
+//! Interval of the lobby heartbeats.
+constexpr auto HeartbeatInterval = std::chrono::seconds(5);
+//! Duration after which a pending request is considered failed.
+constexpr auto RequestTimeout = std::chrono::seconds(10);
+//! Delay between the races of a racing bot.
+constexpr auto RaceInterval = std::chrono::seconds(1);
+
+//! Average count of ticks between the chat messages of a ranch bot.
+constexpr uint32_t RanchChatTicks = 300;
+//! Average count of ticks between the chat messages of a chat bot.
+constexpr uint32_t ChatChatTicks = 20;
+
+//! Returns the ID of a command of the command protocol.
+constexpr uint16_t Id(protocol::Command command)
+{
+  return static_cast<uint16_t>(command);
+}
+
+} // anon namespace
+
+Bot::Bot(asio::io_context& ioContext, Config config, Statistics& statistics)
+  : _strand(asio::make_strand(ioContext))
+  , _tickTimer(_strand)
+  , _config(std::move(config))
+  , _statistics(statistics)
+  , _lobby(_strand, Connection::Protocol::Command, Statistics::Director::Lobby, statistics)
+  , _ranch(_strand, Connection::Protocol::Command, Statistics::Director::Ranch, statistics)
+  , _race(_strand, Connection::Protocol::Command, Statistics::Director::Race, statistics)
+  , _messenger(_strand, Connection::Protocol::Chatter, Statistics::Director::Messenger, statistics)
+  , _random(std::hash<std::string>{}(_config.name))
+{
+  RegisterHandlers();
+}
+
+void Bot::Start()
+{
+  asio::post(_strand, [this]()
+  {
+    _state = State::LoggingIn;
+
+    _lobby.Connect(_config.lobby, [this](bool connected)
+    {
+      if (not connected)
+      {
+        spdlog::warn("Bot '{}' failed to connect to the lobby", _config.name);
+        _statistics.RecordFailure("Connect");
+        _state = State::Stopped;
+        return;
+      }
+
+      _lobby.Request(
+        protocol::LobbyCommandLogin{
+          .loginId = _config.name,
+          .memberNo = 0,
+          .authKey = _config.token},
+        Id(protocol::Command::AcCmdCLLoginOK),
+        Id(protocol::Command::AcCmdCLLoginCancel));
+    });
+
+    TickLoop();
+  });
+}
+
+void Bot::Stop()
+{
+  asio::post(_strand, [this]()
+  {
+    _state = State::Stopped;
+    _tickTimer.cancel();
+
+    _lobby.Close();
+    _ranch.Close();
+    _race.Close();
+    _messenger.Close();
+  });
+}
+
+void Bot::TickLoop()
+{
+  _tickTimer.expires_after(TickInterval);
+  _tickTimer.async_wait([this](const boost::system::error_code& error)
+  {
+    // The timer was cancelled.
+    if (error || _state == State::Stopped)
+      return;
+
+    Tick();
+    TickLoop();
+  });
+}
+
+void Bot::Tick()
+{
+  _lobby.ExpireRequests(RequestTimeout);
+  _ranch.ExpireRequests(RequestTimeout);
+  _race.ExpireRequests(RequestTimeout);
+  _messenger.ExpireRequests(RequestTimeout);
+
+  // The bot lost its lobby connection, it stays idle until it is stopped.
+  if (not _lobby.IsOpen())
+    return;
+
+  const auto now = Clock::now();
+  if (_state != State::LoggingIn && now - _lastHeartbeat >= HeartbeatInterval)
+  {
+    _lobby.Send(protocol::AcCmdCLHeartbeat{});
+    _lastHeartbeat = now;
+  }
+
+  switch (_state)
+  {
+    case State::Lobby:
+    {
+      if (_config.behaviour == Behaviour::Race && now >= _nextRace)
+        BeginRace();
+      break;
+    }
+    case State::Ranch:
+    {
+      TickRanch();
+      break;
+    }
+    case State::Racing:
+    {
+      TickRace();
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void Bot::RegisterHandlers()
+{
+  // Lobby
+  _lobby.SetHandler(
+    Id(protocol::Command::AcCmdCLCreateNicknameNotify),
+    [this](SourceStream&)
+    {
+      // Create the character of a user which does not have one yet.
+      _lobby.Send(protocol::LobbyCommandCreateNickname{
+        .nickname = _config.name});
+    });
+
+  _lobby.SetHandler(
+    Id(protocol::Command::AcCmdCLLoginOK),
+    [this](SourceStream& stream)
+    {
+      // The code is reset by the lobby when the login is accepted.
+      _lobby.ResetCode();
+
+      // Only the UID of the character is needed from the login response.
+      util::WinFileTime lobbyTime{};
+      uint32_t member0{};
+      stream.Read(lobbyTime.dwLowDateTime)
+        .Read(lobbyTime.dwHighDateTime)
+        .Read(member0)
+        .Read(_characterUid);
+
+      _state = State::Lobby;
+      _lastHeartbeat = Clock::now();
+      BeginBehaviour();
+    });
+
+  _lobby.SetHandler(
+    Id(protocol::Command::AcCmdCLLoginCancel),
+    [this](SourceStream&)
+    {
+      spdlog::warn("Bot '{}' was rejected by the lobby", _config.name);
+      _lobby.Close();
+    });
+
+  _lobby.SetHandler(
+    Id(protocol::Command::AcCmdCLEnterRanchOK),
+    [this](SourceStream& stream)
+    {
+      protocol::LobbyCommandEnterRanchOK response{};
+      protocol::LobbyCommandEnterRanchOK::Read(response, stream);
+
+      _ranch.Connect(
+        {asio::ip::address_v4(response.ranchAddress), response.ranchPort},
+        [this, response](bool connected)
+        {
+          if (not connected)
+          {
+            _statistics.RecordFailure("Connect");
+            _state = State::Lobby;
+            return;
+          }
+
+          _ranch.Request(
+            protocol::AcCmdCREnterRanch{
+              .characterUid = _characterUid,
+              .otp = response.otp,
+              .rancherUid = response.rancherUid},
+            Id(protocol::Command::AcCmdCREnterRanchOK),
+            Id(protocol::Command::AcCmdCREnterRanchCancel));
+        });
+    });
+
+  _lobby.SetHandler(
+    Id(protocol::Command::AcCmdCLMakeRoomOK),
+    [this](SourceStream& stream)
+    {
+      protocol::LobbyCommandMakeRoomOK response{};
+      protocol::LobbyCommandMakeRoomOK::Read(response, stream);
+
+      _race.Connect(
+        {asio::ip::address_v4(response.address), response.port},
+        [this, response](bool connected)
+        {
+          if (not connected)
+          {
+            _statistics.RecordFailure("Connect");
+            _state = State::Lobby;
+            _nextRace = Clock::now() + RaceInterval;
+            return;
+          }
+
+          _race.Request(
+            protocol::AcCmdCREnterRoom{
+              .characterUid = _characterUid,
+              .otp = response.otp,
+              .roomUid = response.roomUid},
+            Id(protocol::Command::AcCmdCREnterRoomOK),
+            Id(protocol::Command::AcCmdCREnterRoomCancel));
+        });
+    });
+
+  _lobby.SetHandler(
+    Id(protocol::Command::AcCmdCLGetMessengerInfoOK),
+    [this](SourceStream& stream)
+    {
+      protocol::LobbyCommandGetMessengerInfoOK response{};
+      protocol::LobbyCommandGetMessengerInfoOK::Read(response, stream);
+
+      // The address of the messenger is sent in the network byte order.
+      asio::ip::address_v4::bytes_type addressBytes{};
+      std::memcpy(addressBytes.data(), &response.ip, addressBytes.size());
+
+      _messenger.Connect(
+        {asio::ip::address_v4(addressBytes), response.port},
+        [this, code = response.code](bool connected)
+        {
+          if (not connected)
+          {
+            _statistics.RecordFailure("Connect");
+            return;
+          }
+
+          _messenger.Request(
+            protocol::ChatCmdLogin{
+              .val0 = _characterUid,
+              .name = _config.name,
+              .code = code},
+            static_cast<uint16_t>(protocol::ChatterCommand::ChatCmdLoginAckOK),
+            static_cast<uint16_t>(protocol::ChatterCommand::ChatCmdLoginAckCancel));
+        });
+    });
+
+  // Ranch
+  _ranch.SetHandler(
+    Id(protocol::Command::AcCmdCREnterRanchOK),
+    [this](SourceStream& stream)
+    {
+      // The code is reset by the ranch when the ranch is entered.
+      _ranch.ResetCode();
+
+      // Find the OID of the character of the bot in the ranch.
+      uint32_t rancherUid{};
+      std::string rancherName;
+      std::string ranchName;
+      stream.Read(rancherUid)
+        .Read(rancherName)
+        .Read(ranchName);
+
+      uint8_t horseCount{};
+      stream.Read(horseCount);
+      for (uint8_t idx = 0; idx < horseCount; ++idx)
+      {
+        RanchHorse horse{};
+        stream.Read(horse);
+      }
+
+      uint8_t characterCount{};
+      stream.Read(characterCount);
+      for (uint8_t idx = 0; idx < characterCount; ++idx)
+      {
+        RanchCharacter character{};
+        stream.Read(character);
+
+        if (character.uid == _characterUid)
+          _oid = character.oid;
+      }
+
+      _state = State::Ranch;
+      _tickCount = 0;
+    });
+
+  _ranch.SetHandler(
+    Id(protocol::Command::AcCmdCREnterRanchCancel),
+    [this](SourceStream&)
+    {
+      _ranch.Close();
+      _state = State::Lobby;
+    });
+
+  // Race
+  _race.SetHandler(
+    Id(protocol::Command::AcCmdCREnterRoomOK),
+    [this](SourceStream&)
+    {
+      // The code is reset by the race when the room is entered.
+      _race.ResetCode();
+
+      _race.Request(
+        protocol::AcCmdCRStartRace{},
+        Id(protocol::Command::AcCmdCRStartRaceNotify),
+        Id(protocol::Command::AcCmdCRStartRaceCancel));
+    });
+
+  _race.SetHandler(
+    Id(protocol::Command::AcCmdCREnterRoomCancel),
+    [this](SourceStream&)
+    {
+      _race.Close();
+      _state = State::Lobby;
+      _nextRace = Clock::now() + RaceInterval;
+    });
+
+  _race.SetHandler(
+    Id(protocol::Command::AcCmdCRStartRaceNotify),
+    [this](SourceStream& stream)
+    {
+      // Only the OID of the racer is needed from the race start.
+      uint8_t gameMode{};
+      TeamMode teamMode{};
+      stream.Read(gameMode)
+        .Read(teamMode)
+        .Read(_oid);
+
+      _race.Send(protocol::AcCmdCRLoadingComplete{});
+
+      _state = State::Racing;
+      _raceEnd = Clock::now() + _config.raceDuration;
+      _tickCount = 0;
+    });
+}
+
+void Bot::BeginBehaviour()
+{
+  switch (_config.behaviour)
+  {
+    case Behaviour::Idle:
+      break;
+    case Behaviour::Ranch:
+      EnterRanch();
+      break;
+    case Behaviour::Race:
+      BeginRace();
+      break;
+    case Behaviour::Chat:
+      EnterMessenger();
+      EnterRanch();
+      break;
+  }
+}
+
+void Bot::EnterRanch()
+{
+  _state = State::EnteringRanch;
+
+  _lobby.Request(
+    protocol::LobbyCommandEnterRanch{
+      .rancherUid = _characterUid},
+    Id(protocol::Command::AcCmdCLEnterRanchOK),
+    Id(protocol::Command::AcCmdCLEnterRanchCancel));
+}
+
+void Bot::TickRanch()
+{
+  ++_tickCount;
+
+  // Walk the character of the bot in a circle around the ranch.
+  const float angle = static_cast<float>(_tickCount % 600) / 600.0f * 2.0f * std::numbers::pi_v<float>;
+  const std::array position{
+    std::cos(angle) * 20.0f,
+    0.0f,
+    std::sin(angle) * 20.0f};
+
+  protocol::AcCmdCRRanchSnapshot snapshot{
+    .type = protocol::AcCmdCRRanchSnapshot::Full};
+  snapshot.full.ranchIndex = _oid;
+  snapshot.full.time = _tickCount;
+  std::memcpy(snapshot.full.member4.data(), position.data(), sizeof(position));
+
+  _ranch.Send(snapshot);
+
+  const auto chatTicks = _config.behaviour == Behaviour::Chat
+    ? ChatChatTicks
+    : RanchChatTicks;
+  if (std::uniform_int_distribution<uint32_t>(1, chatTicks)(_random) == 1)
+  {
+    _ranch.Request(
+      protocol::AcCmdCRRanchChat{
+        .message = std::format("Hello from {} ({})", _config.name, _tickCount)},
+      Id(protocol::Command::AcCmdCRRanchChatNotify));
+  }
+}
+
+void Bot::BeginRace()
+{
+  _state = State::EnteringRoom;
+
+  _lobby.Request(
+    protocol::LobbyCommandMakeRoom{
+      .name = _config.name,
+      .password = {},
+      .playerCount = 8,
+      .gameMode = 1,
+      .teamMode = TeamMode::Single,
+      .missionId = 0,
+      .unk3 = 0,
+      .bitset = {},
+      .unk4 = 0},
+    Id(protocol::Command::AcCmdCLMakeRoomOK),
+    Id(protocol::Command::AcCmdCLMakeRoomCancel));
+}
+
+void Bot::TickRace()
+{
+  const auto now = Clock::now();
+  if (now >= _raceEnd)
+  {
+    EndRace();
+    return;
+  }
+
+  ++_tickCount;
+
+  const float progress = std::chrono::duration<float>(now - (_raceEnd - _config.raceDuration))
+    / std::chrono::duration<float>(_config.raceDuration);
+
+  _race.Send(protocol::AcCmdUserRaceUpdatePos{
+    .oid = _oid,
+    .member2 = {20.0f, -25.0f, -8000.0f + progress * 1000.0f},
+    .member3 = {0.0f, 0.0f, 0.0f},
+    .member4 = 15.0f,
+    .member5 = 0,
+    .member6 = progress,
+    .member7 = _tickCount});
+}
+
+void Bot::EndRace()
+{
+  // The connection is closed by the connect of the next race,
+  // by then the leave has been written.
+  _race.Send(protocol::AcCmdCRLeaveRoom{});
+
+  _state = State::Lobby;
+  _nextRace = Clock::now() + RaceInterval;
+}
+
+void Bot::EnterMessenger()
+{
+  _lobby.Request(
+    protocol::LobbyCommandGetMessengerInfo{},
+    Id(protocol::Command::AcCmdCLGetMessengerInfoOK),
+    Id(protocol::Command::AcCmdCLGetMessengerInfoCancel));
+}
+
+} // namespace server::bot
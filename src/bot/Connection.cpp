@@ -0,0 +1,400 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "bot/Connection.hpp"
+
+#include <libserver/network/chatter/ChatterProtocol.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace server::bot
+{
+
+namespace
+{
+
+//! Max size of the command data, including the padding.
+constexpr std::size_t MaxCommandDataSize = 4092;
+//! Size of the buffer for the received data.
+constexpr std::size_t ReadBufferSize = 64 * 1024;
+
+} // anon namespace
+
+Connection::Connection(
+  Strand strand,
+  Protocol protocol,
+  Statistics::Director director,
+  Statistics& statistics)
+  : _strand(std::move(strand))
+  , _socket(_strand)
+  , _protocol(protocol)
+  , _director(director)
+  , _statistics(statistics)
+  , _readBuffer(ReadBufferSize)
+{
+}
+
+void Connection::Connect(
+  const asio::ip::tcp::endpoint& endpoint,
+  ConnectHandler handler)
+{
+  Close();
+
+  const auto session = ++_session;
+  _commandClient.SetCode({});
+  _readSize = 0;
+  _writeQueue.clear();
+  _isWriting = false;
+
+  _socket.async_connect(
+    endpoint,
+    [this, session, handler = std::move(handler)](const boost::system::error_code& error)
+    {
+      if (session != _session)
+        return;
+
+      if (error)
+      {
+        handler(false);
+        return;
+      }
+
+      boost::system::error_code optionError;
+      _socket.set_option(asio::ip::tcp::no_delay(true), optionError);
+
+      ReadLoop();
+      handler(true);
+    });
+}
+
+void Connection::Close()
+{
+  // Completions of the operations of the closed session are ignored.
+  ++_session;
+
+  if (_socket.is_open())
+  {
+    boost::system::error_code error;
+    _socket.shutdown(asio::ip::tcp::socket::shutdown_both, error);
+    _socket.close(error);
+  }
+
+  for (const auto& pendingRequest : _pendingRequests)
+  {
+    _statistics.RecordFailure(pendingRequest.name);
+  }
+
+  _pendingRequests.clear();
+}
+
+bool Connection::IsOpen() const
+{
+  return _socket.is_open();
+}
+
+void Connection::ResetCode()
+{
+  _commandClient.SetCode({});
+}
+
+void Connection::SetHandler(uint16_t commandId, CommandHandler handler)
+{
+  _handlers[commandId] = std::move(handler);
+}
+
+void Connection::ExpireRequests(Clock::duration timeout)
+{
+  const auto now = Clock::now();
+  std::erase_if(
+    _pendingRequests,
+    [this, now, timeout](const PendingRequest& pendingRequest)
+    {
+      if (now - pendingRequest.sentAt < timeout)
+        return false;
+
+      _statistics.RecordFailure(pendingRequest.name);
+      return true;
+    });
+}
+
+std::string_view Connection::GetCommandName(uint16_t commandId) const
+{
+  if (_protocol == Protocol::Command)
+    return protocol::GetCommandName(static_cast<protocol::Command>(commandId));
+
+  switch (static_cast<protocol::ChatterCommand>(commandId))
+  {
+    case protocol::ChatterCommand::ChatCmdLogin:
+      return "ChatCmdLogin";
+    case protocol::ChatterCommand::ChatCmdLoginAckOK:
+      return "ChatCmdLoginAckOK";
+    case protocol::ChatterCommand::ChatCmdLoginAckCancel:
+      return "ChatCmdLoginAckCancel";
+  }
+
+  return "Unknown";
+}
+
+void Connection::Send(uint16_t commandId, const CommandSupplier& supplier)
+{
+  if (not _socket.is_open())
+    return;
+
+  std::array<std::byte, sizeof(uint32_t) + MaxCommandDataSize> buffer{};
+
+  // Write the command data after the message magic or the chatter header.
+  SinkStream commandSink{std::span(buffer).subspan(sizeof(uint32_t))};
+  supplier(commandSink);
+
+  std::size_t commandSize = sizeof(uint32_t) + commandSink.GetCursor();
+
+  if (_protocol == Protocol::Command)
+  {
+    // The director rolls the code only for the commands with data,
+    // the padding is then derived from the rolled code.
+    if (commandSink.GetCursor() > 0)
+    {
+      _commandClient.RollCode();
+
+      const auto padding = static_cast<uint32_t>(_commandClient.GetRollingCodeInt()) & 7;
+      const auto commandDataSize = commandSink.GetCursor() + padding;
+      if (commandDataSize > MaxCommandDataSize)
+        throw std::overflow_error("Command data exceed the max command size");
+
+      protocol::ApplyXorCode(
+        _commandClient.GetRollingCode(),
+        std::span(buffer).subspan(sizeof(uint32_t), commandDataSize));
+
+      commandSize = sizeof(uint32_t) + commandDataSize;
+    }
+
+    const uint32_t magic = protocol::encode_message_magic({
+      .id = commandId,
+      .length = static_cast<uint16_t>(commandSize)});
+    std::memcpy(buffer.data(), &magic, sizeof(magic));
+  }
+  else
+  {
+    const protocol::ChatterCommandHeader header{
+      .length = static_cast<uint16_t>(commandSize),
+      .commandId = commandId};
+    std::memcpy(buffer.data(), &header.length, sizeof(header.length));
+    std::memcpy(buffer.data() + sizeof(header.length), &header.commandId, sizeof(header.commandId));
+
+    // The whole chatter command is scrambled, including the header.
+    protocol::ApplyXorCode(
+      protocol::ChatterXorCode,
+      std::span(buffer.data(), commandSize));
+  }
+
+  _statistics.RecordSent(_director, commandSize);
+
+  _writeQueue.insert(_writeQueue.end(), buffer.begin(), buffer.begin() + commandSize);
+  WriteLoop();
+}
+
+void Connection::ReadLoop()
+{
+  // The director sent a command larger than the read buffer.
+  if (_readSize == _readBuffer.size())
+  {
+    spdlog::warn("Received a command larger than {} bytes", _readBuffer.size());
+    Close();
+    return;
+  }
+
+  _socket.async_read_some(
+    asio::buffer(_readBuffer.data() + _readSize, _readBuffer.size() - _readSize),
+    [this, session = _session](const boost::system::error_code& error, std::size_t size)
+    {
+      if (session != _session)
+        return;
+
+      if (error)
+      {
+        Close();
+        return;
+      }
+
+      _readSize += size;
+      const auto consumedSize = HandleData(std::span(_readBuffer.data(), _readSize));
+
+      // The connection was closed by a handler of a command.
+      if (session != _session)
+        return;
+
+      // Keep the data of the commands which were not received whole.
+      std::memmove(
+        _readBuffer.data(),
+        _readBuffer.data() + consumedSize,
+        _readSize - consumedSize);
+      _readSize -= consumedSize;
+
+      ReadLoop();
+    });
+}
+
+void Connection::WriteLoop()
+{
+  if (_isWriting || _writeQueue.empty())
+    return;
+
+  _isWriting = true;
+  std::swap(_writeQueue, _writeBuffer);
+  _writeQueue.clear();
+
+  asio::async_write(
+    _socket,
+    asio::buffer(_writeBuffer),
+    [this, session = _session](const boost::system::error_code& error, std::size_t)
+    {
+      if (session != _session)
+        return;
+
+      _isWriting = false;
+      if (error)
+      {
+        Close();
+        return;
+      }
+
+      WriteLoop();
+    });
+}
+
+std::size_t Connection::HandleData(std::span<std::byte> data)
+{
+  const auto session = _session;
+  std::size_t consumedSize = 0;
+
+  while (session == _session
+    && data.size() - consumedSize >= sizeof(uint32_t))
+  {
+    const auto command = data.subspan(consumedSize);
+
+    uint16_t commandId = 0;
+    std::size_t commandSize = 0;
+
+    if (_protocol == Protocol::Command)
+    {
+      // The commands sent by the director are not scrambled.
+      uint32_t magicValue{};
+      std::memcpy(&magicValue, command.data(), sizeof(magicValue));
+
+      const auto magic = protocol::decode_message_magic(magicValue);
+      commandId = magic.id;
+      commandSize = magic.length;
+    }
+    else
+    {
+      std::array<std::byte, sizeof(protocol::ChatterCommandHeader)> headerData{};
+      std::memcpy(headerData.data(), command.data(), headerData.size());
+      protocol::ApplyXorCode(protocol::ChatterXorCode, headerData);
+
+      protocol::ChatterCommandHeader header{};
+      std::memcpy(&header.length, headerData.data(), sizeof(header.length));
+      std::memcpy(&header.commandId, headerData.data() + sizeof(header.length), sizeof(header.commandId));
+
+      commandId = header.commandId;
+      commandSize = header.length;
+    }
+
+    if (commandSize < sizeof(uint32_t))
+    {
+      spdlog::warn("Received a command with an invalid size {}", commandSize);
+      Close();
+      break;
+    }
+
+    // Wait for the rest of the command.
+    if (command.size() < commandSize)
+      break;
+
+    if (_protocol == Protocol::Chatter)
+    {
+      protocol::ApplyXorCode(
+        protocol::ChatterXorCode,
+        command.first(commandSize));
+    }
+
+    consumedSize += commandSize;
+    HandleCommand(
+      commandId,
+      command.subspan(sizeof(uint32_t), commandSize - sizeof(uint32_t)));
+  }
+
+  return consumedSize;
+}
+
+void Connection::HandleCommand(
+  uint16_t commandId,
+  std::span<const std::byte> data)
+{
+  _statistics.RecordReceived(_director, sizeof(uint32_t) + data.size());
+
+  // Complete the request the command responds to.
+  const auto pendingRequestIter = std::ranges::find_if(
+    _pendingRequests,
+    [commandId](const PendingRequest& pendingRequest)
+    {
+      return pendingRequest.responseId == commandId
+        || (pendingRequest.cancelId != 0 && pendingRequest.cancelId == commandId);
+    });
+
+  if (pendingRequestIter != _pendingRequests.cend())
+  {
+    if (pendingRequestIter->responseId == commandId)
+    {
+      _statistics.RecordLatency(
+        pendingRequestIter->name,
+        Clock::now() - pendingRequestIter->sentAt);
+    }
+    else
+    {
+      _statistics.RecordFailure(pendingRequestIter->name);
+    }
+
+    _pendingRequests.erase(pendingRequestIter);
+  }
+
+  const auto handlerIter = _handlers.find(commandId);
+  if (handlerIter == _handlers.cend())
+    return;
+
+  // Copy the handler, it may replace itself.
+  const auto handler = handlerIter->second;
+
+  SourceStream commandStream(data);
+  try
+  {
+    handler(commandStream);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::warn(
+      "Failed to handle command '{}': {}",
+      GetCommandName(commandId),
+      x.what());
+  }
+}
+
+} // namespace server::bot
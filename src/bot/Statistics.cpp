@@ -0,0 +1,162 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "bot/Statistics.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+
+namespace server::bot
+{
+
+namespace
+{
+
+//! Returns the percentile of sorted samples.
+//! @param samples Sorted samples.
+//! @param percentile Percentile in range [0, 100].
+//! @returns Value of the percentile.
+uint32_t GetPercentile(const std::vector<uint32_t>& samples, double percentile)
+{
+  if (samples.empty())
+    return 0;
+
+  const auto rank = static_cast<std::size_t>(
+    percentile / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+  return samples[std::min(rank, samples.size() - 1)];
+}
+
+//! Returns the name of a director.
+//! @param director Director.
+//! @returns Name of the director.
+const char* GetDirectorName(Statistics::Director director)
+{
+  switch (director)
+  {
+    case Statistics::Director::Lobby:
+      return "lobby";
+    case Statistics::Director::Ranch:
+      return "ranch";
+    case Statistics::Director::Race:
+      return "race";
+    case Statistics::Director::Messenger:
+      return "messenger";
+    default:
+      return "unknown";
+  }
+}
+
+} // anon namespace
+
+void Statistics::RecordLatency(std::string_view request, Clock::duration latency)
+{
+  const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+    latency).count();
+
+  std::scoped_lock lock(_latenciesMutex);
+  auto latenciesIter = _latencies.find(request);
+  if (latenciesIter == _latencies.cend())
+    latenciesIter = _latencies.try_emplace(std::string(request)).first;
+
+  latenciesIter->second.samples.emplace_back(static_cast<uint32_t>(
+    std::clamp<int64_t>(microseconds, 0, std::numeric_limits<uint32_t>::max())));
+}
+
+void Statistics::RecordFailure(std::string_view request)
+{
+  std::scoped_lock lock(_latenciesMutex);
+  auto latenciesIter = _latencies.find(request);
+  if (latenciesIter == _latencies.cend())
+    latenciesIter = _latencies.try_emplace(std::string(request)).first;
+
+  latenciesIter->second.failures++;
+}
+
+void Statistics::RecordSent(Director director, std::size_t size)
+{
+  auto& traffic = _traffic[static_cast<std::size_t>(director)];
+  traffic.sentCommands.fetch_add(1, std::memory_order::relaxed);
+  traffic.sentBytes.fetch_add(size, std::memory_order::relaxed);
+}
+
+void Statistics::RecordReceived(Director director, std::size_t size)
+{
+  auto& traffic = _traffic[static_cast<std::size_t>(director)];
+  traffic.receivedCommands.fetch_add(1, std::memory_order::relaxed);
+  traffic.receivedBytes.fetch_add(size, std::memory_order::relaxed);
+}
+
+void Statistics::PrintReport(Clock::duration elapsed)
+{
+  const double seconds = std::max(
+    std::chrono::duration<double>(elapsed).count(),
+    1e-3);
+
+  std::printf(
+    "%-36s %10s %8s %10s %10s %10s %10s\n",
+    "request",
+    "count",
+    "failed",
+    "p50 ms",
+    "p90 ms",
+    "p99 ms",
+    "max ms");
+
+  {
+    std::scoped_lock lock(_latenciesMutex);
+    for (auto& [request, latencies] : _latencies)
+    {
+      auto& samples = latencies.samples;
+      std::ranges::sort(samples);
+
+      std::printf(
+        "%-36s %10zu %8zu %10.2f %10.2f %10.2f %10.2f\n",
+        request.c_str(),
+        samples.size(),
+        latencies.failures,
+        GetPercentile(samples, 50.0) / 1000.0,
+        GetPercentile(samples, 90.0) / 1000.0,
+        GetPercentile(samples, 99.0) / 1000.0,
+        GetPercentile(samples, 100.0) / 1000.0);
+    }
+  }
+
+  std::printf(
+    "\n%-12s %14s %14s %14s %14s\n",
+    "director",
+    "sent cmd/s",
+    "sent KiB/s",
+    "recv cmd/s",
+    "recv KiB/s");
+
+  for (std::size_t directorIdx = 0; directorIdx < _traffic.size(); ++directorIdx)
+  {
+    const auto& traffic = _traffic[directorIdx];
+    std::printf(
+      "%-12s %14.1f %14.1f %14.1f %14.1f\n",
+      GetDirectorName(static_cast<Director>(directorIdx)),
+      traffic.sentCommands.load(std::memory_order::relaxed) / seconds,
+      traffic.sentBytes.load(std::memory_order::relaxed) / 1024.0 / seconds,
+      traffic.receivedCommands.load(std::memory_order::relaxed) / seconds,
+      traffic.receivedBytes.load(std::memory_order::relaxed) / 1024.0 / seconds);
+  }
+}
+
+} // namespace server::bot
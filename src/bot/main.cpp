@@ -0,0 +1,343 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "bot/Bot.hpp"
+#include "bot/Statistics.hpp"
+
+#include <boost/asio.hpp>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <array>
+#include <charconv>
+#include <csignal>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+namespace asio = boost::asio;
+using Clock = server::bot::Statistics::Clock;
+
+//! Options of the load generator.
+struct Options
+{
+  std::string host{"127.0.0.1"};
+  uint16_t port{10030};
+
+  uint32_t bots{100};
+  std::string prefix{"bot"};
+  std::string token{"bot"};
+
+  //! Weights of the behaviours.
+  std::array<uint32_t, 4> mix{10, 40, 30, 20};
+
+  std::chrono::seconds duration{60};
+  //! Count of the bots started per second.
+  uint32_t ramp{50};
+  uint32_t threads{std::max(1u, std::thread::hardware_concurrency())};
+  std::chrono::seconds raceDuration{30};
+
+  //! Data directory to register the users of the bots in, or empty.
+  std::filesystem::path registerPath{};
+};
+
+void PrintUsage()
+{
+  std::cout <<
+    "Usage: alicia-bot [options]\n"
+    "  --host <address>         Address of the lobby (127.0.0.1)\n"
+    "  --port <port>            Port of the lobby (10030)\n"
+    "  --bots <count>           Count of the bots (100)\n"
+    "  --prefix <prefix>        Prefix of the user names of the bots (bot)\n"
+    "  --token <token>          Token of the users of the bots (bot)\n"
+    "  --mix <mix>              Weights of the behaviours (idle=10,ranch=40,race=30,chat=20)\n"
+    "  --duration <seconds>     Duration of the run (60)\n"
+    "  --ramp <bots>            Count of the bots started per second (50)\n"
+    "  --threads <count>        Count of the IO threads (hardware concurrency)\n"
+    "  --race-duration <secs>   Duration of a race (30)\n"
+    "  --register <data path>   Registers the users of the bots in the data directory\n";
+}
+
+template <typename T>
+T ParseNumber(std::string_view value)
+{
+  T number{};
+  const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+  if (error != std::errc{} || end != value.data() + value.size())
+    throw std::invalid_argument(std::format("Invalid number '{}'", value));
+
+  return number;
+}
+
+//! Parses the behaviour mix in the format `behaviour=weight,...`.
+std::array<uint32_t, 4> ParseMix(std::string_view value)
+{
+  std::array<uint32_t, 4> mix{};
+  for (const auto entryRange : std::views::split(value, ','))
+  {
+    const std::string_view entry(entryRange.begin(), entryRange.end());
+    const auto separator = entry.find('=');
+    if (separator == std::string_view::npos)
+      throw std::invalid_argument(std::format("Invalid mix entry '{}'", entry));
+
+    const auto behaviour = entry.substr(0, separator);
+    const auto weight = ParseNumber<uint32_t>(entry.substr(separator + 1));
+
+    if (behaviour == "idle")
+      mix[static_cast<std::size_t>(server::bot::Bot::Behaviour::Idle)] = weight;
+    else if (behaviour == "ranch")
+      mix[static_cast<std::size_t>(server::bot::Bot::Behaviour::Ranch)] = weight;
+    else if (behaviour == "race")
+      mix[static_cast<std::size_t>(server::bot::Bot::Behaviour::Race)] = weight;
+    else if (behaviour == "chat")
+      mix[static_cast<std::size_t>(server::bot::Bot::Behaviour::Chat)] = weight;
+    else
+      throw std::invalid_argument(std::format("Unknown behaviour '{}'", behaviour));
+  }
+
+  if (std::ranges::all_of(mix, [](uint32_t weight){ return weight == 0; }))
+    throw std::invalid_argument("The mix has no behaviour");
+
+  return mix;
+}
+
+Options ParseOptions(int argc, char** argv)
+{
+  Options options;
+  for (int idx = 1; idx < argc; ++idx)
+  {
+    const std::string_view option = argv[idx];
+    if (option == "--help")
+    {
+      PrintUsage();
+      std::exit(0);
+    }
+
+    if (idx + 1 >= argc)
+      throw std::invalid_argument(std::format("Missing value of '{}'", option));
+    const std::string_view value = argv[++idx];
+
+    if (option == "--host")
+      options.host = value;
+    else if (option == "--port")
+      options.port = ParseNumber<uint16_t>(value);
+    else if (option == "--bots")
+      options.bots = ParseNumber<uint32_t>(value);
+    else if (option == "--prefix")
+      options.prefix = value;
+    else if (option == "--token")
+      options.token = value;
+    else if (option == "--mix")
+      options.mix = ParseMix(value);
+    else if (option == "--duration")
+      options.duration = std::chrono::seconds(ParseNumber<uint32_t>(value));
+    else if (option == "--ramp")
+      options.ramp = std::max(1u, ParseNumber<uint32_t>(value));
+    else if (option == "--threads")
+      options.threads = std::max(1u, ParseNumber<uint32_t>(value));
+    else if (option == "--race-duration")
+      options.raceDuration = std::chrono::seconds(ParseNumber<uint32_t>(value));
+    else if (option == "--register")
+      options.registerPath = value;
+    else
+      throw std::invalid_argument(std::format("Unknown option '{}'", option));
+  }
+
+  return options;
+}
+
+//! Returns the behaviour of a bot, the behaviours are spread evenly in the ratio of the mix.
+//! @param botIdx Index of the bot.
+//! @param mix Weights of the behaviours.
+//! @returns Behaviour of the bot.
+server::bot::Bot::Behaviour GetBehaviour(uint32_t botIdx, const std::array<uint32_t, 4>& mix)
+{
+  const uint32_t totalWeight = mix[0] + mix[1] + mix[2] + mix[3];
+  uint32_t slot = (botIdx * 7919u) % totalWeight;
+
+  for (std::size_t behaviourIdx = 0; behaviourIdx < mix.size(); ++behaviourIdx)
+  {
+    if (slot < mix[behaviourIdx])
+      return static_cast<server::bot::Bot::Behaviour>(behaviourIdx);
+    slot -= mix[behaviourIdx];
+  }
+
+  return server::bot::Bot::Behaviour::Idle;
+}
+
+//! Registers the users of the bots in the data directory of the file data source.
+//! Users which already exist are left intact.
+void RegisterUsers(const Options& options)
+{
+  const auto usersPath = options.registerPath / "users";
+  std::filesystem::create_directories(usersPath);
+
+  uint32_t registeredCount = 0;
+  for (uint32_t botIdx = 0; botIdx < options.bots; ++botIdx)
+  {
+    const std::string name = std::format("{}{}", options.prefix, botIdx);
+    const auto userPath = usersPath / (name + ".json");
+    if (std::filesystem::exists(userPath))
+      continue;
+
+    nlohmann::json json;
+    json["name"] = name;
+    json["token"] = options.token;
+    json["characterUid"] = 0;
+    json["infractions"] = nlohmann::json::array();
+
+    std::ofstream userFile(userPath);
+    if (not userFile.is_open())
+      throw std::runtime_error(std::format("User file '{}' not accessible", userPath.string()));
+
+    userFile << json.dump(2);
+    ++registeredCount;
+  }
+
+  spdlog::info("Registered {} users in '{}'", registeredCount, usersPath.string());
+}
+
+} // anon namespace
+
+int main(int argc, char** argv)
+{
+  Options options;
+  try
+  {
+    options = ParseOptions(argc, argv);
+  }
+  catch (const std::exception& x)
+  {
+    std::cerr << x.what() << "\n";
+    PrintUsage();
+    return 1;
+  }
+
+  if (not options.registerPath.empty())
+  {
+    try
+    {
+      RegisterUsers(options);
+    }
+    catch (const std::exception& x)
+    {
+      spdlog::error("Failed to register the users: {}", x.what());
+      return 1;
+    }
+  }
+
+  asio::io_context ioContext;
+  auto workGuard = asio::make_work_guard(ioContext);
+
+  // Stop the run early on an interrupt.
+  std::atomic_bool isInterrupted{false};
+  asio::signal_set signals(ioContext, SIGINT, SIGTERM);
+  signals.async_wait([&isInterrupted](const boost::system::error_code& error, int)
+  {
+    if (not error)
+      isInterrupted.store(true, std::memory_order::relaxed);
+  });
+
+  std::vector<std::thread> threads;
+  for (uint32_t threadIdx = 0; threadIdx < options.threads; ++threadIdx)
+  {
+    threads.emplace_back([&ioContext]()
+    {
+      ioContext.run();
+    });
+  }
+
+  const asio::ip::tcp::endpoint lobbyEndpoint(
+    asio::ip::make_address(options.host),
+    options.port);
+
+  server::bot::Statistics statistics;
+  std::vector<std::unique_ptr<server::bot::Bot>> bots;
+
+  spdlog::info(
+    "Starting {} bots against {}:{} for {}s",
+    options.bots,
+    options.host,
+    options.port,
+    options.duration.count());
+
+  const auto startTime = Clock::now();
+  const auto endTime = startTime + options.duration;
+
+  // Ramp up the bots at the configured rate.
+  const auto rampInterval = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::seconds(1)) / options.ramp;
+  auto nextStart = startTime;
+
+  for (uint32_t botIdx = 0; botIdx < options.bots; ++botIdx)
+  {
+    if (isInterrupted.load(std::memory_order::relaxed) || Clock::now() >= endTime)
+      break;
+
+    std::this_thread::sleep_until(nextStart);
+    nextStart += rampInterval;
+
+    auto& bot = bots.emplace_back(std::make_unique<server::bot::Bot>(
+      ioContext,
+      server::bot::Bot::Config{
+        .lobby = lobbyEndpoint,
+        .name = std::format("{}{}", options.prefix, botIdx),
+        .token = options.token,
+        .behaviour = GetBehaviour(botIdx, options.mix),
+        .raceDuration = options.raceDuration},
+      statistics));
+    bot->Start();
+  }
+
+  while (not isInterrupted.load(std::memory_order::relaxed) && Clock::now() < endTime)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  for (auto& bot : bots)
+  {
+    bot->Stop();
+  }
+
+  const auto elapsed = Clock::now() - startTime;
+
+  // Let the bots close their connections and then stop the IO threads.
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  workGuard.reset();
+  signals.cancel();
+  ioContext.stop();
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  statistics.PrintReport(elapsed);
+  return 0;
+}
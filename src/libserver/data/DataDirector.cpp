@@ -19,6 +19,7 @@
 
 #include "libserver/data/DataDirector.hpp"
 #include "libserver/util/Deferred.hpp"
+#include "libserver/util/Trace.hpp"
 
 #include <spdlog/spdlog.h>
 
@@ -469,6 +470,96 @@ DataDirector::DataDirector(const std::filesystem::path& basePath)
         }
         return false;
       })
+  , _leaderboardStorage(
+      [&](const auto& key, auto& leaderboard)
+      {
+        try
+        {
+          _primaryDataSource->RetrieveLeaderboard(key, leaderboard);
+          return true;
+        }
+        catch (const std::exception& x)
+        {
+          spdlog::error(
+            "Exception retrieving leaderboard {} from the primary data source: {}", key, x.what());
+        }
+
+        return false;
+      },
+      [&](const auto& key, auto& leaderboard)
+      {
+        try
+        {
+          _primaryDataSource->StoreLeaderboard(key, leaderboard);
+          return true;
+        }
+        catch (const std::exception& x)
+        {
+          spdlog::error(
+            "Exception storing leaderboard {} on the primary data source: {}", key, x.what());
+        }
+
+        return false;
+      },
+      [&](const auto& key)
+      {
+        try
+        {
+          _primaryDataSource->DeleteLeaderboard(key);
+          return true;
+        }
+        catch (const std::exception& x)
+        {
+          spdlog::error(
+            "Exception deleting leaderboard {} from the primary data source: {}", key, x.what());
+        }
+        return false;
+      })
+  , _breedingMarketStorage(
+      [&](const auto& key, auto& breedingMarket)
+      {
+        try
+        {
+          _primaryDataSource->RetrieveBreedingMarket(key, breedingMarket);
+          return true;
+        }
+        catch (const std::exception& x)
+        {
+          spdlog::error(
+            "Exception retrieving breeding market {} from the primary data source: {}", key, x.what());
+        }
+
+        return false;
+      },
+      [&](const auto& key, auto& breedingMarket)
+      {
+        try
+        {
+          _primaryDataSource->StoreBreedingMarket(key, breedingMarket);
+          return true;
+        }
+        catch (const std::exception& x)
+        {
+          spdlog::error(
+            "Exception storing breeding market {} on the primary data source: {}", key, x.what());
+        }
+
+        return false;
+      },
+      [&](const auto& key)
+      {
+        try
+        {
+          _primaryDataSource->DeleteBreedingMarket(key);
+          return true;
+        }
+        catch (const std::exception& x)
+        {
+          spdlog::error(
+            "Exception deleting breeding market {} from the primary data source: {}", key, x.what());
+        }
+        return false;
+      })
 {
   _primaryDataSource = std::make_unique<FileDataSource>();
   _primaryDataSource->Initialize(basePath);
@@ -496,6 +587,8 @@ void DataDirector::Terminate()
     _petStorage.Terminate();
     _guildStorage.Terminate();
     _housingStorage.Terminate();
+    _leaderboardStorage.Terminate();
+    _breedingMarketStorage.Terminate();
   }
   catch (const std::exception& x)
   {
@@ -505,6 +598,11 @@ void DataDirector::Terminate()
   _primaryDataSource->Terminate();
 }
 
+void DataDirector::QueueTask(const Scheduler::Task& task)
+{
+  _scheduler.Queue(task);
+}
+
 void DataDirector::Tick()
 {
   try
@@ -519,6 +617,8 @@ void DataDirector::Tick()
     _petStorage.Tick();
     _guildStorage.Tick();
     _housingStorage.Tick();
+    _leaderboardStorage.Tick();
+    _breedingMarketStorage.Tick();
   }
   catch (const std::exception& x)
   {
@@ -799,6 +899,8 @@ void DataDirector::ScheduleUserLoad(
 {
   _scheduler.Queue([this, &userDataContext, userName]()
   {
+    const trace::Span traceSpan("DataDirector::UserLoad");
+
     const Deferred deferred([this, &userDataContext, userName]()
     {
       // If the user is completely loaded we can return.
@@ -869,12 +971,24 @@ DataDirector::GuildStorage& DataDirector::GetGuildCache()
   return _guildStorage;
 }
 
+DataDirector::LeaderboardStorage& DataDirector::GetLeaderboardCache()
+{
+  return _leaderboardStorage;
+}
+
+DataDirector::BreedingMarketStorage& DataDirector::GetBreedingMarketCache()
+{
+  return _breedingMarketStorage;
+}
+
 void DataDirector::ScheduleCharacterLoad(
   UserDataContext& userDataContext,
   data::Uid characterUid)
 {
   _scheduler.Queue([this, &userDataContext, characterUid]()
   {
+    const trace::Span traceSpan("DataDirector::CharacterLoad");
+
     const Deferred deferred([this, &userDataContext, characterUid]()
     {
       // If the character is completely loaded we can return.
@@ -63,6 +63,8 @@ void server::FileDataSource::Initialize(const std::filesystem::path& path)
   _petDataPath = prepareDataPath("pets");
   _housingDataPath = prepareDataPath("housing");
   _guildDataPath = prepareDataPath("guilds");
+  _leaderboardDataPath = prepareDataPath("leaderboards");
+  _breedingMarketDataPath = prepareDataPath("breeding");
 
   // Read the meta-data file and parse the sequential UIDs.
   const std::filesystem::path metaFilePath = ProduceDataPath(
@@ -886,3 +888,143 @@ void server::FileDataSource::DeleteGuild(data::Uid uid)
     _guildDataPath, std::format("{}", uid));
   std::filesystem::remove(dataFilePath);
 }
+
+void server::FileDataSource::RetrieveLeaderboard(data::Uid uid, data::Leaderboard& leaderboard)
+{
+  const std::filesystem::path dataFilePath = ProduceDataPath(
+    _leaderboardDataPath, std::format("{}", uid));
+
+  // Leaderboards are created on their first retrieval.
+  leaderboard.uid = uid;
+  if (not std::filesystem::exists(dataFilePath))
+    return;
+
+  std::ifstream dataFile(dataFilePath);
+  if (not dataFile.is_open())
+  {
+    throw std::runtime_error(
+      std::format("Leaderboard file '{}' not accessible", dataFilePath.string()));
+  }
+
+  const auto json = nlohmann::json::parse(dataFile);
+
+  std::vector<data::Leaderboard::Entry> entries;
+  for (const auto& entryJson : json["entries"])
+  {
+    entries.emplace_back(data::Leaderboard::Entry{
+      .characterUid = entryJson["characterUid"].get<data::Uid>(),
+      .score = entryJson["score"].get<uint32_t>()});
+  }
+
+  leaderboard.entries = std::move(entries);
+}
+
+void server::FileDataSource::StoreLeaderboard(data::Uid uid, const data::Leaderboard& leaderboard)
+{
+  const std::filesystem::path dataFilePath = ProduceDataPath(
+    _leaderboardDataPath, std::format("{}", uid));
+
+  std::ofstream dataFile(dataFilePath);
+  if (not dataFile.is_open())
+  {
+    throw std::runtime_error(
+      std::format("Leaderboard file '{}' not accessible", dataFilePath.string()));
+  }
+
+  nlohmann::json json;
+  json["uid"] = leaderboard.uid();
+
+  auto entries = nlohmann::json::array();
+  for (const auto& entry : leaderboard.entries())
+  {
+    nlohmann::json entryJson;
+    entryJson["characterUid"] = entry.characterUid;
+    entryJson["score"] = entry.score;
+    entries.push_back(std::move(entryJson));
+  }
+  json["entries"] = std::move(entries);
+
+  dataFile << json.dump(2);
+}
+
+void server::FileDataSource::DeleteLeaderboard(data::Uid uid)
+{
+  const std::filesystem::path dataFilePath = ProduceDataPath(
+    _leaderboardDataPath, std::format("{}", uid));
+  std::filesystem::remove(dataFilePath);
+}
+
+void server::FileDataSource::RetrieveBreedingMarket(
+  data::Uid uid,
+  data::BreedingMarket& breedingMarket)
+{
+  const std::filesystem::path dataFilePath = ProduceDataPath(
+    _breedingMarketDataPath, std::format("{}", uid));
+
+  // Breeding markets are created on their first retrieval.
+  breedingMarket.uid = uid;
+  if (not std::filesystem::exists(dataFilePath))
+    return;
+
+  std::ifstream dataFile(dataFilePath);
+  if (not dataFile.is_open())
+  {
+    throw std::runtime_error(
+      std::format("Breeding market file '{}' not accessible", dataFilePath.string()));
+  }
+
+  const auto json = nlohmann::json::parse(dataFile);
+
+  std::vector<data::BreedingMarket::Listing> listings;
+  for (const auto& listingJson : json["listings"])
+  {
+    listings.emplace_back(data::BreedingMarket::Listing{
+      .horseUid = listingJson["horseUid"].get<data::Uid>(),
+      .ownerUid = listingJson["ownerUid"].get<data::Uid>(),
+      .matePrice = listingJson["matePrice"].get<uint32_t>(),
+      .expiresAt = data::Clock::time_point(
+        std::chrono::seconds(listingJson["expiresAt"].get<uint64_t>()))});
+  }
+
+  breedingMarket.listings = std::move(listings);
+}
+
+void server::FileDataSource::StoreBreedingMarket(
+  data::Uid uid,
+  const data::BreedingMarket& breedingMarket)
+{
+  const std::filesystem::path dataFilePath = ProduceDataPath(
+    _breedingMarketDataPath, std::format("{}", uid));
+
+  std::ofstream dataFile(dataFilePath);
+  if (not dataFile.is_open())
+  {
+    throw std::runtime_error(
+      std::format("Breeding market file '{}' not accessible", dataFilePath.string()));
+  }
+
+  nlohmann::json json;
+  json["uid"] = breedingMarket.uid();
+
+  auto listings = nlohmann::json::array();
+  for (const auto& listing : breedingMarket.listings())
+  {
+    nlohmann::json listingJson;
+    listingJson["horseUid"] = listing.horseUid;
+    listingJson["ownerUid"] = listing.ownerUid;
+    listingJson["matePrice"] = listing.matePrice;
+    listingJson["expiresAt"] = std::chrono::duration_cast<std::chrono::seconds>(
+      listing.expiresAt.time_since_epoch()).count();
+    listings.push_back(std::move(listingJson));
+  }
+  json["listings"] = std::move(listings);
+
+  dataFile << json.dump(2);
+}
+
+void server::FileDataSource::DeleteBreedingMarket(data::Uid uid)
+{
+  const std::filesystem::path dataFilePath = ProduceDataPath(
+    _breedingMarketDataPath, std::format("{}", uid));
+  std::filesystem::remove(dataFilePath);
+}
@@ -20,6 +20,7 @@
 #include "libserver/network/Server.hpp"
 
 #include "libserver/util/Deferred.hpp"
+#include "libserver/util/Metrics.hpp"
 
 #include <ranges>
 #include <spdlog/spdlog.h>
@@ -27,7 +28,48 @@
 namespace server::network
 {
 
-Client::Client(
+namespace
+{
+
+//! Metrics of a transport.
+struct TransportMetrics
+{
+  explicit TransportMetrics(std::string_view transport)
+    : receivedBytes(metrics::GetRegistry().GetCounter(
+        "alicia_network_received_bytes_total",
+        "Count of the bytes received from the clients.",
+        {{"transport", transport}}))
+    , sentBytes(metrics::GetRegistry().GetCounter(
+        "alicia_network_sent_bytes_total",
+        "Count of the bytes sent to the clients.",
+        {{"transport", transport}}))
+    , clients(metrics::GetRegistry().GetGauge(
+        "alicia_network_clients",
+        "Count of the connected clients.",
+        {{"transport", transport}}))
+  {
+  }
+
+  metrics::Counter& receivedBytes;
+  metrics::Counter& sentBytes;
+  metrics::Gauge& clients;
+};
+
+TransportMetrics& GetTcpMetrics()
+{
+  static TransportMetrics tcpMetrics("tcp");
+  return tcpMetrics;
+}
+
+TransportMetrics& GetLoopbackMetrics()
+{
+  static TransportMetrics loopbackMetrics("loopback");
+  return loopbackMetrics;
+}
+
+} // anon namespace
+
+TcpClient::TcpClient(
   ClientId clientId,
   asio::ip::tcp::socket&& socket,
   EventHandlerInterface& networkEventHandler) noexcept
@@ -37,17 +79,18 @@ Client::Client(
 {
 }
 
-void Client::Begin()
+void TcpClient::Begin()
 {
   if (_shouldRun.exchange(true, std::memory_order::acq_rel))
     return;
 
+  GetTcpMetrics().clients.Increment();
   _networkEventHandler.OnClientConnected(_clientId);
 
   ReadLoop();
 }
 
-void Client::End()
+void TcpClient::End()
 {
   if (not _shouldRun.exchange(false, std::memory_order::seq_cst))
     return;
@@ -65,10 +108,11 @@ void Client::End()
     spdlog::error("Exception ending client: {}", x.what());
   }
 
+  GetTcpMetrics().clients.Decrement();
   _networkEventHandler.OnClientDisconnected(_clientId);
 }
 
-void Client::QueueWrite(WriteSupplier writeSupplier)
+void TcpClient::QueueWrite(WriteSupplier writeSupplier)
 {
   if (not _shouldRun.load(std::memory_order::acquire))
     return;
@@ -81,7 +125,12 @@ void Client::QueueWrite(WriteSupplier writeSupplier)
   WriteLoop();
 }
 
-void Client::WriteLoop() noexcept
+asio::ip::address TcpClient::GetAddress() const
+{
+  return _socket.remote_endpoint().address();
+}
+
+void TcpClient::WriteLoop() noexcept
 {
   // todo: forgive me for this, its not clean, its not pretty and i'm pretty sure there some side effects
   //       i'll nuke it in the future
@@ -111,7 +160,7 @@ void Client::WriteLoop() noexcept
   // Asynchronously write the data to the socket.
   _socket.async_write_some(
     _writeBuffer.data(),
-    [clientPtr = this->shared_from_this()](const boost::system::error_code& error, const std::size_t size)
+    [clientPtr = std::static_pointer_cast<TcpClient>(shared_from_this())](const boost::system::error_code& error, const std::size_t size)
     {
       try
       {
@@ -134,6 +183,8 @@ void Client::WriteLoop() noexcept
           std::scoped_lock lock(clientPtr->_writeMutex);
           clientPtr->_writeBuffer.consume(size);
         }
+
+        GetTcpMetrics().sentBytes.Increment(size);
       }
       catch (const std::exception& x)
       {
@@ -150,14 +201,14 @@ void Client::WriteLoop() noexcept
     });
 }
 
-void Client::ReadLoop() noexcept
+void TcpClient::ReadLoop() noexcept
 {
   if (not _shouldRun.load(std::memory_order::acquire))
     return;
 
   _socket.async_read_some(
     _readBuffer.prepare(1024),
-    [clientPtr = this->shared_from_this()](boost::system::error_code error, std::size_t size)
+    [clientPtr = std::static_pointer_cast<TcpClient>(shared_from_this())](boost::system::error_code error, std::size_t size)
     {
       try
       {
@@ -177,6 +228,7 @@ void Client::ReadLoop() noexcept
         }
 
         clientPtr->_readBuffer.commit(size);
+        GetTcpMetrics().receivedBytes.Increment(size);
 
         const std::span receivedData{
           static_cast<const std::byte*>(clientPtr->_readBuffer.data().data()),
@@ -203,6 +255,116 @@ void Client::ReadLoop() noexcept
     });
 }
 
+LoopbackClient::LoopbackClient(
+  ClientId clientId,
+  EventHandlerInterface& networkEventHandler) noexcept
+  : _clientId(clientId)
+  , _networkEventHandler(networkEventHandler)
+{
+}
+
+void LoopbackClient::Begin()
+{
+  if (_isConnected.exchange(true, std::memory_order::acq_rel))
+    return;
+
+  GetLoopbackMetrics().clients.Increment();
+  _networkEventHandler.OnClientConnected(_clientId);
+}
+
+void LoopbackClient::End()
+{
+  if (not _isConnected.exchange(false, std::memory_order::seq_cst))
+    return;
+
+  GetLoopbackMetrics().clients.Decrement();
+  _networkEventHandler.OnClientDisconnected(_clientId);
+}
+
+void LoopbackClient::QueueWrite(WriteSupplier writeSupplier)
+{
+  if (not _isConnected.load(std::memory_order::acquire))
+    return;
+
+  _writeQueue.Push(std::move(writeSupplier));
+}
+
+asio::ip::address LoopbackClient::GetAddress() const
+{
+  return asio::ip::address_v4::loopback();
+}
+
+void LoopbackClient::Send(std::span<const std::byte> data)
+{
+  if (not _isConnected.load(std::memory_order::acquire))
+    return;
+
+  GetLoopbackMetrics().receivedBytes.Increment(data.size());
+
+  // Pass the data directly if there are no data left over from the previous send.
+  std::span<const std::byte> receivedData = data;
+  if (not _sendBuffer.empty())
+  {
+    _sendBuffer.insert(_sendBuffer.end(), data.begin(), data.end());
+    receivedData = _sendBuffer;
+  }
+
+  std::size_t consumedBytes = 0;
+  try
+  {
+    consumedBytes = _networkEventHandler.OnClientData(
+      _clientId,
+      receivedData);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error(
+      "Exception handling the data of loopback client {}: {}",
+      _clientId,
+      x.what());
+
+    End();
+    return;
+  }
+
+  if (_sendBuffer.empty())
+  {
+    _sendBuffer.assign(data.begin() + consumedBytes, data.end());
+  }
+  else
+  {
+    _sendBuffer.erase(_sendBuffer.begin(), _sendBuffer.begin() + consumedBytes);
+  }
+}
+
+std::span<const std::byte> LoopbackClient::Receive()
+{
+  // Consume the data received the last time.
+  _receiveBuffer.consume(_receiveBuffer.size());
+
+  WriteSupplier writeSupplier;
+  while (_writeQueue.Pop(writeSupplier))
+  {
+    writeSupplier(_receiveBuffer);
+  }
+
+  GetLoopbackMetrics().sentBytes.Increment(_receiveBuffer.size());
+
+  return {
+    static_cast<const std::byte*>(_receiveBuffer.data().data()),
+    _receiveBuffer.data().size()};
+}
+
+ClientId LoopbackClient::GetId() const
+{
+  return _clientId;
+}
+
+bool LoopbackClient::IsConnected() const
+{
+  return _isConnected.load(std::memory_order::acquire);
+}
+
 Server::Server(EventHandlerInterface& networkEventHandler) noexcept
   : _acceptor(_io_ctx)
   , _networkEventHandler(networkEventHandler)
@@ -242,8 +404,24 @@ void Server::End()
   _io_ctx.stop();
 }
 
+std::shared_ptr<LoopbackClient> Server::ConnectLoopback()
+{
+  const auto client = std::make_shared<LoopbackClient>(
+    _client_id++,
+    *this);
+
+  {
+    std::scoped_lock lock(_clientsMutex);
+    _clients.try_emplace(client->GetId(), client);
+  }
+
+  client->Begin();
+  return client;
+}
+
 std::shared_ptr<Client> Server::GetClient(ClientId clientId)
 {
+  std::scoped_lock lock(_clientsMutex);
   const auto clientItr = _clients.find(clientId);
   if (clientItr == _clients.end())
   {
@@ -263,6 +441,8 @@ void Server::OnClientDisconnected(
   ClientId clientId)
 {
   _networkEventHandler.OnClientDisconnected(clientId);
+
+  std::scoped_lock lock(_clientsMutex);
   _clients.erase(clientId);
 }
 
@@ -290,16 +470,21 @@ void Server::AcceptLoop() noexcept
         const ClientId clientId = _client_id++;
 
         // Create the client.
-        const auto [itr, emplaced] = _clients.try_emplace(
-          clientId,
-          std::make_shared<Client>(clientId,
-            std::move(client_socket),
-            *this));
+        const auto client = std::make_shared<TcpClient>(clientId,
+          std::move(client_socket),
+          *this);
 
-        // Id is sequential so emplacement should never fail.
-        assert(emplaced);
+        {
+          std::scoped_lock lock(_clientsMutex);
+          const auto [itr, emplaced] = _clients.try_emplace(
+            clientId,
+            client);
+
+          // Id is sequential so emplacement should never fail.
+          assert(emplaced);
+        }
 
-        itr->second->Begin();
+        client->Begin();
 
         // Continue the accept loop.
         AcceptLoop();
@@ -82,18 +82,11 @@ size_t ChatterServer::OnClientData(
 {
   SourceStream commandStream{data};
 
-  // The base XOR scrambling constant, which seems to not roll.
-  constexpr std::array XorCode{
-    static_cast<std::byte>(0x2B),
-    static_cast<std::byte>(0xFE),
-    static_cast<std::byte>(0xB8),
-    static_cast<std::byte>(0x02)};
-
   protocol::ChatterCommandHeader header;
   commandStream.Read(header.length)
     .Read(header.commandId);
-  header.length ^= *reinterpret_cast<const uint16_t*>(XorCode.data());
-  header.commandId ^= *reinterpret_cast<const uint16_t*>(XorCode.data() + 2);
+  header.length ^= *reinterpret_cast<const uint16_t*>(protocol::ChatterXorCode.data());
+  header.commandId ^= *reinterpret_cast<const uint16_t*>(protocol::ChatterXorCode.data() + 2);
 
   if (header.commandId == static_cast<uint16_t>(
     protocol::ChatterCommand::ChatCmdLogin))
@@ -105,7 +98,7 @@ size_t ChatterServer::OnClientData(
     {
       std::byte& val = commandData[idx];
       commandStream.Read(val);
-      val ^= XorCode[(commandStream.GetCursor() - 1) % 4];
+      val ^= protocol::ChatterXorCode[(commandStream.GetCursor() - 1) % 4];
     }
 
     SourceStream commandDataSource({commandData.begin(), commandData.end()});
@@ -25,7 +25,10 @@ void server::protocol::ChatCmdLogin::Write(
   const ChatCmdLogin& command,
   server::SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented");
+  stream.Write(command.val0)
+    .Write(command.name)
+    .Write(command.code)
+    .Write(command.val1);
 }
 
 void server::protocol::ChatCmdLogin::Read(
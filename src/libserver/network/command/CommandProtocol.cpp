@@ -19,6 +19,7 @@
 
 #include "libserver/network/command/CommandProtocol.hpp"
 
+#include <cstring>
 #include <unordered_map>
 
 namespace server::protocol
@@ -707,6 +708,27 @@ uint32_t encode_message_magic(MessageMagic magic)
   return encoded;
 }
 
+void ApplyXorCode(const XorCode& code, std::span<std::byte> data)
+{
+  uint32_t codeWord;
+  std::memcpy(&codeWord, code.data(), sizeof(codeWord));
+
+  // XOR the whole words of the data, the code repeats every word.
+  std::size_t offset = 0;
+  for (; offset + sizeof(codeWord) <= data.size(); offset += sizeof(codeWord))
+  {
+    uint32_t dataWord;
+    std::memcpy(&dataWord, data.data() + offset, sizeof(dataWord));
+    dataWord ^= codeWord;
+    std::memcpy(data.data() + offset, &dataWord, sizeof(dataWord));
+  }
+
+  for (; offset < data.size(); ++offset)
+  {
+    data[offset] ^= code[offset % code.size()];
+  }
+}
+
 std::string_view GetCommandName(Command command)
 {
   const auto commandIter = commands.find(command);
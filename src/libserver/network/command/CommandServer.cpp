@@ -20,6 +20,7 @@
 #include "libserver/network/command/CommandServer.hpp"
 
 #include "libserver/util/Deferred.hpp"
+#include "libserver/util/Metrics.hpp"
 #include "libserver/util/Util.hpp"
 
 #include <ranges>
@@ -39,47 +40,108 @@ constexpr std::size_t MaxCommandDataSize = 4092;
 //! That is command data size + size of the message magic.
 constexpr std::size_t MaxCommandSize = MaxCommandDataSize + sizeof(protocol::MessageMagic);
 
-//! Reads every specified byte of the source stream,
-//! performs XOR operation on that byte with the specified sliding key
-//! and writes the result to the sink stream.
-//!
-//! @param key Xor Key
-//! @param source Source stream.
-//! @param sink Sink stream.
-void XorAlgorithm(
-  const protocol::XorCode& key,
-  SourceStream& source,
-  SinkStream& sink)
-{
-  for (std::size_t idx = 0; idx < source.Size(); idx++)
+//! Commands which are not logged, as they are sent or received too frequently.
+constexpr std::array MutedCommands{
+  protocol::Command::AcCmdCLHeartbeat,
+  protocol::Command::AcCmdCLRoomList,
+  protocol::Command::AcCmdCLRoomListOK,
+  protocol::Command::AcCmdCRHeartbeat,
+  protocol::Command::AcCmdCRRanchSnapshot,
+  protocol::Command::AcCmdCRRanchSnapshotNotify,
+  protocol::Command::AcCmdUserRaceUpdatePos,
+  protocol::Command::AcCmdCRRelay,
+  protocol::Command::AcCmdCRRelayNotify,
+  protocol::Command::AcCmdCRRelayCommand,
+  protocol::Command::AcCmdCRRelayCommandNotify,
+  protocol::Command::AcCmdUserRaceActivateEvent};
+
+//! A table of the muted commands indexed by the command ID.
+constexpr auto MutedCommandTable = []()
+{
+  std::array<bool, static_cast<std::size_t>(protocol::Command::Count) + 1> table{};
+  for (const auto command : MutedCommands)
   {
-    const auto shift = idx % 4;
-
-    // Read a byte.
-    std::byte v;
-    source.Read(v);
-
-    // Xor it with the key.
-    sink.Write(v ^ key[shift]);
+    table[static_cast<std::size_t>(command)] = true;
   }
-}
+
+  return table;
+}();
 
 bool IsMuted(protocol::Command id)
 {
-  return id == protocol::Command::AcCmdCLHeartbeat
-    || id == protocol::Command::AcCmdCLRoomList
-    || id == protocol::Command::AcCmdCLRoomListOK
-    || id == protocol::Command::AcCmdCRHeartbeat
-    || id == protocol::Command::AcCmdCRRanchSnapshot
-    || id == protocol::Command::AcCmdCRRanchSnapshotNotify
-    || id == protocol::Command::AcCmdUserRaceUpdatePos
-    || id == protocol::Command::AcCmdCRRelay
-    || id == protocol::Command::AcCmdCRRelayNotify
-    || id == protocol::Command::AcCmdCRRelayCommand
-    || id == protocol::Command::AcCmdCRRelayCommandNotify
-    || id == protocol::Command::AcCmdUserRaceActivateEvent;
+  const auto idx = static_cast<std::size_t>(id);
+  return idx < MutedCommandTable.size() && MutedCommandTable[idx];
 }
 
+//! A table of metrics labeled by the command, registered on the first use of a command.
+template <typename Metric>
+class CommandMetricTable
+{
+public:
+  //! Constructor.
+  //! @param name Name of the metrics.
+  //! @param help Description of the metrics.
+  CommandMetricTable(std::string_view name, std::string_view help)
+    : _name(name)
+    , _help(help)
+  {
+  }
+
+  //! Returns the metric of a command.
+  //! @param commandId ID of the command.
+  //! @returns Metric of the command.
+  Metric& Get(protocol::Command commandId)
+  {
+    auto& metricSlot = _metrics[static_cast<std::size_t>(commandId)];
+
+    auto metric = metricSlot.load(std::memory_order::acquire);
+    if (metric == nullptr)
+    {
+      // The registry returns the same metric to the threads racing for the registration.
+      metric = &RegisterMetric(commandId);
+      metricSlot.store(metric, std::memory_order::release);
+    }
+
+    return *metric;
+  }
+
+private:
+  Metric& RegisterMetric(protocol::Command commandId)
+  {
+    auto& registry = metrics::GetRegistry();
+    const metrics::Labels labels{{"command", GetCommandName(commandId)}};
+
+    if constexpr (std::is_same_v<Metric, metrics::Counter>)
+      return registry.GetCounter(_name, _help, labels);
+    else
+      return registry.GetHistogram(_name, _help, labels);
+  }
+
+  std::string_view _name;
+  std::string_view _help;
+  std::array<std::atomic<Metric*>, static_cast<std::size_t>(protocol::Command::Count) + 1> _metrics{};
+};
+
+//! Counters of the commands received from the clients.
+CommandMetricTable<metrics::Counter> ReceivedCommandCounters(
+  "alicia_commands_received_total",
+  "Count of the commands received from the clients.");
+
+//! Counters of the commands sent to the clients.
+CommandMetricTable<metrics::Counter> SentCommandCounters(
+  "alicia_commands_sent_total",
+  "Count of the commands sent to the clients.");
+
+//! Histograms of the durations of the command handlers.
+CommandMetricTable<metrics::Histogram> HandlerHistograms(
+  "alicia_command_handler_seconds",
+  "Duration of the handlers of the commands received from the clients.");
+
+//! Histograms of the durations of the command suppliers.
+CommandMetricTable<metrics::Histogram> SupplierHistograms(
+  "alicia_command_supplier_seconds",
+  "Duration of the suppliers writing the commands sent to the clients.");
+
 } // namespace
 
 void CommandClient::SetCode(protocol::XorCode code)
@@ -106,6 +168,41 @@ int32_t CommandClient::GetRollingCodeInt() const
   return *reinterpret_cast<const int32_t*>(_rollingCode.data());
 }
 
+bool CommandClient::ConflateCommands(
+  protocol::Command commandId,
+  std::span<const SenderCommandSupplier> suppliers)
+{
+  const auto [commandsIter, inserted] = _conflatedCommands.try_emplace(commandId);
+  for (const auto& [senderKey, supplier] : suppliers)
+  {
+    commandsIter->second.insert_or_assign(senderKey, supplier);
+  }
+
+  return not inserted;
+}
+
+std::vector<CommandSupplier> CommandClient::TakeConflatedCommands(protocol::Command commandId)
+{
+  const auto commandsIter = _conflatedCommands.find(commandId);
+  if (commandsIter == _conflatedCommands.cend())
+    return {};
+
+  std::vector<CommandSupplier> suppliers;
+  suppliers.reserve(commandsIter->second.size());
+  for (auto& supplier : commandsIter->second | std::views::values)
+  {
+    suppliers.emplace_back(std::move(supplier));
+  }
+
+  _conflatedCommands.erase(commandsIter);
+  return suppliers;
+}
+
+void CommandClient::ClearConflatedCommands()
+{
+  _conflatedCommands.clear();
+}
+
 CommandServer::CommandServer(
   EventHandlerInterface& networkEventHandler)
   : _eventHandler(networkEventHandler)
@@ -123,6 +220,7 @@ void CommandServer::BeginHost(const asio::ip::address& address, uint16_t port)
   _serverThread = std::thread(
     [this, address, port]()
     {
+      trace::SetThreadName(std::format("network {}", port));
       _server.Begin(address, port);
     });
 }
@@ -141,11 +239,115 @@ void CommandServer::DisconnectClient(ClientId clientId)
   _server.GetClient(clientId)->End();
 }
 
+std::shared_ptr<network::LoopbackClient> CommandServer::ConnectLoopback()
+{
+  return _server.ConnectLoopback();
+}
+
+asio::ip::address CommandServer::GetClientAddress(ClientId clientId)
+{
+  return _server.GetClient(clientId)->GetAddress();
+}
+
+void CommandServer::SetCommandRouter(CommandRouter router)
+{
+  _commandRouter = std::move(router);
+}
+
+void CommandServer::BeginCapture(const std::filesystem::path& path)
+{
+  std::unique_ptr<CommandTraceWriter> captureWriter;
+  try
+  {
+    captureWriter = std::make_unique<CommandTraceWriter>(path);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error("Failed to begin the command capture: {}", x.what());
+    return;
+  }
+
+  std::scoped_lock lock(_captureMutex);
+  _captureWriter = std::move(captureWriter);
+  _isCapturing.store(true, std::memory_order::relaxed);
+
+  spdlog::info("Capturing the received commands to '{}'", path.string());
+}
+
+void CommandServer::EndCapture()
+{
+  std::scoped_lock lock(_captureMutex);
+  _isCapturing.store(false, std::memory_order::relaxed);
+  _captureWriter.reset();
+}
+
+void CommandServer::CaptureState(uint16_t stateId, std::span<const std::byte> data)
+{
+  if (not _isCapturing.load(std::memory_order::relaxed))
+    return;
+
+  std::scoped_lock lock(_captureMutex);
+  if (_captureWriter)
+    _captureWriter->RecordState(stateId, data);
+}
+
 void CommandServer::SetCode(ClientId client, protocol::XorCode code)
 {
+  std::scoped_lock lock(_clientsMutex);
   _clients[client].SetCode(code);
 }
 
+void CommandServer::SetSlowCommandThreshold(std::chrono::microseconds threshold)
+{
+  _slowCommandThreshold = threshold;
+}
+
+void CommandServer::ProfileHandler(
+  protocol::Command commandId,
+  ClientId clientId,
+  Clock::duration duration)
+{
+  HandlerHistograms.Get(commandId).Observe(duration);
+
+  if (_slowCommandThreshold == std::chrono::microseconds::zero()
+    || duration < _slowCommandThreshold)
+  {
+    return;
+  }
+
+  spdlog::warn(
+    "Slow handler of command '{}' (0x{:x}) received from client {} took {}us",
+    GetCommandName(commandId),
+    static_cast<uint16_t>(commandId),
+    clientId,
+    std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void CommandServer::ProfileSupplier(
+  protocol::Command commandId,
+  std::span<const ClientId> clientIds,
+  Clock::duration duration)
+{
+  SupplierHistograms.Get(commandId).Observe(duration);
+
+  if (_slowCommandThreshold == std::chrono::microseconds::zero()
+    || duration < _slowCommandThreshold
+    || clientIds.empty())
+  {
+    return;
+  }
+
+  spdlog::warn(
+    "Slow supplier of command '{}' (0x{:x}) sent to client {}{} took {}us",
+    GetCommandName(commandId),
+    static_cast<uint16_t>(commandId),
+    clientIds.front(),
+    clientIds.size() > 1
+      ? std::format(" and {} other clients", clientIds.size() - 1)
+      : std::string(),
+    std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
 CommandServer::NetworkEventHandler::NetworkEventHandler(
   CommandServer& commandServer)
   : _commandServer(commandServer)
@@ -155,18 +357,39 @@ CommandServer::NetworkEventHandler::NetworkEventHandler(
 void CommandServer::NetworkEventHandler::OnClientConnected(
   network::ClientId clientId)
 {
-  _commandServer._eventHandler.HandleClientConnected(clientId);
+  if (_commandServer._isCapturing.load(std::memory_order::relaxed))
+  {
+    std::scoped_lock lock(_commandServer._captureMutex);
+    if (_commandServer._captureWriter)
+      _commandServer._captureWriter->RecordConnected(clientId);
+  }
+
+  _commandServer.DispatchClientConnected(clientId);
 }
 
 void CommandServer::NetworkEventHandler::OnClientDisconnected(
   network::ClientId clientId)
 {
-  _commandServer._eventHandler.HandleClientDisconnected(clientId);
+  if (_commandServer._isCapturing.load(std::memory_order::relaxed))
+  {
+    std::scoped_lock lock(_commandServer._captureMutex);
+    if (_commandServer._captureWriter)
+      _commandServer._captureWriter->RecordDisconnected(clientId);
+  }
+
+  _commandServer.DispatchClientDisconnected(clientId);
 }
 
 size_t CommandServer::NetworkEventHandler::OnClientData(
   network::ClientId clientId,
   const std::span<const std::byte>& data)
+{
+  return _commandServer.HandleClientData(clientId, data);
+}
+
+std::size_t CommandServer::HandleClientData(
+  ClientId clientId,
+  std::span<const std::byte> data)
 {
   SourceStream commandStream(data);
 
@@ -235,15 +458,17 @@ size_t CommandServer::NetworkEventHandler::OnClientData(
       commandDataBuffer.data(),
       commandDataSize);
 
-    SourceStream commandDataStream(nullptr);
-
-    auto& client = _commandServer._clients[clientId];
+    // The descrambled command data without the padding.
+    std::span<const std::byte> commandData;
 
     const auto commandId = static_cast<protocol::Command>(magic.id);
 
     // Validate and process the command data.
     if (commandDataSize > 0)
     {
+      std::scoped_lock clientsLock(_clientsMutex);
+      auto& client = _clients[clientId];
+
       client.RollCode();
 
       const uint32_t code = client.GetRollingCodeInt();
@@ -266,24 +491,14 @@ size_t CommandServer::NetworkEventHandler::OnClientData(
 
       const auto actualCommandDataSize = commandDataSize - padding;
 
-      // Source stream of the command data.
-      SourceStream dataSourceStream(
-        {commandDataBuffer.begin(), commandDataSize});
-      // Sink stream of the command data.
-      // Correctly points to the same buffer.
-      SinkStream dataSinkStream(
-        {commandDataBuffer.begin(), commandDataBuffer.end()});
-
       // Apply XOR algorithm to the data.
-      XorAlgorithm(
+      protocol::ApplyXorCode(
         client.GetRollingCode(),
-        dataSourceStream,
-        dataSinkStream);
+        std::span(commandDataBuffer.data(), commandDataSize));
 
-      commandDataStream = std::move(SourceStream(
-        {commandDataBuffer.begin(), actualCommandDataSize}));
+      commandData = std::span(commandDataBuffer.data(), actualCommandDataSize);
 
-      if (_commandServer.debugIncomingCommandData
+      if (debugIncomingCommandData
         && not IsMuted(commandId))
       {
         spdlog::debug("Read data for command '{}' (0x{:X}),\n\n"
@@ -301,54 +516,93 @@ size_t CommandServer::NetworkEventHandler::OnClientData(
       }
     }
 
-    // Find the handler of the command.
-    const auto handlerIter = _commandServer._handlers.find(commandId);
-    if (handlerIter == _commandServer._handlers.cend())
+    if (_isCapturing.load(std::memory_order::relaxed))
     {
-      if (_commandServer.debugCommands
-        && not IsMuted(commandId))
+      std::scoped_lock lock(_captureMutex);
+      if (_captureWriter)
       {
-        spdlog::warn(
-          "Unhandled command '{}' (0x{:x})",
-          GetCommandName(commandId),
-          magic.id);
+        _captureWriter->RecordCommand(
+          clientId,
+          commandId,
+          commandData);
       }
     }
-    else
-    {
-      const auto& handler = handlerIter->second;
-      // Handler validity is checked when registering.
-      assert(handler);
 
-      try
-      {
-        // Call the handler.
-        handler(clientId, commandDataStream);
-      }
-      catch (const std::exception& x)
-      {
-        spdlog::error(
-          "Unhandled exception handling command '{}' (0x{:x}): {}",
-          protocol::GetCommandName(commandId),
-          magic.id,
-          x.what());
-      }
+    DispatchCommand(clientId, commandId, commandData);
+  }
+
+  return commandStream.GetCursor();
+}
 
-      // There shouldn't be any left-over data in the stream.
-      assert(commandDataStream.GetCursor() == commandDataStream.Size());
+void CommandServer::DispatchCommand(
+  ClientId clientId,
+  protocol::Command commandId,
+  std::span<const std::byte> data)
+{
+  ReceivedCommandCounters.Get(commandId).Increment();
 
-      if (_commandServer.debugCommands
-        && not IsMuted(commandId))
-      {
-        spdlog::debug(
-          "Handled command '{}' (0x{:x})",
-          GetCommandName(commandId),
-          magic.id);
-      }
+  // Find the handler of the command.
+  const auto handlerIter = _handlers.find(commandId);
+  if (handlerIter == _handlers.cend())
+  {
+    if (debugCommands
+      && not IsMuted(commandId))
+    {
+      spdlog::warn(
+        "Unhandled command '{}' (0x{:x})",
+        GetCommandName(commandId),
+        static_cast<uint16_t>(commandId));
     }
+
+    return;
   }
 
-  return commandStream.GetCursor();
+  const auto& handler = handlerIter->second;
+  // Handler validity is checked when registering.
+  assert(handler);
+
+  SourceStream commandDataStream(data);
+
+  try
+  {
+    // Call the handler.
+    handler(clientId, commandDataStream);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error(
+      "Unhandled exception handling command '{}' (0x{:x}): {}",
+      protocol::GetCommandName(commandId),
+      static_cast<uint16_t>(commandId),
+      x.what());
+  }
+
+  // There shouldn't be any left-over data in the stream.
+  assert(commandDataStream.GetCursor() == commandDataStream.Size());
+
+  if (debugCommands
+    && not IsMuted(commandId))
+  {
+    spdlog::debug(
+      "Handled command '{}' (0x{:x})",
+      GetCommandName(commandId),
+      static_cast<uint16_t>(commandId));
+  }
+}
+
+void CommandServer::DispatchClientConnected(ClientId clientId)
+{
+  _eventHandler.HandleClientConnected(clientId);
+}
+
+void CommandServer::DispatchClientDisconnected(ClientId clientId)
+{
+  _eventHandler.HandleClientDisconnected(clientId);
+
+  std::scoped_lock lock(_clientsMutex);
+  const auto clientIter = _clients.find(clientId);
+  if (clientIter != _clients.cend())
+    clientIter->second.ClearConflatedCommands();
 }
 
 void CommandServer::SendCommand(
@@ -358,67 +612,176 @@ void CommandServer::SendCommand(
 {
   try
   {
+    // The command is written on the network thread within the trace it was queued in.
     _server.GetClient(clientId)->QueueWrite(
-      [this, commandId, supplier = std::move(supplier)](asio::streambuf& writeBuffer)
+      [this, commandId, supplier = std::move(supplier), traceId = trace::GetCurrentTraceId()](
+        asio::streambuf& writeBuffer)
       {
-        const auto mutableBuffer = writeBuffer.prepare(MaxCommandSize);
-        const auto writeBufferView = std::span(
-          static_cast<std::byte*>(mutableBuffer.data()),
-          mutableBuffer.size());
+        const trace::Scope traceScope(traceId);
+        const trace::Span traceSpan(protocol::GetCommandName(commandId));
+
+        return WriteCommand(writeBuffer, commandId, supplier);
+      });
+  }
+  catch (std::exception& x)
+  {
+    // the client disconnected, todo dont use client ids, or dont
+  }
+}
+
+std::size_t CommandServer::WriteCommand(
+  asio::streambuf& writeBuffer,
+  protocol::Command commandId,
+  const CommandSupplier& supplier)
+{
+  const auto mutableBuffer = writeBuffer.prepare(MaxCommandSize);
+  const auto writeBufferView = std::span(
+    static_cast<std::byte*>(mutableBuffer.data()),
+    mutableBuffer.size());
+
+  SinkStream commandSink(writeBufferView);
+
+  const auto streamOrigin = commandSink.GetCursor();
+  commandSink.Seek(streamOrigin + sizeof(protocol::MessageMagic));
+
+  // Write the message data.
+  supplier(commandSink);
+
+  // Command size is the size of the whole command.
+  const uint16_t commandSize = commandSink.GetCursor();
+
+  if (debugOutgoingCommandData
+    && not IsMuted(commandId))
+  {
+    spdlog::debug("Write data for command '{}' (0x{:X}),\n\n"
+      "Command data size: {} \n"
+      "Data dump: \n\n{}\n",
+      GetCommandName(commandId),
+      static_cast<uint32_t>(commandId),
+      commandSize,
+      util::GenerateByteDump(
+        std::span(
+          static_cast<std::byte*>(mutableBuffer.data()) + sizeof(protocol::MessageMagic),
+          commandSize - sizeof(protocol::MessageMagic))));
+  }
+
+  // Traverse back the stream before the message data,
+  // and write the message magic.
+  commandSink.Seek(streamOrigin);
+
+  // Write the message magic.
+  const protocol::MessageMagic magic{
+    .id = static_cast<uint16_t>(commandId),
+    .length = commandSize};
 
-        SinkStream commandSink(writeBufferView);
+  commandSink.Write(encode_message_magic(magic));
+  writeBuffer.commit(magic.length);
+
+  SentCommandCounters.Get(commandId).Increment();
+
+  if (debugCommands
+    && not IsMuted(commandId))
+  {
+    spdlog::debug("Sent command message '{}' (0x{:X})",
+    GetCommandName(commandId),
+    static_cast<uint32_t>(commandId));
+  }
+
+  return commandSize;
+}
+
+void CommandServer::SendCommand(
+  std::span<const ClientId> clientIds,
+  protocol::Command commandId,
+  const CommandSupplier& supplier)
+{
+  // Write the command data once and share them between the clients.
+  const auto sharedSupplier = ShareCommandData(supplier);
+  for (const ClientId clientId : clientIds)
+  {
+    SendCommand(clientId, commandId, sharedSupplier);
+  }
+}
 
-        const auto streamOrigin = commandSink.GetCursor();
-        commandSink.Seek(streamOrigin + sizeof(protocol::MessageMagic));
+void CommandServer::SendConflatedCommands(
+  ClientId clientId,
+  protocol::Command commandId,
+  std::span<const SenderCommandSupplier> suppliers)
+{
+  {
+    std::scoped_lock lock(_clientsMutex);
 
-        // Write the message data.
-        supplier(commandSink);
+    // The commands still waiting to be sent take the latest suppliers when they are written.
+    if (_clients[clientId].ConflateCommands(commandId, suppliers))
+      return;
+  }
 
-        // Command size is the size of the whole command.
-        const uint16_t commandSize = commandSink.GetCursor();
+  try
+  {
+    _server.GetClient(clientId)->QueueWrite(
+      [this, clientId, commandId, traceId = trace::GetCurrentTraceId()](
+        asio::streambuf& writeBuffer) -> std::size_t
+      {
+        std::vector<CommandSupplier> latestSuppliers;
 
-        if (debugOutgoingCommandData
-          && not IsMuted(commandId))
         {
-          spdlog::debug("Write data for command '{}' (0x{:X}),\n\n"
-            "Command data size: {} \n"
-            "Data dump: \n\n{}\n",
-            GetCommandName(commandId),
-            static_cast<uint32_t>(commandId),
-            commandSize,
-            util::GenerateByteDump(
-              std::span(
-                static_cast<std::byte*>(mutableBuffer.data()) + sizeof(protocol::MessageMagic),
-                commandSize - sizeof(protocol::MessageMagic))));
+          std::scoped_lock lock(_clientsMutex);
+          const auto clientIter = _clients.find(clientId);
+          if (clientIter != _clients.end())
+            latestSuppliers = clientIter->second.TakeConflatedCommands(commandId);
         }
 
-        // Traverse back the stream before the message data,
-        // and write the message magic.
-        commandSink.Seek(streamOrigin);
+        // The commands were drained when the client disconnected,
+        // there is nothing to write.
+        if (latestSuppliers.empty())
+          return 0;
 
-        // Write the message magic.
-        const protocol::MessageMagic magic{
-          .id = static_cast<uint16_t>(commandId),
-          .length = commandSize};
+        const trace::Scope traceScope(traceId);
+        const trace::Span traceSpan(protocol::GetCommandName(commandId));
 
-        commandSink.Write(encode_message_magic(magic));
-        writeBuffer.commit(magic.length);
-
-        if (debugCommands
-          && not IsMuted(commandId))
+        std::size_t writtenSize = 0;
+        for (const auto& latestSupplier : latestSuppliers)
         {
-          spdlog::debug("Sent command message '{}' (0x{:X})",
-          GetCommandName(commandId),
-          static_cast<uint32_t>(commandId));
+          writtenSize += WriteCommand(writeBuffer, commandId, latestSupplier);
         }
 
-        return commandSize;
+        return writtenSize;
       });
   }
-  catch (std::exception& x)
+  catch (const std::exception&)
   {
-    // the client disconnected, todo dont use client ids, or dont
+    // The client disconnected, its conflated commands are cleared on the disconnect.
+  }
+}
+
+void CommandServer::SendConflatedCommand(
+  std::span<const ClientId> clientIds,
+  protocol::Command commandId,
+  uint32_t senderKey,
+  const CommandSupplier& supplier)
+{
+  // Write the command data once and share them between the clients.
+  const auto sharedSupplier = ShareCommandData(supplier);
+  const SenderCommandSupplier senderSupplier{senderKey, sharedSupplier};
+  for (const ClientId clientId : clientIds)
+  {
+    SendConflatedCommands(clientId, commandId, std::span(&senderSupplier, 1));
   }
 }
 
+CommandSupplier CommandServer::ShareCommandData(const CommandSupplier& supplier)
+{
+  const auto commandData = std::make_shared<std::vector<std::byte>>(
+    MaxCommandDataSize);
+
+  SinkStream commandSink{std::span(*commandData)};
+  supplier(commandSink);
+  commandData->resize(commandSink.GetCursor());
+
+  return [commandData](SinkStream& sink)
+  {
+    sink.Write(commandData->data(), commandData->size());
+  };
+}
+
 } // namespace server
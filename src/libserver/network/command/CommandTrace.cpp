@@ -0,0 +1,230 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/network/command/CommandTrace.hpp"
+
+#include <array>
+#include <format>
+#include <limits>
+
+namespace server
+{
+
+namespace
+{
+
+//! Appends a value in the little endian byte order of the trace.
+template <typename T>
+void AppendValue(std::vector<std::byte>& buffer, T value)
+{
+  for (std::size_t idx = 0; idx < sizeof(T); ++idx)
+  {
+    buffer.emplace_back(static_cast<std::byte>(
+      static_cast<uint64_t>(value) >> (idx * 8)));
+  }
+}
+
+//! Reads a value in the little endian byte order of the trace.
+//! @returns `true` if the value was read, `false` at the end of the file.
+template <typename T>
+bool ReadValue(std::ifstream& file, T& value)
+{
+  std::array<unsigned char, sizeof(T)> bytes{};
+  if (not file.read(reinterpret_cast<char*>(bytes.data()), bytes.size()))
+    return false;
+
+  uint64_t result = 0;
+  for (std::size_t idx = 0; idx < sizeof(T); ++idx)
+  {
+    result |= static_cast<uint64_t>(bytes[idx]) << (idx * 8);
+  }
+
+  value = static_cast<T>(result);
+  return true;
+}
+
+} // anon namespace
+
+CommandTraceWriter::CommandTraceWriter(const std::filesystem::path& path)
+  : _file(path, std::ios::binary | std::ios::trunc)
+  , _beginning(Clock::now())
+{
+  if (not _file.is_open())
+  {
+    throw std::runtime_error(
+      std::format("Trace file '{}' not accessible", path.string()));
+  }
+
+  _buffer.reserve(FlushSize * 2);
+  AppendValue(_buffer, CommandTraceMagic);
+  AppendValue(_buffer, CommandTraceVersion);
+}
+
+CommandTraceWriter::~CommandTraceWriter()
+{
+  Flush();
+}
+
+void CommandTraceWriter::RecordConnected(network::ClientId clientId)
+{
+  WriteRecordHeader(CommandTraceRecord::Type::Connected, clientId);
+}
+
+void CommandTraceWriter::RecordDisconnected(network::ClientId clientId)
+{
+  WriteRecordHeader(CommandTraceRecord::Type::Disconnected, clientId);
+}
+
+void CommandTraceWriter::RecordCommand(
+  network::ClientId clientId,
+  protocol::Command commandId,
+  std::span<const std::byte> data)
+{
+  WriteRecordHeader(CommandTraceRecord::Type::Command, clientId);
+  AppendValue(_buffer, static_cast<uint16_t>(commandId));
+  WriteVarInt(data.size());
+  _buffer.insert(_buffer.end(), data.begin(), data.end());
+
+  if (_buffer.size() >= FlushSize)
+    Flush();
+}
+
+void CommandTraceWriter::RecordState(
+  uint16_t stateId,
+  std::span<const std::byte> data)
+{
+  WriteRecordHeader(CommandTraceRecord::Type::State, 0);
+  AppendValue(_buffer, stateId);
+  WriteVarInt(data.size());
+  _buffer.insert(_buffer.end(), data.begin(), data.end());
+
+  if (_buffer.size() >= FlushSize)
+    Flush();
+}
+
+void CommandTraceWriter::Flush()
+{
+  _file.write(reinterpret_cast<const char*>(_buffer.data()), _buffer.size());
+  _file.flush();
+  _buffer.clear();
+}
+
+void CommandTraceWriter::WriteRecordHeader(
+  CommandTraceRecord::Type type,
+  network::ClientId clientId)
+{
+  const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+    Clock::now() - _beginning);
+
+  AppendValue(_buffer, static_cast<uint8_t>(type));
+  WriteVarInt((timestamp - _lastTimestamp).count());
+  WriteVarInt(clientId);
+
+  _lastTimestamp = timestamp;
+}
+
+void CommandTraceWriter::WriteVarInt(uint64_t value)
+{
+  // Seven bits per byte, the high bit marks a continuation.
+  while (value >= 0x80)
+  {
+    _buffer.emplace_back(static_cast<std::byte>(value | 0x80));
+    value >>= 7;
+  }
+
+  _buffer.emplace_back(static_cast<std::byte>(value));
+}
+
+CommandTraceReader::CommandTraceReader(const std::filesystem::path& path)
+  : _file(path, std::ios::binary)
+{
+  if (not _file.is_open())
+  {
+    throw std::runtime_error(
+      std::format("Trace file '{}' not accessible", path.string()));
+  }
+
+  uint32_t magic{};
+  uint16_t version{};
+  if (not ReadValue(_file, magic) || magic != CommandTraceMagic)
+    throw std::runtime_error(std::format("File '{}' is not a command trace", path.string()));
+  // The traces of the older versions are a subset of the current one.
+  if (not ReadValue(_file, version) || version == 0 || version > CommandTraceVersion)
+    throw std::runtime_error(std::format("Command trace version {} is not supported", version));
+}
+
+bool CommandTraceReader::Read(CommandTraceRecord& record)
+{
+  uint8_t type{};
+  if (not ReadValue(_file, type))
+    return false;
+
+  if (type > static_cast<uint8_t>(CommandTraceRecord::Type::State))
+    throw std::runtime_error(std::format("Invalid trace record type {}", type));
+
+  record.type = static_cast<CommandTraceRecord::Type>(type);
+  _lastTimestamp += std::chrono::microseconds(ReadVarInt());
+  record.timestamp = _lastTimestamp;
+  record.clientId = ReadVarInt();
+  record.data.clear();
+
+  if (record.type != CommandTraceRecord::Type::Command
+    && record.type != CommandTraceRecord::Type::State)
+    return true;
+
+  // The command ID or the state ID.
+  uint16_t id{};
+  if (not ReadValue(_file, id))
+    throw std::runtime_error("Truncated trace record");
+
+  const auto dataSize = ReadVarInt();
+  if (dataSize > std::numeric_limits<uint16_t>::max())
+    throw std::runtime_error(std::format("Invalid trace record data size {}", dataSize));
+
+  if (record.type == CommandTraceRecord::Type::Command)
+    record.commandId = static_cast<protocol::Command>(id);
+  else
+    record.stateId = id;
+
+  record.data.resize(dataSize);
+
+  if (not _file.read(reinterpret_cast<char*>(record.data.data()), record.data.size()))
+    throw std::runtime_error("Truncated trace record");
+
+  return true;
+}
+
+uint64_t CommandTraceReader::ReadVarInt()
+{
+  uint64_t value = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    uint8_t byte{};
+    if (not ReadValue(_file, byte))
+      throw std::runtime_error("Truncated trace record");
+
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+
+  throw std::runtime_error("Invalid variable-length integer in the trace");
+}
+
+} // namespace server
@@ -19,65 +19,62 @@
 
 #include "libserver/network/command/proto/CommonStructureDefinitions.hpp"
 
+#include "libserver/util/FieldList.hpp"
+
 namespace server
 {
 
+using ItemFields = FieldList<
+  &Item::uid,
+  &Item::tid,
+  &Item::expiresAt,
+  &Item::count>;
+
 void Item::Write(const Item& item, SinkStream& stream)
 {
-  stream.Write(item.uid)
-    .Write(item.tid)
-    .Write(item.expiresAt)
-    .Write(item.count);
+  ItemFields::Write(item, stream);
 }
 
 void Item::Read(Item& item, SourceStream& stream)
 {
-  stream.Read(item.uid)
-    .Read(item.tid)
-    .Read(item.expiresAt)
-    .Read(item.count);
+  ItemFields::Read(item, stream);
 }
 
+using StoredItemFields = FieldList<
+  &StoredItem::uid,
+  &StoredItem::val1,
+  &StoredItem::status,
+  &StoredItem::val3,
+  &StoredItem::val4,
+  &StoredItem::val5,
+  &StoredItem::val6,
+  &StoredItem::sender,
+  &StoredItem::message,
+  &StoredItem::dateAndTime>;
+
 void StoredItem::Write(const StoredItem& item, SinkStream& stream)
 {
-  stream.Write(item.uid)
-    .Write(item.val1)
-    .Write(item.status)
-    .Write(item.val3)
-    .Write(item.val4)
-    .Write(item.val5)
-    .Write(item.val6)
-    .Write(item.sender)
-    .Write(item.message)
-    .Write(item.dateAndTime);
+  StoredItemFields::Write(item, stream);
 }
 
 void StoredItem::Read(StoredItem& item, SourceStream& stream)
 {
-  stream.Read(item.uid)
-    .Read(item.val1)
-    .Read(item.status)
-    .Read(item.val3)
-    .Read(item.val4)
-    .Read(item.val5)
-    .Read(item.val6)
-    .Read(item.sender)
-    .Read(item.message)
-    .Read(item.dateAndTime);
+  StoredItemFields::Read(item, stream);
 }
 
+using KeyboardOptionsOptionFields = FieldList<
+  &KeyboardOptions::Option::index,
+  &KeyboardOptions::Option::type,
+  &KeyboardOptions::Option::key>;
+
 void KeyboardOptions::Option::Write(const Option& option, SinkStream& stream)
 {
-  stream.Write(option.index)
-    .Write(option.type)
-    .Write(option.key);
+  KeyboardOptionsOptionFields::Write(option, stream);
 }
 
 void KeyboardOptions::Option::Read(Option& option, SourceStream& stream)
 {
-  stream.Read(option.index)
-    .Read(option.type)
-    .Read(option.key);
+  KeyboardOptionsOptionFields::Read(option, stream);
 }
 
 void KeyboardOptions::Write(const KeyboardOptions& value, SinkStream& stream)
@@ -118,120 +115,118 @@ void MacroOptions::Read(MacroOptions& value, SourceStream& stream)
   }
 }
 
+using CharacterPartsFields = FieldList<
+  &Character::Parts::charId,
+  &Character::Parts::mouthSerialId,
+  &Character::Parts::faceSerialId,
+  &Character::Parts::val0>;
+
 void Character::Parts::Write(const Parts& value, SinkStream& stream)
 {
-  stream.Write(value.charId)
-    .Write(value.mouthSerialId)
-    .Write(value.faceSerialId)
-    .Write(value.val0);
+  CharacterPartsFields::Write(value, stream);
 }
 
 void Character::Parts::Read(Parts& value, SourceStream& stream)
 {
-  stream.Read(value.charId)
-    .Read(value.mouthSerialId)
-    .Read(value.faceSerialId)
-    .Read(value.val0);
+  CharacterPartsFields::Read(value, stream);
 }
 
+using CharacterAppearanceFields = FieldList<
+  &Character::Appearance::voiceId,
+  &Character::Appearance::headSize,
+  &Character::Appearance::height,
+  &Character::Appearance::thighVolume,
+  &Character::Appearance::legVolume,
+  &Character::Appearance::emblemId>;
+
 void Character::Appearance::Write(const Appearance& value, SinkStream& stream)
 {
-  stream.Write(value.voiceId)
-    .Write(value.headSize)
-    .Write(value.height)
-    .Write(value.thighVolume)
-    .Write(value.legVolume)
-    .Write(value.emblemId);
+  CharacterAppearanceFields::Write(value, stream);
 }
 
 void Character::Appearance::Read(Appearance& value, SourceStream& stream)
 {
-  stream.Read(value.voiceId)
-    .Read(value.headSize)
-    .Read(value.height)
-    .Read(value.thighVolume)
-    .Read(value.legVolume)
-    .Read(value.emblemId);
+  CharacterAppearanceFields::Read(value, stream);
 }
 
+using CharacterFields = FieldList<
+  &Character::parts,
+  &Character::appearance>;
+
 void Character::Write(const Character& value, SinkStream& stream)
 {
-  stream.Write(value.parts)
-    .Write(value.appearance);
+  CharacterFields::Write(value, stream);
 }
 
 void Character::Read(Character& value, SourceStream& stream)
 {
-  stream.Read(value.parts)
-    .Read(value.appearance);
+  CharacterFields::Read(value, stream);
 }
 
+using HorsePartsFields = FieldList<
+  &Horse::Parts::skinId,
+  &Horse::Parts::maneId,
+  &Horse::Parts::tailId,
+  &Horse::Parts::faceId>;
+
 void Horse::Parts::Write(const Parts& value, SinkStream& stream)
 {
-  stream.Write(value.skinId)
-    .Write(value.maneId)
-    .Write(value.tailId)
-    .Write(value.faceId);
+  HorsePartsFields::Write(value, stream);
 }
 
 void Horse::Parts::Read(Parts& value, SourceStream& stream)
 {
-  stream.Read(value.skinId)
-    .Read(value.maneId)
-    .Read(value.tailId)
-    .Read(value.faceId);
+  HorsePartsFields::Read(value, stream);
 }
 
+using HorseAppearanceFields = FieldList<
+  &Horse::Appearance::scale,
+  &Horse::Appearance::legLength,
+  &Horse::Appearance::legVolume,
+  &Horse::Appearance::bodyLength,
+  &Horse::Appearance::bodyVolume>;
+
 void Horse::Appearance::Write(const Appearance& value, SinkStream& stream)
 {
-  stream.Write(value.scale)
-    .Write(value.legLength)
-    .Write(value.legVolume)
-    .Write(value.bodyLength)
-    .Write(value.bodyVolume);
+  HorseAppearanceFields::Write(value, stream);
 }
 
 void Horse::Appearance::Read(Appearance& value, SourceStream& stream)
 {
-  stream.Read(value.scale)
-    .Read(value.legLength)
-    .Read(value.legVolume)
-    .Read(value.bodyLength)
-    .Read(value.bodyVolume);
+  HorseAppearanceFields::Read(value, stream);
 }
 
+using HorseStatsFields = FieldList<
+  &Horse::Stats::agility,
+  &Horse::Stats::ambition,
+  &Horse::Stats::rush,
+  &Horse::Stats::endurance,
+  &Horse::Stats::courage>;
+
 void Horse::Stats::Write(const Stats& value, SinkStream& stream)
 {
-  stream.Write(value.agility)
-    .Write(value.ambition)
-    .Write(value.rush)
-    .Write(value.endurance)
-    .Write(value.courage);
+  HorseStatsFields::Write(value, stream);
 }
 
 void Horse::Stats::Read(Stats& value, SourceStream& stream)
 {
-  stream.Read(value.agility)
-    .Read(value.ambition)
-    .Read(value.rush)
-    .Read(value.endurance)
-    .Read(value.courage);
+  HorseStatsFields::Read(value, stream);
 }
 
+using HorseMasteryFields = FieldList<
+  &Horse::Mastery::spurMagicCount,
+  &Horse::Mastery::jumpCount,
+  &Horse::Mastery::slidingTime,
+  &Horse::Mastery::glidingDistance>;
+
 void Horse::Mastery::Write(const Mastery& value, SinkStream& stream)
 {
-  stream.Write(value.spurMagicCount)
-    .Write(value.jumpCount)
-    .Write(value.slidingTime)
-    .Write(value.glidingDistance);
+  HorseMasteryFields::Write(value, stream);
 }
 
 void Horse::Mastery::Read(Mastery& value, SourceStream& stream)
 {
-  stream.Read(value.spurMagicCount)
-    .Read(value.jumpCount)
-    .Read(value.slidingTime)
-    .Read(value.glidingDistance);
+  HorseMasteryFields::Read(value, stream);
 }
 
 void Horse::Write(const Horse& value, SinkStream& stream)
@@ -343,126 +338,121 @@ void Horse::Read(Horse& value, SourceStream& stream)
     .Read(value.val17);
 }
 
+using GuildFields = FieldList<
+  &Guild::uid,
+  &Guild::val1,
+  &Guild::val2,
+  &Guild::name,
+  &Guild::val4,
+  &Guild::val5,
+  &Guild::val6>;
+
 void Guild::Write(const Guild& value, SinkStream& stream)
 {
-  stream.Write(value.uid)
-    .Write(value.val1)
-    .Write(value.val2)
-    .Write(value.name)
-    .Write(value.val4)
-    .Write(value.val5)
-    .Write(value.val6);
+  GuildFields::Write(value, stream);
 }
 
 void Guild::Read(Guild& value, SourceStream& stream)
 {
-  stream.Read(value.uid)
-    .Read(value.val1)
-    .Read(value.val2)
-    .Read(value.name)
-    .Read(value.val4)
-    .Read(value.val5)
-    .Read(value.val6);
+  GuildFields::Read(value, stream);
 }
 
+using RentFields = FieldList<
+  &Rent::mountUid,
+  &Rent::val1,
+  &Rent::val2>;
+
 void Rent::Write(const Rent& value, SinkStream& stream)
 {
-  stream.Write(value.mountUid)
-    .Write(value.val1)
-    .Write(value.val2);
+  RentFields::Write(value, stream);
 }
 
 void Rent::Read(Rent& value, SourceStream& stream)
 {
-  stream.Read(value.mountUid)
-    .Read(value.val1)
-    .Read(value.val2);
+  RentFields::Read(value, stream);
 }
 
+using PetFields = FieldList<
+  &Pet::petId,
+  &Pet::member2,
+  &Pet::name,
+  &Pet::birthDate>;
+
 void Pet::Write(const Pet& value, SinkStream& stream)
 {
-  stream.Write(value.petId)
-    .Write(value.member2)
-    .Write(value.name)
-    .Write(value.birthDate);
+  PetFields::Write(value, stream);
 }
 
 void Pet::Read(Pet& value, SourceStream& stream)
 {
-  stream.Read(value.petId)
-    .Read(value.member2)
-    .Read(value.name)
-    .Read(value.birthDate);
+  PetFields::Read(value, stream);
 }
 
+using EggFields = FieldList<
+  &Egg::uid,
+  &Egg::itemTid,
+  &Egg::member3,
+  &Egg::member4,
+  &Egg::member5,
+  &Egg::timeRemaining,
+  &Egg::boost,
+  &Egg::totalHatchingTime,
+  &Egg::member9>;
+
 void Egg::Write(const Egg& value, SinkStream& stream)
 {
-  stream.Write(value.uid)
-    .Write(value.itemTid)
-    .Write(value.member3)
-    .Write(value.member4)
-    .Write(value.member5)
-    .Write(value.timeRemaining)
-    .Write(value.boost)
-    .Write(value.totalHatchingTime)
-    .Write(value.member9);
+  EggFields::Write(value, stream);
 }
 
 void Egg::Read(Egg& value, SourceStream& stream)
 {
-  stream.Read(value.uid)
-    .Read(value.itemTid)
-    .Read(value.member3)
-    .Read(value.member4)
-    .Read(value.member5)
-    .Read(value.timeRemaining)
-    .Read(value.boost)
-    .Read(value.totalHatchingTime)
-    .Read(value.member9);
+  EggFields::Read(value, stream);
 }
 
+using PetInfoFields = FieldList<
+  &PetInfo::characterUid,
+  &PetInfo::itemUid,
+  &PetInfo::pet,
+  &PetInfo::member4>;
+
 void PetInfo::Write(const PetInfo& value, SinkStream& stream)
 {
-  stream.Write(value.characterUid)
-    .Write(value.itemUid)
-    .Write(value.pet)
-    .Write(value.member4);
+  PetInfoFields::Write(value, stream);
 }
 
 void PetInfo::Read(PetInfo& value, SourceStream& stream)
 {
-  stream.Read(value.characterUid)
-    .Read(value.itemUid)
-    .Read(value.pet)
-    .Read(value.member4);
+  PetInfoFields::Read(value, stream);
 }
 
+using PetBirthInfoFields = FieldList<
+  &PetBirthInfo::eggItem,
+  &PetBirthInfo::member2,
+  &PetBirthInfo::member3,
+  &PetBirthInfo::petInfo>;
+
 void PetBirthInfo::Write(const PetBirthInfo& value, SinkStream& stream)
 {
-  stream.Write(value.eggItem)
-    .Write(value.member2)
-    .Write(value.member3)
-    .Write(value.petInfo);
+  PetBirthInfoFields::Write(value, stream);
 }
 
 void PetBirthInfo::Read(PetBirthInfo& value, SourceStream& stream)
 {
-  stream.Read(value.eggItem)
-    .Read(value.member2)
-    .Read(value.member3)
-    .Read(value.petInfo);
+  PetBirthInfoFields::Read(value, stream);
 }
 
+using RanchHorseFields = FieldList<
+  &RanchHorse::horseOid,
+  &RanchHorse::horse>;
+
 void RanchHorse::Write(const RanchHorse& value, SinkStream& stream)
 {
-  stream.Write(value.horseOid)
-    .Write(value.horse);
+  RanchHorseFields::Write(value, stream);
 }
 
 void RanchHorse::Read(RanchHorse& value, SourceStream& stream)
 {
-  stream.Read(value.horseOid)
-    .Read(value.horse);
+  RanchHorseFields::Read(value, stream);
 }
 
 void RanchCharacter::Write(const RanchCharacter& ranchCharacter, SinkStream& stream)
@@ -542,50 +532,51 @@ void RanchCharacter::Read(RanchCharacter& value, SourceStream& stream)
     .Read(value.unk5);
 }
 
+using QuestFields = FieldList<
+  &Quest::tid,
+  &Quest::member0,
+  &Quest::member1,
+  &Quest::member2,
+  &Quest::member3,
+  &Quest::member4>;
+
 void Quest::Write(const Quest& value, SinkStream& stream)
 {
-  stream.Write(value.tid)
-    .Write(value.member0)
-    .Write(value.member1)
-    .Write(value.member2)
-    .Write(value.member3)
-    .Write(value.member4);
+  QuestFields::Write(value, stream);
 }
 
 void Quest::Read(Quest& value, SourceStream& stream)
 {
-  stream.Read(value.tid)
-    .Read(value.member0)
-    .Read(value.member1)
-    .Read(value.member2)
-    .Read(value.member3)
-    .Read(value.member4);
+  QuestFields::Read(value, stream);
 }
 
+using HousingFields = FieldList<
+  &Housing::uid,
+  &Housing::tid,
+  &Housing::durability>;
+
 void Housing::Write(const Housing& value, SinkStream& stream)
 {
-  stream.Write(value.uid)
-    .Write(value.tid)
-    .Write(value.durability);
+  HousingFields::Write(value, stream);
 }
 
 void Housing::Read(Housing& value, SourceStream& stream)
 {
-  stream.Read(value.uid)
-    .Read(value.tid)
-    .Read(value.durability);
+  HousingFields::Read(value, stream);
 }
 
+using LeagueFields = FieldList<
+  &League::type,
+  &League::rankingPercentile>;
+
 void League::Write(const League& value, SinkStream& stream)
 {
-  stream.Write(value.type)
-    .Write(value.rankingPercentile);
+  LeagueFields::Write(value, stream);
 }
 
 void League::Read(League& value, SourceStream& stream)
 {
-  stream.Read(value.type)
-    .Read(value.rankingPercentile);
+  LeagueFields::Read(value, stream);
 }
 
 } // namespace server
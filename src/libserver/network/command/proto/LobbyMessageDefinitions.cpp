@@ -19,26 +19,31 @@
 
 #include "libserver/network/command/proto/LobbyMessageDefinitions.hpp"
 
+#include "libserver/util/FieldList.hpp"
+
 namespace server::protocol
 {
 
+using LobbyCommandLoginFields = FieldList<
+  &LobbyCommandLogin::constant0,
+  &LobbyCommandLogin::constant1,
+  &LobbyCommandLogin::loginId,
+  &LobbyCommandLogin::memberNo,
+  &LobbyCommandLogin::authKey,
+  &LobbyCommandLogin::val0>;
+
 void LobbyCommandLogin::Write(
   const LobbyCommandLogin& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  LobbyCommandLoginFields::Write(command, stream);
 }
 
 void LobbyCommandLogin::Read(
   LobbyCommandLogin& command,
   SourceStream& stream)
 {
-  stream.Read(command.constant0)
-    .Read(command.constant1)
-    .Read(command.loginId)
-    .Read(command.memberNo)
-    .Read(command.authKey)
-    .Read(command.val0);
+  LobbyCommandLoginFields::Read(command, stream);
 }
 
 void LobbyCommandLoginOK::SystemContent::Write(const SystemContent& command, SinkStream& stream)
@@ -305,27 +310,33 @@ void LobbyCommandCreateNicknameNotify::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandCreateNicknameFields = FieldList<
+  &LobbyCommandCreateNickname::nickname,
+  &LobbyCommandCreateNickname::character,
+  &LobbyCommandCreateNickname::unk0>;
+
 void LobbyCommandCreateNickname::Write(
   const LobbyCommandCreateNickname& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  LobbyCommandCreateNicknameFields::Write(command, stream);
 }
 
 void LobbyCommandCreateNickname::Read(
   LobbyCommandCreateNickname& command,
   SourceStream& stream)
 {
-  stream.Read(command.nickname)
-    .Read(command.character)
-    .Read(command.unk0);
+  LobbyCommandCreateNicknameFields::Read(command, stream);
 }
 
+using LobbyCommandCreateNicknameCancelFields = FieldList<
+  &LobbyCommandCreateNicknameCancel::error>;
+
 void LobbyCommandCreateNicknameCancel::Write(
   const LobbyCommandCreateNicknameCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.error);
+  LobbyCommandCreateNicknameCancelFields::Write(command, stream);
 }
 
 void LobbyCommandCreateNicknameCancel::Read(
@@ -406,11 +417,14 @@ void LobbyCommandAchievementCompleteList::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandAchievementCompleteListFields = FieldList<
+  &LobbyCommandAchievementCompleteList::unk0>;
+
 void LobbyCommandAchievementCompleteList::Read(
   LobbyCommandAchievementCompleteList& command,
   SourceStream& stream)
 {
-  stream.Read(command.unk0);
+  LobbyCommandAchievementCompleteListFields::Read(command, stream);
 }
 
 void LobbyCommandAchievementCompleteListOK::Write(
@@ -439,19 +453,25 @@ void LobbyCommandEnterChannel::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandEnterChannelFields = FieldList<
+  &LobbyCommandEnterChannel::channel>;
+
 void LobbyCommandEnterChannel::Read(
   LobbyCommandEnterChannel& command,
   SourceStream& stream)
 {
-  stream.Read(command.channel);
+  LobbyCommandEnterChannelFields::Read(command, stream);
 }
 
+using LobbyCommandEnterChannelOKFields = FieldList<
+  &LobbyCommandEnterChannelOK::unk0,
+  &LobbyCommandEnterChannelOK::unk1>;
+
 void LobbyCommandEnterChannelOK::Write(
   const LobbyCommandEnterChannelOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0)
-    .Write(command.unk1);
+  LobbyCommandEnterChannelOKFields::Write(command, stream);
 }
 
 void LobbyCommandEnterChannelOK::Read(
@@ -480,32 +500,38 @@ void LobbyCommandRoomList::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandRoomListFields = FieldList<
+  &LobbyCommandRoomList::page,
+  &LobbyCommandRoomList::gameMode,
+  &LobbyCommandRoomList::teamMode>;
+
 void LobbyCommandRoomList::Read(
   LobbyCommandRoomList& command,
   SourceStream& stream)
 {
-  stream.Read(command.page)
-    .Read(command.gameMode)
-    .Read(command.teamMode);
+  LobbyCommandRoomListFields::Read(command, stream);
 }
 
+using LobbyCommandRoomListOKRoomFields = FieldList<
+  &LobbyCommandRoomListOK::Room::id,
+  &LobbyCommandRoomListOK::Room::name,
+  &LobbyCommandRoomListOK::Room::playerCount,
+  &LobbyCommandRoomListOK::Room::maxPlayers,
+  &LobbyCommandRoomListOK::Room::isLocked,
+  &LobbyCommandRoomListOK::Room::unk0,
+  &LobbyCommandRoomListOK::Room::unk1,
+  &LobbyCommandRoomListOK::Room::map,
+  &LobbyCommandRoomListOK::Room::hasStarted,
+  &LobbyCommandRoomListOK::Room::unk2,
+  &LobbyCommandRoomListOK::Room::unk3,
+  &LobbyCommandRoomListOK::Room::level,
+  &LobbyCommandRoomListOK::Room::unk4>;
+
 void LobbyCommandRoomListOK::Room::Write(
   const Room& value,
   SinkStream& stream)
 {
-  stream.Write(value.id)
-    .Write(value.name)
-    .Write(value.playerCount)
-    .Write(value.maxPlayers)
-    .Write(value.isLocked)
-    .Write(value.unk0)
-    .Write(value.unk1)
-    .Write(value.map)
-    .Write(value.hasStarted)
-    .Write(value.unk2)
-    .Write(value.unk3)
-    .Write(value.level)
-    .Write(value.unk4);
+  LobbyCommandRoomListOKRoomFields::Write(value, stream);
 }
 
 void LobbyCommandRoomListOK::Room::Read(
@@ -539,26 +565,29 @@ void LobbyCommandRoomListOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandMakeRoomFields = FieldList<
+  &LobbyCommandMakeRoom::name,
+  &LobbyCommandMakeRoom::password,
+  &LobbyCommandMakeRoom::playerCount,
+  &LobbyCommandMakeRoom::gameMode,
+  &LobbyCommandMakeRoom::teamMode,
+  &LobbyCommandMakeRoom::missionId,
+  &LobbyCommandMakeRoom::unk3,
+  &LobbyCommandMakeRoom::bitset,
+  &LobbyCommandMakeRoom::unk4>;
+
 void LobbyCommandMakeRoom::Write(
   const LobbyCommandMakeRoom& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  LobbyCommandMakeRoomFields::Write(command, stream);
 }
 
 void LobbyCommandMakeRoom::Read(
   LobbyCommandMakeRoom& command,
   SourceStream& stream)
 {
-  stream.Read(command.name)
-    .Read(command.password)
-    .Read(command.playerCount)
-    .Read(command.gameMode)
-    .Read(command.teamMode)
-    .Read(command.missionId)
-    .Read(command.unk3)
-    .Read(command.bitset)
-    .Read(command.unk4);
+  LobbyCommandMakeRoomFields::Read(command, stream);
 }
 
 void LobbyCommandMakeRoomOK::Write(
@@ -576,14 +605,23 @@ void LobbyCommandMakeRoomOK::Read(
   LobbyCommandMakeRoomOK& command,
   SourceStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  stream.Read(command.roomUid)
+    .Read(command.otp)
+    .Read(command.address)
+    .Read(command.port)
+    .Read(command.unk2);
+
+  command.address = ntohl(command.address);
 }
 
+using LobbyCommandMakeRoomCancelFields = FieldList<
+  &LobbyCommandMakeRoomCancel::unk0>;
+
 void LobbyCommandMakeRoomCancel::Write(
   const LobbyCommandMakeRoomCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0);
+  LobbyCommandMakeRoomCancelFields::Write(command, stream);
 }
 
 void LobbyCommandMakeRoomCancel::Read(
@@ -593,20 +631,23 @@ void LobbyCommandMakeRoomCancel::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandEnterRoomFields = FieldList<
+  &LobbyCommandEnterRoom::roomUid,
+  &LobbyCommandEnterRoom::password,
+  &LobbyCommandEnterRoom::member3>;
+
 void LobbyCommandEnterRoom::Write(
   const LobbyCommandEnterRoom& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  LobbyCommandEnterRoomFields::Write(command, stream);
 }
 
 void LobbyCommandEnterRoom::Read(
   LobbyCommandEnterRoom& command,
   SourceStream& stream)
 {
-  stream.Read(command.roomUid)
-    .Read(command.password)
-    .Read(command.member3);
+  LobbyCommandEnterRoomFields::Read(command, stream);
 }
 
 void LobbyCommandEnterRoomOK::Write(
@@ -627,11 +668,14 @@ void LobbyCommandEnterRoomOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandEnterRoomCancelFields = FieldList<
+  &LobbyCommandEnterRoomCancel::status>;
+
 void LobbyCommandEnterRoomCancel::Write(
   const LobbyCommandEnterRoomCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.status);
+  LobbyCommandEnterRoomCancelFields::Write(command, stream);
 }
 
 void LobbyCommandEnterRoomCancel::Read(
@@ -648,11 +692,14 @@ void LobbyCommandRequestQuestList::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandRequestQuestListFields = FieldList<
+  &LobbyCommandRequestQuestList::unk0>;
+
 void LobbyCommandRequestQuestList::Read(
   LobbyCommandRequestQuestList& command,
   SourceStream& stream)
 {
-  stream.Read(command.unk0);
+  LobbyCommandRequestQuestListFields::Read(command, stream);
 }
 
 void LobbyCommandRequestQuestListOK::Write(
@@ -681,11 +728,14 @@ void LobbyCommandRequestDailyQuestList::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandRequestDailyQuestListFields = FieldList<
+  &LobbyCommandRequestDailyQuestList::val0>;
+
 void LobbyCommandRequestDailyQuestList::Read(
   LobbyCommandRequestDailyQuestList& command,
   SourceStream& stream)
 {
-  stream.Read(command.val0);
+  LobbyCommandRequestDailyQuestListFields::Read(command, stream);
 }
 
 void LobbyCommandRequestDailyQuestListOK::Write(
@@ -717,20 +767,23 @@ void LobbyCommandRequestDailyQuestListOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandEnterRanchFields = FieldList<
+  &LobbyCommandEnterRanch::rancherUid,
+  &LobbyCommandEnterRanch::unk1,
+  &LobbyCommandEnterRanch::unk2>;
+
 void LobbyCommandEnterRanch::Write(
   const LobbyCommandEnterRanch& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  LobbyCommandEnterRanchFields::Write(command, stream);
 }
 
 void LobbyCommandEnterRanch::Read(
   LobbyCommandEnterRanch& command,
   SourceStream& stream)
 {
-  stream.Read(command.rancherUid)
-    .Read(command.unk1)
-    .Read(command.unk2);
+  LobbyCommandEnterRanchFields::Read(command, stream);
 }
 
 void LobbyCommandEnterRanchOK::Write(
@@ -747,14 +800,22 @@ void LobbyCommandEnterRanchOK::Read(
   LobbyCommandEnterRanchOK& command,
   SourceStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  stream.Read(command.rancherUid)
+    .Read(command.otp)
+    .Read(command.ranchAddress)
+    .Read(command.ranchPort);
+
+  command.ranchAddress = ntohl(command.ranchAddress);
 }
 
+using LobbyCommandEnterRanchCancelFields = FieldList<
+  &LobbyCommandEnterRanchCancel::unk0>;
+
 void LobbyCommandEnterRanchCancel::Write(
   const LobbyCommandEnterRanchCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0);
+  LobbyCommandEnterRanchCancelFields::Write(command, stream);
 }
 
 void LobbyCommandEnterRanchCancel::Read(
@@ -768,7 +829,7 @@ void LobbyCommandGetMessengerInfo::Write(
   const LobbyCommandGetMessengerInfo& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  // Empty.
 }
 
 void LobbyCommandGetMessengerInfo::Read(
@@ -778,20 +839,23 @@ void LobbyCommandGetMessengerInfo::Read(
   // Empty.
 }
 
+using LobbyCommandGetMessengerInfoOKFields = FieldList<
+  &LobbyCommandGetMessengerInfoOK::code,
+  &LobbyCommandGetMessengerInfoOK::ip,
+  &LobbyCommandGetMessengerInfoOK::port>;
+
 void LobbyCommandGetMessengerInfoOK::Write(
   const LobbyCommandGetMessengerInfoOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.code)
-    .Write(command.ip)
-    .Write(command.port);
+  LobbyCommandGetMessengerInfoOKFields::Write(command, stream);
 }
 
 void LobbyCommandGetMessengerInfoOK::Read(
   LobbyCommandGetMessengerInfoOK& command,
   SourceStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  LobbyCommandGetMessengerInfoOKFields::Read(command, stream);
 }
 
 void LobbyCommandGetMessengerInfoCancel::Write(
@@ -814,11 +878,14 @@ void LobbyCommandRequestSpecialEventList::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandRequestSpecialEventListFields = FieldList<
+  &LobbyCommandRequestSpecialEventList::unk0>;
+
 void LobbyCommandRequestSpecialEventList::Read(
   LobbyCommandRequestSpecialEventList& command,
   SourceStream& stream)
 {
-  stream.Read(command.unk0);
+  LobbyCommandRequestSpecialEventListFields::Read(command, stream);
 }
 
 void LobbyCommandRequestSpecialEventListOK::Write(
@@ -852,7 +919,7 @@ void AcCmdCLHeartbeat::Write(
   const AcCmdCLHeartbeat& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  // Empty.
 }
 
 void AcCmdCLHeartbeat::Read(
@@ -915,19 +982,12 @@ void AcCmdLCGoodsShopListData::Write(
   const AcCmdLCGoodsShopListData& command,
   SinkStream& stream)
 {
-  for (const auto& b : command.member1)
-  {
-    stream.Write(b);
-  }
-
-  stream.Write(command.member2)
+  stream.Write(command.member1)
+    .Write(command.member2)
     .Write(command.member3);
 
-  stream.Write(static_cast<uint32_t>(command.data.size()));
-  for (const auto & b : command.data)
-  {
-    stream.Write(b);
-  }
+  stream.Write(static_cast<uint32_t>(command.data.size()))
+    .Write(std::span(command.data));
 }
 
 void AcCmdLCGoodsShopListData::Read(
@@ -950,11 +1010,14 @@ void AcCmdCLInquiryTreecash::Read(
   // Empty.
 }
 
+using LobbyCommandInquiryTreecashOKFields = FieldList<
+  &LobbyCommandInquiryTreecashOK::cash>;
+
 void LobbyCommandInquiryTreecashOK::Write(
   const LobbyCommandInquiryTreecashOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.cash);
+  LobbyCommandInquiryTreecashOKFields::Write(command, stream);
 }
 
 void LobbyCommandInquiryTreecashOK::Read(
@@ -985,11 +1048,15 @@ void LobbyCommandClientNotify::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using LobbyCommandClientNotifyFields = FieldList<
+  &LobbyCommandClientNotify::val0,
+  &LobbyCommandClientNotify::val1>;
+
 void LobbyCommandClientNotify::Read(
   LobbyCommandClientNotify& command,
   SourceStream& stream)
 {
-  stream.Read(command.val0).Read(command.val1);
+  LobbyCommandClientNotifyFields::Read(command, stream);
 }
 
 void LobbyCommandGuildPartyList::Write(
@@ -1043,45 +1110,51 @@ void LobbyCommandRequestPersonalInfo::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using LobbyCommandRequestPersonalInfoFields = FieldList<
+  &LobbyCommandRequestPersonalInfo::characterUid,
+  &LobbyCommandRequestPersonalInfo::type>;
+
 void LobbyCommandRequestPersonalInfo::Read(
   LobbyCommandRequestPersonalInfo& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterUid)
-    .Read(command.type);
-}
+  LobbyCommandRequestPersonalInfoFields::Read(command, stream);
+}
+
+using LobbyCommandPersonalInfoBasicFields = FieldList<
+  &LobbyCommandPersonalInfo::Basic::distanceTravelled,
+  &LobbyCommandPersonalInfo::Basic::topSpeed,
+  &LobbyCommandPersonalInfo::Basic::longestGlidingDistance,
+  &LobbyCommandPersonalInfo::Basic::jumpSuccessRate,
+  &LobbyCommandPersonalInfo::Basic::perfectJumpSuccessRate,
+  &LobbyCommandPersonalInfo::Basic::speedSingleWinCombo,
+  &LobbyCommandPersonalInfo::Basic::speedTeamWinCombo,
+  &LobbyCommandPersonalInfo::Basic::magicSingleWinCombo,
+  &LobbyCommandPersonalInfo::Basic::magicTeamWinCombo,
+  &LobbyCommandPersonalInfo::Basic::averageRank,
+  &LobbyCommandPersonalInfo::Basic::completionRate,
+  &LobbyCommandPersonalInfo::Basic::member12,
+  &LobbyCommandPersonalInfo::Basic::highestCarnivalPrize,
+  &LobbyCommandPersonalInfo::Basic::member14,
+  &LobbyCommandPersonalInfo::Basic::member15,
+  &LobbyCommandPersonalInfo::Basic::member16,
+  &LobbyCommandPersonalInfo::Basic::introduction,
+  &LobbyCommandPersonalInfo::Basic::level,
+  &LobbyCommandPersonalInfo::Basic::levelProgress,
+  &LobbyCommandPersonalInfo::Basic::member20,
+  &LobbyCommandPersonalInfo::Basic::perfectBoostCombo,
+  &LobbyCommandPersonalInfo::Basic::perfectJumpCombo,
+  &LobbyCommandPersonalInfo::Basic::magicDefenseCombo,
+  &LobbyCommandPersonalInfo::Basic::member24,
+  &LobbyCommandPersonalInfo::Basic::member25,
+  &LobbyCommandPersonalInfo::Basic::member26,
+  &LobbyCommandPersonalInfo::Basic::guildName,
+  &LobbyCommandPersonalInfo::Basic::member28,
+  &LobbyCommandPersonalInfo::Basic::member29>;
 
 void LobbyCommandPersonalInfo::Basic::Write(const Basic& command, SinkStream& stream)
 {
-  stream.Write(command.distanceTravelled)
-    .Write(command.topSpeed)
-    .Write(command.longestGlidingDistance)
-    .Write(command.jumpSuccessRate)
-    .Write(command.perfectJumpSuccessRate)
-    .Write(command.speedSingleWinCombo)
-    .Write(command.speedTeamWinCombo)
-    .Write(command.magicSingleWinCombo)
-    .Write(command.magicTeamWinCombo)
-    .Write(command.averageRank)
-    .Write(command.completionRate)
-    .Write(command.member12)
-    .Write(command.highestCarnivalPrize)
-    .Write(command.member14)
-    .Write(command.member15)
-    .Write(command.member16)
-    .Write(command.introduction)
-    .Write(command.level)
-    .Write(command.levelProgress)
-    .Write(command.member20)
-    .Write(command.perfectBoostCombo)
-    .Write(command.perfectJumpCombo)
-    .Write(command.magicDefenseCombo)
-    .Write(command.member24)
-    .Write(command.member25)
-    .Write(command.member26)
-    .Write(command.guildName)
-    .Write(command.member28)
-    .Write(command.member29);
+  LobbyCommandPersonalInfoBasicFields::Write(command, stream);
 }
 
 void LobbyCommandPersonalInfo::Basic::Read(Basic& command, SourceStream& stream)
@@ -1168,11 +1241,14 @@ void LobbyCommandSetIntroduction::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using LobbyCommandSetIntroductionFields = FieldList<
+  &LobbyCommandSetIntroduction::introduction>;
+
 void LobbyCommandSetIntroduction::Read(
   LobbyCommandSetIntroduction& command,
   SourceStream& stream)
 {
-  stream.Read(command.introduction);
+  LobbyCommandSetIntroductionFields::Read(command, stream);
 }
 
 void LobbyCommandUpdateSystemContent::Write(
@@ -1182,20 +1258,26 @@ void LobbyCommandUpdateSystemContent::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using LobbyCommandUpdateSystemContentFields = FieldList<
+  &LobbyCommandUpdateSystemContent::member1,
+  &LobbyCommandUpdateSystemContent::key,
+  &LobbyCommandUpdateSystemContent::value>;
+
 void LobbyCommandUpdateSystemContent::Read(
   LobbyCommandUpdateSystemContent& command,
   SourceStream& stream)
 {
-  stream.Read(command.member1)
-    .Read(command.key)
-    .Read(command.value);
+  LobbyCommandUpdateSystemContentFields::Read(command, stream);
 }
 
+using LobbyCommandUpdateSystemContentNotifyFields = FieldList<
+  &LobbyCommandUpdateSystemContentNotify::systemContent>;
+
 void LobbyCommandUpdateSystemContentNotify::Write(
   const LobbyCommandUpdateSystemContentNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.systemContent);
+  LobbyCommandUpdateSystemContentNotifyFields::Write(command, stream);
 }
 
 void LobbyCommandUpdateSystemContentNotify::Read(
@@ -1205,22 +1287,42 @@ void LobbyCommandUpdateSystemContentNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using LobbyCommandChangeRanchOptionFields = FieldList<
+  &LobbyCommandChangeRanchOption::unk0,
+  &LobbyCommandChangeRanchOption::unk1,
+  &LobbyCommandChangeRanchOption::unk2>;
+
 void LobbyCommandChangeRanchOption::Read(
   LobbyCommandChangeRanchOption& command,
   SourceStream& stream)
 {
-  stream.Read(command.unk0)
-    .Read(command.unk1)
-    .Read(command.unk2);
+  LobbyCommandChangeRanchOptionFields::Read(command, stream);
 }
 
+void LobbyCommandChangeRanchOption::Write(
+  const LobbyCommandChangeRanchOption& command,
+  SinkStream& stream)
+{
+  LobbyCommandChangeRanchOptionFields::Write(command, stream);
+}
+
+using LobbyCommandChangeRanchOptionOKFields = FieldList<
+  &LobbyCommandChangeRanchOptionOK::unk0,
+  &LobbyCommandChangeRanchOptionOK::unk1,
+  &LobbyCommandChangeRanchOptionOK::unk2>;
+
 void LobbyCommandChangeRanchOptionOK::Write(
   const LobbyCommandChangeRanchOptionOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0)
-    .Write(command.unk1)
-    .Write(command.unk2);
+  LobbyCommandChangeRanchOptionOKFields::Write(command, stream);
+}
+
+void LobbyCommandChangeRanchOptionOK::Read(
+  LobbyCommandChangeRanchOptionOK& command,
+  SourceStream& stream)
+{
+  LobbyCommandChangeRanchOptionOKFields::Read(command, stream);
 }
 
 void AcCmdLCOpKick::Write(const AcCmdLCOpKick& command, SinkStream& stream)
@@ -1233,9 +1335,12 @@ void AcCmdLCOpKick::Read(AcCmdLCOpKick& command, SourceStream& stream)
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdLCOpMuteFields = FieldList<
+  &AcCmdLCOpMute::duration>;
+
 void AcCmdLCOpMute::Write(const AcCmdLCOpMute& command, SinkStream& stream)
 {
-  stream.Write(command.duration);
+  AcCmdLCOpMuteFields::Write(command, stream);
 }
 
 void AcCmdLCOpMute::Read(AcCmdLCOpMute& command, SourceStream& stream)
@@ -1243,9 +1348,12 @@ void AcCmdLCOpMute::Read(AcCmdLCOpMute& command, SourceStream& stream)
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdLCNoticeFields = FieldList<
+  &AcCmdLCNotice::notice>;
+
 void AcCmdLCNotice::Write(const AcCmdLCNotice& command, SinkStream& stream)
 {
-  stream.Write(command.notice);
+  AcCmdLCNoticeFields::Write(command, stream);
 }
 
 void AcCmdLCNotice::Read(AcCmdLCNotice& command, SourceStream& stream)
@@ -1260,11 +1368,14 @@ void AcCmdCLRequestMountInfo::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCLRequestMountInfoFields = FieldList<
+  &AcCmdCLRequestMountInfo::characterUid>;
+
 void AcCmdCLRequestMountInfo::Read(
   AcCmdCLRequestMountInfo& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterUid);
+  AcCmdCLRequestMountInfoFields::Read(command, stream);
 }
 
 void AcCmdCLRequestMountInfoOK::Write(
@@ -1290,4 +1401,11 @@ void AcCmdCLRequestMountInfoOK::Write(
   }
 }
 
+void AcCmdCLRequestMountInfoOK::Read(
+  AcCmdCLRequestMountInfoOK& command,
+  SourceStream& stream)
+{
+  throw std::runtime_error("Not implemented.");
+}
+
 } // namespace server::protocol
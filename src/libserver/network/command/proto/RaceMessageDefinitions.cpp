@@ -20,6 +20,7 @@
 #include "libserver/network/command/proto/RaceMessageDefinitions.hpp"
 
 #include "libserver/network/chatter/ChatterServer.hpp"
+#include "libserver/util/FieldList.hpp"
 
 namespace server::protocol
 {
@@ -93,20 +94,23 @@ void WriteRoomDescription(SinkStream& stream, const RoomDescription& roomDescrip
     .Write(roomDescription.skillBracket);
 }
 
+using AcCmdCREnterRoomFields = FieldList<
+  &AcCmdCREnterRoom::characterUid,
+  &AcCmdCREnterRoom::otp,
+  &AcCmdCREnterRoom::roomUid>;
+
 void AcCmdCREnterRoom::Write(
   const AcCmdCREnterRoom& command,
   SinkStream& stream)
 {
-  throw std::logic_error("Not implemented.");
+  AcCmdCREnterRoomFields::Write(command, stream);
 }
 
 void AcCmdCREnterRoom::Read(
   AcCmdCREnterRoom& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterUid)
-    .Read(command.otp)
-    .Read(command.roomUid);
+  AcCmdCREnterRoomFields::Read(command, stream);
 }
 
 void AcCmdCREnterRoomOK::Write(
@@ -269,20 +273,26 @@ void AcCmdCRChangeTeam::Write(
   throw std::logic_error("Not implemented.");
 }
 
+using AcCmdCRChangeTeamFields = FieldList<
+  &AcCmdCRChangeTeam::characterOid,
+  &AcCmdCRChangeTeam::teamColor>;
+
 void AcCmdCRChangeTeam::Read(
   AcCmdCRChangeTeam& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.teamColor);
+  AcCmdCRChangeTeamFields::Read(command, stream);
 }
 
+using AcCmdCRChangeTeamOKFields = FieldList<
+  &AcCmdCRChangeTeamOK::characterOid,
+  &AcCmdCRChangeTeamOK::teamColor>;
+
 void AcCmdCRChangeTeamOK::Write(
   const AcCmdCRChangeTeamOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.teamColor);
+  AcCmdCRChangeTeamOKFields::Write(command, stream);
 }
 
 void AcCmdCRChangeTeamOK::Read(
@@ -292,12 +302,15 @@ void AcCmdCRChangeTeamOK::Read(
   throw std::logic_error("Not implemented.");
 }
 
+using AcCmdCRChangeTeamNotifyFields = FieldList<
+  &AcCmdCRChangeTeamNotify::characterOid,
+  &AcCmdCRChangeTeamNotify::teamColor>;
+
 void AcCmdCRChangeTeamNotify::Write(
   const AcCmdCRChangeTeamNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.teamColor);
+  AcCmdCRChangeTeamNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRChangeTeamNotify::Read(
@@ -311,7 +324,7 @@ void AcCmdCRLeaveRoom::Write(
   const AcCmdCRLeaveRoom& command,
   SinkStream& stream)
 {
-  throw std::logic_error("Not implemented.");
+  // Empty
 }
 
 void AcCmdCRLeaveRoom::Read(
@@ -334,12 +347,15 @@ void AcCmdCRLeaveRoomOK::Read(
   throw std::logic_error("Not implemented.");
 }
 
+using AcCmdCRLeaveRoomNotifyFields = FieldList<
+  &AcCmdCRLeaveRoomNotify::characterId,
+  &AcCmdCRLeaveRoomNotify::unk0>;
+
 void AcCmdCRLeaveRoomNotify::Write(
   const AcCmdCRLeaveRoomNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterId);
-  stream.Write(command.unk0);
+  AcCmdCRLeaveRoomNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRLeaveRoomNotify::Read(
@@ -353,7 +369,11 @@ void AcCmdCRStartRace::Write(
   const AcCmdCRStartRace& command,
   SinkStream& stream)
 {
-  throw std::logic_error("Not implemented.");
+  stream.Write(static_cast<uint8_t>(command.unk0.size()));
+  for (const auto& element : command.unk0)
+  {
+    stream.Write(element);
+  }
 }
 
 void AcCmdCRStartRace::Read(
@@ -405,14 +425,17 @@ void AcCmdCRStartRaceNotify::Struct1::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRStartRaceNotifyStruct2Fields = FieldList<
+  &AcCmdCRStartRaceNotify::Struct2::unk0,
+  &AcCmdCRStartRaceNotify::Struct2::unk1,
+  &AcCmdCRStartRaceNotify::Struct2::unk2,
+  &AcCmdCRStartRaceNotify::Struct2::unk3>;
+
 void AcCmdCRStartRaceNotify::Struct2::Write(
   const Struct2& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0)
-    .Write(command.unk1)
-    .Write(command.unk2)
-    .Write(command.unk3);
+  AcCmdCRStartRaceNotifyStruct2Fields::Write(command, stream);
 }
 
 void AcCmdCRStartRaceNotify::Struct2::Read(
@@ -503,11 +526,14 @@ void AcCmdCRStartRaceNotify::Read(
   throw std::logic_error("Not implemented.");
 }
 
+using AcCmdCRStartRaceCancelFields = FieldList<
+  &AcCmdCRStartRaceCancel::reason>;
+
 void AcCmdCRStartRaceCancel::Write(
   const AcCmdCRStartRaceCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.reason);
+  AcCmdCRStartRaceCancelFields::Write(command, stream);
 }
 
 void AcCmdCRStartRaceCancel::Read(
@@ -524,19 +550,25 @@ void AcCmdUserRaceTimer::Write(
   throw std::logic_error("Not implemented.");
 }
 
+using AcCmdUserRaceTimerFields = FieldList<
+  &AcCmdUserRaceTimer::timestamp>;
+
 void AcCmdUserRaceTimer::Read(
   AcCmdUserRaceTimer& command,
   SourceStream& stream)
 {
-  stream.Read(command.timestamp);
+  AcCmdUserRaceTimerFields::Read(command, stream);
 }
 
+using AcCmdUserRaceTimerOKFields = FieldList<
+  &AcCmdUserRaceTimerOK::clientTimestamp,
+  &AcCmdUserRaceTimerOK::serverTimestamp>;
+
 void AcCmdUserRaceTimerOK::Write(
   const AcCmdUserRaceTimerOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.clientTimestamp)
-    .Write(command.serverTimestamp);
+  AcCmdUserRaceTimerOKFields::Write(command, stream);
 }
 
 void AcCmdUserRaceTimerOK::Read(
@@ -550,7 +582,7 @@ void AcCmdCRLoadingComplete::Write(
   const AcCmdCRLoadingComplete& command,
   SinkStream& stream)
 {
-  throw std::logic_error("Not implemented.");
+  // Empty.
 }
 
 void AcCmdCRLoadingComplete::Read(
@@ -560,11 +592,14 @@ void AcCmdCRLoadingComplete::Read(
   // Empty.
 }
 
+using AcCmdCRLoadingCompleteNotifyFields = FieldList<
+  &AcCmdCRLoadingCompleteNotify::oid>;
+
 void AcCmdCRLoadingCompleteNotify::Write(
   const AcCmdCRLoadingCompleteNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.oid);
+  AcCmdCRLoadingCompleteNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRLoadingCompleteNotify::Read(
@@ -574,28 +609,34 @@ void AcCmdCRLoadingCompleteNotify::Read(
   throw std::logic_error("Not implemented.");
 }
 
+using AcCmdCRChatFields = FieldList<
+  &AcCmdCRChat::message,
+  &AcCmdCRChat::unknown>;
+
 void AcCmdCRChat::Write(
   const AcCmdCRChat& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented");
+  AcCmdCRChatFields::Write(command, stream);
 }
 
 void AcCmdCRChat::Read(
   AcCmdCRChat& command,
   SourceStream& stream)
 {
-  stream.Read(command.message)
-    .Read(command.unknown);
+  AcCmdCRChatFields::Read(command, stream);
 }
 
+using AcCmdCRChatNotifyFields = FieldList<
+  &AcCmdCRChatNotify::message,
+  &AcCmdCRChatNotify::author,
+  &AcCmdCRChatNotify::isSystem>;
+
 void AcCmdCRChatNotify::Write(
   const AcCmdCRChatNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.message)
-    .Write(command.author)
-    .Write(command.isSystem);
+  AcCmdCRChatNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRChatNotify::Read(
@@ -609,7 +650,7 @@ void AcCmdCRReadyRace::Write(
   const AcCmdCRReadyRace& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented");
+  // Empty.
 }
 
 void AcCmdCRReadyRace::Read(
@@ -619,12 +660,15 @@ void AcCmdCRReadyRace::Read(
   // Empty.
 }
 
+using AcCmdCRReadyRaceNotifyFields = FieldList<
+  &AcCmdCRReadyRaceNotify::characterUid,
+  &AcCmdCRReadyRaceNotify::isReady>;
+
 void AcCmdCRReadyRaceNotify::Write(
   const AcCmdCRReadyRaceNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid)
-    .Write(command.isReady);
+  AcCmdCRReadyRaceNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRReadyRaceNotify::Read(
@@ -634,11 +678,14 @@ void AcCmdCRReadyRaceNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdUserRaceCountdownFields = FieldList<
+  &AcCmdUserRaceCountdown::timestamp>;
+
 void AcCmdUserRaceCountdown::Write(
   const AcCmdUserRaceCountdown& command,
   SinkStream& stream)
 {
-  stream.Write(command.timestamp);
+  AcCmdUserRaceCountdownFields::Write(command, stream);
 }
 
 void AcCmdUserRaceCountdown::Read(
@@ -655,21 +702,27 @@ void AcCmdUserRaceFinal::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdUserRaceFinalFields = FieldList<
+  &AcCmdUserRaceFinal::oid,
+  &AcCmdUserRaceFinal::courseTime,
+  &AcCmdUserRaceFinal::member3>;
+
 void AcCmdUserRaceFinal::Read(
   AcCmdUserRaceFinal& command,
   SourceStream& stream)
 {
-  stream.Read(command.oid)
-    .Read(command.courseTime)
-    .Read(command.member3);
+  AcCmdUserRaceFinalFields::Read(command, stream);
 }
 
+using AcCmdUserRaceFinalNotifyFields = FieldList<
+  &AcCmdUserRaceFinalNotify::oid,
+  &AcCmdUserRaceFinalNotify::courseTime>;
+
 void AcCmdUserRaceFinalNotify::Write(
   const AcCmdUserRaceFinalNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.oid)
-    .Write(command.courseTime);
+  AcCmdUserRaceFinalNotifyFields::Write(command, stream);
 }
 
 void AcCmdUserRaceFinalNotify::Read(
@@ -715,16 +768,19 @@ void AcCmdCRRaceResult::Read(
     .Read(command.member14);
 }
 
+using AcCmdCRRaceResultOKFields = FieldList<
+  &AcCmdCRRaceResultOK::member1,
+  &AcCmdCRRaceResultOK::member2,
+  &AcCmdCRRaceResultOK::member3,
+  &AcCmdCRRaceResultOK::member4,
+  &AcCmdCRRaceResultOK::member5,
+  &AcCmdCRRaceResultOK::member6>;
+
 void AcCmdCRRaceResultOK::Write(
   const AcCmdCRRaceResultOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.member2)
-    .Write(command.member3)
-    .Write(command.member4)
-    .Write(command.member5)
-    .Write(command.member6);
+  AcCmdCRRaceResultOKFields::Write(command, stream);
 }
 
 void AcCmdCRRaceResultOK::Read(
@@ -852,11 +908,14 @@ void AcCmdCRAwardStart::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRAwardStartFields = FieldList<
+  &AcCmdCRAwardStart::member1>;
+
 void AcCmdCRAwardStart::Read(
   AcCmdCRAwardStart& command,
   SourceStream& stream)
 {
-  stream.Read(command.member1);
+  AcCmdCRAwardStartFields::Read(command, stream);
 }
 
 void AcCmdCRAwardEnd::Write(
@@ -873,11 +932,14 @@ void AcCmdCRAwardEnd::Read(
   // Empty.
 }
 
+using AcCmdRCAwardNotifyFields = FieldList<
+  &AcCmdRCAwardNotify::member1>;
+
 void AcCmdRCAwardNotify::Write(
   const AcCmdRCAwardNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1);
+  AcCmdRCAwardNotifyFields::Write(command, stream);
 }
 
 void AcCmdRCAwardNotify::Read(
@@ -908,22 +970,28 @@ void AcCmdCRStarPointGet::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRStarPointGetFields = FieldList<
+  &AcCmdCRStarPointGet::characterOid,
+  &AcCmdCRStarPointGet::unk1,
+  &AcCmdCRStarPointGet::gainedStarPoints>;
+
 void AcCmdCRStarPointGet::Read(
   AcCmdCRStarPointGet& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.unk1)
-    .Read(command.gainedStarPoints);
+  AcCmdCRStarPointGetFields::Read(command, stream);
 }
 
+using AcCmdCRStarPointGetOKFields = FieldList<
+  &AcCmdCRStarPointGetOK::characterOid,
+  &AcCmdCRStarPointGetOK::starPointValue,
+  &AcCmdCRStarPointGetOK::giveMagicItem>;
+
 void AcCmdCRStarPointGetOK::Write(
   const AcCmdCRStarPointGetOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.starPointValue)
-    .Write(command.giveMagicItem);
+  AcCmdCRStarPointGetOKFields::Write(command, stream);
 }
 
 void AcCmdCRStarPointGetOK::Read(
@@ -940,23 +1008,29 @@ void AcCmdCRRequestSpur::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRequestSpurFields = FieldList<
+  &AcCmdCRRequestSpur::characterOid,
+  &AcCmdCRRequestSpur::activeBoosters,
+  &AcCmdCRRequestSpur::comboBreak>;
+
 void AcCmdCRRequestSpur::Read(
   AcCmdCRRequestSpur& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.activeBoosters)
-    .Read(command.comboBreak);
+  AcCmdCRRequestSpurFields::Read(command, stream);
 }
 
+using AcCmdCRRequestSpurOKFields = FieldList<
+  &AcCmdCRRequestSpurOK::characterOid,
+  &AcCmdCRRequestSpurOK::activeBoosters,
+  &AcCmdCRRequestSpurOK::startPointValue,
+  &AcCmdCRRequestSpurOK::comboBreak>;
+
 void AcCmdCRRequestSpurOK::Write(
   const AcCmdCRRequestSpurOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.activeBoosters)
-    .Write(command.startPointValue)
-    .Write(command.comboBreak);
+  AcCmdCRRequestSpurOKFields::Write(command, stream);
 }
 
 void AcCmdCRRequestSpurOK::Read(
@@ -973,22 +1047,28 @@ void AcCmdCRHurdleClearResult::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHurdleClearResultFields = FieldList<
+  &AcCmdCRHurdleClearResult::characterOid,
+  &AcCmdCRHurdleClearResult::hurdleClearType>;
+
 void AcCmdCRHurdleClearResult::Read(
   AcCmdCRHurdleClearResult& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.hurdleClearType);
+  AcCmdCRHurdleClearResultFields::Read(command, stream);
 }
 
+using AcCmdCRHurdleClearResultOKFields = FieldList<
+  &AcCmdCRHurdleClearResultOK::characterOid,
+  &AcCmdCRHurdleClearResultOK::hurdleClearType,
+  &AcCmdCRHurdleClearResultOK::jumpCombo,
+  &AcCmdCRHurdleClearResultOK::unk3>;
+
 void AcCmdCRHurdleClearResultOK::Write(
   const AcCmdCRHurdleClearResultOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.hurdleClearType)
-    .Write(command.jumpCombo)
-    .Write(command.unk3);
+  AcCmdCRHurdleClearResultOKFields::Write(command, stream);
 }
 
 void AcCmdCRHurdleClearResultOK::Read(
@@ -1005,13 +1085,16 @@ void AcCmdCRStartingRate::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRStartingRateFields = FieldList<
+  &AcCmdCRStartingRate::characterOid,
+  &AcCmdCRStartingRate::unk1,
+  &AcCmdCRStartingRate::boostGained>;
+
 void AcCmdCRStartingRate::Read(
   AcCmdCRStartingRate& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.unk1)
-    .Read(command.boostGained);
+  AcCmdCRStartingRateFields::Read(command, stream);
 }
 
 void AcCmdCRRequestMagicItem::Write(
@@ -1021,21 +1104,27 @@ void AcCmdCRRequestMagicItem::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRequestMagicItemFields = FieldList<
+  &AcCmdCRRequestMagicItem::member1,
+  &AcCmdCRRequestMagicItem::member2>;
+
 void AcCmdCRRequestMagicItem::Read(
   AcCmdCRRequestMagicItem& command,
   SourceStream& stream)
 {
-  stream.Read(command.member1)
-    .Read(command.member2);
+  AcCmdCRRequestMagicItemFields::Read(command, stream);
 }
 
+using AcCmdCRRequestMagicItemOKFields = FieldList<
+  &AcCmdCRRequestMagicItemOK::member1,
+  &AcCmdCRRequestMagicItemOK::member2,
+  &AcCmdCRRequestMagicItemOK::member3>;
+
 void AcCmdCRRequestMagicItemOK::Write(
   const AcCmdCRRequestMagicItemOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.member2)
-    .Write(command.member3);
+  AcCmdCRRequestMagicItemOKFields::Write(command, stream);
 }
 
 void AcCmdCRRequestMagicItemOK::Read(
@@ -1045,12 +1134,15 @@ void AcCmdCRRequestMagicItemOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRequestMagicItemNotifyFields = FieldList<
+  &AcCmdCRRequestMagicItemNotify::member1,
+  &AcCmdCRRequestMagicItemNotify::member2>;
+
 void AcCmdCRRequestMagicItemNotify::Write(
   const AcCmdCRRequestMagicItemNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.member2);
+  AcCmdCRRequestMagicItemNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRRequestMagicItemNotify::Read(
@@ -1060,41 +1152,42 @@ void AcCmdCRRequestMagicItemNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdUserRaceUpdatePosFields = FieldList<
+  &AcCmdUserRaceUpdatePos::oid,
+  &AcCmdUserRaceUpdatePos::member2,
+  &AcCmdUserRaceUpdatePos::member3,
+  &AcCmdUserRaceUpdatePos::member4,
+  &AcCmdUserRaceUpdatePos::member5,
+  &AcCmdUserRaceUpdatePos::member6,
+  &AcCmdUserRaceUpdatePos::member7>;
+
+// The position is updated many times a second by every racer,
+// expect it to be copied in one region of the stream.
+static_assert(AcCmdUserRaceUpdatePosFields::IsFixedSize);
+
 void AcCmdUserRaceUpdatePos::Write(
   const AcCmdUserRaceUpdatePos& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented");
+  AcCmdUserRaceUpdatePosFields::Write(command, stream);
 }
 
 void AcCmdUserRaceUpdatePos::Read(
   AcCmdUserRaceUpdatePos& command,
   SourceStream& stream)
 {
-  stream.Read(command.oid);
-
-  for (auto& element : command.member2)
-  {
-    stream.Read(element);
-  }
-
-  for (auto& element : command.member3)
-  {
-    stream.Read(element);
-  }
-
-  stream.Read(command.member4)
-    .Read(command.member5)
-    .Read(command.member6)
-    .Read(command.member7);
+  AcCmdUserRaceUpdatePosFields::Read(command, stream);
 }
 
+using AcCmdRCRoomCountdownFields = FieldList<
+  &AcCmdRCRoomCountdown::member0,
+  &AcCmdRCRoomCountdown::member1>;
+
 void AcCmdRCRoomCountdown::Write(
   const AcCmdRCRoomCountdown& command,
   SinkStream& stream)
 {
-  stream.Write(command.member0)
-    .Write(command.member1);
+  AcCmdRCRoomCountdownFields::Write(command, stream);
 }
 
 void AcCmdRCRoomCountdown::Read(
@@ -1118,11 +1211,14 @@ void AcCmdRCRoomCountdownCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRChangeMasterNotifyFields = FieldList<
+  &AcCmdCRChangeMasterNotify::masterUid>;
+
 void AcCmdCRChangeMasterNotify::Write(
   const AcCmdCRChangeMasterNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.masterUid);
+  AcCmdCRChangeMasterNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRChangeMasterNotify::Read(
@@ -1136,11 +1232,8 @@ void AcCmdCRRelayCommand::Write(
   const AcCmdCRRelayCommand& command,
   SinkStream& stream)
 {
-  stream.Write(command.senderOid);
-  for (const auto& byte : command.relayData)
-  {
-    stream.Write(byte);
-  }
+  stream.Write(command.senderOid)
+    .Write(std::span(command.relayData));
 }
 
 void AcCmdCRRelayCommand::Read(
@@ -1152,21 +1245,15 @@ void AcCmdCRRelayCommand::Read(
   // Read remaining bytes as relay data
   const auto remainingBytes = stream.Size() - stream.GetCursor();
   command.relayData.resize(remainingBytes);
-  for (auto& byte : command.relayData)
-  {
-    stream.Read(byte);
-  }
+  stream.Read(std::span(command.relayData));
 }
 
 void AcCmdCRRelayCommandNotify::Write(
   const AcCmdCRRelayCommandNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.senderOid);
-  for (const auto& byte : command.relayData)
-  {
-    stream.Write(byte);
-  }
+  stream.Write(command.senderOid)
+    .Write(std::span(command.relayData));
 }
 
 void AcCmdCRRelayCommandNotify::Read(
@@ -1178,21 +1265,15 @@ void AcCmdCRRelayCommandNotify::Read(
   // Read remaining bytes as relay data
   const auto remainingBytes = stream.Size() - stream.GetCursor();
   command.relayData.resize(remainingBytes);
-  for (auto& byte : command.relayData)
-  {
-    stream.Read(byte);
-  }
+  stream.Read(std::span(command.relayData));
 }
 
 void AcCmdCRRelay::Write(
   const AcCmdCRRelay& command,
   SinkStream& stream)
 {
-  stream.Write(command.senderOid);
-  for (const auto& byte : command.relayData)
-  {
-    stream.Write(byte);
-  }
+  stream.Write(command.senderOid)
+    .Write(std::span(command.relayData));
 }
 
 void AcCmdCRRelay::Read(
@@ -1204,21 +1285,15 @@ void AcCmdCRRelay::Read(
   // Read remaining bytes as relay data
   const auto remainingBytes = stream.Size() - stream.GetCursor();
   command.relayData.resize(remainingBytes);
-  for (auto& byte : command.relayData)
-  {
-    stream.Read(byte);
-  }
+  stream.Read(std::span(command.relayData));
 }
 
 void AcCmdCRRelayNotify::Write(
   const AcCmdCRRelayNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.senderOid);
-  for (const auto& byte : command.relayData)
-  {
-    stream.Write(byte);
-  }
+  stream.Write(command.senderOid)
+    .Write(std::span(command.relayData));
 }
 
 void AcCmdCRRelayNotify::Read(
@@ -1230,22 +1305,22 @@ void AcCmdCRRelayNotify::Read(
   // Read remaining bytes as relay data
   const auto remainingBytes = stream.Size() - stream.GetCursor();
   command.relayData.resize(remainingBytes);
-  for (auto& byte : command.relayData)
-  {
-    stream.Read(byte);
-  }
+  stream.Read(std::span(command.relayData));
 }
 
+using AcCmdRCTeamSpurGaugeFields = FieldList<
+  &AcCmdRCTeamSpurGauge::member1,
+  &AcCmdRCTeamSpurGauge::member2,
+  &AcCmdRCTeamSpurGauge::member3,
+  &AcCmdRCTeamSpurGauge::member4,
+  &AcCmdRCTeamSpurGauge::member5,
+  &AcCmdRCTeamSpurGauge::member6>;
+
 void AcCmdRCTeamSpurGauge::Write(
   const AcCmdRCTeamSpurGauge& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.member2)
-    .Write(command.member3)
-    .Write(command.member4)
-    .Write(command.member5)
-    .Write(command.member6);
+  AcCmdRCTeamSpurGaugeFields::Write(command, stream);
 }
 
 void AcCmdRCTeamSpurGauge::Read(
@@ -1255,13 +1330,16 @@ void AcCmdRCTeamSpurGauge::Read(
   throw std::runtime_error("Not implemented");  
 }
 
+using AcCmdUserRaceActivateInteractiveEventFields = FieldList<
+  &AcCmdUserRaceActivateInteractiveEvent::member1,
+  &AcCmdUserRaceActivateInteractiveEvent::characterOid,
+  &AcCmdUserRaceActivateInteractiveEvent::member3>;
+
 void AcCmdUserRaceActivateInteractiveEvent::Write(
   const AcCmdUserRaceActivateInteractiveEvent& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.characterOid)
-    .Write(command.member3);
+  AcCmdUserRaceActivateInteractiveEventFields::Write(command, stream);
 }
 
 void AcCmdUserRaceActivateInteractiveEvent::Read(
@@ -1272,12 +1350,15 @@ void AcCmdUserRaceActivateInteractiveEvent::Read(
     .Read(command.member3);
 }
 
+using AcCmdUserRaceActivateEventFields = FieldList<
+  &AcCmdUserRaceActivateEvent::eventId,
+  &AcCmdUserRaceActivateEvent::characterOid>;
+
 void AcCmdUserRaceActivateEvent::Write(
   const AcCmdUserRaceActivateEvent& command,
   SinkStream& stream)
 {
-  stream.Write(command.eventId)
-    .Write(command.characterOid);
+  AcCmdUserRaceActivateEventFields::Write(command, stream);
 }
 
 void AcCmdUserRaceActivateEvent::Read(
@@ -1482,84 +1563,140 @@ void AcCmdUserRaceItemGet::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdUserRaceItemGetFields = FieldList<
+  &AcCmdUserRaceItemGet::characterOid,
+  &AcCmdUserRaceItemGet::itemId,
+  &AcCmdUserRaceItemGet::unk3>;
+
 void AcCmdUserRaceItemGet::Read(
   AcCmdUserRaceItemGet& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.itemId)
-    .Read(command.unk3);
+  AcCmdUserRaceItemGetFields::Read(command, stream);
 }
 
+using AcCmdGameRaceItemGetFields = FieldList<
+  &AcCmdGameRaceItemGet::characterOid,
+  &AcCmdGameRaceItemGet::itemId,
+  &AcCmdGameRaceItemGet::itemType>;
+
 void AcCmdGameRaceItemGet::Write(
   const AcCmdGameRaceItemGet& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.itemId)
-    .Write(command.itemType);
+  AcCmdGameRaceItemGetFields::Write(command, stream);
 }
 
 void AcCmdGameRaceItemGet::Read(
   AcCmdGameRaceItemGet& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.itemId)
-    .Read(command.itemType);
+  AcCmdGameRaceItemGetFields::Read(command, stream);
 }
 
 // Magic Targeting Commands Implementation
+using AcCmdCRStartMagicTargetFields = FieldList<
+  &AcCmdCRStartMagicTarget::characterOid>;
+
+void AcCmdCRStartMagicTarget::Write(
+  const AcCmdCRStartMagicTarget& command,
+  SinkStream& stream)
+{
+  AcCmdCRStartMagicTargetFields::Write(command, stream);
+}
+
 void AcCmdCRStartMagicTarget::Read(
   AcCmdCRStartMagicTarget& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid);
+  AcCmdCRStartMagicTargetFields::Read(command, stream);
 }
 
+using AcCmdCRChangeMagicTargetNotifyFields = FieldList<
+  &AcCmdCRChangeMagicTargetNotify::characterOid,
+  &AcCmdCRChangeMagicTargetNotify::targetOid>;
+
 void AcCmdCRChangeMagicTargetNotify::Write(
   const AcCmdCRChangeMagicTargetNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.targetOid);
+  AcCmdCRChangeMagicTargetNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRChangeMagicTargetNotify::Read(
   AcCmdCRChangeMagicTargetNotify& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.targetOid);
+  AcCmdCRChangeMagicTargetNotifyFields::Read(command, stream);
+}
+
+using AcCmdCRChangeMagicTargetOKFields = FieldList<
+  &AcCmdCRChangeMagicTargetOK::characterOid,
+  &AcCmdCRChangeMagicTargetOK::targetOid>;
+
+void AcCmdCRChangeMagicTargetOK::Write(
+  const AcCmdCRChangeMagicTargetOK& command,
+  SinkStream& stream)
+{
+  AcCmdCRChangeMagicTargetOKFields::Write(command, stream);
 }
 
 void AcCmdCRChangeMagicTargetOK::Read(
   AcCmdCRChangeMagicTargetOK& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.targetOid);
+  AcCmdCRChangeMagicTargetOKFields::Read(command, stream);
+}
+
+using AcCmdCRChangeMagicTargetCancelFields = FieldList<
+  &AcCmdCRChangeMagicTargetCancel::characterOid>;
+
+void AcCmdCRChangeMagicTargetCancel::Write(
+  const AcCmdCRChangeMagicTargetCancel& command,
+  SinkStream& stream)
+{
+  AcCmdCRChangeMagicTargetCancelFields::Write(command, stream);
 }
 
 void AcCmdCRChangeMagicTargetCancel::Read(
   AcCmdCRChangeMagicTargetCancel& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid);
+  AcCmdCRChangeMagicTargetCancelFields::Read(command, stream);
 }
 
+using AcCmdRCRemoveMagicTargetFields = FieldList<
+  &AcCmdRCRemoveMagicTarget::characterOid>;
+
 void AcCmdRCRemoveMagicTarget::Write(
   const AcCmdRCRemoveMagicTarget& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid);
+  AcCmdRCRemoveMagicTargetFields::Write(command, stream);
+}
+
+void AcCmdRCRemoveMagicTarget::Read(
+  AcCmdRCRemoveMagicTarget& command,
+  SourceStream& stream)
+{
+  AcCmdRCRemoveMagicTargetFields::Read(command, stream);
 }
 
+using AcCmdRCMagicExpireFields = FieldList<
+  &AcCmdRCMagicExpire::characterOid>;
+
 void AcCmdRCMagicExpire::Write(
   const AcCmdRCMagicExpire& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid);
+  AcCmdRCMagicExpireFields::Write(command, stream);
+}
+
+void AcCmdRCMagicExpire::Read(
+  AcCmdRCMagicExpire& command,
+  SourceStream& stream)
+{
+  AcCmdRCMagicExpireFields::Read(command, stream);
 }
 
 void AcCmdCRUseMagicItemNotify::Write(
@@ -1712,64 +1849,64 @@ void AcCmdCRUseMagicItemNotify::Read(
   }
 }
 
+using AcCmdRCTriggerActivateFields = FieldList<
+  &AcCmdRCTriggerActivate::characterOid,
+  &AcCmdRCTriggerActivate::triggerType,
+  &AcCmdRCTriggerActivate::triggerValue,
+  &AcCmdRCTriggerActivate::duration>;
+
 void AcCmdRCTriggerActivate::Write(
   const AcCmdRCTriggerActivate& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.triggerType)
-    .Write(command.triggerValue)
-    .Write(command.duration);
+  AcCmdRCTriggerActivateFields::Write(command, stream);
 }
 
 void AcCmdRCTriggerActivate::Read(
   AcCmdRCTriggerActivate& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.triggerType)
-    .Read(command.triggerValue)
-    .Read(command.duration);
+  AcCmdRCTriggerActivateFields::Read(command, stream);
 }
 
+using AcCmdCRActivateSkillEffectFields = FieldList<
+  &AcCmdCRActivateSkillEffect::characterOid,
+  &AcCmdCRActivateSkillEffect::skillId,
+  &AcCmdCRActivateSkillEffect::unk1,
+  &AcCmdCRActivateSkillEffect::unk2>;
+
 void AcCmdCRActivateSkillEffect::Write(
   const AcCmdCRActivateSkillEffect& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.skillId)
-    .Write(command.unk1)
-    .Write(command.unk2);
+  AcCmdCRActivateSkillEffectFields::Write(command, stream);
 }
 
 void AcCmdCRActivateSkillEffect::Read(
   AcCmdCRActivateSkillEffect& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.skillId)
-    .Read(command.unk1)
-    .Read(command.unk2);
+  AcCmdCRActivateSkillEffectFields::Read(command, stream);
 }
 
+using AcCmdRCAddSkillEffectFields = FieldList<
+  &AcCmdRCAddSkillEffect::characterOid,
+  &AcCmdRCAddSkillEffect::effectId,
+  &AcCmdRCAddSkillEffect::duration,
+  &AcCmdRCAddSkillEffect::intensity>;
+
 void AcCmdRCAddSkillEffect::Write(
   const AcCmdRCAddSkillEffect& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterOid)
-    .Write(command.effectId)
-    .Write(command.duration)
-    .Write(command.intensity);
+  AcCmdRCAddSkillEffectFields::Write(command, stream);
 }
 
 void AcCmdRCAddSkillEffect::Read(
   AcCmdRCAddSkillEffect& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterOid)
-    .Read(command.effectId)
-    .Read(command.duration)
-    .Read(command.intensity);
+  AcCmdRCAddSkillEffectFields::Read(command, stream);
 }
 
 } // namespace server::protocol
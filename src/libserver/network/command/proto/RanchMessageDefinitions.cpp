@@ -19,6 +19,8 @@
 
 #include "libserver/network/command/proto/RanchMessageDefinitions.hpp"
 
+#include "libserver/util/FieldList.hpp"
+
 #include <cassert>
 #include <algorithm>
 #include <format>
@@ -33,14 +35,17 @@ void AcCmdCRUseItem::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRUseItemFields = FieldList<
+  &AcCmdCRUseItem::itemUid,
+  &AcCmdCRUseItem::always1,
+  &AcCmdCRUseItem::horseUid,
+  &AcCmdCRUseItem::playSuccessLevel>;
+
 void AcCmdCRUseItem::Read(
   AcCmdCRUseItem& command,
   SourceStream& stream)
 {
-  stream.Read(command.itemUid)
-    .Read(command.always1)
-    .Read(command.horseUid)
-    .Read(command.playSuccessLevel);
+  AcCmdCRUseItemFields::Read(command, stream);
 }
 
 void AcCmdCRUseItemOK::Write(
@@ -71,12 +76,15 @@ void AcCmdCRUseItemOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRUseItemCancelFields = FieldList<
+  &AcCmdCRUseItemCancel::itemUid,
+  &AcCmdCRUseItemCancel::rewardExperience>;
+
 void AcCmdCRUseItemCancel::Write(
   const AcCmdCRUseItemCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.itemUid)
-    .Write(command.rewardExperience);
+  AcCmdCRUseItemCancelFields::Write(command, stream);
 }
 
 void AcCmdCRUseItemCancel::Read(
@@ -93,11 +101,14 @@ void RanchCommandMountFamilyTree::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandMountFamilyTreeFields = FieldList<
+  &RanchCommandMountFamilyTree::horseUid>;
+
 void RanchCommandMountFamilyTree::Read(
   RanchCommandMountFamilyTree& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid);
+  RanchCommandMountFamilyTreeFields::Read(command, stream);
 }
 
 void RanchCommandMountFamilyTreeOK::Write(
@@ -133,20 +144,23 @@ void RanchCommandMountFamilyTreeCancel::Read(
 {
 }
 
+using AcCmdCREnterRanchFields = FieldList<
+  &AcCmdCREnterRanch::characterUid,
+  &AcCmdCREnterRanch::otp,
+  &AcCmdCREnterRanch::rancherUid>;
+
 void AcCmdCREnterRanch::Write(
   const AcCmdCREnterRanch& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  AcCmdCREnterRanchFields::Write(command, stream);
 }
 
 void AcCmdCREnterRanch::Read(
   AcCmdCREnterRanch& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterUid)
-    .Read(command.otp)
-    .Read(command.rancherUid);
+  AcCmdCREnterRanchFields::Read(command, stream);
 }
 
 void AcCmdCREnterRanchOK::Write(
@@ -229,11 +243,14 @@ void RanchCommandEnterRanchCancel::Read(
 {
 }
 
+using RanchCommandEnterRanchNotifyFields = FieldList<
+  &RanchCommandEnterRanchNotify::character>;
+
 void RanchCommandEnterRanchNotify::Write(
   const RanchCommandEnterRanchNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.character);
+  RanchCommandEnterRanchNotifyFields::Write(command, stream);
 }
 
 void RanchCommandEnterRanchNotify::Read(
@@ -335,7 +352,28 @@ void AcCmdCRRanchSnapshot::Write(
   const AcCmdCRRanchSnapshot& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  stream.Write(command.type);
+
+  switch (command.type)
+  {
+    case Full:
+      {
+        stream.Write(command.full);
+        break;
+      }
+    case Partial:
+      {
+        stream.Write(command.partial);
+        break;
+      }
+    default:
+      {
+        throw std::runtime_error(
+          std::format(
+            "Update type {} not implemented",
+            static_cast<uint32_t>(command.type)));
+      }
+  }
 }
 
 void AcCmdCRRanchSnapshot::Read(
@@ -418,13 +456,16 @@ void AcCmdCRRanchCmdAction::Read(
   stream.Read(command.snapshot.data(), length);
 }
 
+using RanchCommandRanchCmdActionNotifyFields = FieldList<
+  &RanchCommandRanchCmdActionNotify::unk0,
+  &RanchCommandRanchCmdActionNotify::unk1,
+  &RanchCommandRanchCmdActionNotify::unk2>;
+
 void RanchCommandRanchCmdActionNotify::Write(
   const RanchCommandRanchCmdActionNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0)
-    .Write(command.unk1)
-    .Write(command.unk2);
+  RanchCommandRanchCmdActionNotifyFields::Write(command, stream);
 }
 
 void RanchCommandRanchCmdActionNotify::Read(
@@ -441,19 +482,25 @@ void RanchCommandUpdateBusyState::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandUpdateBusyStateFields = FieldList<
+  &RanchCommandUpdateBusyState::busyState>;
+
 void RanchCommandUpdateBusyState::Read(
   RanchCommandUpdateBusyState& command,
   SourceStream& stream)
 {
-  stream.Read(command.busyState);
+  RanchCommandUpdateBusyStateFields::Read(command, stream);
 }
 
+using RanchCommandUpdateBusyStateNotifyFields = FieldList<
+  &RanchCommandUpdateBusyStateNotify::characterUid,
+  &RanchCommandUpdateBusyStateNotify::busyState>;
+
 void RanchCommandUpdateBusyStateNotify::Write(
   const RanchCommandUpdateBusyStateNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid)
-    .Write(command.busyState);
+  RanchCommandUpdateBusyStateNotifyFields::Write(command, stream);
 }
 
 void RanchCommandUpdateBusyStateNotify::Read(
@@ -467,7 +514,7 @@ void AcCmdCRLeaveRanch::Write(
   const AcCmdCRLeaveRanch& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented.");
+  // Empty.
 }
 
 void AcCmdCRLeaveRanch::Read(
@@ -491,11 +538,14 @@ void AcCmdCRLeaveRanchOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRLeaveRanchNotifyFields = FieldList<
+  &AcCmdCRLeaveRanchNotify::characterId>;
+
 void AcCmdCRLeaveRanchNotify::Write(
   const AcCmdCRLeaveRanchNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterId);
+  AcCmdCRLeaveRanchNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRLeaveRanchNotify::Read(
@@ -522,21 +572,27 @@ void RanchCommandRanchStuff::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandRanchStuffFields = FieldList<
+  &RanchCommandRanchStuff::eventId,
+  &RanchCommandRanchStuff::value>;
+
 void RanchCommandRanchStuff::Read(
   RanchCommandRanchStuff& command,
   SourceStream& stream)
 {
-  stream.Read(command.eventId)
-    .Read(command.value);
+  RanchCommandRanchStuffFields::Read(command, stream);
 }
 
+using RanchCommandRanchStuffOKFields = FieldList<
+  &RanchCommandRanchStuffOK::eventId,
+  &RanchCommandRanchStuffOK::moneyIncrement,
+  &RanchCommandRanchStuffOK::totalMoney>;
+
 void RanchCommandRanchStuffOK::Write(
   const RanchCommandRanchStuffOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.eventId)
-    .Write(command.moneyIncrement)
-    .Write(command.totalMoney);
+  RanchCommandRanchStuffOKFields::Write(command, stream);
 }
 
 void RanchCommandRanchStuffOK::Read(
@@ -603,19 +659,25 @@ void AcCmdCRRegisterStallion::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRegisterStallionFields = FieldList<
+  &AcCmdCRRegisterStallion::horseUid,
+  &AcCmdCRRegisterStallion::carrots>;
+
 void AcCmdCRRegisterStallion::Read(
   AcCmdCRRegisterStallion& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid)
-    .Read(command.carrots);
+  AcCmdCRRegisterStallionFields::Read(command, stream);
 }
 
+using AcCmdCRRegisterStallionOKFields = FieldList<
+  &AcCmdCRRegisterStallionOK::horseUid>;
+
 void AcCmdCRRegisterStallionOK::Write(
   const AcCmdCRRegisterStallionOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.horseUid);
+  AcCmdCRRegisterStallionOKFields::Write(command, stream);
 }
 
 void AcCmdCRRegisterStallionOK::Read(
@@ -646,11 +708,14 @@ void AcCmdCRUnregisterStallion::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRUnregisterStallionFields = FieldList<
+  &AcCmdCRUnregisterStallion::horseUid>;
+
 void AcCmdCRUnregisterStallion::Read(
   AcCmdCRUnregisterStallion& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid);
+  AcCmdCRUnregisterStallionFields::Read(command, stream);
 }
 
 void AcCmdCRUnregisterStallionOK::Write(
@@ -688,22 +753,28 @@ void AcCmdCRUnregisterStallionEstimateInfo::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRUnregisterStallionEstimateInfoFields = FieldList<
+  &AcCmdCRUnregisterStallionEstimateInfo::horseUid>;
+
 void AcCmdCRUnregisterStallionEstimateInfo::Read(
   AcCmdCRUnregisterStallionEstimateInfo& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid);
+  AcCmdCRUnregisterStallionEstimateInfoFields::Read(command, stream);
 }
 
+using AcCmdCRUnregisterStallionEstimateInfoOKFields = FieldList<
+  &AcCmdCRUnregisterStallionEstimateInfoOK::member1,
+  &AcCmdCRUnregisterStallionEstimateInfoOK::timesMated,
+  &AcCmdCRUnregisterStallionEstimateInfoOK::matingCompensation,
+  &AcCmdCRUnregisterStallionEstimateInfoOK::member4,
+  &AcCmdCRUnregisterStallionEstimateInfoOK::matingPrice>;
+
 void AcCmdCRUnregisterStallionEstimateInfoOK::Write(
   const AcCmdCRUnregisterStallionEstimateInfoOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.timesMated)
-    .Write(command.matingCompensation)
-    .Write(command.member4)
-    .Write(command.matingPrice);
+  AcCmdCRUnregisterStallionEstimateInfoOKFields::Write(command, stream);
 }
 
 void AcCmdCRUnregisterStallionEstimateInfoOK::Read(
@@ -790,6 +861,18 @@ void RanchCommandEnterBreedingMarketCancel::Read(
 {
 }
 
+void RanchCommandLeaveBreedingMarket::Write(
+  const RanchCommandLeaveBreedingMarket& command,
+  SinkStream& stream)
+{
+}
+
+void RanchCommandLeaveBreedingMarket::Read(
+  RanchCommandLeaveBreedingMarket& command,
+  SourceStream& stream)
+{
+}
+
 void RanchCommandEnterBreedingMarketOK::Write(
   const RanchCommandEnterBreedingMarketOK& command,
   SinkStream& stream)
@@ -825,24 +908,30 @@ void AcCmdCRTryBreeding::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRTryBreedingFields = FieldList<
+  &AcCmdCRTryBreeding::mareUid,
+  &AcCmdCRTryBreeding::stallionUid>;
+
 void AcCmdCRTryBreeding::Read(
   AcCmdCRTryBreeding& command,
   SourceStream& stream)
 {
-  stream.Read(command.mareUid)
-    .Read(command.stallionUid);
+  AcCmdCRTryBreedingFields::Read(command, stream);
 }
 
+using RanchCommandTryBreedingCancelFields = FieldList<
+  &RanchCommandTryBreedingCancel::unk0,
+  &RanchCommandTryBreedingCancel::unk1,
+  &RanchCommandTryBreedingCancel::unk2,
+  &RanchCommandTryBreedingCancel::unk3,
+  &RanchCommandTryBreedingCancel::unk4,
+  &RanchCommandTryBreedingCancel::unk5>;
+
 void RanchCommandTryBreedingCancel::Write(
   const RanchCommandTryBreedingCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0)
-    .Write(command.unk1)
-    .Write(command.unk2)
-    .Write(command.unk3)
-    .Write(command.unk4)
-    .Write(command.unk5);
+  RanchCommandTryBreedingCancelFields::Write(command, stream);
 }
 
 void RanchCommandTryBreedingCancel::Read(
@@ -859,18 +948,24 @@ void AcCmdCRBreedingAbandon::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRBreedingAbandonFields = FieldList<
+  &AcCmdCRBreedingAbandon::horseUid>;
+
 void AcCmdCRBreedingAbandon::Read(
   AcCmdCRBreedingAbandon& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid);
+  AcCmdCRBreedingAbandonFields::Read(command, stream);
 }
 
+using RanchCommandBreedingAbandonOKFields = FieldList<
+  &AcCmdCRBreedingAbandon::horseUid>;
+
 void RanchCommandBreedingAbandonOK::Write(
   const AcCmdCRBreedingAbandon& command,
   SinkStream& stream)
 {
-  stream.Write(command.horseUid);
+  RanchCommandBreedingAbandonOKFields::Write(command, stream);
 }
 
 void RanchCommandBreedingAbandonOK::Read(
@@ -880,11 +975,14 @@ void RanchCommandBreedingAbandonOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandBreedingAbandonCancelFields = FieldList<
+  &AcCmdCRBreedingAbandon::horseUid>;
+
 void RanchCommandBreedingAbandonCancel::Write(
   const AcCmdCRBreedingAbandon& command,
   SinkStream& stream)
 {
-  stream.Write(command.horseUid);
+  RanchCommandBreedingAbandonCancelFields::Write(command, stream);
 }
 
 void RanchCommandBreedingAbandonCancel::Read(
@@ -894,28 +992,31 @@ void RanchCommandBreedingAbandonCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandTryBreedingOKFields = FieldList<
+  &RanchCommandTryBreedingOK::uid,
+  &RanchCommandTryBreedingOK::tid,
+  &RanchCommandTryBreedingOK::val,
+  &RanchCommandTryBreedingOK::count,
+  &RanchCommandTryBreedingOK::unk0,
+  &RanchCommandTryBreedingOK::parts,
+  &RanchCommandTryBreedingOK::appearance,
+  &RanchCommandTryBreedingOK::stats,
+  &RanchCommandTryBreedingOK::unk1,
+  &RanchCommandTryBreedingOK::unk2,
+  &RanchCommandTryBreedingOK::unk3,
+  &RanchCommandTryBreedingOK::unk4,
+  &RanchCommandTryBreedingOK::unk5,
+  &RanchCommandTryBreedingOK::unk6,
+  &RanchCommandTryBreedingOK::unk7,
+  &RanchCommandTryBreedingOK::unk8,
+  &RanchCommandTryBreedingOK::unk9,
+  &RanchCommandTryBreedingOK::unk10>;
+
 void RanchCommandTryBreedingOK::Write(
   const RanchCommandTryBreedingOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.uid)
-    .Write(command.tid)
-    .Write(command.val)
-    .Write(command.count)
-    .Write(command.unk0)
-    .Write(command.parts)
-    .Write(command.appearance)
-    .Write(command.stats)
-    .Write(command.unk1)
-    .Write(command.unk2)
-    .Write(command.unk3)
-    .Write(command.unk4)
-    .Write(command.unk5)
-    .Write(command.unk6)
-    .Write(command.unk7)
-    .Write(command.unk8)
-    .Write(command.unk9)
-    .Write(command.unk10);
+  RanchCommandTryBreedingOKFields::Write(command, stream);
 }
 
 void RanchCommandTryBreedingOK::Read(
@@ -990,20 +1091,26 @@ void RanchCommandUpdateMountNickname::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandUpdateMountNicknameFields = FieldList<
+  &RanchCommandUpdateMountNickname::horseUid,
+  &RanchCommandUpdateMountNickname::name,
+  &RanchCommandUpdateMountNickname::unk1>;
+
 void RanchCommandUpdateMountNickname::Read(
   RanchCommandUpdateMountNickname& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid)
-    .Read(command.name)
-    .Read(command.unk1);
+  RanchCommandUpdateMountNicknameFields::Read(command, stream);
 }
 
+using RanchCommandUpdateMountNicknameCancelFields = FieldList<
+  &RanchCommandUpdateMountNicknameCancel::unk0>;
+
 void RanchCommandUpdateMountNicknameCancel::Write(
   const RanchCommandUpdateMountNicknameCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0);
+  RanchCommandUpdateMountNicknameCancelFields::Write(command, stream);
 }
 
 void RanchCommandUpdateMountNicknameCancel::Read(
@@ -1013,13 +1120,16 @@ void RanchCommandUpdateMountNicknameCancel::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdRCUpdateMountInfoNotifyFields = FieldList<
+  &AcCmdRCUpdateMountInfoNotify::action,
+  &AcCmdRCUpdateMountInfoNotify::member1,
+  &AcCmdRCUpdateMountInfoNotify::horse>;
+
 void AcCmdRCUpdateMountInfoNotify::Write(
   const AcCmdRCUpdateMountInfoNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.action)
-    .Write(command.member1)
-    .Write(command.horse);
+  AcCmdRCUpdateMountInfoNotifyFields::Write(command, stream);
 }
 
 void AcCmdRCUpdateMountInfoNotify::Read(
@@ -1029,14 +1139,17 @@ void AcCmdRCUpdateMountInfoNotify::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandUpdateMountNicknameOKFields = FieldList<
+  &RanchCommandUpdateMountNicknameOK::horseUid,
+  &RanchCommandUpdateMountNicknameOK::nickname,
+  &RanchCommandUpdateMountNicknameOK::unk1,
+  &RanchCommandUpdateMountNicknameOK::unk2>;
+
 void RanchCommandUpdateMountNicknameOK::Write(
   const RanchCommandUpdateMountNicknameOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.horseUid)
-    .Write(command.nickname)
-    .Write(command.unk1)
-    .Write(command.unk2);
+  RanchCommandUpdateMountNicknameOKFields::Write(command, stream);
 }
 
 void RanchCommandUpdateMountNicknameOK::Read(
@@ -1053,9 +1166,13 @@ void AcCmdCRRequestStorage::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRRequestStorageFields = FieldList<
+  &AcCmdCRRequestStorage::category,
+  &AcCmdCRRequestStorage::page>;
+
 void AcCmdCRRequestStorage::Read(AcCmdCRRequestStorage& command, SourceStream& stream)
 {
-  stream.Read(command.category).Read(command.page);
+  AcCmdCRRequestStorageFields::Read(command, stream);
 }
 
 void AcCmdCRRequestStorageOK::Write(
@@ -1078,11 +1195,15 @@ void AcCmdCRRequestStorageOK::Read(AcCmdCRRequestStorageOK& command, SourceStrea
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRRequestStorageCancelFields = FieldList<
+  &AcCmdCRRequestStorageCancel::category,
+  &AcCmdCRRequestStorageCancel::val1>;
+
 void AcCmdCRRequestStorageCancel::Write(
   const AcCmdCRRequestStorageCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.category).Write(command.val1);
+  AcCmdCRRequestStorageCancelFields::Write(command, stream);
 }
 
 void AcCmdCRRequestStorageCancel::Read(
@@ -1099,11 +1220,14 @@ void AcCmdCRGetItemFromStorage::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRGetItemFromStorageFields = FieldList<
+  &AcCmdCRGetItemFromStorage::storedItemUid>;
+
 void AcCmdCRGetItemFromStorage::Read(
   AcCmdCRGetItemFromStorage& command,
   SourceStream& stream)
 {
-  stream.Read(command.storedItemUid);
+  AcCmdCRGetItemFromStorageFields::Read(command, stream);
 }
 
 void AcCmdCRGetItemFromStorageOK::Write(
@@ -1126,12 +1250,15 @@ void AcCmdCRGetItemFromStorageOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRGetItemFromStorageCancelFields = FieldList<
+  &AcCmdCRGetItemFromStorageCancel::storedItemUid,
+  &AcCmdCRGetItemFromStorageCancel::status>;
+
 void AcCmdCRGetItemFromStorageCancel::Write(
   const AcCmdCRGetItemFromStorageCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.storedItemUid)
-    .Write(command.status);
+  AcCmdCRGetItemFromStorageCancelFields::Write(command, stream);
 }
 
 void AcCmdCRGetItemFromStorageCancel::Read(
@@ -1148,11 +1275,14 @@ void RanchCommandCheckStorageItem::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandCheckStorageItemFields = FieldList<
+  &AcCmdCRGetItemFromStorage::storedItemUid>;
+
 void RanchCommandCheckStorageItem::Read(
   AcCmdCRGetItemFromStorage& command,
   SourceStream& stream)
 {
-  stream.Read(command.storedItemUid);
+  RanchCommandCheckStorageItemFields::Read(command, stream);
 }
 
 void RanchCommandRequestNpcDressList::Write(
@@ -1162,11 +1292,14 @@ void RanchCommandRequestNpcDressList::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using RanchCommandRequestNpcDressListFields = FieldList<
+  &RanchCommandRequestNpcDressList::unk0>;
+
 void RanchCommandRequestNpcDressList::Read(
   RanchCommandRequestNpcDressList& command,
   SourceStream& stream)
 {
-  stream.Read(command.unk0);
+  RanchCommandRequestNpcDressListFields::Read(command, stream);
 }
 
 void RanchCommandRequestNpcDressListOK::Write(
@@ -1202,30 +1335,36 @@ void RanchCommandRequestNpcDressListCancel::Read(
   // Empty
 }
 
+using AcCmdCRRanchChatFields = FieldList<
+  &AcCmdCRRanchChat::message,
+  &AcCmdCRRanchChat::unknown,
+  &AcCmdCRRanchChat::unknown2>;
+
 void AcCmdCRRanchChat::Write(
   const AcCmdCRRanchChat& command,
   SinkStream& stream)
 {
-  throw std::runtime_error("Not implemented");
+  AcCmdCRRanchChatFields::Write(command, stream);
 }
 
 void AcCmdCRRanchChat::Read(
   AcCmdCRRanchChat& command,
   SourceStream& stream)
 {
-  stream.Read(command.message)
-    .Read(command.unknown)
-    .Read(command.unknown2);
+  AcCmdCRRanchChatFields::Read(command, stream);
 }
 
+using AcCmdCRRanchChatNotifyFields = FieldList<
+  &AcCmdCRRanchChatNotify::author,
+  &AcCmdCRRanchChatNotify::message,
+  &AcCmdCRRanchChatNotify::isSystem,
+  &AcCmdCRRanchChatNotify::unknown2>;
+
 void AcCmdCRRanchChatNotify::Write(
   const AcCmdCRRanchChatNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.author)
-    .Write(command.message)
-    .Write(command.isSystem)
-    .Write(command.unknown2);
+  AcCmdCRRanchChatNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRRanchChatNotify::Read(
@@ -1242,20 +1381,26 @@ void AcCmdCRWearEquipment::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRWearEquipmentFields = FieldList<
+  &AcCmdCRWearEquipment::equipmentUid,
+  &AcCmdCRWearEquipment::member>;
+
 void AcCmdCRWearEquipment::Read(
   AcCmdCRWearEquipment& command,
   SourceStream& stream)
 {
-  stream.Read(command.equipmentUid)
-    .Read(command.member);
+  AcCmdCRWearEquipmentFields::Read(command, stream);
 }
 
+using AcCmdCRWearEquipmentOKFields = FieldList<
+  &AcCmdCRWearEquipmentOK::itemUid,
+  &AcCmdCRWearEquipmentOK::member>;
+
 void AcCmdCRWearEquipmentOK::Write(
   const AcCmdCRWearEquipmentOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.itemUid)
-    .Write(command.member);
+  AcCmdCRWearEquipmentOKFields::Write(command, stream);
 }
 
 void AcCmdCRWearEquipmentOK::Read(
@@ -1265,12 +1410,15 @@ void AcCmdCRWearEquipmentOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRWearEquipmentCancelFields = FieldList<
+  &AcCmdCRWearEquipmentCancel::itemUid,
+  &AcCmdCRWearEquipmentCancel::member>;
+
 void AcCmdCRWearEquipmentCancel::Write(
   const AcCmdCRWearEquipmentCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.itemUid)
-    .Write(command.member);
+  AcCmdCRWearEquipmentCancelFields::Write(command, stream);
 }
 
 void AcCmdCRWearEquipmentCancel::Read(
@@ -1287,18 +1435,24 @@ void AcCmdCRRemoveEquipment::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRemoveEquipmentFields = FieldList<
+  &AcCmdCRRemoveEquipment::itemUid>;
+
 void AcCmdCRRemoveEquipment::Read(
   AcCmdCRRemoveEquipment& command,
   SourceStream& stream)
 {
-  stream.Read(command.itemUid);
+  AcCmdCRRemoveEquipmentFields::Read(command, stream);
 }
 
+using AcCmdCRRemoveEquipmentOKFields = FieldList<
+  &AcCmdCRRemoveEquipmentOK::uid>;
+
 void AcCmdCRRemoveEquipmentOK::Write(
   const AcCmdCRRemoveEquipmentOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.uid);
+  AcCmdCRRemoveEquipmentOKFields::Write(command, stream);
 }
 
 void AcCmdCRRemoveEquipmentOK::Read(
@@ -1308,12 +1462,15 @@ void AcCmdCRRemoveEquipmentOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRemoveEquipmentCancelFields = FieldList<
+  &AcCmdCRRemoveEquipmentCancel::itemUid,
+  &AcCmdCRRemoveEquipmentCancel::member>;
+
 void AcCmdCRRemoveEquipmentCancel::Write(
   const AcCmdCRRemoveEquipmentCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.itemUid)
-    .Write(command.member);
+  AcCmdCRRemoveEquipmentCancelFields::Write(command, stream);
 }
 
 void AcCmdCRRemoveEquipmentCancel::Read(
@@ -1351,12 +1508,15 @@ void AcCmdCRUpdateEquipmentNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandSetIntroductionNotifyFields = FieldList<
+  &RanchCommandSetIntroductionNotify::characterUid,
+  &RanchCommandSetIntroductionNotify::introduction>;
+
 void RanchCommandSetIntroductionNotify::Write(
   const RanchCommandSetIntroductionNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid)
-    .Write(command.introduction);
+  RanchCommandSetIntroductionNotifyFields::Write(command, stream);
 }
 
 void RanchCommandSetIntroductionNotify::Read(
@@ -1373,20 +1533,26 @@ void RanchCommandCreateGuild::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandCreateGuildFields = FieldList<
+  &RanchCommandCreateGuild::name,
+  &RanchCommandCreateGuild::description>;
+
 void RanchCommandCreateGuild::Read(
   RanchCommandCreateGuild& command,
   SourceStream& stream)
 {
-  stream.Read(command.name)
-    .Read(command.description);
+  RanchCommandCreateGuildFields::Read(command, stream);
 }
 
+using RanchCommandCreateGuildOKFields = FieldList<
+  &RanchCommandCreateGuildOK::uid,
+  &RanchCommandCreateGuildOK::updatedCarrots>;
+
 void RanchCommandCreateGuildOK::Write(
   const RanchCommandCreateGuildOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.uid)
-    .Write(command.updatedCarrots);
+  RanchCommandCreateGuildOKFields::Write(command, stream);
 }
 
 void RanchCommandCreateGuildOK::Read(
@@ -1396,12 +1562,15 @@ void RanchCommandCreateGuildOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandCreateGuildCancelFields = FieldList<
+  &RanchCommandCreateGuildCancel::status,
+  &RanchCommandCreateGuildCancel::member2>;
+
 void RanchCommandCreateGuildCancel::Write(
   const RanchCommandCreateGuildCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.status)
-    .Write(command.member2);
+  RanchCommandCreateGuildCancelFields::Write(command, stream);
 }
 
 void RanchCommandCreateGuildCancel::Read(
@@ -1424,22 +1593,25 @@ void RanchCommandRequestGuildInfo::Read(
   // Empty.
 }
 
+using RanchCommandRequestGuildInfoOKGuildInfoFields = FieldList<
+  &RanchCommandRequestGuildInfoOK::GuildInfo::uid,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member1,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member2,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member3,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member4,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member5,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::name,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::description,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member8,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member9,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member10,
+  &RanchCommandRequestGuildInfoOK::GuildInfo::member11>;
+
 void RanchCommandRequestGuildInfoOK::GuildInfo::Write(
   const GuildInfo& command,
   SinkStream& stream)
 {
-  stream.Write(command.uid)
-    .Write(command.member1)
-    .Write(command.member2)
-    .Write(command.member3)
-    .Write(command.member4)
-    .Write(command.member5)
-    .Write(command.name)
-    .Write(command.description)
-    .Write(command.member8)
-    .Write(command.member9)
-    .Write(command.member10)
-    .Write(command.member11);
+  RanchCommandRequestGuildInfoOKGuildInfoFields::Write(command, stream);
 }
 
 void RanchCommandRequestGuildInfoOK::GuildInfo::Read(
@@ -1449,11 +1621,14 @@ void RanchCommandRequestGuildInfoOK::GuildInfo::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandRequestGuildInfoOKFields = FieldList<
+  &RanchCommandRequestGuildInfoOK::guildInfo>;
+
 void RanchCommandRequestGuildInfoOK::Write(
   const RanchCommandRequestGuildInfoOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.guildInfo);
+  RanchCommandRequestGuildInfoOKFields::Write(command, stream);
 }
 
 void RanchCommandRequestGuildInfoOK::Read(
@@ -1463,11 +1638,14 @@ void RanchCommandRequestGuildInfoOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandRequestGuildInfoCancelFields = FieldList<
+  &RanchCommandRequestGuildInfoCancel::status>;
+
 void RanchCommandRequestGuildInfoCancel::Write(
   const RanchCommandRequestGuildInfoCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.status);
+  RanchCommandRequestGuildInfoCancelFields::Write(command, stream);
 }
 
 void RanchCommandRequestGuildInfoCancel::Read(
@@ -1493,12 +1671,15 @@ void AcCmdCRUpdatePet::Read(
     stream.Read(command.itemUid);
 }
 
+using AcCmdRCUpdatePetFields = FieldList<
+  &AcCmdRCUpdatePet::petInfo,
+  &AcCmdRCUpdatePet::itemUid>;
+
 void AcCmdRCUpdatePet::Write(
   const AcCmdRCUpdatePet& command,
   SinkStream& stream)
 {
-  stream.Write(command.petInfo)
-   .Write(command.itemUid);
+  AcCmdRCUpdatePetFields::Write(command, stream);
 }
 
 void AcCmdRCUpdatePet::Read(
@@ -1510,13 +1691,16 @@ void AcCmdRCUpdatePet::Read(
     stream.Read(command.itemUid);
 }
 
+using AcCmdRCUpdatePetCancelFields = FieldList<
+  &AcCmdRCUpdatePetCancel::petInfo,
+  &AcCmdRCUpdatePetCancel::member2,
+  &AcCmdRCUpdatePetCancel::member3>;
+
 void AcCmdRCUpdatePetCancel::Write(
   const AcCmdRCUpdatePetCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.petInfo)
-    .Write(command.member2)
-    .Write(command.member3);
+  AcCmdRCUpdatePetCancelFields::Write(command, stream);
 }
 
 void AcCmdRCUpdatePetCancel::Read(
@@ -1533,12 +1717,15 @@ void AcCmdCRBoostIncubateInfoList::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRBoostIncubateInfoListFields = FieldList<
+  &AcCmdCRBoostIncubateInfoList::member1,
+  &AcCmdCRBoostIncubateInfoList::member2>;
+
 void AcCmdCRBoostIncubateInfoList::Read(
   AcCmdCRBoostIncubateInfoList& command,
   SourceStream& stream)
 {
-  stream.Read(command.member1)
-    .Read(command.member2);
+  AcCmdCRBoostIncubateInfoListFields::Read(command, stream);
 }
 
 void AcCmdCRBoostIncubateInfoListOK::Write(
@@ -1565,21 +1752,27 @@ void AcCmdCRBoostIncubateEgg::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRBoostIncubateEggFields = FieldList<
+  &AcCmdCRBoostIncubateEgg::itemUid,
+  &AcCmdCRBoostIncubateEgg::incubatorSlot>;
+
 void AcCmdCRBoostIncubateEgg::Read(
   AcCmdCRBoostIncubateEgg& command,
   SourceStream& stream)
 {
-  stream.Read(command.itemUid)
-    .Read(command.incubatorSlot);
+  AcCmdCRBoostIncubateEggFields::Read(command, stream);
 }
 
+using AcCmdCRBoostIncubateEggOKFields = FieldList<
+  &AcCmdCRBoostIncubateEggOK::item,
+  &AcCmdCRBoostIncubateEggOK::incubatorSlot,
+  &AcCmdCRBoostIncubateEggOK::egg>;
+
 void AcCmdCRBoostIncubateEggOK::Write(
   const AcCmdCRBoostIncubateEggOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.item)
-    .Write(command.incubatorSlot)
-    .Write(command.egg);
+  AcCmdCRBoostIncubateEggOKFields::Write(command, stream);
 }
 
 void AcCmdCRBoostIncubateEggOK::Read(
@@ -1596,20 +1789,26 @@ void AcCmdCRRequestPetBirth::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRequestPetBirthFields = FieldList<
+  &AcCmdCRRequestPetBirth::eggLevel,
+  &AcCmdCRRequestPetBirth::incubatorSlot,
+  &AcCmdCRRequestPetBirth::petInfo>;
+
 void AcCmdCRRequestPetBirth::Read(
   AcCmdCRRequestPetBirth& command,
   SourceStream& stream)
 {
-  stream.Read(command.eggLevel)
-    .Read(command.incubatorSlot)
-    .Read(command.petInfo);
+  AcCmdCRRequestPetBirthFields::Read(command, stream);
 }
 
+using AcCmdCRRequestPetBirthOKFields = FieldList<
+  &AcCmdCRRequestPetBirthOK::petBirthInfo>;
+
 void AcCmdCRRequestPetBirthOK::Write(
   const AcCmdCRRequestPetBirthOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.petBirthInfo);
+  AcCmdCRRequestPetBirthOKFields::Write(command, stream);
 }
 
 void AcCmdCRRequestPetBirthOK::Read(
@@ -1619,11 +1818,14 @@ void AcCmdCRRequestPetBirthOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRequestPetBirthNotifyFields = FieldList<
+  &AcCmdCRRequestPetBirthNotify::petBirthInfo>;
+
 void AcCmdCRRequestPetBirthNotify::Write(
   const AcCmdCRRequestPetBirthNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.petBirthInfo);
+  AcCmdCRRequestPetBirthNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRRequestPetBirthNotify::Read(
@@ -1633,11 +1835,14 @@ void AcCmdCRRequestPetBirthNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRRequestPetBirthCancelFields = FieldList<
+  &AcCmdCRRequestPetBirthCancel::petInfo>;
+
 void AcCmdCRRequestPetBirthCancel::Write(
   const AcCmdCRRequestPetBirthCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.petInfo);
+  AcCmdCRRequestPetBirthCancelFields::Write(command, stream);
 }
 
 void AcCmdCRRequestPetBirthCancel::Read(
@@ -1647,11 +1852,14 @@ void AcCmdCRRequestPetBirthCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandPetBirthNotifyFields = FieldList<
+  &RanchCommandPetBirthNotify::petBirthInfo>;
+
 void RanchCommandPetBirthNotify::Write(
   const RanchCommandPetBirthNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.petBirthInfo);
+  RanchCommandPetBirthNotifyFields::Write(command, stream);
 }
 
 void RanchCommandPetBirthNotify::Read(
@@ -1668,22 +1876,28 @@ void AcCmdCRIncubateEgg::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRIncubateEggFields = FieldList<
+  &AcCmdCRIncubateEgg::itemUid,
+  &AcCmdCRIncubateEgg::itemTid,
+  &AcCmdCRIncubateEgg::incubatorSlot>;
+
 void AcCmdCRIncubateEgg::Read(
   AcCmdCRIncubateEgg& command,
   SourceStream& stream)
 {
-  stream.Read(command.itemUid)
-    .Read(command.itemTid)
-    .Read(command.incubatorSlot);
+  AcCmdCRIncubateEggFields::Read(command, stream);
 }
 
+using AcCmdCRIncubateEggOKFields = FieldList<
+  &AcCmdCRIncubateEggOK::incubatorSlot,
+  &AcCmdCRIncubateEggOK::egg,
+  &AcCmdCRIncubateEggOK::member3>;
+
 void AcCmdCRIncubateEggOK::Write(
   const AcCmdCRIncubateEggOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.incubatorSlot)
-    .Write(command.egg)
-    .Write(command.member3);
+  AcCmdCRIncubateEggOKFields::Write(command, stream);
 }
 
 void AcCmdCRIncubateEggOK::Read(
@@ -1693,14 +1907,17 @@ void AcCmdCRIncubateEggOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRIncubateEggNotifyFields = FieldList<
+  &AcCmdCRIncubateEggNotify::characterUid,
+  &AcCmdCRIncubateEggNotify::incubatorSlot,
+  &AcCmdCRIncubateEggNotify::egg,
+  &AcCmdCRIncubateEggNotify::member3>;
+
 void AcCmdCRIncubateEggNotify::Write(
   const AcCmdCRIncubateEggNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid)
-    .Write(command.incubatorSlot)
-    .Write(command.egg)
-    .Write(command.member3);
+  AcCmdCRIncubateEggNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRIncubateEggNotify::Read(
@@ -1710,14 +1927,17 @@ void AcCmdCRIncubateEggNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRIncubateEggCancelFields = FieldList<
+  &AcCmdCRIncubateEggCancel::cancel,
+  &AcCmdCRIncubateEggCancel::itemUid,
+  &AcCmdCRIncubateEggCancel::itemTid,
+  &AcCmdCRIncubateEggCancel::incubatorSlot>;
+
 void AcCmdCRIncubateEggCancel::Write(
   const AcCmdCRIncubateEggCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.cancel)
-  .Write(command.itemUid)
-  .Write(command.itemTid)
-  .Write(command.incubatorSlot);
+  AcCmdCRIncubateEggCancelFields::Write(command, stream);
 }
 
 void AcCmdCRIncubateEggCancel::Read(
@@ -1768,12 +1988,15 @@ void RanchCommandAchievementUpdateProperty::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandAchievementUpdatePropertyFields = FieldList<
+  &RanchCommandAchievementUpdateProperty::achievementEvent,
+  &RanchCommandAchievementUpdateProperty::member2>;
+
 void RanchCommandAchievementUpdateProperty::Read(
   RanchCommandAchievementUpdateProperty& command,
   SourceStream& stream)
 {
-  stream.Read(command.achievementEvent)
-    .Read(command.member2);
+  RanchCommandAchievementUpdatePropertyFields::Read(command, stream);
 }
 
 void AcCmdCRHousingBuild::Write(
@@ -1783,20 +2006,26 @@ void AcCmdCRHousingBuild::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHousingBuildFields = FieldList<
+  &AcCmdCRHousingBuild::housingTid>;
+
 void AcCmdCRHousingBuild::Read(
   AcCmdCRHousingBuild& command,
   SourceStream& stream)
 {
-  stream.Read(command.housingTid);
+  AcCmdCRHousingBuildFields::Read(command, stream);
 }
 
+using AcCmdCRHousingBuildOKFields = FieldList<
+  &AcCmdCRHousingBuildOK::member1,
+  &AcCmdCRHousingBuildOK::housingTid,
+  &AcCmdCRHousingBuildOK::member3>;
+
 void AcCmdCRHousingBuildOK::Write(
   const AcCmdCRHousingBuildOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.housingTid)
-    .Write(command.member3);
+  AcCmdCRHousingBuildOKFields::Write(command, stream);
 }
 
 void AcCmdCRHousingBuildOK::Read(
@@ -1806,11 +2035,14 @@ void AcCmdCRHousingBuildOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHousingBuildCancelFields = FieldList<
+  &AcCmdCRHousingBuildCancel::status>;
+
 void AcCmdCRHousingBuildCancel::Write(
   const AcCmdCRHousingBuildCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.status);
+  AcCmdCRHousingBuildCancelFields::Write(command, stream);
 }
 
 void AcCmdCRHousingBuildCancel::Read(
@@ -1820,12 +2052,15 @@ void AcCmdCRHousingBuildCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHousingBuildNotifyFields = FieldList<
+  &AcCmdCRHousingBuildNotify::member1,
+  &AcCmdCRHousingBuildNotify::housingId>;
+
 void AcCmdCRHousingBuildNotify::Write(
   const AcCmdCRHousingBuildNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.housingId);
+  AcCmdCRHousingBuildNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRHousingBuildNotify::Read(
@@ -1842,19 +2077,25 @@ void AcCmdCRHousingRepair::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHousingRepairFields = FieldList<
+  &AcCmdCRHousingRepair::housingUid>;
+
 void AcCmdCRHousingRepair::Read(
   AcCmdCRHousingRepair& command,
   SourceStream& stream)
 {
-  stream.Read(command.housingUid);
+  AcCmdCRHousingRepairFields::Read(command, stream);
 }
 
+using AcCmdCRHousingRepairOKFields = FieldList<
+  &AcCmdCRHousingRepairOK::housingUid,
+  &AcCmdCRHousingRepairOK::member2>;
+
 void AcCmdCRHousingRepairOK::Write(
   const AcCmdCRHousingRepairOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.housingUid)
-    .Write(command.member2);
+  AcCmdCRHousingRepairOKFields::Write(command, stream);
 }
 
 void AcCmdCRHousingRepairOK::Read(
@@ -1864,11 +2105,14 @@ void AcCmdCRHousingRepairOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHousingRepairCancelFields = FieldList<
+  &AcCmdCRHousingRepairCancel::status>;
+
 void AcCmdCRHousingRepairCancel::Write(
   const AcCmdCRHousingRepairCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.status);
+  AcCmdCRHousingRepairCancelFields::Write(command, stream);
 }
 
 void AcCmdCRHousingRepairCancel::Read(
@@ -1878,12 +2122,15 @@ void AcCmdCRHousingRepairCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHousingRepairNotifyFields = FieldList<
+  &AcCmdCRHousingRepairNotify::member1,
+  &AcCmdCRHousingRepairNotify::housingTid>;
+
 void AcCmdCRHousingRepairNotify::Write(
   const AcCmdCRHousingRepairNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.member1)
-    .Write(command.housingTid);
+  AcCmdCRHousingRepairNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRHousingRepairNotify::Read(
@@ -1892,22 +2139,23 @@ void AcCmdCRHousingRepairNotify::Read(
 {
   throw std::runtime_error("Not implemented");
 }
+using AcCmdRCMissionEventFields = FieldList<
+  &AcCmdRCMissionEvent::event,
+  &AcCmdRCMissionEvent::callerOid,
+  &AcCmdRCMissionEvent::calledOid>;
+
 void AcCmdRCMissionEvent::Write(
   const AcCmdRCMissionEvent& command,
   SinkStream& stream)
 {
-  stream.Write(command.event)
-    .Write(command.callerOid)
-    .Write(command.calledOid);
+  AcCmdRCMissionEventFields::Write(command, stream);
 }
 
 void AcCmdRCMissionEvent::Read(
   AcCmdRCMissionEvent& command,
   SourceStream& stream)
 {
-  stream.Read(command.event)
-    .Read(command.callerOid)
-    .Read(command.calledOid);
+  AcCmdRCMissionEventFields::Read(command, stream);
 }
 
 void RanchCommandKickRanch::Write(
@@ -1917,11 +2165,14 @@ void RanchCommandKickRanch::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandKickRanchFields = FieldList<
+  &RanchCommandKickRanch::characterUid>;
+
 void RanchCommandKickRanch::Read(
   RanchCommandKickRanch& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterUid);
+  RanchCommandKickRanchFields::Read(command, stream);
 }
 
 void RanchCommandKickRanchOK::Write(
@@ -1952,11 +2203,14 @@ void RanchCommandKickRanchCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandKickRanchNotifyFields = FieldList<
+  &RanchCommandKickRanchNotify::characterUid>;
+
 void RanchCommandKickRanchNotify::Write(
   const RanchCommandKickRanchNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid);
+  RanchCommandKickRanchNotifyFields::Write(command, stream);
 }
 
 void RanchCommandKickRanchNotify::Read(
@@ -1973,19 +2227,25 @@ void RanchCommandOpCmd::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using RanchCommandOpCmdFields = FieldList<
+  &RanchCommandOpCmd::command>;
+
 void RanchCommandOpCmd::Read(
   RanchCommandOpCmd& command,
   SourceStream& stream)
 {
-  stream.Read(command.command);
+  RanchCommandOpCmdFields::Read(command, stream);
 }
 
+using RanchCommandOpCmdOKFields = FieldList<
+  &RanchCommandOpCmdOK::feedback,
+  &RanchCommandOpCmdOK::observerState>;
+
 void RanchCommandOpCmdOK::Write(
   const RanchCommandOpCmdOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.feedback)
-    .Write(command.observerState);
+  RanchCommandOpCmdOKFields::Write(command, stream);
 }
 
 void RanchCommandOpCmdOK::Read(
@@ -2045,6 +2305,18 @@ void RanchCommandRequestLeagueTeamListOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+void RanchCommandRequestLeagueTeamListCancel::Write(
+  const RanchCommandRequestLeagueTeamListCancel& command,
+  SinkStream& stream)
+{
+}
+
+void RanchCommandRequestLeagueTeamListCancel::Read(
+  RanchCommandRequestLeagueTeamListCancel& command,
+  SourceStream& stream)
+{
+}
+
 void AcCmdCRRecoverMount::Write(
   const AcCmdCRRecoverMount& command,
   SinkStream& stream)
@@ -2052,20 +2324,26 @@ void AcCmdCRRecoverMount::Write(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRRecoverMountFields = FieldList<
+  &AcCmdCRRecoverMount::horseUid>;
+
 void AcCmdCRRecoverMount::Read(
   AcCmdCRRecoverMount& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid);
+  AcCmdCRRecoverMountFields::Read(command, stream);
 }
 
+using AcCmdCRRecoverMountOKFields = FieldList<
+  &AcCmdCRRecoverMountOK::horseUid,
+  &AcCmdCRRecoverMountOK::stamina,
+  &AcCmdCRRecoverMountOK::updatedCarrots>;
+
 void AcCmdCRRecoverMountOK::Write(
   const AcCmdCRRecoverMountOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.horseUid)
-    .Write(command.stamina)
-    .Write(command.updatedCarrots);
+  AcCmdCRRecoverMountOKFields::Write(command, stream);
 }
 
 void AcCmdCRRecoverMountOK::Read(
@@ -2075,11 +2353,14 @@ void AcCmdCRRecoverMountOK::Read(
   throw std::runtime_error("Not implemented.");
 }
 
+using AcCmdCRRecoverMountCancelFields = FieldList<
+  &AcCmdCRRecoverMountCancel::horseUid>;
+
 void AcCmdCRRecoverMountCancel::Write(
   const AcCmdCRRecoverMountCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.horseUid);
+  AcCmdCRRecoverMountCancelFields::Write(command, stream);
 }
 
 void AcCmdCRRecoverMountCancel::Read(
@@ -2096,19 +2377,25 @@ void AcCmdCRWithdrawGuildMember::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRWithdrawGuildMemberFields = FieldList<
+  &AcCmdCRWithdrawGuildMember::characterUid,
+  &AcCmdCRWithdrawGuildMember::member1>;
+
 void AcCmdCRWithdrawGuildMember::Read(
   AcCmdCRWithdrawGuildMember& command,
   SourceStream& stream)
 {
-  stream.Read(command.characterUid)
-    .Read(command.member1);
+  AcCmdCRWithdrawGuildMemberFields::Read(command, stream);
 }
 
+using AcCmdCRWithdrawGuildMemberOKFields = FieldList<
+  &AcCmdCRWithdrawGuildMemberOK::unk0>;
+
 void AcCmdCRWithdrawGuildMemberOK::Write(
   const AcCmdCRWithdrawGuildMemberOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.unk0);
+  AcCmdCRWithdrawGuildMemberOKFields::Write(command, stream);
 }
 
 void AcCmdCRWithdrawGuildMemberOK::Read(
@@ -2118,11 +2405,14 @@ void AcCmdCRWithdrawGuildMemberOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRWithdrawGuildMemberCancelFields = FieldList<
+  &AcCmdCRWithdrawGuildMemberCancel::status>;
+
 void AcCmdCRWithdrawGuildMemberCancel::Write(
   const AcCmdCRWithdrawGuildMemberCancel& command,
   SinkStream& stream)
 {
-  stream.Write(command.status);
+  AcCmdCRWithdrawGuildMemberCancelFields::Write(command, stream);
 }
 
 void AcCmdCRWithdrawGuildMemberCancel::Read(
@@ -2132,11 +2422,14 @@ void AcCmdCRWithdrawGuildMemberCancel::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRCheckStorageItemFields = FieldList<
+  &AcCmdCRCheckStorageItem::storedItemUid>;
+
 void AcCmdCRCheckStorageItem::Read(
   AcCmdCRCheckStorageItem& command,
   SourceStream& stream)
 {
-  stream.Read(command.storedItemUid);
+  AcCmdCRCheckStorageItemFields::Read(command, stream);
 }
 
 void AcCmdCRCheckStorageItem::Write(
@@ -2146,11 +2439,14 @@ void AcCmdCRCheckStorageItem::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRChangeAgeFields = FieldList<
+  &AcCmdCRChangeAge::age>;
+
 void AcCmdCRChangeAge::Read(
   AcCmdCRChangeAge& command,
   SourceStream& stream)
 {
-  stream.Read(command.age);
+  AcCmdCRChangeAgeFields::Read(command, stream);
 }
 
 void AcCmdCRChangeAge::Write(
@@ -2180,11 +2476,14 @@ void AcCmdCRChangeAgeOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRChangeAgeOKFields = FieldList<
+  &AcCmdCRChangeAgeOK::age>;
+
 void AcCmdCRChangeAgeOK::Write(
   const AcCmdCRChangeAgeOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.age);
+  AcCmdCRChangeAgeOKFields::Write(command, stream);
 }
 
 void AcCmdRCChangeAgeNotify::Read(
@@ -2194,19 +2493,25 @@ void AcCmdRCChangeAgeNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdRCChangeAgeNotifyFields = FieldList<
+  &AcCmdRCChangeAgeNotify::characterUid,
+  &AcCmdRCChangeAgeNotify::age>;
+
 void AcCmdRCChangeAgeNotify::Write(
   const AcCmdRCChangeAgeNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid)
-    .Write(command.age);
+  AcCmdRCChangeAgeNotifyFields::Write(command, stream);
 }
 
+using AcCmdCRHideAgeFields = FieldList<
+  &AcCmdCRHideAge::option>;
+
 void AcCmdCRHideAge::Read(
   AcCmdCRHideAge& command,
   SourceStream& stream)
 {
-  stream.Read(command.option);
+  AcCmdCRHideAgeFields::Read(command, stream);
 }
 
 void AcCmdCRHideAge::Write(
@@ -2236,11 +2541,14 @@ void AcCmdCRHideAgeOK::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRHideAgeOKFields = FieldList<
+  &AcCmdCRHideAgeOK::option>;
+
 void AcCmdCRHideAgeOK::Write(
   const AcCmdCRHideAgeOK& command,
   SinkStream& stream)
 {
-  stream.Write(command.option);
+  AcCmdCRHideAgeOKFields::Write(command, stream);
 }
 
 void AcCmdRCHideAgeNotify::Read(
@@ -2250,12 +2558,15 @@ void AcCmdRCHideAgeNotify::Read(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdRCHideAgeNotifyFields = FieldList<
+  &AcCmdRCHideAgeNotify::characterUid,
+  &AcCmdRCHideAgeNotify::option>;
+
 void AcCmdRCHideAgeNotify::Write(
   const AcCmdRCHideAgeNotify& command,
   SinkStream& stream)
 {
-  stream.Write(command.characterUid)
-    .Write(command.option);
+  AcCmdRCHideAgeNotifyFields::Write(command, stream);
 }
 
 void AcCmdCRStatusPointApply::Write(
@@ -2265,12 +2576,15 @@ void AcCmdCRStatusPointApply::Write(
   throw std::runtime_error("Not implemented");
 }
 
+using AcCmdCRStatusPointApplyFields = FieldList<
+  &AcCmdCRStatusPointApply::horseUid,
+  &AcCmdCRStatusPointApply::stats>;
+
 void AcCmdCRStatusPointApply::Read(
   AcCmdCRStatusPointApply& command,
   SourceStream& stream)
 {
-  stream.Read(command.horseUid)
-  .Read(command.stats);
+  AcCmdCRStatusPointApplyFields::Read(command, stream);
 }
 
 void AcCmdCRStatusPointApplyOK::Write(
@@ -0,0 +1,198 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/network/http/MetricsServer.hpp"
+
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+namespace server::network
+{
+
+namespace
+{
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+
+//! Content type of the Prometheus text exposition format.
+constexpr auto ExpositionContentType = "text/plain; version=0.0.4; charset=utf-8";
+
+//! A connection to the metrics server.
+class Session final
+  : public std::enable_shared_from_this<Session>
+{
+public:
+  Session(asio::ip::tcp::socket socket, metrics::Registry& registry)
+    : _stream(std::move(socket))
+    , _registry(registry)
+  {
+  }
+
+  //! Reads a request of the connection.
+  void ReadRequest()
+  {
+    _request = {};
+    _stream.expires_after(std::chrono::seconds(30));
+
+    http::async_read(
+      _stream,
+      _buffer,
+      _request,
+      [session = shared_from_this()](beast::error_code error, std::size_t)
+      {
+        // The connection was closed or timed out.
+        if (error)
+          return;
+
+        session->WriteResponse();
+      });
+  }
+
+private:
+  //! Writes the response to the request.
+  void WriteResponse()
+  {
+    _response = {};
+    _response.version(_request.version());
+    _response.keep_alive(_request.keep_alive());
+
+    if (_request.method() == http::verb::get && _request.target() == "/metrics")
+    {
+      _response.result(http::status::ok);
+      _response.set(http::field::content_type, ExpositionContentType);
+      _response.body() = _registry.Expose();
+    }
+    else
+    {
+      _response.result(http::status::not_found);
+      _response.set(http::field::content_type, "text/plain");
+      _response.body() = "Not found\n";
+    }
+
+    _response.prepare_payload();
+
+    http::async_write(
+      _stream,
+      _response,
+      [session = shared_from_this()](beast::error_code error, std::size_t)
+      {
+        if (error)
+          return;
+
+        if (not session->_response.keep_alive())
+        {
+          beast::error_code shutdownError;
+          session->_stream.socket().shutdown(asio::ip::tcp::socket::shutdown_send, shutdownError);
+          return;
+        }
+
+        // Continue with the next request of the connection.
+        session->ReadRequest();
+      });
+  }
+
+  beast::tcp_stream _stream;
+  beast::flat_buffer _buffer;
+  http::request<http::string_body> _request;
+  http::response<http::string_body> _response;
+
+  metrics::Registry& _registry;
+};
+
+} // anon namespace
+
+MetricsServer::MetricsServer(metrics::Registry& registry)
+  : _registry(registry)
+  , _acceptor(_ioContext)
+{
+}
+
+MetricsServer::~MetricsServer()
+{
+  EndHost();
+}
+
+void MetricsServer::BeginHost(const asio::ip::address& address, uint16_t port)
+{
+  const asio::ip::tcp::endpoint metricsEndpoint(address, port);
+  try
+  {
+    _acceptor.open(metricsEndpoint.protocol());
+    _acceptor.set_option(asio::socket_base::reuse_address(true));
+    _acceptor.bind(metricsEndpoint);
+    _acceptor.listen();
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error(
+      "Failed to host metrics on {}:{}: {}",
+      address.to_string(),
+      port,
+      x.what());
+    return;
+  }
+
+  AcceptLoop();
+
+  _thread = std::thread([this]()
+  {
+    _ioContext.run();
+  });
+
+  spdlog::info("Metrics exposed on http://{}:{}/metrics", address.to_string(), port);
+}
+
+void MetricsServer::EndHost()
+{
+  if (not _thread.joinable())
+    return;
+
+  // Stop the io context, the pending connections are abandoned.
+  _ioContext.stop();
+  _thread.join();
+}
+
+void MetricsServer::AcceptLoop()
+{
+  _acceptor.async_accept(
+    [this](const boost::system::error_code& error, asio::ip::tcp::socket socket)
+    {
+      // The acceptor was closed.
+      if (error == asio::error::operation_aborted)
+        return;
+
+      if (not error)
+        Serve(std::move(socket));
+
+      // Continue the accept loop.
+      AcceptLoop();
+    });
+}
+
+void MetricsServer::Serve(asio::ip::tcp::socket socket)
+{
+  std::make_shared<Session>(std::move(socket), _registry)->ReadRequest();
+}
+
+} // namespace server::network
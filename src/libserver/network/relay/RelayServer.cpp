@@ -0,0 +1,480 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/network/relay/RelayServer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
+namespace server::network
+{
+
+namespace
+{
+
+//! Max interval in which the idle members are expired.
+constexpr auto ExpiryInterval = std::chrono::seconds(5);
+
+} // anon namespace
+
+RelayServer::RelayServer()
+  : _socket(_ioContext)
+  , _expiryTimer(_ioContext)
+  , _receiveBuffers(BatchSize)
+{
+}
+
+RelayServer::~RelayServer()
+{
+  EndHost();
+}
+
+void RelayServer::BeginHost(
+  const asio::ip::address& address,
+  uint16_t port,
+  std::chrono::milliseconds idleTimeout)
+{
+  _idleTimeout = idleTimeout;
+
+  const asio::ip::udp::endpoint relayEndpoint(address, port);
+  try
+  {
+    _socket.open(relayEndpoint.protocol());
+    _socket.non_blocking(true);
+    _socket.bind(relayEndpoint);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error(
+      "Failed to host relay on {}:{}: {}",
+      address.to_string(),
+      port,
+      x.what());
+    return;
+  }
+
+  ReadLoop();
+  if (_idleTimeout != Clock::duration::zero())
+    ExpiryLoop();
+
+  _isHosting.store(true, std::memory_order::release);
+  _thread = std::thread([this]()
+  {
+    _ioContext.run();
+  });
+}
+
+void RelayServer::EndHost()
+{
+  if (not _thread.joinable())
+    return;
+
+  _isHosting.store(false, std::memory_order::release);
+
+  // Close the socket and cancel the timer on the relay thread,
+  // the io context runs out of work and the thread finishes.
+  asio::post(_ioContext, [this]()
+  {
+    boost::system::error_code error;
+    _expiryTimer.cancel();
+    _socket.close(error);
+  });
+
+  _thread.join();
+}
+
+void RelayServer::ReserveMember(
+  RoomId roomId,
+  MemberId memberId,
+  const asio::ip::address& address)
+{
+  if (not _isHosting.load(std::memory_order::acquire))
+    return;
+
+  asio::post(_ioContext, [this, roomId, memberId, address]()
+  {
+    auto roomIter = _rooms.try_emplace(roomId).first;
+
+    // Replace the previous membership along with its bound endpoint.
+    const auto memberIter = roomIter->second.members.find(memberId);
+    if (memberIter != roomIter->second.members.end())
+      EraseMember(roomIter, memberIter);
+
+    roomIter->second.members.try_emplace(
+      memberId,
+      Member{
+        .address = address,
+        .lastActivity = Clock::now()});
+    _reservations[address].emplace_back(MemberRef{
+      .roomId = roomId,
+      .memberId = memberId});
+  });
+}
+
+void RelayServer::RemoveMember(RoomId roomId, MemberId memberId)
+{
+  if (not _isHosting.load(std::memory_order::acquire))
+    return;
+
+  asio::post(_ioContext, [this, roomId, memberId]()
+  {
+    const auto roomIter = _rooms.find(roomId);
+    if (roomIter == _rooms.end())
+      return;
+
+    const auto memberIter = roomIter->second.members.find(memberId);
+    if (memberIter == roomIter->second.members.end())
+      return;
+
+    EraseMember(roomIter, memberIter);
+
+    if (roomIter->second.members.empty())
+      _rooms.erase(roomIter);
+  });
+}
+
+void RelayServer::RemoveRoom(RoomId roomId)
+{
+  if (not _isHosting.load(std::memory_order::acquire))
+    return;
+
+  asio::post(_ioContext, [this, roomId]()
+  {
+    const auto roomIter = _rooms.find(roomId);
+    if (roomIter == _rooms.end())
+      return;
+
+    auto memberIter = roomIter->second.members.begin();
+    while (memberIter != roomIter->second.members.end())
+    {
+      memberIter = EraseMember(roomIter, memberIter);
+    }
+
+    _rooms.erase(roomIter);
+  });
+}
+
+void RelayServer::ReadLoop()
+{
+  _socket.async_wait(
+    asio::ip::udp::socket::wait_read,
+    [this](const boost::system::error_code& error)
+    {
+      // The socket was closed.
+      if (error)
+        return;
+
+      ReceiveDatagrams();
+      SendDatagrams();
+
+      // Continue the read loop.
+      ReadLoop();
+    });
+}
+
+void RelayServer::ExpiryLoop()
+{
+  _expiryTimer.expires_after(
+    std::min<Clock::duration>(ExpiryInterval, _idleTimeout));
+  _expiryTimer.async_wait(
+    [this](const boost::system::error_code& error)
+    {
+      // The timer was cancelled.
+      if (error)
+        return;
+
+      ExpireIdle();
+
+      // Continue the expiry loop.
+      ExpiryLoop();
+    });
+}
+
+void RelayServer::ReceiveDatagrams()
+{
+#if defined(__linux__)
+  std::array<mmsghdr, BatchSize> headers{};
+  std::array<iovec, BatchSize> vectors{};
+  std::array<sockaddr_storage, BatchSize> addresses{};
+
+  for (std::size_t idx = 0; idx < BatchSize; ++idx)
+  {
+    vectors[idx].iov_base = _receiveBuffers[idx].data();
+    vectors[idx].iov_len = _receiveBuffers[idx].size();
+
+    headers[idx].msg_hdr.msg_iov = &vectors[idx];
+    headers[idx].msg_hdr.msg_iovlen = 1;
+  }
+
+  while (true)
+  {
+    for (std::size_t idx = 0; idx < BatchSize; ++idx)
+    {
+      headers[idx].msg_hdr.msg_name = &addresses[idx];
+      headers[idx].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+    }
+
+    const int receivedCount = recvmmsg(
+      _socket.native_handle(),
+      headers.data(),
+      BatchSize,
+      MSG_DONTWAIT,
+      nullptr);
+    if (receivedCount <= 0)
+      break;
+
+    for (std::size_t idx = 0; idx < static_cast<std::size_t>(receivedCount); ++idx)
+    {
+      asio::ip::udp::endpoint sender;
+      if (headers[idx].msg_hdr.msg_namelen > sender.capacity())
+        continue;
+
+      std::memcpy(sender.data(), &addresses[idx], headers[idx].msg_hdr.msg_namelen);
+      sender.resize(headers[idx].msg_hdr.msg_namelen);
+
+      HandleDatagram(
+        sender,
+        std::span(_receiveBuffers[idx].data(), headers[idx].msg_len));
+    }
+
+    // The socket has no more pending datagrams.
+    if (static_cast<std::size_t>(receivedCount) < BatchSize)
+      break;
+
+    // Send the datagrams relayed from this batch before receiving the next one.
+    SendDatagrams();
+  }
+#else
+  auto& receiveBuffer = _receiveBuffers.front();
+
+  while (true)
+  {
+    asio::ip::udp::endpoint sender;
+    boost::system::error_code error;
+
+    const auto receivedSize = _socket.receive_from(
+      asio::buffer(receiveBuffer),
+      sender,
+      0,
+      error);
+
+    // The socket has no more pending datagrams.
+    if (error)
+      break;
+
+    HandleDatagram(
+      sender,
+      std::span(receiveBuffer.data(), receivedSize));
+  }
+#endif
+}
+
+void RelayServer::SendDatagrams()
+{
+#if defined(__linux__)
+  std::array<mmsghdr, BatchSize> headers{};
+  std::array<iovec, BatchSize> vectors{};
+
+  std::size_t sentCount = 0;
+  while (sentCount < _sendQueue.size())
+  {
+    const std::size_t batchCount = std::min(BatchSize, _sendQueue.size() - sentCount);
+    for (std::size_t idx = 0; idx < batchCount; ++idx)
+    {
+      auto& datagram = _sendQueue[sentCount + idx];
+
+      vectors[idx].iov_base = _sendBuffer.data() + datagram.offset;
+      vectors[idx].iov_len = datagram.size;
+
+      headers[idx].msg_hdr.msg_name = datagram.endpoint.data();
+      headers[idx].msg_hdr.msg_namelen = datagram.endpoint.size();
+      headers[idx].msg_hdr.msg_iov = &vectors[idx];
+      headers[idx].msg_hdr.msg_iovlen = 1;
+    }
+
+    const int batchSentCount = sendmmsg(
+      _socket.native_handle(),
+      headers.data(),
+      batchCount,
+      MSG_DONTWAIT);
+
+    // The send buffer of the socket is full,
+    // the rest of the datagrams is dropped.
+    if (batchSentCount <= 0)
+      break;
+
+    sentCount += batchSentCount;
+  }
+#else
+  for (const auto& datagram : _sendQueue)
+  {
+    boost::system::error_code error;
+    _socket.send_to(
+      asio::buffer(_sendBuffer.data() + datagram.offset, datagram.size),
+      datagram.endpoint,
+      0,
+      error);
+  }
+#endif
+
+  _sendQueue.clear();
+  _sendBuffer.clear();
+}
+
+void RelayServer::HandleDatagram(
+  const asio::ip::udp::endpoint& sender,
+  std::span<const std::byte> data)
+{
+  std::optional<MemberRef> memberRef;
+
+  const auto peerIter = _peers.find(sender);
+  if (peerIter != _peers.end())
+    memberRef = peerIter->second;
+  else
+    memberRef = BindMember(sender, data);
+
+  // The datagram is not from a member of any room.
+  if (not memberRef)
+    return;
+
+  auto& room = _rooms[memberRef->roomId];
+  room.members[memberRef->memberId].lastActivity = Clock::now();
+
+  if (room.members.size() < 2)
+    return;
+
+  // Write the datagram once and share it between the other members of the room.
+  const RelayHeader header{};
+  const Datagram datagram{
+    .offset = _sendBuffer.size(),
+    .size = sizeof(header) + data.size()};
+
+  _sendBuffer.resize(datagram.offset + datagram.size);
+  std::memcpy(_sendBuffer.data() + datagram.offset, &header, sizeof(header));
+  std::memcpy(_sendBuffer.data() + datagram.offset + sizeof(header), data.data(), data.size());
+
+  for (const auto& [memberId, member] : room.members)
+  {
+    // Prevent relaying to self and to the members which are not bound yet.
+    if (memberId == memberRef->memberId || not member.endpoint)
+      continue;
+
+    auto& queuedDatagram = _sendQueue.emplace_back(datagram);
+    queuedDatagram.endpoint = *member.endpoint;
+  }
+}
+
+std::optional<RelayServer::MemberRef> RelayServer::BindMember(
+  const asio::ip::udp::endpoint& sender,
+  std::span<const std::byte> data)
+{
+  const auto reservationsIter = _reservations.find(sender.address());
+  if (reservationsIter == _reservations.cend())
+    return std::nullopt;
+
+  const auto& reservations = reservationsIter->second;
+  auto reservationIter = reservations.cbegin();
+
+  // Peers sharing the address are told apart by the member ID
+  // their first datagram is assumed to begin with.
+  if (reservations.size() > 1)
+  {
+    MemberId memberId{};
+    if (data.size() < sizeof(memberId))
+      return std::nullopt;
+    std::memcpy(&memberId, data.data(), sizeof(memberId));
+
+    reservationIter = std::ranges::find(reservations, memberId, &MemberRef::memberId);
+    if (reservationIter == reservations.cend())
+      return std::nullopt;
+  }
+
+  const auto memberRef = *reservationIter;
+  auto& member = _rooms[memberRef.roomId].members[memberRef.memberId];
+
+  // Rebind the member which changed its endpoint.
+  if (member.endpoint)
+    _peers.erase(*member.endpoint);
+
+  member.endpoint = sender;
+  _peers.try_emplace(sender, memberRef);
+
+  spdlog::debug(
+    "Relay peer {}:{} bound to member {} of room {}",
+    sender.address().to_string(),
+    sender.port(),
+    memberRef.memberId,
+    memberRef.roomId);
+
+  return memberRef;
+}
+
+std::unordered_map<RelayServer::MemberId, RelayServer::Member>::iterator RelayServer::EraseMember(
+  std::unordered_map<RoomId, Room>::iterator roomIter,
+  std::unordered_map<MemberId, Member>::iterator memberIter)
+{
+  const MemberRef memberRef{
+    .roomId = roomIter->first,
+    .memberId = memberIter->first};
+  const auto& member = memberIter->second;
+
+  if (member.endpoint)
+    _peers.erase(*member.endpoint);
+
+  const auto reservationsIter = _reservations.find(member.address);
+  if (reservationsIter != _reservations.end())
+  {
+    std::erase(reservationsIter->second, memberRef);
+    if (reservationsIter->second.empty())
+      _reservations.erase(reservationsIter);
+  }
+
+  return roomIter->second.members.erase(memberIter);
+}
+
+void RelayServer::ExpireIdle()
+{
+  const auto now = Clock::now();
+
+  for (auto roomIter = _rooms.begin(); roomIter != _rooms.end();)
+  {
+    auto& members = roomIter->second.members;
+
+    for (auto memberIter = members.begin(); memberIter != members.end();)
+    {
+      if (memberIter->second.lastActivity + _idleTimeout < now)
+        memberIter = EraseMember(roomIter, memberIter);
+      else
+        ++memberIter;
+    }
+
+    if (members.empty())
+      roomIter = _rooms.erase(roomIter);
+    else
+      ++roomIter;
+  }
+}
+
+} // namespace server::network
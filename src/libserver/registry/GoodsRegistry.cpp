@@ -0,0 +1,94 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/registry/GoodsRegistry.hpp"
+
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+
+namespace server::registry
+{
+
+namespace
+{
+
+void ReadGoods(
+  const YAML::Node& node,
+  Goods& goods)
+{
+  goods.goodsSq = node["goodsSq"].as<decltype(goods.goodsSq)>();
+  goods.setType = node["setType"].as<decltype(goods.setType)>(0);
+  goods.moneyType = node["moneyType"].as<decltype(goods.moneyType)>(0);
+  goods.goodsType = node["goodsType"].as<decltype(goods.goodsType)>(0);
+  goods.recommendType = node["recommendType"].as<decltype(goods.recommendType)>(0);
+  goods.recommendNo = node["recommendNo"].as<decltype(goods.recommendNo)>(0);
+  goods.giftType = node["giftType"].as<decltype(goods.giftType)>(0);
+  goods.salesRank = node["salesRank"].as<decltype(goods.salesRank)>(0);
+  goods.bonusGameMoney = node["bonusGameMoney"].as<decltype(goods.bonusGameMoney)>(0);
+  goods.name = node["name"].as<decltype(goods.name)>("");
+  goods.description = node["description"].as<decltype(goods.description)>("");
+  goods.capacityDescription = node["capacityDescription"].as<
+    decltype(goods.capacityDescription)>("");
+  goods.sellState = node["sellState"].as<decltype(goods.sellState)>(0);
+  goods.itemTid = node["itemTid"].as<decltype(goods.itemTid)>();
+
+  for (const auto& priceSection : node["prices"])
+  {
+    goods.prices.emplace_back(Goods::Price{
+      .priceId = priceSection["priceId"].as<uint32_t>(),
+      .priceRange = priceSection["priceRange"].as<uint32_t>(),
+      .goodsPrice = priceSection["goodsPrice"].as<uint32_t>()});
+  }
+}
+
+} // anon namespace
+
+void GoodsRegistry::ReadConfig(const std::filesystem::path& configPath)
+{
+  const auto root = YAML::LoadFile(configPath.string());
+
+  const auto goodsSection = root["goods"];
+  if (not goodsSection)
+    throw std::runtime_error("Missing goods section");
+
+  const auto collectionSection = goodsSection["collection"];
+  if (not collectionSection)
+    throw std::runtime_error("Missing collection section");
+
+  std::vector<Goods> goods;
+  for (const auto& goodsEntrySection : collectionSection)
+  {
+    ReadGoods(goodsEntrySection, goods.emplace_back());
+  }
+
+  spdlog::info("Goods registry loaded {} goods", goods.size());
+
+  auto loadedGoods = std::make_shared<const std::vector<Goods>>(std::move(goods));
+
+  std::scoped_lock lock(_goodsMutex);
+  _goods = std::move(loadedGoods);
+}
+
+std::shared_ptr<const std::vector<Goods>> GoodsRegistry::GetGoods() const
+{
+  std::scoped_lock lock(_goodsMutex);
+  return _goods;
+}
+
+} // namespace server::registry
@@ -10,8 +10,15 @@
 #include <icu.h>
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#include <cstring>
 #include <format>
+#include <list>
 #include <stdexcept>
+#include <unordered_map>
 
 #include <spdlog/spdlog.h>
 
@@ -21,7 +28,71 @@ namespace server
 namespace locale
 {
 
-std::string ToUtf8(const std::string& input)
+namespace
+{
+
+//! A least recently used cache of the converted strings.
+//! Only short strings, such as names of characters and ranches, are cached,
+//! as those are converted repeatedly.
+class ConversionCache final
+{
+public:
+  //! Max length of a cached string.
+  static constexpr std::size_t MaxLength = 64;
+  //! Max count of the cached strings.
+  static constexpr std::size_t Capacity = 256;
+
+  //! Finds the conversion of a string and marks it as recently used.
+  //! @param input Input string.
+  //! @returns Pointer to the output string, or null if the conversion is not cached.
+  [[nodiscard]] const std::string* Find(const std::string& input)
+  {
+    const auto indexIter = _index.find(input);
+    if (indexIter == _index.cend())
+      return nullptr;
+
+    _entries.splice(_entries.begin(), _entries, indexIter->second);
+    return &indexIter->second->second;
+  }
+
+  //! Caches the conversion of a string, evicting the least recently used one if full.
+  //! @param input Input string.
+  //! @param output Output string.
+  void Insert(const std::string& input, const std::string& output)
+  {
+    if (input.length() > MaxLength)
+      return;
+
+    if (_entries.size() >= Capacity)
+    {
+      _index.erase(_entries.back().first);
+      _entries.pop_back();
+    }
+
+    _entries.emplace_front(input, output);
+    _index.emplace(_entries.front().first, _entries.begin());
+  }
+
+private:
+  //! An input string and its conversion.
+  using Entry = std::pair<std::string, std::string>;
+
+  //! Entries ordered from the most recently used one.
+  std::list<Entry> _entries;
+  //! Entries indexed by the input string they own.
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> _index;
+};
+
+//! Copies an ASCII string up to its null terminator,
+//! the same way the conversions stop at the terminator.
+//! @param input Input string.
+//! @returns Output string.
+std::string CopyAscii(const std::string& input)
+{
+  return input.substr(0, input.find('\0'));
+}
+
+std::string ConvertToUtf8(const std::string& input)
 {
   std::string output;
 
@@ -74,7 +145,7 @@ std::string ToUtf8(const std::string& input)
   return {output.data()};
 }
 
-std::string FromUtf8(const std::string& input)
+std::string ConvertFromUtf8(const std::string& input)
 {
   std::string output;
 
@@ -127,6 +198,73 @@ std::string FromUtf8(const std::string& input)
   return {output.data()};
 }
 
+} // anon namespace
+
+bool IsAscii(std::string_view input)
+{
+  const auto* data = input.data();
+  const std::size_t size = input.size();
+  std::size_t offset = 0;
+
+#if defined(__SSE2__) || defined(_M_X64)
+  // Test the high bits of sixteen bytes at a time.
+  for (; offset + sizeof(__m128i) <= size; offset += sizeof(__m128i))
+  {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+    if (_mm_movemask_epi8(block) != 0)
+      return false;
+  }
+#endif
+
+  // Test the high bits of eight bytes at a time.
+  constexpr uint64_t HighBits = 0x8080808080808080ull;
+  for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, data + offset, sizeof(word));
+    if ((word & HighBits) != 0)
+      return false;
+  }
+
+  for (; offset < size; ++offset)
+  {
+    if ((static_cast<uint8_t>(data[offset]) & 0x80) != 0)
+      return false;
+  }
+
+  return true;
+}
+
+std::string ToUtf8(const std::string& input)
+{
+  // ASCII is encoded the same in both of the encodings.
+  if (IsAscii(input))
+    return CopyAscii(input);
+
+  thread_local ConversionCache cache;
+  if (const auto* cachedOutput = cache.Find(input))
+    return *cachedOutput;
+
+  auto output = ConvertToUtf8(input);
+  cache.Insert(input, output);
+  return output;
+}
+
+std::string FromUtf8(const std::string& input)
+{
+  // ASCII is encoded the same in both of the encodings.
+  if (IsAscii(input))
+    return CopyAscii(input);
+
+  thread_local ConversionCache cache;
+  if (const auto* cachedOutput = cache.Find(input))
+    return *cachedOutput;
+
+  auto output = ConvertFromUtf8(input);
+  cache.Insert(input, output);
+  return output;
+}
+
 } // namespace locale
 
 } // namespace server
\ No newline at end of file
@@ -0,0 +1,319 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/util/Metrics.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <stdexcept>
+
+namespace server::metrics
+{
+
+namespace
+{
+
+//! Quantiles exposed for the histograms.
+constexpr std::array ExposedQuantiles{0.5, 0.9, 0.99, 0.999};
+
+//! Formats the labels of a metric.
+//! @param labels Labels.
+//! @returns Labels formatted as `name="value"` pairs separated by a comma.
+std::string FormatLabels(Labels labels)
+{
+  std::string formattedLabels;
+  for (const auto& [name, value] : labels)
+  {
+    if (not formattedLabels.empty())
+      formattedLabels += ',';
+
+    formattedLabels += name;
+    formattedLabels += "=\"";
+    for (const char character : value)
+    {
+      switch (character)
+      {
+        case '\\':
+          formattedLabels += "\\\\";
+          break;
+        case '"':
+          formattedLabels += "\\\"";
+          break;
+        case '\n':
+          formattedLabels += "\\n";
+          break;
+        default:
+          formattedLabels += character;
+          break;
+      }
+    }
+    formattedLabels += '"';
+  }
+
+  return formattedLabels;
+}
+
+//! Formats the label set of a sample.
+//! @param labels Formatted labels of the metric.
+//! @param extraLabel Formatted label of the sample, may be empty.
+//! @returns Label set enclosed in braces, or empty if there are no labels.
+std::string FormatLabelSet(std::string_view labels, std::string_view extraLabel = {})
+{
+  if (labels.empty() && extraLabel.empty())
+    return {};
+
+  if (labels.empty())
+    return std::format("{{{}}}", extraLabel);
+  if (extraLabel.empty())
+    return std::format("{{{}}}", labels);
+  return std::format("{{{},{}}}", labels, extraLabel);
+}
+
+//! Converts nanoseconds to seconds.
+double ToSeconds(uint64_t nanoseconds)
+{
+  return static_cast<double>(nanoseconds) / 1'000'000'000.0;
+}
+
+} // anon namespace
+
+std::size_t GetThreadShard()
+{
+  static std::atomic_size_t nextShard{0};
+  thread_local const std::size_t shard =
+    nextShard.fetch_add(1, std::memory_order::relaxed) % ShardCount;
+  return shard;
+}
+
+uint64_t Counter::GetValue() const
+{
+  uint64_t value = 0;
+  for (const auto& shard : _shards)
+  {
+    value += shard.value.load(std::memory_order::relaxed);
+  }
+
+  return value;
+}
+
+Histogram::Histogram()
+{
+  for (auto& shard : _shards)
+  {
+    shard = std::make_unique<Shard>();
+  }
+}
+
+Histogram::Snapshot Histogram::GetSnapshot() const
+{
+  Snapshot snapshot;
+  for (const auto& shard : _shards)
+  {
+    for (std::size_t bucket = 0; bucket < BucketCount; ++bucket)
+    {
+      const auto count = shard->buckets[bucket].load(std::memory_order::relaxed);
+      snapshot.buckets[bucket] += count;
+      snapshot.count += count;
+    }
+
+    snapshot.sum += shard->sum.load(std::memory_order::relaxed);
+  }
+
+  return snapshot;
+}
+
+uint64_t Histogram::Snapshot::GetQuantile(double quantile) const
+{
+  if (count == 0)
+    return 0;
+
+  const auto rank = std::max<uint64_t>(
+    1,
+    static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count))));
+
+  uint64_t cumulativeCount = 0;
+  for (std::size_t bucket = 0; bucket < BucketCount; ++bucket)
+  {
+    cumulativeCount += buckets[bucket];
+    if (cumulativeCount >= rank)
+      return GetBucketHighestValue(bucket);
+  }
+
+  return GetBucketHighestValue(BucketCount - 1);
+}
+
+std::size_t Histogram::GetBucket(uint64_t value)
+{
+  constexpr uint64_t MaxValue = (uint64_t{1} << MaxValueBits) - 1;
+  constexpr uint64_t LinearValueCount = uint64_t{1} << (SubBucketBits + 1);
+
+  value = std::min(value, MaxValue);
+
+  // Values which fit in the sub-buckets are counted exactly.
+  if (value < LinearValueCount)
+    return value;
+
+  // The greater values are counted in the sub-buckets of their power of two,
+  // the exponent drops the bits which do not fit in a sub-bucket.
+  const uint32_t exponent = std::bit_width(value) - (SubBucketBits + 1);
+  return (static_cast<std::size_t>(exponent) << SubBucketBits) + (value >> exponent);
+}
+
+uint64_t Histogram::GetBucketHighestValue(std::size_t bucket)
+{
+  constexpr std::size_t LinearBucketCount = std::size_t{1} << (SubBucketBits + 1);
+  constexpr std::size_t SubBucketCount = std::size_t{1} << SubBucketBits;
+
+  if (bucket < LinearBucketCount)
+    return bucket;
+
+  const uint32_t exponent = (bucket >> SubBucketBits) - 1;
+  const uint64_t mantissa = (bucket & (SubBucketCount - 1)) + SubBucketCount;
+  return ((mantissa + 1) << exponent) - 1;
+}
+
+template <typename T>
+T& Registry::GetMetric(std::string_view name, std::string_view help, Labels labels)
+{
+  const auto formattedLabels = FormatLabels(labels);
+
+  std::scoped_lock lock(_familiesMutex);
+
+  auto familyIter = _families.find(name);
+  if (familyIter == _families.end())
+  {
+    familyIter = _families.emplace(name, Family{.help = std::string(help)}).first;
+  }
+
+  auto& family = familyIter->second;
+
+  // All the metrics of a family must be of the same type.
+  if (not family.metrics.empty()
+    && not std::holds_alternative<std::unique_ptr<T>>(family.metrics.begin()->second))
+  {
+    throw std::logic_error(
+      std::format("Metric '{}' is already registered with a different type", name));
+  }
+
+  auto metricIter = family.metrics.find(formattedLabels);
+  if (metricIter == family.metrics.end())
+  {
+    metricIter = family.metrics.emplace(
+      formattedLabels,
+      std::make_unique<T>()).first;
+  }
+
+  return *std::get<std::unique_ptr<T>>(metricIter->second);
+}
+
+Counter& Registry::GetCounter(std::string_view name, std::string_view help, Labels labels)
+{
+  return GetMetric<Counter>(name, help, labels);
+}
+
+Gauge& Registry::GetGauge(std::string_view name, std::string_view help, Labels labels)
+{
+  return GetMetric<Gauge>(name, help, labels);
+}
+
+Histogram& Registry::GetHistogram(std::string_view name, std::string_view help, Labels labels)
+{
+  return GetMetric<Histogram>(name, help, labels);
+}
+
+std::string Registry::Expose() const
+{
+  std::string exposition;
+
+  std::scoped_lock lock(_familiesMutex);
+  for (const auto& [name, family] : _families)
+  {
+    if (family.metrics.empty())
+      continue;
+
+    std::string_view type;
+    switch (family.metrics.begin()->second.index())
+    {
+      case 0:
+        type = "counter";
+        break;
+      case 1:
+        type = "gauge";
+        break;
+      default:
+        type = "summary";
+        break;
+    }
+
+    exposition += std::format("# HELP {} {}\n# TYPE {} {}\n", name, family.help, name, type);
+
+    for (const auto& [labels, metric] : family.metrics)
+    {
+      if (const auto counter = std::get_if<std::unique_ptr<Counter>>(&metric))
+      {
+        exposition += std::format(
+          "{}{} {}\n",
+          name,
+          FormatLabelSet(labels),
+          (*counter)->GetValue());
+      }
+      else if (const auto gauge = std::get_if<std::unique_ptr<Gauge>>(&metric))
+      {
+        exposition += std::format(
+          "{}{} {}\n",
+          name,
+          FormatLabelSet(labels),
+          (*gauge)->GetValue());
+      }
+      else if (const auto histogram = std::get_if<std::unique_ptr<Histogram>>(&metric))
+      {
+        const auto snapshot = (*histogram)->GetSnapshot();
+        for (const double quantile : ExposedQuantiles)
+        {
+          exposition += std::format(
+            "{}{} {}\n",
+            name,
+            FormatLabelSet(labels, std::format("quantile=\"{}\"", quantile)),
+            ToSeconds(snapshot.GetQuantile(quantile)));
+        }
+
+        exposition += std::format(
+          "{}_sum{} {}\n{}_count{} {}\n",
+          name,
+          FormatLabelSet(labels),
+          ToSeconds(snapshot.sum),
+          name,
+          FormatLabelSet(labels),
+          snapshot.count);
+      }
+    }
+  }
+
+  return exposition;
+}
+
+Registry& GetRegistry()
+{
+  static Registry registry;
+  return registry;
+}
+
+} // namespace server::metrics
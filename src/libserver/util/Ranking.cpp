@@ -0,0 +1,144 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/util/Ranking.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace server
+{
+
+Ranking::Ranking(Order order, Score maxScore, Score bucketSize)
+  : _order(order)
+  , _bucketSize(bucketSize)
+{
+  if (_bucketSize == 0)
+    throw std::invalid_argument("Bucket size must not be zero");
+
+  _tree.resize(maxScore / _bucketSize + 2);
+}
+
+void Ranking::Set(Key key, Score score)
+{
+  const auto [scoreIter, inserted] = _scores.try_emplace(key, score);
+  if (not inserted)
+  {
+    AddToBucket(GetBucket(scoreIter->second), -1);
+    scoreIter->second = score;
+  }
+
+  AddToBucket(GetBucket(score), 1);
+}
+
+bool Ranking::Submit(Key key, Score score)
+{
+  const auto scoreIter = _scores.find(key);
+  if (scoreIter != _scores.cend())
+  {
+    const bool isBetter = _order == Order::Ascending
+      ? score < scoreIter->second
+      : score > scoreIter->second;
+    if (not isBetter)
+      return false;
+  }
+
+  Set(key, score);
+  return true;
+}
+
+void Ranking::Remove(Key key)
+{
+  const auto scoreIter = _scores.find(key);
+  if (scoreIter == _scores.cend())
+    return;
+
+  AddToBucket(GetBucket(scoreIter->second), -1);
+  _scores.erase(scoreIter);
+}
+
+std::optional<Ranking::Score> Ranking::GetScore(Key key) const
+{
+  const auto scoreIter = _scores.find(key);
+  if (scoreIter == _scores.cend())
+    return std::nullopt;
+
+  return scoreIter->second;
+}
+
+std::optional<uint32_t> Ranking::GetRank(Key key) const
+{
+  const auto scoreIter = _scores.find(key);
+  if (scoreIter == _scores.cend())
+    return std::nullopt;
+
+  return CountPreceding(GetBucket(scoreIter->second)) + 1;
+}
+
+std::optional<uint8_t> Ranking::GetPercentile(Key key) const
+{
+  const auto rank = GetRank(key);
+  if (not rank)
+    return std::nullopt;
+
+  // The keys ranked worse than or equal to the key.
+  const auto outrankedCount = _scores.size() - *rank + 1;
+  return static_cast<uint8_t>(outrankedCount * 100 / _scores.size());
+}
+
+std::size_t Ranking::GetSize() const
+{
+  return _scores.size();
+}
+
+const std::unordered_map<Ranking::Key, Ranking::Score>& Ranking::GetScores() const
+{
+  return _scores;
+}
+
+std::size_t Ranking::GetBucket(Score score) const
+{
+  const std::size_t bucketCount = _tree.size() - 1;
+  const std::size_t bucket = std::min<std::size_t>(score / _bucketSize, bucketCount - 1);
+
+  return _order == Order::Ascending
+    ? bucket
+    : bucketCount - 1 - bucket;
+}
+
+void Ranking::AddToBucket(std::size_t bucket, int32_t delta)
+{
+  for (std::size_t idx = bucket + 1; idx < _tree.size(); idx += idx & -idx)
+  {
+    _tree[idx] += delta;
+  }
+}
+
+uint32_t Ranking::CountPreceding(std::size_t bucket) const
+{
+  uint32_t count = 0;
+  for (std::size_t idx = bucket; idx > 0; idx -= idx & -idx)
+  {
+    count += _tree[idx];
+  }
+
+  return count;
+}
+
+} // namespace server
@@ -18,42 +18,52 @@
  **/
 
 #include "libserver/util/Scheduler.hpp"
+#include "libserver/util/Metrics.hpp"
 
 namespace server
 {
 
-Scheduler::Scheduler()
+namespace
 {
-  _jobIterator = _jobs.cend();
+
+//! Histogram of the durations of the executed tasks.
+metrics::Histogram& GetTaskHistogram()
+{
+  static auto& taskHistogram = metrics::GetRegistry().GetHistogram(
+    "alicia_scheduler_task_seconds",
+    "Duration of the tasks executed by the schedulers.");
+  return taskHistogram;
 }
 
+} // anon namespace
+
 void Scheduler::Tick()
 {
-  // Make sure there is jobs to execute.
-  if (_jobs.empty())
-    return;
-
-  // If the job iterator is at the end cycle it back to the front,
-  // since the job list is not empty.
-  if (_jobIterator == _jobs.cend())
+  // Splice out the jobs which are due, the jobs are executed outside of the lock
+  // so that the other threads and the tasks themselves can queue jobs meanwhile.
+  std::list<Job> dueJobs;
   {
-    _jobIterator = _jobs.begin();
+    std::scoped_lock lock(_jobsMutex);
+
+    const auto timeNow = Clock::now();
+    for (auto jobIter = _jobs.begin(); jobIter != _jobs.end();)
+    {
+      const auto nextJobIter = std::next(jobIter);
+      if (timeNow >= jobIter->when)
+        dueJobs.splice(dueJobs.cend(), _jobs, jobIter);
+      jobIter = nextJobIter;
+    }
   }
 
-  // Iterate over the jobs until you find one that can be executed,
-  // execute it and remove it from the job list.
-  while (true)
+  // Execute the jobs in the order they were queued in.
+  for (const auto& job : dueJobs)
   {
-    const auto& job = *_jobIterator;
-    if (Clock::now() >= job.when)
+    const auto timeNow = Clock::now();
     {
+      const trace::Scope traceScope(job.traceId);
       job.task();
-      _jobIterator = _jobs.erase(_jobIterator);
-      break;
     }
-
-    if (++_jobIterator == _jobs.cend())
-      break;
+    GetTaskHistogram().Observe(Clock::now() - timeNow);
   }
 }
 
@@ -64,7 +74,8 @@ void Scheduler::Queue(
   std::scoped_lock lock(_jobsMutex);
   _jobs.emplace_back(Job{
     .when = when,
-    .task = task});
+    .task = task,
+    .traceId = trace::GetCurrentTraceId()});
 }
 
 
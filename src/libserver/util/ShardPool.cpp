@@ -0,0 +1,338 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/util/ShardPool.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <format>
+#include <ranges>
+
+namespace server
+{
+
+ShardPool::~ShardPool()
+{
+  Stop();
+}
+
+void ShardPool::Start(std::size_t shardCount)
+{
+  if (_isRunning.exchange(true, std::memory_order::acq_rel))
+    return;
+
+  if (shardCount == 0)
+    shardCount = std::max(1u, std::thread::hardware_concurrency());
+
+  for (std::size_t shardIdx = 0; shardIdx < shardCount; ++shardIdx)
+  {
+    _shards.emplace_back(std::make_unique<Shard>());
+  }
+
+  for (std::size_t shardIdx = 0; shardIdx < _shards.size(); ++shardIdx)
+  {
+    _shards[shardIdx]->thread = std::thread([this, shardIdx, &shard = *_shards[shardIdx]]()
+    {
+      trace::SetThreadName(std::format("shard {}", shardIdx));
+      RunShard(shard);
+    });
+  }
+}
+
+void ShardPool::Stop()
+{
+  if (not _isRunning.exchange(false, std::memory_order::acq_rel))
+    return;
+
+  for (auto& shard : _shards)
+  {
+    {
+      std::scoped_lock lock(shard->runQueueMutex);
+    }
+    shard->runQueueCv.notify_all();
+
+    if (shard->thread.joinable())
+      shard->thread.join();
+  }
+
+  _shards.clear();
+
+  std::scoped_lock lock(_partitionsMutex);
+  _partitions.clear();
+}
+
+void ShardPool::Queue(Key key, Task task)
+{
+  if (not _isRunning.load(std::memory_order::acquire))
+    return;
+
+  std::shared_ptr<Partition> partition;
+  bool shouldSchedule = false;
+
+  // The task is queued under the partitions lock,
+  // so that the partition can't be forgotten in the meantime.
+  std::scoped_lock lock(_partitionsMutex);
+  auto [partitionIter, created] = _partitions.try_emplace(key);
+  if (created)
+  {
+    partitionIter->second = std::make_shared<Partition>();
+    partitionIter->second->key = key;
+
+    // Pin the new partition to the shard with the least partitions.
+    std::vector<std::size_t> partitionCounts(_shards.size());
+    for (const auto& existingPartition : _partitions | std::views::values)
+    {
+      if (existingPartition)
+        partitionCounts[existingPartition->shard.load(std::memory_order::relaxed)]++;
+    }
+
+    partitionIter->second->shard.store(
+      std::ranges::min_element(partitionCounts) - partitionCounts.cbegin(),
+      std::memory_order::relaxed);
+  }
+
+  partition = partitionIter->second;
+
+  {
+    std::scoped_lock tasksLock(partition->tasksMutex);
+    partition->tasks.emplace(QueuedTask{
+      .task = std::move(task),
+      .traceId = trace::GetCurrentTraceId()});
+
+    // The partition is in use again.
+    partition->isRemoved = false;
+
+    shouldSchedule = not partition->isScheduled;
+    partition->isScheduled = true;
+  }
+
+  if (shouldSchedule)
+    Schedule(partition);
+}
+
+void ShardPool::Remove(Key key)
+{
+  std::scoped_lock lock(_partitionsMutex);
+  const auto partitionIter = _partitions.find(key);
+  if (partitionIter == _partitions.cend())
+    return;
+
+  {
+    auto& partition = *partitionIter->second;
+    std::scoped_lock tasksLock(partition.tasksMutex);
+
+    // A partition with tasks left is forgotten by its shard once it runs out of them.
+    // Forgetting it now would let the tasks queued with the same key in the meantime
+    // execute on a new partition, concurrently with the tasks left.
+    if (partition.isScheduled)
+    {
+      partition.isRemoved = true;
+      return;
+    }
+  }
+
+  _partitions.erase(partitionIter);
+}
+
+bool ShardPool::Balance()
+{
+  if (_shards.size() < 2)
+    return false;
+
+  std::scoped_lock lock(_partitionsMutex);
+
+  // Collect the load of the shards and reset the load of the partitions.
+  std::vector<std::pair<std::shared_ptr<Partition>, std::size_t>> partitionLoads;
+  std::vector<std::size_t> shardLoads(_shards.size());
+  for (const auto& partition : _partitions | std::views::values)
+  {
+    const auto load = partition->load.exchange(0, std::memory_order::relaxed);
+    shardLoads[partition->shard.load(std::memory_order::relaxed)] += load;
+    partitionLoads.emplace_back(partition, load);
+  }
+
+  const auto [minLoadIter, maxLoadIter] = std::ranges::minmax_element(shardLoads);
+  const std::size_t imbalance = *maxLoadIter - *minLoadIter;
+  if (imbalance < MinLoadImbalance)
+    return false;
+
+  const std::size_t sourceShard = maxLoadIter - shardLoads.cbegin();
+  const std::size_t targetShard = minLoadIter - shardLoads.cbegin();
+
+  // Pick the partition of the source shard which evens out the loads of the shards the most.
+  // Migrating a partition with load greater than the imbalance would only swap the shard roles.
+  std::shared_ptr<Partition> migratedPartition;
+  std::size_t migratedLoad = 0;
+  std::size_t remainingImbalance = imbalance;
+  for (const auto& [partition, load] : partitionLoads)
+  {
+    if (partition->shard.load(std::memory_order::relaxed) != sourceShard)
+      continue;
+    if (load == 0 || load >= imbalance)
+      continue;
+
+    const std::size_t migratedImbalance = load * 2 > imbalance
+      ? load * 2 - imbalance
+      : imbalance - load * 2;
+    if (migratedImbalance >= remainingImbalance)
+      continue;
+
+    migratedPartition = partition;
+    migratedLoad = load;
+    remainingImbalance = migratedImbalance;
+  }
+
+  if (not migratedPartition)
+    return false;
+
+  // The partition is executed by the source shard until its current turn ends,
+  // it is scheduled on the target shard from the next turn on.
+  migratedPartition->shard.store(targetShard, std::memory_order::release);
+
+  spdlog::debug(
+    "Migrated a partition from shard {} to shard {} (load {}, imbalance {})",
+    sourceShard,
+    targetShard,
+    migratedLoad,
+    imbalance);
+
+  return true;
+}
+
+std::size_t ShardPool::GetShardCount() const
+{
+  return _shards.size();
+}
+
+std::size_t ShardPool::GetShard(Key key)
+{
+  std::scoped_lock lock(_partitionsMutex);
+  const auto partitionIter = _partitions.find(key);
+  if (partitionIter == _partitions.cend())
+    return _shards.size();
+
+  return partitionIter->second->shard.load(std::memory_order::relaxed);
+}
+
+void ShardPool::Schedule(const std::shared_ptr<Partition>& partition)
+{
+  auto& shard = *_shards[partition->shard.load(std::memory_order::acquire)];
+
+  {
+    std::scoped_lock lock(shard.runQueueMutex);
+    shard.runQueue.emplace(partition);
+  }
+
+  shard.runQueueCv.notify_one();
+}
+
+void ShardPool::Forget(const std::shared_ptr<Partition>& partition)
+{
+  std::scoped_lock lock(_partitionsMutex);
+
+  {
+    std::scoped_lock tasksLock(partition->tasksMutex);
+    // Tasks might have been queued since the partition ran out of them.
+    if (partition->isScheduled || not partition->isRemoved)
+      return;
+  }
+
+  const auto partitionIter = _partitions.find(partition->key);
+  if (partitionIter != _partitions.cend() && partitionIter->second == partition)
+    _partitions.erase(partitionIter);
+}
+
+void ShardPool::RunShard(Shard& shard)
+{
+  while (_isRunning.load(std::memory_order::acquire))
+  {
+    std::shared_ptr<Partition> partition;
+
+    {
+      std::unique_lock lock(shard.runQueueMutex);
+      shard.runQueueCv.wait(lock, [this, &shard]()
+      {
+        return not shard.runQueue.empty()
+          || not _isRunning.load(std::memory_order::acquire);
+      });
+
+      if (shard.runQueue.empty())
+        continue;
+
+      partition = std::move(shard.runQueue.front());
+      shard.runQueue.pop();
+    }
+
+    // Execute the tasks of the partition for one turn.
+    bool hasRemainingTasks = false;
+    bool isForgotten = false;
+    for (std::size_t taskIdx = 0; taskIdx < MaxTasksPerTurn; ++taskIdx)
+    {
+      QueuedTask task;
+
+      {
+        std::scoped_lock lock(partition->tasksMutex);
+        if (partition->tasks.empty())
+        {
+          partition->isScheduled = false;
+          isForgotten = partition->isRemoved;
+          break;
+        }
+
+        task = std::move(partition->tasks.front());
+        partition->tasks.pop();
+        hasRemainingTasks = not partition->tasks.empty();
+      }
+
+      try
+      {
+        const trace::Scope traceScope(task.traceId);
+        task.task();
+      }
+      catch (const std::exception& x)
+      {
+        spdlog::error("Unhandled exception executing a shard task: {}", x.what());
+      }
+
+      partition->load.fetch_add(1, std::memory_order::relaxed);
+
+      if (not hasRemainingTasks)
+      {
+        std::scoped_lock lock(partition->tasksMutex);
+        if (partition->tasks.empty())
+        {
+          partition->isScheduled = false;
+          isForgotten = partition->isRemoved;
+          break;
+        }
+        hasRemainingTasks = true;
+      }
+    }
+
+    // Let the other partitions have their turn,
+    // the partition is scheduled on the shard it is currently pinned to.
+    if (hasRemainingTasks)
+      Schedule(partition);
+    else if (isForgotten)
+      Forget(partition);
+  }
+}
+
+} // namespace server
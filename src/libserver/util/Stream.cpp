@@ -6,6 +6,9 @@
 
 #include "libserver/util/Locale.hpp"
 
+#include <algorithm>
+#include <cstring>
+
 namespace server
 {
 
@@ -57,65 +60,43 @@ SinkStream& SinkStream::operator=(SinkStream&& rhs) noexcept
 
 void SinkStream::Write(const void* data, std::size_t size)
 {
-  if (_cursor + size > _storage.size())
-  {
-    throw std::overflow_error(std::format("Couldn't write {} bytes to the buffer (cursor: {}, available: {}). Not enough space.", size, _cursor, _storage.size()));
-  }
+  if (size == 0)
+    return;
 
-  // Write the bytes.
-  for (std::size_t byteIdx = 0; byteIdx < size; ++byteIdx)
-  {
-    _storage[_cursor++] = static_cast<const std::byte*>(data)[byteIdx];
-  }
+  std::memcpy(Reserve(size), data, size);
 }
 
 SinkStream& SinkStream::Write(const std::string& value)
 {
   const std::string buffer = locale::FromUtf8(value);
 
-  for (char b : buffer)
-  {
-    Write(b);
-  }
-
-  Write(static_cast<char>(0x00));
+  // Write the string along with its terminator.
+  Write(buffer.c_str(), buffer.length() + 1);
   return *this;
 }
 
 void SourceStream::Read(void* data, std::size_t size)
 {
-  if (_cursor + size > _storage.size())
-  {
-    throw std::overflow_error(std::format("Couldn't read {} bytes to the buffer (cursor: {}, available: {}). Not enough space.", size, _cursor, _storage.size()));
-  }
+  if (size == 0)
+    return;
 
-  // Read the bytes.
-  for (std::size_t byteIdx = 0; byteIdx < size; ++byteIdx)
-  {
-    static_cast<std::byte*>(data)[byteIdx] = _storage[_cursor++];
-  }
+  std::memcpy(data, Reserve(size), size);
 }
 
 SourceStream& SourceStream::Read(std::string& value)
 {
-  std::string buffer;
-  buffer.reserve(512);
-
-  bool readNext = true;
-  do
+  // Find the terminator of the string.
+  const auto remaining = _storage.subspan(_cursor);
+  const auto terminatorIter = std::ranges::find(remaining, std::byte{0x00});
+  if (terminatorIter == remaining.end())
   {
-    char read = '\0';
-    Read(read);
-
-    if (read == '\0')
-    {
-      readNext = false;
-    }
-    else
-    {
-      buffer += read;
-    }
-  } while (readNext);
+    throw std::overflow_error(std::format("Couldn't read a string from the buffer (cursor: {}, available: {}). Missing terminator.", _cursor, _storage.size()));
+  }
+
+  const std::string buffer(
+    reinterpret_cast<const char*>(remaining.data()),
+    terminatorIter - remaining.begin());
+  _cursor += buffer.length() + 1;
 
   value = locale::ToUtf8(buffer);
   return *this;
@@ -0,0 +1,303 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/util/Trace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace server::trace
+{
+
+namespace
+{
+
+//! Category of the exported events.
+constexpr std::string_view EventCategory = "alicia";
+
+//! A span recorded to a buffer.
+struct SpanRecord
+{
+  //! Name of the span.
+  std::string_view name{};
+  //! Trace ID of the span.
+  TraceId traceId{InvalidTraceId};
+  //! Time point of when the span began.
+  Clock::time_point beginning{};
+  //! Duration of the span.
+  Clock::duration duration{};
+};
+
+//! A ring buffer of the spans recorded by a thread.
+struct SpanBuffer
+{
+  //! A mutex locked by the owning thread to record a span,
+  //! it is contended only while the spans are being dumped.
+  std::mutex mutex;
+  //! ID of the thread in the exported traces.
+  uint32_t threadId{};
+  //! Name of the thread in the exported traces.
+  std::string threadName;
+  //! Recorded spans.
+  std::vector<SpanRecord> spans;
+  //! Count of the spans recorded over the lifetime of the buffer.
+  uint64_t recordedCount{0};
+};
+
+//! A span collected for the export.
+struct ExportedSpan
+{
+  uint32_t threadId{};
+  SpanRecord record{};
+};
+
+//! The state shared by all the threads.
+struct Tracer
+{
+  //! Time point the exported timestamps are relative to.
+  const Clock::time_point epoch{Clock::now()};
+  //! Next trace ID.
+  std::atomic<TraceId> nextTraceId{InvalidTraceId + 1};
+
+  //! A mutex for the buffers.
+  std::mutex buffersMutex;
+  //! Buffers of the threads, kept after the threads exit so that their spans can be dumped.
+  std::vector<std::shared_ptr<SpanBuffer>> buffers;
+  //! Next thread ID.
+  uint32_t nextThreadId{1};
+};
+
+//! Trace ID of the thread.
+thread_local TraceId threadTraceId = InvalidTraceId;
+
+Tracer& GetTracer()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+//! Returns the buffer of the calling thread, registering it on the first use.
+//! @returns Buffer of the thread.
+SpanBuffer& GetThreadBuffer()
+{
+  thread_local const auto threadBuffer = []()
+  {
+    auto buffer = std::make_shared<SpanBuffer>();
+    buffer->spans.resize(SpanBufferCapacity);
+
+    auto& tracer = GetTracer();
+    std::scoped_lock lock(tracer.buffersMutex);
+    buffer->threadId = tracer.nextThreadId++;
+    tracer.buffers.emplace_back(buffer);
+    return buffer;
+  }();
+
+  return *threadBuffer;
+}
+
+//! Writes a string as a JSON string literal.
+//! @param stream Stream to write to.
+//! @param value Value of the string.
+void WriteString(std::ostream& stream, std::string_view value)
+{
+  stream << '"';
+  for (const char character : value)
+  {
+    switch (character)
+    {
+      case '\\':
+        stream << "\\\\";
+        break;
+      case '"':
+        stream << "\\\"";
+        break;
+      case '\n':
+        stream << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(character) < 0x20)
+          stream << std::format("\\u{:04x}", static_cast<int>(character));
+        else
+          stream << character;
+        break;
+    }
+  }
+  stream << '"';
+}
+
+//! Converts a duration to the microseconds of the trace-event format.
+//! @param duration Duration.
+//! @returns Duration in microseconds.
+double ToMicroseconds(Clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // anon namespace
+
+TraceId GenerateTraceId()
+{
+  return GetTracer().nextTraceId.fetch_add(1, std::memory_order::relaxed);
+}
+
+TraceId GetCurrentTraceId()
+{
+  return threadTraceId;
+}
+
+void SetThreadName(std::string_view name)
+{
+  auto& buffer = GetThreadBuffer();
+  std::scoped_lock lock(buffer.mutex);
+  buffer.threadName = name;
+}
+
+void RecordSpan(
+  std::string_view name,
+  TraceId traceId,
+  Clock::time_point beginning,
+  Clock::time_point end)
+{
+  auto& buffer = GetThreadBuffer();
+  std::scoped_lock lock(buffer.mutex);
+  buffer.spans[buffer.recordedCount++ % SpanBufferCapacity] = SpanRecord{
+    .name = name,
+    .traceId = traceId,
+    .beginning = beginning,
+    .duration = end - beginning};
+}
+
+TraceId Scope::Exchange(TraceId traceId)
+{
+  return std::exchange(threadTraceId, traceId);
+}
+
+std::size_t WriteChromeTrace(std::ostream& stream)
+{
+  auto& tracer = GetTracer();
+
+  std::vector<std::shared_ptr<SpanBuffer>> buffers;
+  {
+    std::scoped_lock lock(tracer.buffersMutex);
+    buffers = tracer.buffers;
+  }
+
+  // Collect the spans, holding the lock of a buffer only while it is copied.
+  std::vector<std::pair<uint32_t, std::string>> threadNames;
+  std::vector<ExportedSpan> spans;
+  for (const auto& buffer : buffers)
+  {
+    std::scoped_lock lock(buffer->mutex);
+    if (not buffer->threadName.empty())
+      threadNames.emplace_back(buffer->threadId, buffer->threadName);
+
+    const auto spanCount = std::min<uint64_t>(buffer->recordedCount, SpanBufferCapacity);
+    for (std::size_t spanIdx = 0; spanIdx < spanCount; ++spanIdx)
+    {
+      spans.emplace_back(ExportedSpan{
+        .threadId = buffer->threadId,
+        .record = buffer->spans[spanIdx]});
+    }
+  }
+
+  // Order the spans of a trace by their beginning, so that they can be linked in order.
+  std::ranges::sort(spans, [](const ExportedSpan& lhs, const ExportedSpan& rhs)
+  {
+    if (lhs.record.traceId != rhs.record.traceId)
+      return lhs.record.traceId < rhs.record.traceId;
+    return lhs.record.beginning < rhs.record.beginning;
+  });
+
+  stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+  stream << std::format(
+    R"({{"name":"process_name","ph":"M","pid":1,"tid":0,"args":{{"name":"alicia-server"}}}})");
+
+  for (const auto& [threadId, threadName] : threadNames)
+  {
+    stream << std::format(
+      R"(,{{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":)",
+      threadId);
+    WriteString(stream, threadName);
+    stream << "}}";
+  }
+
+  for (std::size_t spanIdx = 0; spanIdx < spans.size(); ++spanIdx)
+  {
+    const auto& [threadId, record] = spans[spanIdx];
+    const auto timestamp = ToMicroseconds(record.beginning - tracer.epoch);
+
+    stream << R"(,{"name":)";
+    WriteString(stream, record.name);
+    stream << std::format(
+      R"(,"cat":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":1,"tid":{},"args":{{"trace":{}}}}})",
+      EventCategory,
+      timestamp,
+      ToMicroseconds(record.duration),
+      threadId,
+      record.traceId);
+
+    // Link the span to the previous and to the next span of the trace.
+    const bool hasPrevious = spanIdx > 0
+      && spans[spanIdx - 1].record.traceId == record.traceId;
+    const bool hasNext = spanIdx + 1 < spans.size()
+      && spans[spanIdx + 1].record.traceId == record.traceId;
+    if (not hasPrevious && not hasNext)
+      continue;
+
+    const std::string_view flowPhase = not hasPrevious ? "s" : hasNext ? "t" : "f";
+    stream << std::format(
+      R"(,{{"name":"trace","cat":"{}","ph":"{}","bp":"e","id":{},"ts":{:.3f},"pid":1,"tid":{}}})",
+      EventCategory,
+      flowPhase,
+      record.traceId,
+      timestamp,
+      threadId);
+  }
+
+  stream << "]}";
+
+  return spans.size();
+}
+
+std::size_t DumpChromeTrace(const std::filesystem::path& path)
+{
+  std::ofstream file(path, std::ios::trunc);
+  if (not file.is_open())
+    throw std::runtime_error(
+      std::format("Couldn't open the trace file '{}'", path.string()));
+
+  const auto spanCount = WriteChromeTrace(file);
+
+  file.flush();
+  if (not file)
+    throw std::runtime_error(
+      std::format("Couldn't write the trace file '{}'", path.string()));
+
+  return spanCount;
+}
+
+} // namespace server::trace
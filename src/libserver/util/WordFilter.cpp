@@ -0,0 +1,330 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/util/WordFilter.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <ranges>
+
+namespace server
+{
+
+namespace
+{
+
+//! A base of the code points representing the bytes of invalid UTF-8 sequences.
+//! It lies outside of the Unicode range so these never match a valid character.
+constexpr char32_t InvalidByteBase = 0x110000;
+
+//! Normalizes a code point.
+//! @param codePoint Code point.
+//! @returns Normalized code point.
+char32_t NormalizeCodePoint(char32_t codePoint)
+{
+  // Map the full-width forms to ASCII.
+  if (codePoint >= 0xFF01 && codePoint <= 0xFF5E)
+    codePoint -= 0xFEE0;
+
+  // Fold the case of ASCII and Latin-1 letters.
+  if (codePoint >= 'A' && codePoint <= 'Z')
+    return codePoint + ('a' - 'A');
+  if (codePoint >= 0xC0 && codePoint <= 0xDE && codePoint != 0xD7)
+    return codePoint + 0x20;
+
+  return codePoint;
+}
+
+} // anon namespace
+
+WordFilter::WordFilter(std::span<const std::string> words)
+{
+  // Build the trie of the words.
+  std::vector<std::vector<Transition>> nodeTransitions(1);
+  for (const auto& word : words)
+  {
+    const auto characters = DecodeText(word);
+    if (characters.empty())
+      continue;
+
+    NodeIndex nodeIndex = 0;
+    for (const auto& character : characters)
+    {
+      auto& transitions = nodeTransitions[nodeIndex];
+      const auto transitionIter = std::ranges::lower_bound(
+        transitions,
+        character.codePoint,
+        {},
+        &Transition::first);
+
+      if (transitionIter != transitions.cend() && transitionIter->first == character.codePoint)
+      {
+        nodeIndex = transitionIter->second;
+        continue;
+      }
+
+      const auto childIndex = static_cast<NodeIndex>(_nodes.size());
+      transitions.emplace(transitionIter, character.codePoint, childIndex);
+      nodeTransitions.emplace_back();
+      _nodes.emplace_back();
+      nodeIndex = childIndex;
+    }
+
+    auto& matchLength = _nodes[nodeIndex].matchLength;
+    if (matchLength == 0)
+      ++_wordCount;
+    matchLength = static_cast<uint32_t>(characters.size());
+  }
+
+  // Store the transitions contiguously.
+  for (std::size_t nodeIdx = 0; nodeIdx < _nodes.size(); ++nodeIdx)
+  {
+    auto& node = _nodes[nodeIdx];
+    node.transitionOffset = static_cast<uint32_t>(_transitions.size());
+    node.transitionCount = static_cast<uint32_t>(nodeTransitions[nodeIdx].size());
+    _transitions.insert(
+      _transitions.cend(),
+      nodeTransitions[nodeIdx].cbegin(),
+      nodeTransitions[nodeIdx].cend());
+  }
+
+  for (const auto& [codePoint, childIndex] : nodeTransitions.front())
+  {
+    if (codePoint < RootTableSize)
+      _rootTable[codePoint] = childIndex;
+  }
+
+  // Link the nodes to their longest suffixes in a breadth-first order,
+  // so that the suffixes are always linked before the nodes which refer to them.
+  std::queue<NodeIndex> nodeQueue;
+  for (const auto& childIndex : nodeTransitions.front() | std::views::values)
+  {
+    nodeQueue.emplace(childIndex);
+  }
+
+  while (not nodeQueue.empty())
+  {
+    const auto nodeIndex = nodeQueue.front();
+    nodeQueue.pop();
+
+    for (const auto& [codePoint, childIndex] : nodeTransitions[nodeIndex])
+    {
+      const auto failureIndex = Advance(_nodes[nodeIndex].failure, codePoint);
+
+      auto& child = _nodes[childIndex];
+      child.failure = failureIndex;
+      child.matchLength = std::max(child.matchLength, _nodes[failureIndex].matchLength);
+
+      nodeQueue.emplace(childIndex);
+    }
+  }
+}
+
+std::vector<WordFilter::Match> WordFilter::Scan(std::string_view text) const
+{
+  if (_wordCount == 0)
+    return {};
+
+  return ScanCharacters(DecodeText(text));
+}
+
+bool WordFilter::Contains(std::string_view text) const
+{
+  if (_wordCount == 0)
+    return false;
+
+  NodeIndex nodeIndex = 0;
+  for (const auto& character : DecodeText(text))
+  {
+    nodeIndex = Advance(nodeIndex, character.codePoint);
+    if (_nodes[nodeIndex].matchLength != 0)
+      return true;
+  }
+
+  return false;
+}
+
+std::string WordFilter::Mask(std::string_view text, char mask) const
+{
+  if (_wordCount == 0)
+    return std::string(text);
+
+  const auto characters = DecodeText(text);
+  const auto matches = ScanCharacters(characters);
+  if (matches.empty())
+    return std::string(text);
+
+  std::string maskedText;
+  maskedText.reserve(text.size());
+
+  // Matches are ordered by their end and a later match may start before the end of an earlier one.
+  std::vector<bool> isMasked(text.size(), false);
+  for (const auto& match : matches)
+  {
+    std::fill_n(isMasked.begin() + match.offset, match.length, true);
+  }
+
+  for (const auto& character : characters)
+  {
+    if (isMasked[character.offset])
+      maskedText.push_back(mask);
+    else
+      maskedText.append(text.substr(character.offset, character.length));
+  }
+
+  return maskedText;
+}
+
+std::size_t WordFilter::GetWordCount() const
+{
+  return _wordCount;
+}
+
+std::vector<WordFilter::Character> WordFilter::DecodeText(std::string_view text)
+{
+  std::vector<Character> characters;
+  characters.reserve(text.size());
+
+  std::size_t offset = 0;
+  while (offset < text.size())
+  {
+    const auto leadByte = static_cast<uint8_t>(text[offset]);
+
+    std::size_t length = 1;
+    char32_t codePoint = leadByte;
+    if (leadByte >= 0xF0 && leadByte <= 0xF4)
+    {
+      length = 4;
+      codePoint = leadByte & 0x07;
+    }
+    else if (leadByte >= 0xE0)
+    {
+      length = 3;
+      codePoint = leadByte & 0x0F;
+    }
+    else if (leadByte >= 0xC2 && leadByte <= 0xDF)
+    {
+      length = 2;
+      codePoint = leadByte & 0x1F;
+    }
+    else if (leadByte >= 0x80)
+    {
+      length = 0;
+    }
+
+    // Decode the continuation bytes.
+    if (length > 1)
+    {
+      if (offset + length > text.size())
+      {
+        length = 0;
+      }
+      else
+      {
+        for (std::size_t byteIdx = 1; byteIdx < length; ++byteIdx)
+        {
+          const auto continuationByte = static_cast<uint8_t>(text[offset + byteIdx]);
+          if ((continuationByte & 0xC0) != 0x80)
+          {
+            length = 0;
+            break;
+          }
+
+          codePoint = (codePoint << 6) | (continuationByte & 0x3F);
+        }
+      }
+    }
+
+    // Decode the byte of an invalid sequence on its own.
+    if (length == 0)
+    {
+      length = 1;
+      codePoint = InvalidByteBase + leadByte;
+    }
+
+    characters.emplace_back(Character{
+      .codePoint = NormalizeCodePoint(codePoint),
+      .offset = offset,
+      .length = length});
+
+    offset += length;
+  }
+
+  return characters;
+}
+
+std::vector<WordFilter::Match> WordFilter::ScanCharacters(
+  std::span<const Character> characters) const
+{
+  std::vector<Match> matches;
+
+  NodeIndex nodeIndex = 0;
+  for (std::size_t characterIdx = 0; characterIdx < characters.size(); ++characterIdx)
+  {
+    nodeIndex = Advance(nodeIndex, characters[characterIdx].codePoint);
+
+    const auto matchLength = _nodes[nodeIndex].matchLength;
+    if (matchLength == 0)
+      continue;
+
+    const auto& firstCharacter = characters[characterIdx + 1 - matchLength];
+    const auto& lastCharacter = characters[characterIdx];
+    matches.emplace_back(Match{
+      .offset = firstCharacter.offset,
+      .length = lastCharacter.offset + lastCharacter.length - firstCharacter.offset});
+  }
+
+  return matches;
+}
+
+WordFilter::NodeIndex WordFilter::FindTransition(NodeIndex nodeIndex, char32_t codePoint) const
+{
+  if (nodeIndex == 0 && codePoint < RootTableSize)
+    return _rootTable[codePoint];
+
+  const auto& node = _nodes[nodeIndex];
+  const auto transitions = std::span(_transitions).subspan(
+    node.transitionOffset,
+    node.transitionCount);
+
+  const auto transitionIter = std::ranges::lower_bound(
+    transitions,
+    codePoint,
+    {},
+    &Transition::first);
+
+  if (transitionIter == transitions.end() || transitionIter->first != codePoint)
+    return 0;
+
+  return transitionIter->second;
+}
+
+WordFilter::NodeIndex WordFilter::Advance(NodeIndex nodeIndex, char32_t codePoint) const
+{
+  while (true)
+  {
+    const auto childIndex = FindTransition(nodeIndex, codePoint);
+    if (childIndex != 0 || nodeIndex == 0)
+      return childIndex;
+
+    nodeIndex = _nodes[nodeIndex].failure;
+  }
+}
+
+} // namespace server
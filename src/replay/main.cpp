@@ -0,0 +1,229 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "server/ServerInstance.hpp"
+
+#include <libserver/network/command/CommandTrace.hpp>
+
+#include <spdlog/spdlog.h>
+
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <ranges>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+void PrintUsage()
+{
+  std::cout <<
+    "Usage: alicia-replay <trace> <lobby|ranch|race> [options]\n"
+    "  --speed <factor>     Speed of the replay relative to the capture (1),\n"
+    "                       0 replays the commands as fast as possible\n"
+    "  --base <directory>   Base directory of the server (working directory)\n";
+}
+
+} // anon namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    PrintUsage();
+    return 1;
+  }
+
+  const std::filesystem::path tracePath = argv[1];
+  const std::string_view directorName = argv[2];
+
+  double speed = 1.0;
+  std::filesystem::path baseDirectory;
+  for (int idx = 3; idx + 1 < argc; idx += 2)
+  {
+    const std::string_view option = argv[idx];
+    const std::string_view value = argv[idx + 1];
+
+    if (option == "--speed")
+    {
+      const auto result = std::from_chars(value.data(), value.data() + value.size(), speed);
+      if (result.ec != std::errc{} || speed < 0.0)
+      {
+        std::cerr << "Invalid speed '" << value << "'\n";
+        return 1;
+      }
+    }
+    else if (option == "--base")
+    {
+      baseDirectory = value;
+    }
+    else
+    {
+      PrintUsage();
+      return 1;
+    }
+  }
+
+  std::optional<server::CommandTraceReader> traceReader;
+  try
+  {
+    traceReader.emplace(tracePath);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error("Failed to open the trace: {}", x.what());
+    return 1;
+  }
+
+  // The handlers log every command on the debug level.
+  spdlog::set_level(spdlog::level::info);
+
+  server::ServerInstance serverInstance(baseDirectory);
+  serverInstance.Initialize();
+
+  server::CommandServer* commandServer = nullptr;
+  if (directorName == "lobby")
+    commandServer = &serverInstance.GetLobbyDirector().GetCommandServer();
+  else if (directorName == "ranch")
+    commandServer = &serverInstance.GetRanchDirector().GetCommandServer();
+  else if (directorName == "race")
+    commandServer = &serverInstance.GetRaceDirector().GetCommandServer();
+  else
+  {
+    PrintUsage();
+    serverInstance.Terminate();
+    return 1;
+  }
+
+  // Let the directors initialize on their threads.
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  spdlog::info(
+    "Replaying '{}' into the {} director at {}x speed",
+    tracePath.string(),
+    directorName,
+    speed);
+
+  // The replayed clients are connected through the loopback transport and
+  // their commands are dispatched to the handlers in-process.
+  // The responses are written to the loopback clients and discarded.
+  std::unordered_map<server::ClientId, std::shared_ptr<server::network::LoopbackClient>> clients;
+  std::size_t commandCount = 0;
+  std::size_t responseSize = 0;
+  Clock::duration dispatchDuration{};
+
+  const auto beginning = Clock::now();
+  server::CommandTraceRecord record;
+
+  try
+  {
+    while (traceReader->Read(record))
+    {
+      if (speed > 0.0)
+      {
+        std::this_thread::sleep_until(
+          beginning + std::chrono::duration_cast<Clock::duration>(record.timestamp / speed));
+      }
+
+      switch (record.type)
+      {
+        case server::CommandTraceRecord::Type::Connected:
+        {
+          if (not clients.contains(record.clientId))
+            clients.emplace(record.clientId, commandServer->ConnectLoopback());
+          break;
+        }
+        case server::CommandTraceRecord::Type::Disconnected:
+        {
+          const auto clientIter = clients.find(record.clientId);
+          if (clientIter == clients.cend())
+            break;
+
+          responseSize += clientIter->second->Receive().size();
+          clientIter->second->End();
+          clients.erase(clientIter);
+          break;
+        }
+        case server::CommandTraceRecord::Type::Command:
+        {
+          // The client connected before the capture began.
+          auto clientIter = clients.find(record.clientId);
+          if (clientIter == clients.cend())
+          {
+            clientIter = clients.emplace(
+              record.clientId,
+              commandServer->ConnectLoopback()).first;
+          }
+
+          auto& client = *clientIter->second;
+
+          const auto dispatchBeginning = Clock::now();
+          commandServer->DispatchCommand(client.GetId(), record.commandId, record.data);
+          dispatchDuration += Clock::now() - dispatchBeginning;
+
+          responseSize += client.Receive().size();
+          ++commandCount;
+          break;
+        }
+        case server::CommandTraceRecord::Type::State:
+        {
+          // Seed the states the following commands depend on,
+          // such as the codes granted and the rooms created by the lobby.
+          serverInstance.RestoreState(record.stateId, record.data);
+          break;
+        }
+      }
+    }
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error("Failed to read the trace: {}", x.what());
+  }
+
+  const auto replayDuration = Clock::now() - beginning;
+
+  for (const auto& client : clients | std::views::values)
+  {
+    responseSize += client->Receive().size();
+    client->End();
+  }
+
+  serverInstance.Terminate();
+
+  const auto replaySeconds = std::chrono::duration<double>(replayDuration).count();
+  const auto dispatchSeconds = std::chrono::duration<double>(dispatchDuration).count();
+
+  spdlog::info(
+    "Replayed {} commands in {:.3f}s ({:.0f} cmd/s), dispatch took {:.3f}s ({:.2f}us per command), "
+    "{} bytes of responses",
+    commandCount,
+    replaySeconds,
+    replaySeconds > 0.0 ? commandCount / replaySeconds : 0.0,
+    dispatchSeconds,
+    commandCount > 0 ? dispatchSeconds * 1'000'000.0 / commandCount : 0.0,
+    responseSize);
+
+  return 0;
+}
@@ -117,6 +117,27 @@ void Config::LoadFromEnvironment()
     std::format("RACE_SERVER_PORT"),
     race.listen.address,
     race.listen.port);
+
+  // Race relay address and port.
+  getAddressAndPortVariables(
+    std::format("RACE_RELAY_ADDRESS"),
+    std::format("RACE_RELAY_PORT"),
+    race.relay.listen.address,
+    race.relay.listen.port);
+
+  // Race relay advertised address and port.
+  getAddressAndPortVariables(
+    std::format("RACE_RELAY_ADVERTISED_ADDRESS"),
+    std::format("RACE_RELAY_ADVERTISED_PORT"),
+    race.relay.advertisement.address,
+    race.relay.advertisement.port);
+
+  // Metrics address and port.
+  getAddressAndPortVariables(
+    std::format("METRICS_ADDRESS"),
+    std::format("METRICS_PORT"),
+    metrics.listen.address,
+    metrics.listen.port);
 }
 
 void Config::LoadFromFile(const std::filesystem::path& filePath)
@@ -170,6 +191,7 @@ void Config::LoadFromFile(const std::filesystem::path& filePath)
       const auto lobbyYaml = serverYaml["lobby"];
       lobby.enabled = lobbyYaml["enabled"].as<bool>();
       lobby.listen = parseListenSection(lobbyYaml["listen"]);
+      lobby.capturePath = lobbyYaml["capture"].as<std::string>(lobby.capturePath);
 
       const auto lobbyAdvertisementYaml = lobbyYaml["advertisement"];
       lobby.advertisement.ranch = parseListenSection(lobbyAdvertisementYaml["ranch"]);
@@ -187,6 +209,10 @@ void Config::LoadFromFile(const std::filesystem::path& filePath)
       const auto ranchYaml = serverYaml["ranch"];
       ranch.enabled = ranchYaml["enabled"].as<bool>();
       ranch.listen = parseListenSection(ranchYaml["listen"]);
+      ranch.interestRadius = ranchYaml["interestRadius"].as<float>(ranch.interestRadius);
+      ranch.farSnapshotInterval = ranchYaml["farSnapshotInterval"].as<uint32_t>(
+        ranch.farSnapshotInterval);
+      ranch.capturePath = ranchYaml["capture"].as<std::string>(ranch.capturePath);
     }
     catch (const std::exception& e)
     {
@@ -199,6 +225,17 @@ void Config::LoadFromFile(const std::filesystem::path& filePath)
       const auto raceYaml = serverYaml["race"];
       race.enabled = raceYaml["enabled"].as<bool>();
       race.listen = parseListenSection(raceYaml["listen"]);
+      race.snapshotRate = raceYaml["snapshotRate"].as<uint32_t>(race.snapshotRate);
+      race.shardCount = raceYaml["shardCount"].as<uint32_t>(race.shardCount);
+      race.capturePath = raceYaml["capture"].as<std::string>(race.capturePath);
+
+      if (const auto relayYaml = raceYaml["relay"])
+      {
+        race.relay.enabled = relayYaml["enabled"].as<bool>();
+        race.relay.listen = parseListenSection(relayYaml["listen"]);
+        race.relay.advertisement = parseListenSection(relayYaml["advertisement"]);
+        race.relay.idleTimeout = relayYaml["idleTimeout"].as<uint32_t>(race.relay.idleTimeout);
+      }
     }
     catch (const std::exception& e)
     {
@@ -217,6 +254,34 @@ void Config::LoadFromFile(const std::filesystem::path& filePath)
       spdlog::error("Unhandled exception parsing the messenger config: {}", e.what());
     }
 
+    // Profiling config
+    try
+    {
+      if (const auto profilingYaml = serverYaml["profiling"])
+      {
+        profiling.slowCommandThreshold = profilingYaml["slowCommandThreshold"].as<uint32_t>(
+          profiling.slowCommandThreshold);
+      }
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::error("Unhandled exception parsing the profiling config: {}", e.what());
+    }
+
+    // Metrics config
+    try
+    {
+      if (const auto metricsYaml = serverYaml["metrics"])
+      {
+        metrics.enabled = metricsYaml["enabled"].as<bool>();
+        metrics.listen = parseListenSection(metricsYaml["listen"]);
+      }
+    }
+    catch (const std::exception& e)
+    {
+      spdlog::error("Unhandled exception parsing the metrics config: {}", e.what());
+    }
+
     // Messenger config
     try
     {
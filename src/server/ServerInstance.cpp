@@ -4,9 +4,30 @@
 
 #include "server/ServerInstance.hpp"
 
+#include <libserver/util/Stream.hpp>
+
+#include <array>
+
 namespace server
 {
 
+namespace
+{
+
+//! IDs of the states captured along with the commands.
+enum class CapturedState : uint16_t
+{
+  //! A one-time code granted by the lobby.
+  OtpCode = 0,
+  //! A room created by the lobby.
+  Room = 1,
+};
+
+//! Max size of the data of a captured state.
+constexpr std::size_t MaxCapturedStateSize = 1024;
+
+} // anon namespace
+
 ServerInstance::ServerInstance(
   const std::filesystem::path& resourceDirectory)
   : _resourceDirectory(resourceDirectory)
@@ -15,8 +36,11 @@ ServerInstance::ServerInstance(
   , _messengerDirector(*this)
   , _ranchDirector(*this)
   , _raceDirector(*this)
+  , _breedingMarketSystem(*this)
   , _chatSystem(*this)
   , _infractionSystem(*this)
+  , _rankingSystem(*this)
+  , _metricsServer(metrics::GetRegistry())
 {
 }
 
@@ -52,6 +76,24 @@ void ServerInstance::Initialize()
   _itemRegistry.ReadConfig(_resourceDirectory / "config/game/items.yaml");
   _petRegistry.ReadConfig(_resourceDirectory / "config/game/pets.yaml");
 
+  ReloadShopCatalogue();
+
+  try
+  {
+    ReloadChatModeration();
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error("Failed to load the chat moderation: {}", x.what());
+  }
+
+  if (_config.metrics.enabled)
+  {
+    _metricsServer.BeginHost(
+      _config.metrics.listen.address,
+      _config.metrics.listen.port);
+  }
+
   // Initialize the directors and tick them on their own threads.
   // Directors will terminate their tick loop once `_shouldRun` flag is set to false.
 
@@ -59,7 +101,7 @@ void ServerInstance::Initialize()
   _dataDirectorThread = std::thread([this]()
   {
     _dataDirector.Initialize();
-    RunDirectorTaskLoop(_dataDirector);
+    RunDirectorTaskLoop(_dataDirector, "data");
     _dataDirector.Terminate();
   });
 
@@ -67,7 +109,7 @@ void ServerInstance::Initialize()
   _lobbyDirectorThread = std::thread([this]()
   {
     _lobbyDirector.Initialize();
-    RunDirectorTaskLoop(_lobbyDirector);
+    RunDirectorTaskLoop(_lobbyDirector, "lobby");
     _lobbyDirector.Terminate();
   });
 
@@ -75,7 +117,7 @@ void ServerInstance::Initialize()
   _messengerThread = std::thread([this]()
   {
     _messengerDirector.Initialize();
-    RunDirectorTaskLoop(_messengerDirector);
+    RunDirectorTaskLoop(_messengerDirector, "messenger");
     _messengerDirector.Terminate();
   });
 
@@ -83,7 +125,7 @@ void ServerInstance::Initialize()
   _ranchDirectorThread = std::thread([this]()
   {
     _ranchDirector.Initialize();
-    RunDirectorTaskLoop(_ranchDirector);
+    RunDirectorTaskLoop(_ranchDirector, "ranch");
     _ranchDirector.Terminate();
   });
 
@@ -91,7 +133,7 @@ void ServerInstance::Initialize()
   _raceDirectorThread = std::thread([this]()
   {
     _raceDirector.Initialize();
-    RunDirectorTaskLoop(_raceDirector);
+    RunDirectorTaskLoop(_raceDirector, "race");
     _raceDirector.Terminate();
   });
 }
@@ -99,6 +141,100 @@ void ServerInstance::Initialize()
 void ServerInstance::Terminate()
 {
   _shouldRun.store(false, std::memory_order::relaxed);
+  _metricsServer.EndHost();
+}
+
+void ServerInstance::ReloadShopCatalogue()
+{
+  _goodsRegistry.ReadConfig(_resourceDirectory / "config/game/goods.yaml");
+  _shopSystem.CompileCatalogue(*_goodsRegistry.GetGoods());
+}
+
+void ServerInstance::ReloadChatModeration()
+{
+  _chatSystem.ReadModerationConfig(_resourceDirectory / "config/server/moderation.yaml");
+}
+
+void ServerInstance::CaptureStates(CommandServer& commandServer)
+{
+  _otpSystem.AddGrantListener(
+    [&commandServer](uint32_t key, uint32_t code)
+    {
+      std::array<std::byte, MaxCapturedStateSize> buffer{};
+      SinkStream sink{std::span(buffer)};
+      sink.Write(key)
+        .Write(code);
+
+      commandServer.CaptureState(
+        static_cast<uint16_t>(CapturedState::OtpCode),
+        std::span(buffer).first(sink.GetCursor()));
+    });
+
+  _roomSystem.AddCreateListener(
+    [&commandServer](const Room& room)
+    {
+      std::array<std::byte, MaxCapturedStateSize> buffer{};
+      SinkStream sink{std::span(buffer)};
+      sink.Write(room.uid)
+        .Write(room.name)
+        .Write(room.password)
+        .Write(room.missionId)
+        .Write(room.mapBlockId)
+        .Write(room.otp)
+        .Write(room.playerCount)
+        .Write(room.gameMode)
+        .Write(room.teamMode)
+        .Write(room.unk3)
+        .Write(room.bitset)
+        .Write(room.unk4);
+
+      commandServer.CaptureState(
+        static_cast<uint16_t>(CapturedState::Room),
+        std::span(buffer).first(sink.GetCursor()));
+    });
+}
+
+void ServerInstance::RestoreState(uint16_t stateId, std::span<const std::byte> data)
+{
+  SourceStream source(data);
+
+  switch (static_cast<CapturedState>(stateId))
+  {
+    case CapturedState::OtpCode:
+    {
+      uint32_t key{};
+      uint32_t code{};
+      source.Read(key)
+        .Read(code);
+
+      _otpSystem.RestoreCode(key, code);
+      break;
+    }
+    case CapturedState::Room:
+    {
+      Room room{};
+      source.Read(room.uid)
+        .Read(room.name)
+        .Read(room.password)
+        .Read(room.missionId)
+        .Read(room.mapBlockId)
+        .Read(room.otp)
+        .Read(room.playerCount)
+        .Read(room.gameMode)
+        .Read(room.teamMode)
+        .Read(room.unk3)
+        .Read(room.bitset)
+        .Read(room.unk4);
+
+      _roomSystem.RestoreRoom(room);
+      break;
+    }
+    default:
+    {
+      spdlog::warn("Unknown captured state {}", stateId);
+      break;
+    }
+  }
 }
 
 DataDirector& ServerInstance::GetDataDirector()
@@ -126,6 +262,11 @@ registry::CourseRegistry& ServerInstance::GetCourseRegistry()
   return _courseRegistry;
 }
 
+registry::GoodsRegistry& ServerInstance::GetGoodsRegistry()
+{
+  return _goodsRegistry;
+}
+
 registry::HorseRegistry& ServerInstance::GetHorseRegistry()
 {
   return _horseRegistry;
@@ -141,6 +282,11 @@ registry::PetRegistry& ServerInstance::GetPetRegistry()
   return _petRegistry;
 }
 
+BreedingMarketSystem& ServerInstance::GetBreedingMarketSystem()
+{
+  return _breedingMarketSystem;
+}
+
 ChatSystem& ServerInstance::GetChatSystem()
 {
   return _chatSystem;
@@ -151,6 +297,16 @@ InfractionSystem& ServerInstance::GetInfractionSystem()
   return _infractionSystem;
 }
 
+PresenceSystem& ServerInstance::GetPresenceSystem()
+{
+  return _presenceSystem;
+}
+
+RankingSystem& ServerInstance::GetRankingSystem()
+{
+  return _rankingSystem;
+}
+
 RoomSystem& ServerInstance::GetRoomSystem()
 {
   return _roomSystem;
@@ -161,6 +317,11 @@ OtpSystem& ServerInstance::GetOtpSystem()
   return _otpSystem;
 }
 
+ShopSystem& ServerInstance::GetShopSystem()
+{
+  return _shopSystem;
+}
+
 Config& ServerInstance::GetSettings()
 {
   return _config;
@@ -22,7 +22,6 @@
 #include "../../../include/server/system/RoomSystem.hpp"
 #include "libserver/data/helper/ProtocolHelper.hpp"
 #include "server/ServerInstance.hpp"
-#include "zlib.h"
 
 #include <random>
 
@@ -33,6 +32,11 @@ namespace
 
 std::random_device rd;
 
+//! Chance of picking the ranch of an online character when visiting a random ranch.
+constexpr double OnlineRanchChance = 0.75;
+//! Max count of the offline ranches kept for the random ranch selection.
+constexpr std::size_t MaxOfflineRanchCount = 10'000;
+
 } // namespace
 
 namespace server
@@ -190,34 +194,9 @@ LobbyDirector::LobbyDirector(ServerInstance& serverInstance)
       // If the rancher's uid is invalid randomize it.
       if (rancherUid == data::InvalidUid)
       {
-        std::vector<data::Uid> availableRanches;
-
-        auto& characters = GetServerInstance().GetDataDirector().GetCharacterCache();
-        const auto& characterKeys = characters.GetKeys();
-
-        for (const auto& randomRancherUid : characterKeys)
-        {
-          const auto character = characters.Get(randomRancherUid);
-          character->Immutable([&availableRanches, requestingCharacterUid](const data::Character& character)
-          {
-            // Only consider ranches that are unlocked and that
-            // do not belong to the character that requested the random ranch.
-            if (character.isRanchLocked() || character.uid() == requestingCharacterUid)
-              return;
-
-            availableRanches.emplace_back(character.uid());
-          });
-        }
-
         // There must be at least the ranch the requesting character is the owner of.
-        if (availableRanches.empty())
-        {
-          availableRanches.emplace_back(clientContext.characterUid);
-        }
-
-        // Pick a random character from the available list to join the ranch of.
-        std::uniform_int_distribution<size_t> uidDistribution(0, availableRanches.size() - 1);
-        rancherUid = availableRanches[uidDistribution(rd)];
+        rancherUid = PickRandomRanch(requestingCharacterUid).value_or(
+          requestingCharacterUid);
       }
 
     QueueEnterRanchOK(clientId, rancherUid);
@@ -262,12 +241,19 @@ void LobbyDirector::Initialize()
     GetConfig().listen.address.to_string(),
     GetConfig().listen.port);
 
+  _commandServer.SetSlowCommandThreshold(std::chrono::milliseconds(
+    GetServerInstance().GetSettings().profiling.slowCommandThreshold));
+
+  if (not GetConfig().capturePath.empty())
+    _commandServer.BeginCapture(GetConfig().capturePath);
+
   _commandServer.BeginHost(GetConfig().listen.address, GetConfig().listen.port);
 }
 
 void LobbyDirector::Terminate()
 {
   _commandServer.EndHost();
+  _commandServer.EndCapture();
 }
 
 void LobbyDirector::Tick()
@@ -284,7 +270,22 @@ void LobbyDirector::HandleClientConnected(ClientId clientId)
 void LobbyDirector::HandleClientDisconnected(ClientId clientId)
 {
   spdlog::info("Client {} disconnected from the lobby", clientId);
-  _clients.erase(clientId);
+
+  const auto clientContextIter = _clients.find(clientId);
+  if (clientContextIter == _clients.cend())
+    return;
+
+  const auto& clientContext = clientContextIter->second;
+  if (clientContext.isAuthenticated)
+  {
+    GetServerInstance().GetPresenceSystem().Disconnect(
+      clientContext.characterUid,
+      PresenceSystem::Director::Lobby);
+
+    UnindexOnlineRanch(clientContext.characterUid);
+  }
+
+  _clients.erase(clientContextIter);
 }
 
 ServerInstance& LobbyDirector::GetServerInstance()
@@ -297,6 +298,11 @@ Config::Lobby& LobbyDirector::GetConfig()
   return GetServerInstance().GetSettings().lobby;
 }
 
+CommandServer& LobbyDirector::GetCommandServer()
+{
+  return _commandServer;
+}
+
 void LobbyDirector::RequestCharacterCreator(data::Uid characterUid)
 {
   _forcedCharacterCreator.emplace(characterUid);
@@ -364,32 +370,14 @@ void LobbyDirector::Notice(data::Uid characterUid, const std::string& message)
   }
 }
 
-std::vector<std::string> LobbyDirector::GetOnlineUsers()
+void LobbyDirector::BroadcastNotice(
+  std::span<const ClientId> clientIds,
+  const std::string& message)
 {
-  std::vector<std::string> userName;
-
-  for (const auto& [clientId, clientContext] : _clients)
-  {
-    if (not clientContext.isAuthenticated)
-      continue;
-    userName.emplace_back(clientContext.userName);
-  }
-
-  return userName;
-}
-
-std::vector<data::Uid> LobbyDirector::GetOnlineCharacters()
-{
-  std::vector<data::Uid> characters;
-
-  for (const auto& [clientId, clientContext] : _clients)
-  {
-    if (not clientContext.isAuthenticated)
-      continue;
-    characters.emplace_back(clientContext.characterUid);
-  }
+  const protocol::AcCmdLCNotice notice{
+    .notice = message};
 
-  return characters;
+  _commandServer.QueueCommand(clientIds, notice);
 }
 
 void LobbyDirector::UpdateVisitPreference(data::Uid characterUid, data::Uid visitingCharacterUid)
@@ -429,27 +417,31 @@ void LobbyDirector::HandleRoomList(
   ClientId clientId,
   const protocol::LobbyCommandRoomList& command)
 {
+  // The pages of the room list are numbered from one.
+  const std::size_t page = command.page > 0 ? command.page - 1 : 0;
+
   protocol::LobbyCommandRoomListOK response;
-  response.page = command.page;
+  // Report the page that is actually served.
+  response.page = static_cast<uint8_t>(page + 1);
   response.unk1 = command.gameMode;
   response.unk2 = static_cast<uint8_t>(command.teamMode);
 
-  for (const auto& room : _serverInstance.GetRoomSystem().GetRooms() | std::views::values)
-  {
-    if ( room.gameMode != command.gameMode
-      || room.teamMode != command.teamMode)
-      continue;
+  const auto rooms = _serverInstance.GetRoomSystem().GetRoomPage(
+    command.gameMode,
+    command.teamMode,
+    page);
 
-    // TODO: get Live player count from RaceDirector
-    // TODO: gamestate showing
+  for (const auto& room : rooms)
+  {
     auto& roomResponse = response.rooms.emplace_back();
     roomResponse.id = room.uid;
     if (room.password.empty())
       roomResponse.isLocked = false;
     else
       roomResponse.isLocked = true;
-    roomResponse.playerCount = 1; // Placeholder, replace with actual live count
+    roomResponse.playerCount = room.occupantCount;
     roomResponse.maxPlayers = room.playerCount;
+    roomResponse.hasStarted = room.isRacing;
     roomResponse.level = 2;
     roomResponse.name = room.name;
     roomResponse.map = room.mapBlockId;
@@ -467,18 +459,20 @@ void LobbyDirector::HandleMakeRoom(
   ClientId clientId,
   const protocol::LobbyCommandMakeRoom& command)
 {
-  auto& room = _serverInstance.GetRoomSystem().CreateRoom();
-
-  room.name = command.name;
-  room.password = command.password;
-  room.missionId = command.missionId;
-  room.playerCount = command.playerCount;
-  room.gameMode = command.gameMode;
-  room.teamMode = command.teamMode;
-  room.unk3 = command.unk3;
-  room.bitset = static_cast<uint16_t>(command.bitset);
-  room.unk4 = command.unk4;
-  room.mapBlockId = 10002;
+  const auto room = _serverInstance.GetRoomSystem().CreateRoom(
+    [&command](Room& room)
+    {
+      room.name = command.name;
+      room.password = command.password;
+      room.missionId = command.missionId;
+      room.playerCount = command.playerCount;
+      room.gameMode = command.gameMode;
+      room.teamMode = command.teamMode;
+      room.unk3 = command.unk3;
+      room.bitset = static_cast<uint16_t>(command.bitset);
+      room.unk4 = command.unk4;
+      room.mapBlockId = 10002;
+    });
 
   protocol::LobbyCommandMakeRoomOK response{
     .roomUid = room.uid,
@@ -594,7 +588,16 @@ void LobbyDirector::HandleRequestLeagueInfo(
   ClientId clientId,
   const protocol::LobbyCommandRequestLeagueInfo& command)
 {
-  protocol::LobbyCommandRequestLeagueInfoOK response{};
+  const auto& clientContext = GetClientContext(clientId);
+  auto& rankingSystem = GetServerInstance().GetRankingSystem();
+
+  const auto league = rankingSystem.GetLeague(clientContext.characterUid);
+  const auto leagueRank = rankingSystem.GetLeagueRank(clientContext.characterUid);
+
+  protocol::LobbyCommandRequestLeagueInfoOK response{
+    .league = static_cast<uint8_t>(league.type),
+    .rankingPercentile = league.rankingPercentile,
+    .place = leagueRank.value_or(0)};
 
   _commandServer.QueueCommand<decltype(response)>(
     clientId,
@@ -790,54 +793,22 @@ void LobbyDirector::HandleGoodsShopList(
       return response;
     });
 
-  const std::string xml =
-    "<ShopList>\n"
-    "  <GoodsList>\n"
-    "    <GoodsSQ>0</GoodsSQ>\n"
-    "    <SetType>0</SetType>\n"
-    "    <MoneyType>0</MoneyType>\n"
-    "    <GoodsType>0</GoodsType>\n"
-    "    <RecommendType>1</RecommendType>\n"
-    "    <RecommendNO>1</RecommendNO>\n"
-    "    <GiftType>0</GiftType>\n"
-    "    <SalesRank>1</SalesRank>\n"
-    "    <BonusGameMoney>0</BonusGameMoney>\n"
-    "    <GoodsNM><![CDATA[Goods name]]></GoodsNM>\n"
-    "    <GoodsDesc><![CDATA[Goods desc]]></GoodsDesc>\n"
-    "    <ItemCapacityDesc><![CDATA[Capacity desc]]></ItemCapacityDesc>\n"
-    "    <SellST>0</SellST>\n"
-    "    <ItemUID>30013</ItemUID>\n"
-    "    <ItemElem>\n"
-    "      <Item>\n"
-    "        <PriceID>1</PriceID>\n"
-    "        <PriceRange>1</PriceRange>\n"
-    "        <GoodsPrice>1</GoodsPrice>\n"
-    "      </Item>\n"
-    "    </ItemElem>\n"
-    "  </GoodsList>\n"
-    "</ShopList>\n";
-
-  std::vector<std::byte> compressedXml;
-  compressedXml.resize(xml.size());
-
-  uLongf compressedSize = compressedXml.size();
-  compress(
-    reinterpret_cast<Bytef*>(compressedXml.data()),
-    &compressedSize,
-    reinterpret_cast<const Bytef*>(xml.c_str()),
-    xml.length());
-
-  compressedXml.resize(compressedSize);
-
-  protocol::AcCmdLCGoodsShopListData data{
-    .member3 = 1,
-    .data = compressedXml};
-
-  _commandServer.QueueCommand<decltype(data)>(
+  const auto catalogue = _serverInstance.GetShopSystem().GetCatalogue();
+  if (not catalogue)
+    return;
+
+  // The client already has the current catalogue, the signature is derived from its content.
+  if (std::ranges::equal(command.data, catalogue->signature))
+    return;
+
+  _commandServer.QueueCommand<protocol::AcCmdLCGoodsShopListData>(
     clientId,
-    [data]()
+    [catalogue]()
     {
-      return data;
+      return protocol::AcCmdLCGoodsShopListData{
+        .member1 = catalogue->signature,
+        .member3 = 1,
+        .data = catalogue->data};
     });
 }
 
@@ -922,11 +893,15 @@ void LobbyDirector::HandleChangeRanchOption(
     .unk0 = command.unk0,
     .unk1 = command.unk1,
     .unk2 = command.unk2};
-  characterRecord.Mutable([](data::Character& character)
+  bool isRanchLocked = false;
+  characterRecord.Mutable([&isRanchLocked](data::Character& character)
     {
       character.isRanchLocked() = !character.isRanchLocked();
+      isRanchLocked = character.isRanchLocked();
     });
 
+  IndexRanch(clientContext.characterUid, isRanchLocked, true);
+
   _commandServer.QueueCommand<decltype(response)>(
     clientId,
     [response]()
@@ -935,6 +910,64 @@ void LobbyDirector::HandleChangeRanchOption(
     });
 }
 
+void LobbyDirector::IndexRanch(data::Uid characterUid, bool isLocked, bool isOnline)
+{
+  std::scoped_lock lock(_ranchesMutex);
+
+  _onlineRanches.Remove(characterUid);
+  _offlineRanches.Remove(characterUid);
+
+  if (isLocked)
+    return;
+
+  if (isOnline)
+    _onlineRanches.Insert(characterUid);
+  else
+    InsertOfflineRanch(characterUid);
+}
+
+void LobbyDirector::UnindexOnlineRanch(data::Uid characterUid)
+{
+  std::scoped_lock lock(_ranchesMutex);
+
+  // Keep the unlocked ranch of the character visitable while it is offline.
+  if (_onlineRanches.Remove(characterUid))
+    InsertOfflineRanch(characterUid);
+}
+
+std::optional<data::Uid> LobbyDirector::PickRandomRanch(data::Uid characterUid)
+{
+  std::scoped_lock lock(_ranchesMutex);
+
+  // Prefer the ranches of the online characters as those are likely to be visited by others.
+  std::bernoulli_distribution onlineDistribution(OnlineRanchChance);
+  if (onlineDistribution(rd))
+  {
+    const auto rancherUid = _onlineRanches.Pick(rd, characterUid);
+    if (rancherUid)
+      return rancherUid;
+  }
+
+  const auto rancherUid = _offlineRanches.Pick(rd, characterUid);
+  if (rancherUid)
+    return rancherUid;
+
+  return _onlineRanches.Pick(rd, characterUid);
+}
+
+void LobbyDirector::InsertOfflineRanch(data::Uid characterUid)
+{
+  if (_offlineRanches.GetSize() >= MaxOfflineRanchCount)
+  {
+    // Any offline ranch is as good as the other for a random visit.
+    const auto evictedUid = _offlineRanches.Pick(rd);
+    if (evictedUid)
+      _offlineRanches.Remove(*evictedUid);
+  }
+
+  _offlineRanches.Insert(characterUid);
+}
+
 LobbyDirector::ClientContext& LobbyDirector::GetClientContext(
   const ClientId clientId,
   const bool requireAuthentication)
@@ -45,9 +45,13 @@ void LoginHandler::Tick()
     const ClientId clientId = _clientLoginRequestQueue.front();
     auto& loginContext = _clientLogins[clientId];
 
+    // Continue the trace of the login request.
+    const trace::Scope traceScope(loginContext.traceId);
+
     // Request the load of the user data if not requested yet.
     if (not loginContext.userLoadRequested)
     {
+      const trace::Span traceSpan("LoginHandler::RequestUserLoad");
       _lobbyDirector.GetServerInstance().GetDataDirector().RequestLoadUserData(
         loginContext.userName);
 
@@ -64,6 +68,8 @@ void LoginHandler::Tick()
 
     _clientLoginRequestQueue.pop();
 
+    const trace::Span traceSpan("LoginHandler::Authenticate");
+
     if (not _lobbyDirector.GetServerInstance().GetDataDirector().AreUserDataLoaded(
       loginContext.userName))
     {
@@ -120,6 +126,9 @@ void LoginHandler::Tick()
     auto& clientContext = _lobbyDirector.GetClientContext(clientId, false);
     auto& loginContext = _clientLogins[clientId];
 
+    // Continue the trace of the login request.
+    const trace::Scope traceScope(loginContext.traceId);
+
     // If the user character load was already requested wait for the load to complete.
     if (loginContext.userCharacterLoadRequested)
     {
@@ -149,6 +158,7 @@ void LoginHandler::Tick()
       // If the user character is not loaded do not proceed.
       if (not loginContext.userCharacterLoadRequested)
       {
+        const trace::Span traceSpan("LoginHandler::RequestCharacterLoad");
         _lobbyDirector.GetServerInstance().GetDataDirector().RequestLoadCharacterData(
           loginContext.userName,
           characterUid);
@@ -160,6 +170,8 @@ void LoginHandler::Tick()
 
     _clientLoginResponseQueue.pop();
 
+    const trace::Span traceSpan("LoginHandler::Accept");
+
     const bool forcedCharacterCreator = _lobbyDirector._forcedCharacterCreator.erase(
       characterUid) > 0;
 
@@ -190,6 +202,24 @@ void LoginHandler::Tick()
     clientContext.characterUid = characterUid;
     clientContext.isAuthenticated = true;
 
+    const auto characterRecord = _lobbyDirector.GetServerInstance().GetDataDirector().GetCharacter(
+      characterUid);
+    characterRecord.Immutable([this, clientId, characterUid, &loginContext](const data::Character& character)
+    {
+      _lobbyDirector.IndexRanch(characterUid, character.isRanchLocked(), true);
+
+      _lobbyDirector.GetServerInstance().GetPresenceSystem().Connect(
+        characterUid,
+        PresenceSystem::Director::Lobby,
+        clientId,
+        [&loginContext, &character](PresenceSystem::Presence& presence)
+        {
+          presence.userName = loginContext.userName;
+          presence.characterName = character.name();
+          presence.guildUid = character.guildUid();
+        });
+    });
+
     // Only one response per tick.
     break;
   }
@@ -230,7 +260,8 @@ void LoginHandler::HandleUserLogin(
       clientId,
       LoginContext{
         .userName = login.loginId,
-        .userToken = login.authKey});
+        .userToken = login.authKey,
+        .traceId = trace::GetCurrentTraceId()});
   assert(inserted && "Duplicate client login request.");
 
   std::scoped_lock lock(_clientLoginRequestQueueMutex);
@@ -20,6 +20,8 @@
 #include "Version.hpp"
 #include "server/ServerInstance.hpp"
 
+#include <libserver/util/Trace.hpp>
+
 #include <spdlog/sinks/daily_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
@@ -29,6 +31,7 @@
 #include <mutex>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 #ifdef WIN32
   #include <windows.h>
@@ -45,6 +48,13 @@ using Clock = std::chrono::steady_clock;
 std::atomic_bool shouldProgramRun = true;
 std::condition_variable shouldProgramRunCv;
 
+//! Whether a dump of the trace was requested by a signal.
+std::atomic_bool shouldDumpTrace = false;
+//! A directory the traces are dumped to by default.
+std::filesystem::path traceDirectory;
+//! Interval in which the trace dump loop polls the flags.
+constexpr auto TraceDumpPollInterval = std::chrono::milliseconds(250);
+
 std::shared_ptr<spdlog::logger> g_logger;
 
 Clock::time_point serverStartupTime;
@@ -78,10 +88,51 @@ void handler(int sig, siginfo_t* info, void* ucontext)
     shouldProgramRun.store(false, std::memory_order::relaxed);
     shouldProgramRunCv.notify_all();
   }
+  else if (sig == SIGUSR1)
+  {
+    // Only the lock-free flag is safe to set from the signal handler,
+    // the trace dump loop polls it.
+    shouldDumpTrace.store(true, std::memory_order::relaxed);
+  }
 }
 
 #endif
 
+//! Dumps the recorded trace spans to a Chrome trace-event file.
+//! @param path Path of the file. If empty, a timestamped file in the trace directory is used.
+void DumpTrace(std::filesystem::path path)
+{
+  if (path.empty())
+  {
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+    path = traceDirectory / std::format("trace-{}.json", timestamp.count());
+  }
+
+  try
+  {
+    const auto spanCount = server::trace::DumpChromeTrace(path);
+    spdlog::info("Dumped {} trace spans to '{}'", spanCount, path.string());
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::error("Failed to dump the trace: {}", x.what());
+  }
+}
+
+//! Dumps the trace whenever it is requested by a signal, until the program stops running.
+void TraceDumpLoop()
+{
+  while (shouldProgramRun)
+  {
+    // The flags are polled, the condition variable is left to the main thread.
+    std::this_thread::sleep_for(TraceDumpPollInterval);
+
+    if (shouldDumpTrace.exchange(false, std::memory_order::relaxed))
+      DumpTrace({});
+  }
+}
+
 void InteractiveLoop()
 {
   while (shouldProgramRun)
@@ -89,6 +140,10 @@ void InteractiveLoop()
     std::string commandLine;
     std::getline(std::cin, commandLine);
 
+    // The read is interrupted when the thread handles a signal.
+    if (std::cin.fail() && not std::cin.eof())
+      std::cin.clear();
+
     const auto command = server::util::TokenizeString(
       commandLine, ' ');
 
@@ -96,6 +151,10 @@ void InteractiveLoop()
     {
       shouldProgramRun.exchange(false, std::memory_order::relaxed);
     }
+    else if (command[0] == "trace")
+    {
+      DumpTrace(command.size() > 1 ? std::filesystem::path(command[1]) : std::filesystem::path{});
+    }
   }
 }
 
@@ -137,6 +196,13 @@ int main(int argc, char** argv)
     spdlog::error("Failed to change the signal action handler for SIGTERM");
     return 1;
   }
+
+  // Dumps the trace on request.
+  if (sigaction(SIGUSR1, &act, nullptr) == -1)
+  {
+    spdlog::error("Failed to change the signal action handler for SIGUSR1");
+    return 1;
+  }
 #endif
 
   serverStartupTime = std::chrono::steady_clock::now();
@@ -166,9 +232,13 @@ int main(int argc, char** argv)
   else
     spdlog::info("Base directory is the working directory");
 
+  traceDirectory = baseDirectory / "logs";
+
   server::ServerInstance serverInstance(baseDirectory);
   serverInstance.Initialize();
 
+  std::thread traceDumpThread(TraceDumpLoop);
+
   spdlog::info(
     "Server started up in {}ms",
     std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -202,6 +272,7 @@ int main(int argc, char** argv)
     InteractiveLoop();
   }
 
+  traceDumpThread.join();
   serverInstance.Terminate();
 
   return 0;
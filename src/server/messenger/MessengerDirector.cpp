@@ -71,25 +71,31 @@ void MessengerDirector::HandleChatterLogin(
   protocol::ChatCmdLoginAckOK response{
     .groups = {{.uid = OnlinePlayersCategoryUid, .name = "Online Players"}}};
 
-  for (data::Uid onlineCharacterUid : _serverInstance.GetLobbyDirector().GetOnlineCharacters())
+  const auto onlinePresences = _serverInstance.GetPresenceSystem().GetPresences(
+    PresenceSystem::Director::Lobby);
+
+  for (const auto& onlinePresence : onlinePresences)
   {
     const auto onlineCharacterRecord = _serverInstance.GetDataDirector().GetCharacter(
-      onlineCharacterUid);
+      onlinePresence.characterUid);
+    if (not onlineCharacterRecord)
+      continue;
 
     auto& friendo = response.friends.emplace_back();
+    friendo.name = onlinePresence.characterName;
+    friendo.uid = onlinePresence.characterUid;
+    friendo.categoryUid = OnlinePlayersCategoryUid;
+
     onlineCharacterRecord.Immutable([&friendo](const data::Character& onlineCharacter)
     {
-      friendo.name = onlineCharacter.name();
       friendo.status = onlineCharacter.isRanchLocked()
         ? protocol::ChatCmdLoginAckOK::Friend::Status::Offline
         : protocol::ChatCmdLoginAckOK::Friend::Status::Online;
-      friendo.uid = onlineCharacter.uid();
-      friendo.categoryUid = OnlinePlayersCategoryUid;
-
-      // todo: get the ranch/room information
-      //friendo.ranchUid = onlineCharacter.uid();
-      friendo.roomUid = 1;
     });
+
+    // todo: get the ranch/room information
+    //friendo.ranchUid = onlinePresence.ranchUid;
+    friendo.roomUid = 1;
   }
 
   _chatterServer.QueueCommand<decltype(response)>(clientId, [response](){ return response; });
@@ -22,23 +22,101 @@
 #include "libserver/data/helper/ProtocolHelper.hpp"
 #include "server/ServerInstance.hpp"
 
+#include "server/system/RankingSystem.hpp"
 #include "server/system/RoomSystem.hpp"
 
 #include <spdlog/spdlog.h>
 #include <bitset>
+#include <cmath>
 #include <limits>
+#include <ranges>
 
 namespace server
 {
 
+namespace
+{
+
+//! Quantization step of the position.
+constexpr float PositionQuantum = 1.0f / 16.0f;
+//! Quantization step of the rotation.
+constexpr float RotationQuantum = 1.0f / 256.0f;
+//! Quantization step of the speed.
+constexpr float SpeedQuantum = 1.0f / 16.0f;
+//! Quantization step of the race track progress.
+constexpr float ProgressQuantum = 1.0f / 4096.0f;
+
+//! Quantizes the value to the specified step.
+//! @param value Value.
+//! @param quantum Quantization step.
+//! @returns Quantized value.
+int64_t Quantize(float value, float quantum)
+{
+  return std::llround(value / quantum);
+}
+
+//! Returns whether the kinematic state changed noticeably.
+//! @param lhs Kinematic state.
+//! @param rhs Kinematic state.
+//! @returns `true` if the quantized states differ, `false` otherwise.
+bool HasKinematicsChanged(
+  const tracker::RaceTracker::Kinematics& lhs,
+  const tracker::RaceTracker::Kinematics& rhs)
+{
+  for (std::size_t idx = 0; idx < lhs.position.size(); ++idx)
+  {
+    if (Quantize(lhs.position[idx], PositionQuantum) != Quantize(rhs.position[idx], PositionQuantum))
+      return true;
+    if (Quantize(lhs.rotation[idx], RotationQuantum) != Quantize(rhs.rotation[idx], RotationQuantum))
+      return true;
+  }
+
+  return Quantize(lhs.speed, SpeedQuantum) != Quantize(rhs.speed, SpeedQuantum)
+    || Quantize(lhs.progress, ProgressQuantum) != Quantize(rhs.progress, ProgressQuantum)
+    || lhs.airborne != rhs.airborne;
+}
+
+//! Interval in which the load of the room shards is balanced.
+constexpr auto ShardBalanceInterval = std::chrono::seconds(10);
+//! Interval in which the leaderboards are loaded and flushed.
+constexpr auto RankingTickInterval = std::chrono::seconds(1);
+
+} // anon namespace
+
 RaceDirector::RaceDirector(ServerInstance& serverInstance)
   : _serverInstance(serverInstance)
   , _commandServer(*this)
 {
+  _commandServer.SetCommandRouter(
+    [this](ClientId clientId, protocol::Command commandId, std::function<void()> handler)
+    {
+      RouteCommand(clientId, commandId, std::move(handler));
+    });
+
   _commandServer.RegisterCommandHandler<protocol::AcCmdCREnterRoom>(
     [this](ClientId clientId, const auto& message)
     {
-      HandleEnterRoom(clientId, message);
+      // The client is routed to the room before its following commands are routed.
+      if (not RouteToRoom(clientId, message.characterUid, message.roomUid))
+      {
+        spdlog::warn("Client {} tried to enter the room {} while in another room", clientId, message.roomUid);
+
+        _commandServer.QueueCommand<protocol::AcCmdCREnterRoomCancel>(
+          clientId,
+          []()
+          {
+            return protocol::AcCmdCREnterRoomCancel{};
+          });
+        return;
+      }
+
+      // Entering a room is handled on the shard of the entered room.
+      _roomShards.Queue(
+        message.roomUid,
+        [this, clientId, message]()
+        {
+          HandleEnterRoom(clientId, message);
+        });
     });
 
   _commandServer.RegisterCommandHandler<protocol::AcCmdCRChangeRoomOptions>(
@@ -237,102 +315,153 @@ void RaceDirector::Initialize()
     GetConfig().listen.address.to_string(),
     GetConfig().listen.port);
 
-  test = std::thread([this]()
+  if (GetConfig().relay.enabled)
   {
-    std::unordered_set<asio::ip::udp::endpoint> _clients;
-
-    asio::io_context ioCtx;
-    asio::ip::udp::socket skt(
-      ioCtx,
-      asio::ip::udp::endpoint(
-        asio::ip::address_v4::loopback(),
-        10500));
-
-    asio::streambuf readBuffer;
-    asio::streambuf writeBuffer;
-
-    while (run_test)
-    {
-      const auto request = readBuffer.prepare(1024);
-      asio::ip::udp::endpoint sender;
-
-      try
-      {
-        const size_t bytesRead = skt.receive_from(request, sender);
-
-        struct RelayHeader
-        {
-          uint16_t member0{};
-          uint16_t member1{};
-          uint16_t member2{};
-        };
-
-        const auto response = writeBuffer.prepare(1024);
-
-        RelayHeader* header = static_cast<RelayHeader*>(response.data());
-        header->member2 = 1;
-
-        for (const auto idx : std::views::iota(0ull, bytesRead))
-        {
-          static_cast<std::byte*>(response.data())[idx + sizeof(RelayHeader)] = static_cast<const std::byte*>(
-            request.data())[idx];
-        }
-
-        writeBuffer.commit(bytesRead + sizeof(RelayHeader));
-        readBuffer.consume(bytesRead + sizeof(RelayHeader));
-
-        for (auto& client : _clients)
-        {
-          if (client == sender)
-            continue;
-
-          writeBuffer.consume(
-            skt.send_to(writeBuffer.data(), client));
-        }
+    spdlog::debug(
+      "Race relay listening on {}:{}",
+      GetConfig().relay.listen.address.to_string(),
+      GetConfig().relay.listen.port);
+
+    _relayServer.BeginHost(
+      GetConfig().relay.listen.address,
+      GetConfig().relay.listen.port,
+      std::chrono::seconds(GetConfig().relay.idleTimeout));
+  }
 
-        if (not _clients.contains(sender))
-          _clients.insert(sender);
+  _roomShards.Start(GetConfig().shardCount);
+  spdlog::debug(
+    "Race rooms simulated on {} shards",
+    _roomShards.GetShardCount());
 
-      } catch (const std::exception& x) {
-      }
+  _commandServer.SetSlowCommandThreshold(std::chrono::milliseconds(
+    GetServerInstance().GetSettings().profiling.slowCommandThreshold));
 
-    }
-  });
-  test.detach();
+  if (not GetConfig().capturePath.empty())
+  {
+    _commandServer.BeginCapture(GetConfig().capturePath);
+    // The sessions depend on the codes granted and the rooms created by the lobby.
+    GetServerInstance().CaptureStates(_commandServer);
+  }
 
   _commandServer.BeginHost(GetConfig().listen.address, GetConfig().listen.port);
 }
 
 void RaceDirector::Terminate()
 {
-  run_test = false;
+  _relayServer.EndHost();
   _commandServer.EndHost();
+  _commandServer.EndCapture();
+  _roomShards.Stop();
 }
 
 void RaceDirector::Tick() {
   _scheduler.Tick();
+
+  const auto now = Scheduler::Clock::now();
+
+  // The leaderboards are kept in the data storages,
+  // load and flush them on the data director thread.
+  if (now >= _nextRankingTickTime)
+  {
+    _nextRankingTickTime = now + RankingTickInterval;
+    _serverInstance.GetDataDirector().QueueTask([this]()
+    {
+      _serverInstance.GetRankingSystem().Tick();
+    });
+  }
+
+  // Periodically migrate the rooms from the busy shards to the idle ones.
+  if (now >= _nextShardBalanceTime)
+  {
+    _roomShards.Balance();
+    _nextShardBalanceTime = now + ShardBalanceInterval;
+  }
+
+  // Publish the racer states of the rooms at the configured rate,
+  // every room publishes its snapshot on its own shard.
+  const auto snapshotRate = GetConfig().snapshotRate;
+  if (snapshotRate != 0 && now >= _nextSnapshotTime)
+  {
+    _nextSnapshotTime = now + std::chrono::duration_cast<Scheduler::Clock::duration>(
+      std::chrono::duration<double>(1.0 / snapshotRate));
+
+    std::vector<uint32_t> roomUids;
+    {
+      std::shared_lock lock(_roomInstancesMutex);
+      roomUids.reserve(_roomInstances.size());
+      for (const auto roomUid : _roomInstances | std::views::keys)
+        roomUids.emplace_back(roomUid);
+    }
+
+    for (const auto roomUid : roomUids)
+    {
+      _roomShards.Queue(
+        roomUid,
+        [this, roomUid]()
+        {
+          PublishRacerSnapshot(roomUid);
+        });
+    }
+  }
 }
 
 void RaceDirector::HandleClientConnected(ClientId clientId)
 {
-  _clients.try_emplace(clientId);
+  {
+    std::scoped_lock lock(_clientsMutex);
+    _clients.try_emplace(clientId);
+  }
 
   spdlog::info("Client {} connected to the race", clientId);
 }
 
 void RaceDirector::HandleClientDisconnected(ClientId clientId)
 {
-  const auto& clientContext = _clients[clientId];
+  spdlog::info("Client {} disconnected from the race", clientId);
 
-  const auto roomIter = _roomInstances.find(
-    clientContext.roomUid);
-  if (roomIter != _roomInstances.cend())
+  const auto eraseClientContext = [this, clientId]()
   {
-    HandleLeaveRoom(clientId);
+    std::scoped_lock lock(_clientsMutex);
+    _clients.erase(clientId);
+  };
+
+  const auto clientContext = GetClientContext(clientId);
+  if (clientContext.characterUid != data::InvalidUid)
+  {
+    GetServerInstance().GetPresenceSystem().Disconnect(
+      clientContext.characterUid,
+      PresenceSystem::Director::Race);
   }
 
-  spdlog::info("Client {} disconnected from the race", clientId);
-  _clients.erase(clientId);
+  const auto roomUid = clientContext.roomUid;
+  if (roomUid == data::InvalidUid)
+  {
+    eraseClientContext();
+    return;
+  }
+
+  // Leave the room on its shard, after the commands of the client queued before the disconnect.
+  _roomShards.Queue(
+    roomUid,
+    [this, clientId, roomUid, eraseClientContext]()
+    {
+      // The client might have left the room or failed to enter it in the meantime.
+      if (GetClientContext(clientId).roomUid == roomUid)
+        HandleLeaveRoom(clientId);
+
+      eraseClientContext();
+    });
+}
+
+void RaceDirector::BroadcastNotice(
+  std::span<const ClientId> clientIds,
+  const std::string& message)
+{
+  const protocol::AcCmdCRChatNotify notify{
+    .message = message,
+    .isSystem = true};
+
+  _commandServer.QueueCommand(clientIds, notify);
 }
 
 ServerInstance& RaceDirector::GetServerInstance()
@@ -345,40 +474,221 @@ Config::Race& RaceDirector::GetConfig()
   return GetServerInstance().GetSettings().race;
 }
 
+CommandServer& RaceDirector::GetCommandServer()
+{
+  return _commandServer;
+}
+
+RaceDirector::ClientContext RaceDirector::GetClientContext(ClientId clientId)
+{
+  std::shared_lock lock(_clientsMutex);
+
+  const auto clientIter = _clients.find(clientId);
+  if (clientIter == _clients.end())
+    throw std::runtime_error("Client context does not exist");
+
+  return clientIter->second;
+}
+
+std::shared_ptr<RaceDirector::RoomInstance> RaceDirector::GetRoomInstance(uint32_t roomUid)
+{
+  std::shared_lock lock(_roomInstancesMutex);
+
+  const auto roomInstanceIter = _roomInstances.find(roomUid);
+  if (roomInstanceIter == _roomInstances.end())
+    throw std::runtime_error("Room instance does not exist");
+
+  return roomInstanceIter->second;
+}
+
+const RaceDirector::Participant& RaceDirector::GetParticipant(
+  const RoomInstance& roomInstance,
+  data::Uid characterUid)
+{
+  static const Participant EmptyParticipant{};
+
+  const auto participantIter = roomInstance.participants.find(characterUid);
+  if (participantIter == roomInstance.participants.cend())
+    return EmptyParticipant;
+
+  return participantIter->second;
+}
+
+RaceDirector::Participant& RaceDirector::RefreshParticipant(
+  RoomInstance& roomInstance,
+  data::Uid characterUid)
+{
+  auto& participant = roomInstance.participants[characterUid];
+
+  data::Uid mountUid{data::InvalidUid};
+  _serverInstance.GetDataDirector().GetCharacter(characterUid).Immutable(
+    [&participant, &mountUid](const data::Character& character)
+    {
+      participant.name = character.name();
+      participant.level = character.level();
+      mountUid = character.mountUid();
+    });
+
+  _serverInstance.GetDataDirector().GetHorse(mountUid).Immutable(
+    [&participant](const data::Horse& horse)
+    {
+      participant.mountName = horse.name();
+    });
+
+  return participant;
+}
+
+bool RaceDirector::RouteToRoom(
+  ClientId clientId,
+  data::Uid characterUid,
+  data::Uid roomUid)
+{
+  std::scoped_lock lock(_clientsMutex);
+  const auto clientIter = _clients.find(clientId);
+  if (clientIter == _clients.end())
+    return false;
+
+  auto& clientContext = clientIter->second;
+  if (clientContext.roomUid != data::InvalidUid)
+    return false;
+
+  clientContext.characterUid = characterUid;
+  clientContext.roomUid = roomUid;
+  return true;
+}
+
+void RaceDirector::ResetRoute(ClientId clientId)
+{
+  std::scoped_lock lock(_clientsMutex);
+  const auto clientIter = _clients.find(clientId);
+  if (clientIter != _clients.end())
+    clientIter->second.roomUid = data::InvalidUid;
+}
+
+void RaceDirector::RouteCommand(
+  ClientId clientId,
+  protocol::Command commandId,
+  std::function<void()> handler)
+{
+  // Entering a room is handled on the network thread, where it routes the client to the room.
+  // Routing it by the room the client is in would let the commands received after it
+  // be routed before the client has entered the room.
+  if (commandId == protocol::Command::AcCmdCREnterRoom)
+  {
+    handler();
+    return;
+  }
+
+  uint32_t roomUid = data::InvalidUid;
+  {
+    std::shared_lock lock(_clientsMutex);
+    const auto clientIter = _clients.find(clientId);
+    if (clientIter != _clients.cend())
+      roomUid = clientIter->second.roomUid;
+  }
+
+  // Commands of the clients outside of a room are handled on the network thread.
+  if (roomUid == data::InvalidUid)
+  {
+    handler();
+    return;
+  }
+
+  _roomShards.Queue(
+    roomUid,
+    [this, clientId, roomUid, handler = std::move(handler)]()
+    {
+      // The client left the room since the command was routed.
+      // The room of a client in this room is changed only by this shard,
+      // so it stays the same while the handler is executed.
+      if (GetClientContext(clientId).roomUid != roomUid)
+        return;
+
+      handler();
+    });
+}
+
+void RaceDirector::QueueRoomTask(
+  uint32_t roomUid,
+  Scheduler::Task task,
+  Scheduler::Clock::time_point when)
+{
+  _scheduler.Queue(
+    [this, roomUid, task = std::move(task)]()
+    {
+      _roomShards.Queue(roomUid, task);
+    },
+    when);
+}
+
 void RaceDirector::HandleEnterRoom(
   ClientId clientId,
   const protocol::AcCmdCREnterRoom& command)
 {
-  auto& clientContext = _clients[clientId];
-  clientContext.characterUid = command.characterUid;
-  clientContext.roomUid = command.roomUid;
+  const auto clientContext = GetClientContext(clientId);
 
-  const auto& room = _serverInstance.GetRoomSystem().GetRoom(
-    command.roomUid);
+  Room room;
+  try
+  {
+    room = _serverInstance.GetRoomSystem().GetRoom(
+      command.roomUid);
+  }
+  catch (const std::exception&)
+  {
+    // The room was deleted since the client was routed to it.
+    spdlog::warn("Client {} tried to enter the room {} which does not exist", clientId, command.roomUid);
+
+    ResetRoute(clientId);
+    _commandServer.QueueCommand<protocol::AcCmdCREnterRoomCancel>(
+      clientId,
+      []()
+      {
+        return protocol::AcCmdCREnterRoomCancel{};
+      });
+    return;
+  }
+
+  // The character is present in the room only once the room is known to exist.
+  GetServerInstance().GetPresenceSystem().Connect(
+    command.characterUid,
+    PresenceSystem::Director::Race,
+    clientId,
+    [roomUid = command.roomUid](PresenceSystem::Presence& presence)
+    {
+      presence.roomUid = roomUid;
+    });
 
   // todo: verify otp
 
-  const auto& [roomInstanceIter, inserted] = _roomInstances.try_emplace(
-    command.roomUid);
-  auto& roomInstance = roomInstanceIter->second;
+  std::shared_ptr<RoomInstance> roomInstance;
+  bool inserted = false;
+  {
+    std::scoped_lock lock(_roomInstancesMutex);
+    auto [roomInstanceIter, created] = _roomInstances.try_emplace(
+      command.roomUid);
+    if (created)
+      roomInstanceIter->second = std::make_shared<RoomInstance>();
+
+    roomInstance = roomInstanceIter->second;
+    inserted = created;
+  }
 
   // If the room instance was just created, set it up.
   if (inserted)
   {
-    roomInstance.masterUid = command.characterUid;
+    roomInstance->masterUid = command.characterUid;
   }
 
-  _serverInstance.GetDataDirector().GetCharacter(clientContext.characterUid).Immutable(
-    [roomUid = clientContext.roomUid, inserted](
-      const data::Character& character)
-    {
-      if (inserted)
-        spdlog::info("Character '{}' has created the room {}", character.name(), roomUid);
-      else
-        spdlog::info("Character '{}' has joined the room {}", character.name(), roomUid);
-    });
+  const auto& joinedParticipant = RefreshParticipant(
+    *roomInstance,
+    command.characterUid);
 
-  auto& joinedRacer = roomInstance.tracker.AddRacer(
+  if (inserted)
+    spdlog::info("Character '{}' has created the room {}", joinedParticipant.name, command.roomUid);
+  else
+    spdlog::info("Character '{}' has joined the room {}", joinedParticipant.name, command.roomUid);
+
+  auto& joinedRacer = roomInstance->tracker.AddRacer(
     command.characterUid);
 
   joinedRacer.state = tracker::RaceTracker::Racer::State::NotReady;
@@ -404,16 +714,16 @@ void RaceDirector::HandleEnterRoom(
 
   protocol::Racer joiningRacer;
 
-  for (const auto& [characterUid, racer] : roomInstance.tracker.GetRacers())
+  for (const auto& racer : roomInstance->tracker.GetRacers())
   {
     auto& protocolRacer = response.racers.emplace_back();
 
     protocolRacer.isReady = racer.state == tracker::RaceTracker::Racer::State::Ready;
 
     const auto characterRecord = GetServerInstance().GetDataDirector().GetCharacter(
-      characterUid);
+      racer.characterUid);
     characterRecord.Immutable(
-      [this, racer, &protocolRacer, leaderUid = roomInstance.masterUid](
+      [this, racer, &protocolRacer, leaderUid = roomInstance->masterUid](
         const data::Character& character)
       {
         if (character.uid() == leaderUid)
@@ -452,7 +762,7 @@ void RaceDirector::HandleEnterRoom(
           });
       });
 
-    if (characterUid == clientContext.characterUid)
+    if (racer.characterUid == clientContext.characterUid)
     {
       joiningRacer = protocolRacer;
     }
@@ -469,7 +779,7 @@ void RaceDirector::HandleEnterRoom(
     .racer = joiningRacer,
     .averageTimeRecord = clientContext.characterUid};
 
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -479,7 +789,14 @@ void RaceDirector::HandleEnterRoom(
       });
   }
 
-  roomInstance.clients.insert(clientId);
+  roomInstance->clients.insert(clientId);
+
+  _serverInstance.GetRoomSystem().UpdateRoom(
+    command.roomUid,
+    [occupantCount = roomInstance->clients.size()](Room& room)
+    {
+      room.occupantCount = static_cast<uint8_t>(occupantCount);
+    });
 }
 
 void RaceDirector::HandleChangeRoomOptions(
@@ -488,26 +805,29 @@ void RaceDirector::HandleChangeRoomOptions(
 {
   // todo: validate command fields
 
-  const auto& clientContext = _clients[clientId];
-  auto& room = _serverInstance.GetRoomSystem().GetRoom(
-    clientContext.roomUid);
+  const auto clientContext = GetClientContext(clientId);
 
   const std::bitset<6> options(
     static_cast<uint16_t>(command.optionsBitfield));
 
-  if (options.test(0))
-    room.name = command.name;
-  if (options.test(1))
-    room.playerCount = command.playerCount;
-  if (options.test(2))
-    room.password = command.password;
-  if (options.test(3))
-    room.gameMode = command.gameMode;
-  if (options.test(4))
-    room.mapBlockId = command.mapBlockId;
-  if (options.test(5))
-    room.unk3 = command.npcRace;
-  
+  _serverInstance.GetRoomSystem().UpdateRoom(
+    clientContext.roomUid,
+    [&options, &command](Room& room)
+    {
+      if (options.test(0))
+        room.name = command.name;
+      if (options.test(1))
+        room.playerCount = command.playerCount;
+      if (options.test(2))
+        room.password = command.password;
+      if (options.test(3))
+        room.gameMode = command.gameMode;
+      if (options.test(4))
+        room.mapBlockId = command.mapBlockId;
+      if (options.test(5))
+        room.unk3 = command.npcRace;
+    });
+
   protocol::AcCmdCRChangeRoomOptionsNotify notify{
     .optionsBitfield = command.optionsBitfield,
     .name = command.name,
@@ -517,9 +837,9 @@ void RaceDirector::HandleChangeRoomOptions(
     .mapBlockId = command.mapBlockId,
     .npcRace = command.npcRace};
 
-  const auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  for (const auto roomClientId : roomInstance.clients)
+  for (const auto roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -534,10 +854,10 @@ void RaceDirector::HandleChangeTeam(
   ClientId clientId,
   const protocol::AcCmdCRChangeTeam& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
 
   // todo: team balancing
@@ -569,7 +889,7 @@ void RaceDirector::HandleChangeTeam(
     });
 
   // Notify all other clients in the room
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     if (roomClientId == clientId)
       continue;
@@ -587,22 +907,29 @@ void RaceDirector::HandleLeaveRoom(ClientId clientId)
 {
   protocol::AcCmdCRLeaveRoomOK response{};
 
-  auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  _serverInstance.GetDataDirector().GetCharacter(clientContext.characterUid).Immutable(
-    [roomUid = clientContext.roomUid](
-      const data::Character& character)
-    {
-      spdlog::info("Character '{}' has left the room {}", character.name(), roomUid);
-    });
+  spdlog::info(
+    "Character '{}' has left the room {}",
+    GetParticipant(*roomInstance, clientContext.characterUid).name,
+    clientContext.roomUid);
+
+  // Drop the relay membership of the racer.
+  if (GetConfig().relay.enabled)
+  {
+    _relayServer.RemoveMember(
+      clientContext.roomUid,
+      roomInstance->tracker.GetRacer(clientContext.characterUid).oid);
+  }
 
-  roomInstance.tracker.RemoveRacer(
+  roomInstance->tracker.RemoveRacer(
     clientContext.characterUid);
-  roomInstance.clients.erase(clientId);
+  roomInstance->participants.erase(clientContext.characterUid);
+  roomInstance->clients.erase(clientId);
 
   // Check if the leaving player was the leader
-  const bool wasLeader = roomInstance.masterUid == clientContext.characterUid;
+  const bool wasLeader = roomInstance->masterUid == clientContext.characterUid;
 
   {
     // Notify other clients in the room about the character leaving.
@@ -610,7 +937,7 @@ void RaceDirector::HandleLeaveRoom(ClientId clientId)
       .characterId = clientContext.characterUid,
       .unk0 = 1};
 
-    for (const ClientId& roomClientId : roomInstance.clients)
+    for (const ClientId& roomClientId : roomInstance->clients)
     {
       if (roomClientId == clientId)
         continue;
@@ -624,25 +951,32 @@ void RaceDirector::HandleLeaveRoom(ClientId clientId)
     }
   }
 
-  if (not roomInstance.tracker.GetRacers().empty())
+  if (not roomInstance->tracker.GetRacers().empty())
   {
+    _serverInstance.GetRoomSystem().UpdateRoom(
+      clientContext.roomUid,
+      [occupantCount = roomInstance->clients.size()](Room& room)
+      {
+        room.occupantCount = static_cast<uint8_t>(occupantCount);
+      });
+
     if (wasLeader)
     {
       // Find the next leader.
       // todo: assign mastership to the best player
 
-      roomInstance.masterUid = roomInstance.tracker.GetRacers().begin()->first;
+      roomInstance->masterUid = roomInstance->tracker.GetRacers().front().characterUid;
 
       spdlog::info("Character {} became the master of room {} after the previous master left",
-        roomInstance.masterUid,
+        roomInstance->masterUid,
         clientContext.roomUid);
 
       {
         // Notify other clients in the room about the new master.
         protocol::AcCmdCRChangeMasterNotify notify{
-          .masterUid = roomInstance.masterUid};
+          .masterUid = roomInstance->masterUid};
 
-        for (const ClientId& roomClientId : roomInstance.clients)
+        for (const ClientId& roomClientId : roomInstance->clients)
         {
           _commandServer.QueueCommand<decltype(notify)>(
             roomClientId,
@@ -658,10 +992,23 @@ void RaceDirector::HandleLeaveRoom(ClientId clientId)
   {
     _serverInstance.GetRoomSystem().DeleteRoom(
       clientContext.roomUid);
-    _roomInstances.erase(clientContext.roomUid);
+    {
+      std::scoped_lock lock(_roomInstancesMutex);
+      _roomInstances.erase(clientContext.roomUid);
+    }
+    if (GetConfig().relay.enabled)
+      _relayServer.RemoveRoom(clientContext.roomUid);
+    _roomShards.Remove(clientContext.roomUid);
   }
 
-  clientContext.roomUid = data::InvalidUid;
+  ResetRoute(clientId);
+
+  GetServerInstance().GetPresenceSystem().Update(
+    clientContext.characterUid,
+    [](PresenceSystem::Presence& presence)
+    {
+      presence.roomUid = data::InvalidUid;
+    });
 
   _commandServer.QueueCommand<decltype(response)>(
     clientId,
@@ -675,11 +1022,11 @@ void RaceDirector::HandleReadyRace(
   ClientId clientId,
   const protocol::AcCmdCRReadyRace& command)
 {
-  auto& clientContext = _clients[clientId];
+  const auto clientContext = GetClientContext(clientId);
 
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
 
   // Toggle the ready state.
@@ -692,7 +1039,7 @@ void RaceDirector::HandleReadyRace(
     .characterUid = clientContext.characterUid,
     .isReady = racer.state == tracker::RaceTracker::Racer::State::Ready};
 
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(response)>(
       roomClientId,
@@ -707,14 +1054,24 @@ void RaceDirector::HandleStartRace(
   ClientId clientId,
   const protocol::AcCmdCRStartRace& command)
 {
-  _scheduler.Queue(
-    [this, clientId]()
+  const auto roomUid = GetClientContext(clientId).roomUid;
+
+  QueueRoomTask(
+    roomUid,
+    [this, roomUid]()
     {
-      const auto& clientContext = _clients[clientId];
+      const trace::Span traceSpan("RaceDirector::StartRace");
 
       const auto& room = _serverInstance.GetRoomSystem().GetRoom(
-        clientContext.roomUid);
-      auto& roomInstance = _roomInstances[clientContext.roomUid];
+        roomUid);
+      const auto roomInstance = GetRoomInstance(roomUid);
+
+      _serverInstance.GetRoomSystem().UpdateRoom(
+        roomUid,
+        [](Room& updatedRoom)
+        {
+          updatedRoom.isRacing = true;
+        });
 
       // todo: verify master
 
@@ -725,8 +1082,8 @@ void RaceDirector::HandleStartRace(
       protocol::AcCmdCRStartRaceNotify notify{
         .gameMode = room.gameMode,
         .teamMode = room.teamMode,
-        .p2pRelayAddress = asio::ip::address_v4::loopback().to_uint(),
-        .p2pRelayPort = static_cast<uint16_t>(10500)};
+        .p2pRelayAddress = GetConfig().relay.advertisement.address.to_uint(),
+        .p2pRelayPort = GetConfig().relay.advertisement.port};
 
       if (room.mapBlockId == AllMapsCourseId || room.mapBlockId == NewMapsCourseId || room.mapBlockId == HotMapsCourseId)
       {
@@ -740,17 +1097,21 @@ void RaceDirector::HandleStartRace(
       }
       notify.missionId = room.missionId;
 
-      for (const auto& [characterUid, racer] : roomInstance.tracker.GetRacers())
+      roomInstance->raceMapBlockId = notify.mapBlockId;
+      roomInstance->raceGameMode = room.gameMode;
+      roomInstance->resultsRecorded = false;
+
+      for (const auto& racer : roomInstance->tracker.GetRacers())
       {
-        std::string characterName;
-        GetServerInstance().GetDataDirector().GetCharacter(characterUid).Immutable([&characterName](const data::Character& character)
-          {
-            characterName = character.name();
-          });
+        // The participants are refreshed once per race,
+        // the events of the race then read the snapshots.
+        const auto& participant = RefreshParticipant(
+          *roomInstance,
+          racer.characterUid);
 
         auto& protocolRacer = notify.racers.emplace_back(protocol::AcCmdCRStartRaceNotify::Player{
           .oid = racer.oid,
-          .name = characterName,
+          .name = participant.name,
           .p2dId = racer.oid,
         });
 
@@ -769,7 +1130,7 @@ void RaceDirector::HandleStartRace(
       }
 
       // Reset jump combo/star point (boost)
-      for (auto& racer : roomInstance.tracker.GetRacers() | std::views::values)
+      for (auto& racer : roomInstance->tracker.GetRacers())
       {
         racer.jumpComboValue = 0;
         racer.starPointValue = 0;
@@ -777,21 +1138,39 @@ void RaceDirector::HandleStartRace(
 
       // todo: start loading timeout timer
       // Send to all clients in the room.
-      for (const ClientId& roomClientId : roomInstance.clients)
+      for (const ClientId& roomClientId : roomInstance->clients)
       {
-        const auto& roomClientContext = _clients[roomClientId];
+        const auto roomClientContext = GetClientContext(roomClientId);
 
-        auto& racer = roomInstance.tracker.GetRacer(
+        auto& racer = roomInstance->tracker.GetRacer(
           roomClientContext.characterUid);
         racer.state = tracker::RaceTracker::Racer::State::Loading;
 
-        _serverInstance.GetDataDirector().GetCharacter(roomClientContext.characterUid).Immutable([](const data::Character& character)
-          {
-            spdlog::info("Race start sent to '{}'", character.name());
-          });
+        spdlog::info(
+          "Race start sent to '{}'",
+          GetParticipant(*roomInstance, roomClientContext.characterUid).name);
 
         notify.hostOid = racer.oid;
 
+        // Reserve the relay membership of the room for the racer.
+        if (GetConfig().relay.enabled)
+        {
+          try
+          {
+            _relayServer.ReserveMember(
+              roomUid,
+              racer.oid,
+              _commandServer.GetClientAddress(roomClientId));
+          }
+          catch (const std::exception& x)
+          {
+            spdlog::warn(
+              "Couldn't reserve the relay membership for client {}: {}",
+              roomClientId,
+              x.what());
+          }
+        }
+
         _commandServer.QueueCommand<decltype(notify)>(
           roomClientId,
           [notify]()
@@ -827,16 +1206,16 @@ void RaceDirector::HandleLoadingComplete(
   ClientId clientId,
   const protocol::AcCmdCRLoadingComplete& command)
 {
-  auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
 
   racer.state = tracker::RaceTracker::Racer::State::Racing;
 
   // Notify all clients in the room that this player's loading is complete
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<protocol::AcCmdCRLoadingCompleteNotify>(
       roomClientId,
@@ -848,7 +1227,7 @@ void RaceDirector::HandleLoadingComplete(
   }
 
   const bool allRacersLoaded = std::ranges::all_of(
-    std::views::values(roomInstance.tracker.GetRacers()),
+    roomInstance->tracker.GetRacers(),
     [](const tracker::RaceTracker::Racer& racer)
     {
       return racer.state == tracker::RaceTracker::Racer::State::Racing;
@@ -861,7 +1240,7 @@ void RaceDirector::HandleLoadingComplete(
 
   // TODO: better way of doing this? Reinstantiating the room?
   // Clear room items before populating
-  roomInstance.tracker.GetItems().clear();
+  roomInstance->tracker.ClearItems();
 
   // map id 1, right in front of start line [20.631426, -25.969913, -8004.5986]
   // 101 - Gold horseshoe
@@ -869,7 +1248,7 @@ void RaceDirector::HandleLoadingComplete(
   // 402 - magic horseshoe (tutorial?)
   for (uint32_t i = 0; i < 5; ++i)
   {
-    auto& item = roomInstance.tracker.AddItem();
+    auto& item = roomInstance->tracker.AddItem();
     item.itemType = 102;
     // FIXME: do not use hardcoded positions, store them in files instead
     item.position = {30.0f, -25.0f, -8012.0f + (i * 3)};
@@ -882,7 +1261,7 @@ void RaceDirector::HandleLoadingComplete(
       .member5 = false,
       .removeDelay = -1.0f};
 
-    for (const ClientId& roomClientId : roomInstance.clients)
+    for (const ClientId& roomClientId : roomInstance->clients)
       _commandServer.QueueCommand<decltype(spawn)>(roomClientId, [spawn](){return spawn;});
   }
 
@@ -892,7 +1271,7 @@ void RaceDirector::HandleLoadingComplete(
     clientContext.roomUid);
 
   // Record countdown start time
-  roomInstance.countdownStartTime = std::chrono::steady_clock::now();
+  roomInstance->countdownStartTime = std::chrono::steady_clock::now();
 
   // todo: start race timeout timer
 
@@ -901,9 +1280,9 @@ void RaceDirector::HandleLoadingComplete(
     .count() / 100 + 10 * 10'000'000;
     
   // Store when the race will actually start (countdown timestamp is when race begins)
-  roomInstance.raceStartTimestamp = countdownTimestamp;
+  roomInstance->raceStartTimestamp = countdownTimestamp;
 
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<protocol::AcCmdUserRaceCountdown>(
       roomClientId,
@@ -919,12 +1298,12 @@ void RaceDirector::HandleUserRaceFinal(
   ClientId clientId,
   const protocol::AcCmdUserRaceFinal& command)
 {
-  auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
   // todo: sanity check for course time
   // todo: address npc racers and update their states
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
   racer.state = tracker::RaceTracker::Racer::State::Finished;
   racer.courseTime = command.courseTime;
@@ -935,7 +1314,7 @@ void RaceDirector::HandleUserRaceFinal(
 
   // todo: start finish timeout timer
 
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -952,8 +1331,8 @@ void RaceDirector::HandleRaceResult(
 {
   // todo: only requested by the room master
 
-  auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
   protocol::AcCmdCRRaceResultOK response{
     .member1 = 1,
@@ -973,7 +1352,7 @@ void RaceDirector::HandleRaceResult(
   protocol::AcCmdRCRaceResultNotify notify{};
 
   const bool allRacersFinished = std::ranges::all_of(
-    std::views::values(roomInstance.tracker.GetRacers()),
+    roomInstance->tracker.GetRacers(),
     [](const tracker::RaceTracker::Racer& racer)
     {
       return racer.state == tracker::RaceTracker::Racer::State::Finished;
@@ -982,8 +1361,18 @@ void RaceDirector::HandleRaceResult(
   if (not allRacersFinished)
     return;
 
+  _serverInstance.GetRoomSystem().UpdateRoom(
+    clientContext.roomUid,
+    [](Room& room)
+    {
+      room.isRacing = false;
+    });
+
+  // Every racer may report the result, record it only once.
+  RecordRaceResults(*roomInstance);
+
   // Build the score board.
-  for (const auto& [characterUid, racer] : roomInstance.tracker.GetRacers())
+  for (const auto& racer : roomInstance->tracker.GetRacers())
   {
     auto& score = notify.scores.emplace_back();
 
@@ -994,24 +1383,14 @@ void RaceDirector::HandleRaceResult(
 
     score.courseTime = racer.courseTime;
 
-    const auto characterRecord = _serverInstance.GetDataDirector().GetCharacter(
-      characterUid);
-
-    characterRecord.Immutable([this, &score](const data::Character& character)
-    {
-      score.uid = character.uid();
-      score.name = character.name();
-      score.level = character.level();
-
-      _serverInstance.GetDataDirector().GetHorse(character.mountUid()).Immutable(
-        [&score](const data::Horse& horse)
-        {
-          score.mountName = horse.name();
-        });
-    });
+    const auto& participant = GetParticipant(*roomInstance, racer.characterUid);
+    score.uid = racer.characterUid;
+    score.name = participant.name;
+    score.level = participant.level;
+    score.mountName = participant.mountName;
   }
 
-  for (const ClientId roomClientId : roomInstance.clients)
+  for (const ClientId roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -1022,6 +1401,30 @@ void RaceDirector::HandleRaceResult(
   }
 }
 
+bool RaceDirector::RecordRaceResults(RoomInstance& roomInstance)
+{
+  if (roomInstance.resultsRecorded)
+    return false;
+
+  roomInstance.resultsRecorded = true;
+
+  // All the racers remaining in the room have finished the race.
+  std::vector<RankingSystem::RacerResult> racerResults;
+  for (const auto& racer : roomInstance.tracker.GetRacers())
+  {
+    racerResults.emplace_back(RankingSystem::RacerResult{
+      .characterUid = racer.characterUid,
+      .courseTime = racer.courseTime});
+  }
+
+  _serverInstance.GetRankingSystem().RecordRaceResults(
+    roomInstance.raceMapBlockId,
+    roomInstance.raceGameMode,
+    racerResults);
+
+  return true;
+}
+
 void RaceDirector::HandleP2PRaceResult(
   ClientId clientId,
   const protocol::AcCmdCRP2PResult& command)
@@ -1038,13 +1441,13 @@ void RaceDirector::HandleAwardStart(
   ClientId clientId,
   const protocol::AcCmdCRAwardStart& command)
 {
-  const auto& clientContext = _clients[clientId];
-  const auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
   protocol::AcCmdRCAwardNotify notify{
     .member1 = command.member1};
 
-  for (const auto roomClientId : roomInstance.clients)
+  for (const auto roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -1059,12 +1462,12 @@ void RaceDirector::HandleAwardEnd(
   ClientId clientId,
   const protocol::AcCmdCRAwardEnd& command)
 {
-  const auto& clientContext = _clients[clientId];
-  const auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
   protocol::AcCmdCRAwardEndNotify notify{};
 
-  for (const auto roomClientId : roomInstance.clients)
+  for (const auto roomClientId : roomInstance->clients)
   {
     if (roomClientId == clientId)
       continue;
@@ -1082,10 +1485,10 @@ void RaceDirector::HandleStarPointGet(
   ClientId clientId,
   const protocol::AcCmdCRStarPointGet& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
   if (command.characterOid != racer.oid)
   {
@@ -1122,10 +1525,10 @@ void RaceDirector::HandleRequestSpur(
   ClientId clientId,
   const protocol::AcCmdCRRequestSpur& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
   if (command.characterOid != racer.oid)
   {
@@ -1161,10 +1564,10 @@ void RaceDirector::HandleHurdleClearResult(
   ClientId clientId,
   const protocol::AcCmdCRHurdleClearResult& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
   if (command.characterOid != racer.oid)
   {
@@ -1291,10 +1694,10 @@ void RaceDirector::HandleStartingRate(
     return;
   }
 
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
-  auto& racer = roomInstance.tracker.GetRacer(
+  auto& racer = roomInstance->tracker.GetRacer(
     clientContext.characterUid);
   if (command.characterOid != racer.oid)
   {
@@ -1331,18 +1734,22 @@ void RaceDirector::HandleRaceUserPos(
   ClientId clientId,
   const protocol::AcCmdUserRaceUpdatePos& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
   if (command.oid != racer.oid)
   {
     // TODO: command character oid does not match calling character oid
     return;
   }
   
-  // Note: Position tracking removed for Docker compatibility
-  // racer.position = command.member2;  // Position (x, y, z)
-  // racer.rotation = command.member3;  // Rotation (x, y, z)
+  roomInstance->tracker.GetKinematics(racer.oid) = {
+    .position = command.member2,
+    .rotation = command.member3,
+    .speed = command.member4,
+    .airborne = command.member5,
+    .progress = command.member6,
+    .timestamp = command.member7};
 
   const auto& room = _serverInstance.GetRoomSystem().GetRoom(
     clientContext.roomUid);
@@ -1352,13 +1759,13 @@ void RaceDirector::HandleRaceUserPos(
   // Only regenerate magic during active race (after countdown finishes)
   // Check if gamemode is magic, race is active, countdown finished, and not holding an item
   bool raceActuallyStarted = false;
-  if (roomInstance.raceStartTimestamp.has_value())
+  if (roomInstance->raceStartTimestamp.has_value())
   {
     // Get current timestamp in same format as countdown timestamp
     auto currentTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
       std::chrono::steady_clock::now().time_since_epoch()).count() / 100;
       
-    raceActuallyStarted = currentTimestamp >= roomInstance.raceStartTimestamp.value();
+    raceActuallyStarted = currentTimestamp >= roomInstance->raceStartTimestamp.value();
   }
   
   if (room.gameMode == 2 && racer.state == tracker::RaceTracker::Racer::State::Racing && raceActuallyStarted && not racer.magicItem.has_value())
@@ -1388,38 +1795,125 @@ void RaceDirector::HandleRaceUserPos(
         return starPointResponse;
       });
   }
+}
 
-  for (const auto& roomClientId : roomInstance.clients)
+void RaceDirector::PublishRacerSnapshot(uint32_t roomUid)
+{
+  std::shared_ptr<RoomInstance> roomInstance;
+  {
+    std::shared_lock lock(_roomInstancesMutex);
+    const auto roomInstanceIter = _roomInstances.find(roomUid);
+    if (roomInstanceIter != _roomInstances.cend())
+      roomInstance = roomInstanceIter->second;
+  }
+
+  // The room was destroyed since the publish was queued,
+  // forget the partition the publish recreated.
+  if (not roomInstance)
+  {
+    _roomShards.Remove(roomUid);
+    return;
+  }
+
+  auto& raceTracker = roomInstance->tracker;
+
+  const auto racers = raceTracker.GetRacers();
+  const auto kinematics = raceTracker.GetKinematics();
+  const auto publishedKinematics = raceTracker.GetPublishedKinematics();
+
+  // Build the snapshot of the racer states which changed since the last publish,
+  // every state is written once and shared by all the recipients.
+  std::vector<SenderCommandSupplier> snapshot;
+  for (std::size_t idx = 0; idx < racers.size(); ++idx)
   {
+    const auto& racer = racers[idx];
+    if (racer.state != tracker::RaceTracker::Racer::State::Racing)
+      continue;
+
+    if (not HasKinematicsChanged(kinematics[idx], publishedKinematics[idx]))
+      continue;
+    publishedKinematics[idx] = kinematics[idx];
+
+    const protocol::AcCmdUserRaceUpdatePos update{
+      .oid = racer.oid,
+      .member2 = kinematics[idx].position,
+      .member3 = kinematics[idx].rotation,
+      .member4 = kinematics[idx].speed,
+      .member5 = kinematics[idx].airborne,
+      .member6 = kinematics[idx].progress,
+      .member7 = kinematics[idx].timestamp};
+
+    snapshot.emplace_back(racer.oid, _commandServer.ShareCommand(update));
+  }
+
+  if (snapshot.empty())
+    return;
+
+  // Send the snapshot to the clients still racing or the ones who already finished.
+  std::vector<SenderCommandSupplier> recipientSnapshot;
+  recipientSnapshot.reserve(snapshot.size());
+  for (const ClientId roomClientId : roomInstance->clients)
+  {
+    const auto roomClientContext = GetClientContext(roomClientId);
+    if (not raceTracker.IsRacer(roomClientContext.characterUid))
+      continue;
+
+    const auto& recipientRacer = raceTracker.GetRacer(roomClientContext.characterUid);
+    if (recipientRacer.state != tracker::RaceTracker::Racer::State::Racing
+      && recipientRacer.state != tracker::RaceTracker::Racer::State::Finished)
+      continue;
+
     // Prevent broadcast to self.
-    if (clientId == roomClientId)
+    recipientSnapshot.clear();
+    for (const auto& racerUpdate : snapshot)
+    {
+      if (racerUpdate.first != recipientRacer.oid)
+        recipientSnapshot.emplace_back(racerUpdate);
+    }
+
+    if (recipientSnapshot.empty())
       continue;
+
+    // An update of a racer not yet sent to the recipient is replaced by the one in this snapshot.
+    _commandServer.QueueConflatedCommands<protocol::AcCmdUserRaceUpdatePos>(
+      roomClientId,
+      recipientSnapshot);
   }
 }
 
 void RaceDirector::HandleChat(ClientId clientId, const protocol::AcCmdCRChat& command)
 {
-  const auto& clientContext = _clients[clientId];
+  const auto clientContext = GetClientContext(clientId);
 
   const auto messageVerdict = _serverInstance.GetChatSystem().ProcessChatMessage(
     clientContext.characterUid, command.message);
 
-  const auto characterRecord = _serverInstance.GetDataDirector().GetCharacter(
-    clientContext.characterUid);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+
+  // Results of the commands are sent only to their author.
+  if (messageVerdict.commandVerdict)
+  {
+    for (const auto& resultMessage : messageVerdict.commandVerdict->result)
+    {
+      protocol::AcCmdCRChatNotify notify{
+        .message = resultMessage,
+        .isSystem = true};
+
+      _commandServer.QueueCommand<decltype(notify)>(
+        clientId,
+        [notify]{return notify;});
+    }
+    return;
+  }
 
   protocol::AcCmdCRChatNotify notify{
     .message = messageVerdict.message,
+    .author = GetParticipant(*roomInstance, clientContext.characterUid).name,
     .isSystem = false};
 
-  characterRecord.Immutable([&notify](const data::Character& character)
-  {
-    notify.author = character.name();
-  });
-
   spdlog::info("[Room {}] {}: {}", clientContext.roomUid, notify.author, notify.message);
 
-  const auto& roomInstance = _roomInstances[clientContext.roomUid];
-  for (const ClientId roomClientId : roomInstance.clients)
+  for (const ClientId roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -1431,7 +1925,7 @@ void RaceDirector::HandleRelayCommand(
   ClientId clientId,
   const protocol::AcCmdCRRelayCommand& command)
 {
-  const auto& clientContext = _clients[clientId];
+  const auto clientContext = GetClientContext(clientId);
   
   // Create relay notify message
   protocol::AcCmdCRRelayCommandNotify notify{
@@ -1440,10 +1934,10 @@ void RaceDirector::HandleRelayCommand(
   };
 
   // Get the room instance for this client
-  const auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
   
   // Relay the command to all other clients in the room
-  for (const ClientId roomClientId : roomInstance.clients)
+  for (const ClientId roomClientId : roomInstance->clients)
   {
     if (roomClientId != clientId) // Don't send back to sender
     {
@@ -1458,7 +1952,7 @@ void RaceDirector::HandleRelay(
   ClientId clientId,
   const protocol::AcCmdCRRelay& command)
 {
-  const auto& clientContext = _clients[clientId];
+  const auto clientContext = GetClientContext(clientId);
   
   // Create relay notify message
   protocol::AcCmdCRRelayNotify notify{
@@ -1467,10 +1961,10 @@ void RaceDirector::HandleRelay(
   };
 
   // Get the room instance for this client
-  const auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
   
   // Relay the command to all other clients in the room
-  for (const ClientId roomClientId : roomInstance.clients)
+  for (const ClientId roomClientId : roomInstance->clients)
   {
     if (roomClientId != clientId) // Don't send back to sender
     {
@@ -1486,11 +1980,11 @@ void RaceDirector::HandleUserRaceActivateInteractiveEvent
   ClientId clientId,
   const protocol::AcCmdUserRaceActivateInteractiveEvent& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
   // Get the sender's OID from the room tracker
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
 
   protocol::AcCmdUserRaceActivateInteractiveEvent notify{
     .member1 = command.member1,
@@ -1499,7 +1993,7 @@ void RaceDirector::HandleUserRaceActivateInteractiveEvent
   };
 
   // Broadcast to all clients in the room
-  for (const ClientId roomClientId : roomInstance.clients)
+  for (const ClientId roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -1512,11 +2006,11 @@ void RaceDirector::HandleUserRaceActivateEvent
   ClientId clientId,
   const protocol::AcCmdUserRaceActivateEvent& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
 
   // Get the sender's OID from the room tracker
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
 
   spdlog::info("HandleUserRaceActivateEvent: clientId={}, eventId={}, characterOid={}", 
     clientId, command.eventId, racer.oid);
@@ -1527,7 +2021,7 @@ void RaceDirector::HandleUserRaceActivateEvent
   };
 
   // Broadcast to all clients in the room
-  for (const ClientId roomClientId : roomInstance.clients)
+  for (const ClientId roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(notify)>(
       roomClientId,
@@ -1542,9 +2036,9 @@ void RaceDirector::HandleRequestMagicItem(
   spdlog::info("Player {} requested magic item (OID: {}, type: {})", 
     clientId, command.member1, command.member2);
 
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
 
   // TODO: command.member1 is character oid?
   if (command.member1 != racer.oid)
@@ -1598,7 +2092,7 @@ void RaceDirector::HandleRequestMagicItem(
     .member2 = response.member1
   };
 
-  for (const auto& roomClientId : roomInstance.clients)
+  for (const auto& roomClientId : roomInstance->clients)
   {
     // Prevent broadcast to self
     if (roomClientId == clientId)
@@ -1618,9 +2112,9 @@ void RaceDirector::HandleUseMagicItem(
   const protocol::AcCmdCRUseMagicItem& command)
 {
   spdlog::info("Player {} used magic item {} (OID: {})", clientId, command.magicItemId, command.characterOid);
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
 
   if (command.characterOid != racer.oid)
   {
@@ -1683,7 +2177,7 @@ void RaceDirector::HandleUseMagicItem(
   // Send general usage notification to other players (except for ice wall which has its own notification)
   if (command.magicItemId != 10) 
   {
-    for (const auto& roomClientId : roomInstance.clients)
+    for (const auto& roomClientId : roomInstance->clients)
     {
       if (roomClientId == clientId)
         continue;
@@ -1701,7 +2195,7 @@ void RaceDirector::HandleUseMagicItem(
     
     // Find a target automatically (first other player in the room)
     tracker::Oid targetOid = tracker::InvalidEntityOid;
-    for (const auto& [targetUid, targetRacer] : roomInstance.tracker.GetRacers())
+    for (const auto& targetRacer : roomInstance->tracker.GetRacers())
     {
       // Skip the attacker, find first valid target
       if (targetRacer.oid != command.characterOid && 
@@ -1716,61 +2210,55 @@ void RaceDirector::HandleUseMagicItem(
     if (targetOid != tracker::InvalidEntityOid)
     {
       // Apply bolt hit effects to the target
-      for (auto& [targetUid, targetRacer] : roomInstance.tracker.GetRacers())
+      auto& targetRacer = roomInstance->tracker.GetRacerByOid(targetOid);
+
+      spdlog::info("Applying bolt effects to target racer {} (OID: {})", targetRacer.characterUid, targetRacer.oid);
+      
+      // Send magic item notify for bolt hit effects (safe approach)
+      protocol::AcCmdCRUseMagicItemNotify boltHitNotify{
+        .characterOid = targetRacer.oid,  // Target gets hit
+        .magicItemId = 2,  // Bolt magic item ID  
+        .unk3 = targetRacer.oid
+      };
+      
+      // Populate required optional fields for bolt
+      if (!boltHitNotify.optional2.has_value()) {
+        auto& opt2 = boltHitNotify.optional2.emplace();
+        opt2.size = 0;
+        opt2.list.clear();
+      }
+      
+      // Set timing values for bolt animation
+      boltHitNotify.optional3 = 1.0f;  // Cast time: 1 second for bolt to hit
+      boltHitNotify.optional4 = 3.0f;  // Effect duration: 3 seconds target stays down
+      
+      spdlog::info("Sending bolt hit notification: characterOid={}, magicItemId={}, timing: {}s/{}s", 
+        boltHitNotify.characterOid, boltHitNotify.magicItemId, 
+        boltHitNotify.optional3.value(), boltHitNotify.optional4.value());
+      
+      for (const ClientId& roomClientId : roomInstance->clients)
       {
-        if (targetRacer.oid == targetOid)
-        {
-          spdlog::info("Applying bolt effects to target racer {} (OID: {})", targetUid, targetRacer.oid);
-          
-          // Send magic item notify for bolt hit effects (safe approach)
-          protocol::AcCmdCRUseMagicItemNotify boltHitNotify{
-            .characterOid = targetRacer.oid,  // Target gets hit
-            .magicItemId = 2,  // Bolt magic item ID  
-            .unk3 = targetRacer.oid
-          };
-          
-          // Populate required optional fields for bolt
-          if (!boltHitNotify.optional2.has_value()) {
-            auto& opt2 = boltHitNotify.optional2.emplace();
-            opt2.size = 0;
-            opt2.list.clear();
-          }
-          
-          // Set timing values for bolt animation
-          boltHitNotify.optional3 = 1.0f;  // Cast time: 1 second for bolt to hit
-          boltHitNotify.optional4 = 3.0f;  // Effect duration: 3 seconds target stays down
-          
-          spdlog::info("Sending bolt hit notification: characterOid={}, magicItemId={}, timing: {}s/{}s", 
-            boltHitNotify.characterOid, boltHitNotify.magicItemId, 
-            boltHitNotify.optional3.value(), boltHitNotify.optional4.value());
-          
-          for (const ClientId& roomClientId : roomInstance.clients)
-          {
-            spdlog::info("Sending bolt hit notification to client {}", roomClientId);
-            _commandServer.QueueCommand<decltype(boltHitNotify)>(
-              roomClientId, 
-              [boltHitNotify]() { return boltHitNotify; });
-          }
-          
-          // Effect 1: Target loses their current magic item
-          if (targetRacer.magicItem.has_value())
-          {
-            uint32_t lostItemId = targetRacer.magicItem.value();
-            spdlog::info("Target racer {} lost magic item {}", targetRacer.oid, lostItemId);
-            targetRacer.magicItem.reset();
-            
-            // TODO: Add proper magic expire notification once we confirm bolt hit works
-            spdlog::info("Target lost magic item {} (server-side only for now)", lostItemId);
-            
-            // TODO: Add client notifications once bolt hit animation is working
-          }
-          else
-          {
-            spdlog::info("Target racer {} has no magic item to lose", targetRacer.oid);
-          }
-          
-          break;
-        }
+        spdlog::info("Sending bolt hit notification to client {}", roomClientId);
+        _commandServer.QueueCommand<decltype(boltHitNotify)>(
+          roomClientId, 
+          [boltHitNotify]() { return boltHitNotify; });
+      }
+      
+      // Effect 1: Target loses their current magic item
+      if (targetRacer.magicItem.has_value())
+      {
+        uint32_t lostItemId = targetRacer.magicItem.value();
+        spdlog::info("Target racer {} lost magic item {}", targetRacer.oid, lostItemId);
+        targetRacer.magicItem.reset();
+        
+        // TODO: Add proper magic expire notification once we confirm bolt hit works
+        spdlog::info("Target lost magic item {} (server-side only for now)", lostItemId);
+        
+        // TODO: Add client notifications once bolt hit animation is working
+      }
+      else
+      {
+        spdlog::info("Target racer {} has no magic item to lose", targetRacer.oid);
       }
     }
     else
@@ -1785,7 +2273,7 @@ void RaceDirector::HandleUseMagicItem(
     spdlog::info("Ice wall used! Spawning ice wall at player {} location", clientId);
     
     // Spawn ice wall at a reasonable position (near start line like other items)
-    auto& iceWall = roomInstance.tracker.AddItem();
+    auto& iceWall = roomInstance->tracker.AddItem();
     iceWall.itemType = 102;  // Use same type as working items (temporarily)
     iceWall.position = {25.0f, -25.0f, -8010.0f};  // Near other track items
     
@@ -1805,8 +2293,8 @@ void RaceDirector::HandleUseMagicItem(
     spdlog::info("Sending ice wall spawn using AcCmdGameRaceItemSpawn: itemId={}, position=({}, {}, {})", 
       iceWallSpawn.itemId, iceWallSpawn.position[0], iceWallSpawn.position[1], iceWallSpawn.position[2]);
     
-    spdlog::info("Broadcasting to {} clients in room", roomInstance.clients.size());
-    for (const ClientId& roomClientId : roomInstance.clients)
+    spdlog::info("Broadcasting to {} clients in room", roomInstance->clients.size());
+    for (const ClientId& roomClientId : roomInstance->clients)
     {
       spdlog::info("Sending ice wall spawn to client {}", roomClientId);
       _commandServer.QueueCommand<decltype(iceWallSpawn)>(
@@ -1822,9 +2310,9 @@ void RaceDirector::HandleUserRaceItemGet(
   ClientId clientId,
   const protocol::AcCmdUserRaceItemGet& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto const& item = roomInstance.tracker.GetItems().at(command.itemId);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto const& item = roomInstance->tracker.GetItem(command.itemId);
   protocol::AcCmdGameRaceItemGet get{
     .characterOid = command.characterOid,
     .itemId = command.itemId,
@@ -1832,7 +2320,7 @@ void RaceDirector::HandleUserRaceItemGet(
   };
 
   // Notify all clients in the room that this item has been picked up
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
     _commandServer.QueueCommand<decltype(get)>(
       roomClientId,
@@ -1843,9 +2331,12 @@ void RaceDirector::HandleUserRaceItemGet(
   }
   // Wait for ItemDeck registry, to give the correct amount of SP for item pick up
 
-  _scheduler.Queue(
-    [this, clientId, item, &roomInstance]()
+  QueueRoomTask(
+    clientContext.roomUid,
+    [this, item, roomUid = clientContext.roomUid]()
     {
+      const auto roomInstance = GetRoomInstance(roomUid);
+
       // Respawn the item after a delay
       protocol::AcCmdGameRaceItemSpawn spawn{
         .itemId = item.itemId,
@@ -1856,7 +2347,7 @@ void RaceDirector::HandleUserRaceItemGet(
         .removeDelay = -1.0f
       };
 
-      for (const ClientId& roomClientId : roomInstance.clients)
+      for (const ClientId& roomClientId : roomInstance->clients)
       {
         _commandServer.QueueCommand<decltype(spawn)>(
           roomClientId, 
@@ -1878,9 +2369,9 @@ void RaceDirector::HandleStartMagicTarget(
   spdlog::info("Player {} started magic targeting with character OID {}", 
     clientId, command.characterOid);
   
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
   
   if (command.characterOid != racer.oid)
   {
@@ -1902,9 +2393,9 @@ void RaceDirector::HandleChangeMagicTargetNotify(
   spdlog::info("Player {} changed magic target: character OID {} -> target OID {}", 
     clientId, command.characterOid, command.targetOid);
   
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
   
   if (command.characterOid != racer.oid)
   {
@@ -1922,10 +2413,10 @@ void RaceDirector::HandleChangeMagicTargetNotify(
   };
   
   // Find the client ID for this target and send notification
-  for (const ClientId& roomClientId : roomInstance.clients)
+  for (const ClientId& roomClientId : roomInstance->clients)
   {
-    const auto& targetClientContext = _clients[roomClientId];
-    if (roomInstance.tracker.GetRacer(targetClientContext.characterUid).oid == command.targetOid)
+    const auto targetClientContext = GetClientContext(roomClientId);
+    if (roomInstance->tracker.GetRacer(targetClientContext.characterUid).oid == command.targetOid)
     {
       _commandServer.QueueCommand<decltype(targetNotify)>(
         roomClientId, 
@@ -1942,9 +2433,9 @@ void RaceDirector::HandleChangeMagicTargetOK(
   spdlog::info("Player {} confirmed magic target: character OID {} -> target OID {}", 
     clientId, command.characterOid, command.targetOid);
   
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
   
   if (command.characterOid != racer.oid)
   {
@@ -1956,43 +2447,40 @@ void RaceDirector::HandleChangeMagicTargetOK(
   spdlog::info("BOLT FIRED! {} -> {}", command.characterOid, command.targetOid);
   
   // Find the target racer and apply bolt effects
-  for (auto& [targetUid, targetRacer] : roomInstance.tracker.GetRacers())
+  if (roomInstance->tracker.IsRacerOid(command.targetOid))
   {
-    if (targetRacer.oid == command.targetOid)
+    auto& targetRacer = roomInstance->tracker.GetRacerByOid(command.targetOid);
+
+    spdlog::info("Bolt hit target {}! Applying effects...", command.targetOid);
+    
+    // Apply bolt effects: fall down, lose speed, lose item
+    // Reset their magic item (they lose it when hit)
+    targetRacer.magicItem.reset();
+    
+    // Send bolt hit notification to all clients so they can see the hit effects
+    spdlog::info("Sending bolt hit notification to all clients for target {}", command.targetOid);
+    
+    // Send bolt hit as magic item usage notification
+    protocol::AcCmdCRUseMagicItemNotify boltHitNotify{
+      .characterOid = command.targetOid,  // The target who gets hit
+      .magicItemId = 2,  // Bolt magic item ID  
+      .unk3 = command.targetOid
+    };
+    
+    // For bolt (ID 2), we might need to populate optional fields
+    // Based on the Read method, bolt (case 0x2) expects optional2 and optional3/4
+    if (!boltHitNotify.optional2.has_value()) {
+      auto& opt2 = boltHitNotify.optional2.emplace();
+      opt2.size = 0;  // Empty list for now
+      opt2.list.clear();
+    }
+    
+    for (const ClientId& roomClientId : roomInstance->clients)
     {
-      spdlog::info("Bolt hit target {}! Applying effects...", command.targetOid);
-      
-      // Apply bolt effects: fall down, lose speed, lose item
-      // Reset their magic item (they lose it when hit)
-      targetRacer.magicItem.reset();
-      
-      // Send bolt hit notification to all clients so they can see the hit effects
-      spdlog::info("Sending bolt hit notification to all clients for target {}", command.targetOid);
-      
-      // Send bolt hit as magic item usage notification
-      protocol::AcCmdCRUseMagicItemNotify boltHitNotify{
-        .characterOid = command.targetOid,  // The target who gets hit
-        .magicItemId = 2,  // Bolt magic item ID  
-        .unk3 = command.targetOid
-      };
-      
-      // For bolt (ID 2), we might need to populate optional fields
-      // Based on the Read method, bolt (case 0x2) expects optional2 and optional3/4
-      if (!boltHitNotify.optional2.has_value()) {
-        auto& opt2 = boltHitNotify.optional2.emplace();
-        opt2.size = 0;  // Empty list for now
-        opt2.list.clear();
-      }
-      
-      for (const ClientId& roomClientId : roomInstance.clients)
-      {
-        spdlog::info("Sending bolt hit notification to client {}", roomClientId);
-        _commandServer.QueueCommand<decltype(boltHitNotify)>(
-          roomClientId, 
-          [boltHitNotify]() { return boltHitNotify; });
-      }
-      
-      break;
+      spdlog::info("Sending bolt hit notification to client {}", roomClientId);
+      _commandServer.QueueCommand<decltype(boltHitNotify)>(
+        roomClientId, 
+        [boltHitNotify]() { return boltHitNotify; });
     }
   }
   
@@ -2011,9 +2499,9 @@ void RaceDirector::HandleChangeMagicTargetCancel(
   spdlog::info("Player {} cancelled magic targeting: character OID {}", 
     clientId, command.characterOid);
   
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
-  auto& racer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
+  auto& racer = roomInstance->tracker.GetRacer(clientContext.characterUid);
   
   if (command.characterOid != racer.oid)
   {
@@ -2029,10 +2517,10 @@ void RaceDirector::HandleChangeMagicTargetCancel(
     };
     
     // Find the client ID for the current target
-    for (const ClientId& roomClientId : roomInstance.clients)
+    for (const ClientId& roomClientId : roomInstance->clients)
     {
-      const auto& targetClientContext = _clients[roomClientId];
-      if (roomInstance.tracker.GetRacer(targetClientContext.characterUid).oid == racer.currentTarget)
+      const auto targetClientContext = GetClientContext(roomClientId);
+      if (roomInstance->tracker.GetRacer(targetClientContext.characterUid).oid == racer.currentTarget)
       {
         _commandServer.QueueCommand<decltype(removeNotify)>(
           roomClientId, 
@@ -2054,8 +2542,8 @@ void RaceDirector::HandleActivateSkillEffect(
   ClientId clientId,
   const protocol::AcCmdCRActivateSkillEffect& command)
 {
-  const auto& clientContext = _clients[clientId];
-  auto& roomInstance = _roomInstances[clientContext.roomUid];
+  const auto clientContext = GetClientContext(clientId);
+  const auto roomInstance = GetRoomInstance(clientContext.roomUid);
   
   // Convert unk2 back to float (it's 1.0f = 1065353216 as uint32)
   float intensity = *reinterpret_cast<const float*>(&command.unk2);
@@ -2064,7 +2552,7 @@ void RaceDirector::HandleActivateSkillEffect(
     clientId, command.characterOid, command.skillId, command.unk1, intensity);
   
   // Process the skill effect activation - give target extra gauge (Attack Compensation skill)
-  auto& targetRacer = roomInstance.tracker.GetRacer(clientContext.characterUid);
+  auto& targetRacer = roomInstance->tracker.GetRacer(clientContext.characterUid);
   
   // Apply "Attack Compensation" skill - target gets extra gauge when attacked
   targetRacer.starPointValue += 50;  // Give 50 star points for being attacked
@@ -25,6 +25,8 @@
 #include "libserver/registry/PetRegistry.hpp"
 #include "libserver/util/Util.hpp"
 
+#include <cmath>
+#include <cstring>
 #include <ranges>
 
 #include <spdlog/spdlog.h>
@@ -44,6 +46,23 @@ constexpr size_t MaxRanchHousingCount = 13;
 constexpr int16_t DoubleIncubatorId = 52;
 constexpr int16_t SingleIncubatorId = 51;
 
+//! Reads the position of a character from the spatial data of its snapshot.
+//! @note The spatial data is assumed to hold the coordinates, the layout of the snapshot is unverified.
+//! @param data Spatial data holding the coordinates.
+//! @returns Position, or empty if the coordinates are not finite.
+std::optional<tracker::RanchTracker::Position> ReadSnapshotPosition(
+  const std::array<std::byte, 12>& data)
+{
+  tracker::RanchTracker::Position position{};
+  static_assert(sizeof(position) == sizeof(data));
+  std::memcpy(position.data(), data.data(), sizeof(position));
+
+  if (not std::ranges::all_of(position, [](float coordinate){ return std::isfinite(coordinate); }))
+    return std::nullopt;
+
+  return position;
+}
+
 } // namespace anon
 
 RanchDirector::RanchDirector(ServerInstance& serverInstance)
@@ -339,30 +358,28 @@ void RanchDirector::Initialize()
     GetConfig().listen.address.to_string(),
     GetConfig().listen.port);
 
+  _commandServer.SetSlowCommandThreshold(std::chrono::milliseconds(
+    GetServerInstance().GetSettings().profiling.slowCommandThreshold));
+
+  if (not GetConfig().capturePath.empty())
+  {
+    _commandServer.BeginCapture(GetConfig().capturePath);
+    // The sessions depend on the codes granted and the rooms created by the lobby.
+    GetServerInstance().CaptureStates(_commandServer);
+  }
+
   _commandServer.BeginHost(GetConfig().listen.address, GetConfig().listen.port);
 }
 
 void RanchDirector::Terminate()
 {
   _commandServer.EndHost();
+  _commandServer.EndCapture();
 }
 
 void RanchDirector::Tick()
 {
-}
-
-std::vector<data::Uid> RanchDirector::GetOnlineCharacters()
-{
-  std::vector<data::Uid> onlineCharacterUids;
-
-  for (const auto& clientContext : _clients | std::views::values)
-  {
-    if (not clientContext.isAuthenticated)
-      continue;
-    onlineCharacterUids.emplace_back(clientContext.characterUid);
-  }
-
-  return onlineCharacterUids;
+  GetServerInstance().GetBreedingMarketSystem().Tick();
 }
 
 void RanchDirector::HandleClientConnected(ClientId clientId)
@@ -379,6 +396,10 @@ void RanchDirector::HandleClientDisconnected(ClientId clientId)
   if (clientContext.isAuthenticated)
   {
     HandleRanchLeave(clientId);
+
+    GetServerInstance().GetPresenceSystem().Disconnect(
+      clientContext.characterUid,
+      PresenceSystem::Director::Ranch);
   }
 
   _clients.erase(clientId);
@@ -541,6 +562,17 @@ void RanchDirector::BroadcastHideAgeNotify(
   }
 }
 
+void RanchDirector::BroadcastNotice(
+  std::span<const ClientId> clientIds,
+  const std::string& message)
+{
+  const protocol::AcCmdCRRanchChatNotify notify{
+    .message = message,
+    .isSystem = true};
+
+  _commandServer.QueueCommand(clientIds, notify);
+}
+
 ServerInstance& RanchDirector::GetServerInstance()
 {
   return _serverInstance;
@@ -551,6 +583,11 @@ Config::Ranch& RanchDirector::GetConfig()
   return GetServerInstance().GetSettings().ranch;
 }
 
+CommandServer& RanchDirector::GetCommandServer()
+{
+  return _commandServer;
+}
+
 RanchDirector::ClientContext& RanchDirector::GetClientContext(
   const ClientId clientId,
   const bool requireAuthentication)
@@ -627,11 +664,18 @@ void RanchDirector::HandleEnterRanch(
   clientContext.characterUid = command.characterUid;
   clientContext.visitingRancherUid = command.rancherUid;
 
+  GetServerInstance().GetPresenceSystem().Connect(
+    command.characterUid,
+    PresenceSystem::Director::Ranch,
+    clientId,
+    [rancherUid = command.rancherUid](PresenceSystem::Presence& presence)
+    {
+      presence.ranchUid = rancherUid;
+    });
+
   protocol::AcCmdCREnterRanchOK response{
     .rancherUid = command.rancherUid,
-    .league = {
-      .type = League::Type::Platinum,
-      .rankingPercentile = 50}};
+    .league = _serverInstance.GetRankingSystem().GetLeague(command.characterUid)};
 
   rancherRecord->Immutable(
     [this, &response, &ranchInstance, ranchCreated](
@@ -864,6 +908,8 @@ void RanchDirector::HandleEnterRanch(
   }
 
   ranchInstance.clients.emplace(clientId);
+  ranchInstance.characterClients[ranchInstance.tracker.GetCharacterOid(
+    command.characterUid)] = clientId;
 }
 
 void RanchDirector::HandleRanchLeave(ClientId clientId)
@@ -882,6 +928,8 @@ void RanchDirector::HandleRanchLeave(ClientId clientId)
 
   auto& ranchInstance = ranchIter->second;
 
+  ranchInstance.characterClients.erase(
+    ranchInstance.tracker.GetCharacterOid(clientContext.characterUid));
   ranchInstance.tracker.RemoveCharacter(clientContext.characterUid);
   ranchInstance.clients.erase(clientId);
 
@@ -978,8 +1026,8 @@ void RanchDirector::HandleSnapshot(
   ClientId clientId,
   const protocol::AcCmdCRRanchSnapshot& command)
 {
-  const auto& clientContext = GetClientContext(clientId);
-  const auto& ranchInstance = _ranches[clientContext.visitingRancherUid];
+  auto& clientContext = GetClientContext(clientId);
+  auto& ranchInstance = _ranches[clientContext.visitingRancherUid];
 
   protocol::RanchCommandRanchSnapshotNotify notify{
     .ranchIndex = ranchInstance.tracker.GetCharacterOid(
@@ -1005,18 +1053,67 @@ void RanchDirector::HandleSnapshot(
     }
   }
 
-  for (const auto& ranchClient : ranchInstance.clients)
+  // Only the latest snapshot of the character matters to the other clients.
+  const auto queueNotify = [this, &notify](ClientId ranchClient)
   {
-    // Do not broadcast to the client that sent the snapshot.
-    if (ranchClient == clientId)
-      continue;
-
-    _commandServer.QueueCommand<decltype(notify)>(
+    _commandServer.QueueConflatedCommand<decltype(notify)>(
       ranchClient,
+      notify.ranchIndex,
       [notify]()
       {
         return notify;
       });
+  };
+
+  // Remember the position of the character if the snapshot carries a valid one,
+  // the position is read only if the interest filtering is enabled.
+  std::optional<tracker::RanchTracker::Position> position;
+  if (GetConfig().interestRadius > 0.0f)
+  {
+    position = ReadSnapshotPosition(
+      command.type == protocol::AcCmdCRRanchSnapshot::Full
+        ? command.full.member4
+        : command.partial.member4);
+  }
+
+  if (position)
+    ranchInstance.tracker.SetPosition(notify.ranchIndex, *position);
+
+  // The clients outside of the interest radius of the character
+  // are sent only every n-th snapshot of the character.
+  const bool isFarSnapshot = GetConfig().farSnapshotInterval <= 1
+    || clientContext.snapshotCount % GetConfig().farSnapshotInterval == 0;
+  ++clientContext.snapshotCount;
+
+  const bool isFiltered = position.has_value();
+  if (isFarSnapshot || not isFiltered)
+  {
+    for (const auto& ranchClient : ranchInstance.clients)
+    {
+      // Do not broadcast to the client that sent the snapshot.
+      if (ranchClient == clientId)
+        continue;
+
+      queueNotify(ranchClient);
+    }
+
+    return;
+  }
+
+  const auto nearbyOids = ranchInstance.tracker.GetObjectsInRadius(
+    *position,
+    GetConfig().interestRadius);
+  for (const auto nearbyOid : nearbyOids)
+  {
+    const auto clientIter = ranchInstance.characterClients.find(nearbyOid);
+    if (clientIter == ranchInstance.characterClients.cend())
+      continue;
+
+    // Do not broadcast to the client that sent the snapshot.
+    if (clientIter->second == clientId)
+      continue;
+
+    queueNotify(clientIter->second);
   }
 }
 
@@ -1058,8 +1155,6 @@ void RanchDirector::HandleEnterBreedingMarket(
     });
 }
 
-static std::vector<data::Uid> g_stallions;
-
 void RanchDirector::HandleSearchStallion(
   ClientId clientId,
   const protocol::AcCmdCRSearchStallion& command)
@@ -1068,27 +1163,19 @@ void RanchDirector::HandleSearchStallion(
     .unk0 = 0,
     .unk1 = 0};
 
-  for (const data::Uid& stallionUid : g_stallions)
+  // todo: map the search criteria and the page of the command once their layout is known,
+  //       until then all the listed stallions are sent like before the market was indexed.
+  auto& breedingMarketSystem = GetServerInstance().GetBreedingMarketSystem();
+  BreedingMarketSystem::Query query{};
+  for (uint32_t pageCount = 1; query.page < pageCount; ++query.page)
   {
-    const auto stallionRecord = GetServerInstance().GetDataDirector().GetHorseCache().Get(
-      stallionUid);
-
-    auto& protocolStallion = response.stallions.emplace_back();
-    stallionRecord->Immutable([&protocolStallion](const data::Horse& stallion)
-    {
-      protocolStallion.member1 = "unknown";
-      protocolStallion.uid = stallion.uid();
-      protocolStallion.tid = stallion.tid();
+    const auto page = breedingMarketSystem.Search(query);
+    pageCount = page->pageCount;
 
-      protocolStallion.name = stallion.name();
-      protocolStallion.grade = stallion.grade();
-
-      protocolStallion.expiresAt = util::TimePointToAliciaTime(util::Clock::now() + std::chrono::hours(1));
-
-      protocol::BuildProtocolHorseStats(protocolStallion.stats, stallion.stats);
-      protocol::BuildProtocolHorseParts(protocolStallion.parts, stallion.parts);
-      protocol::BuildProtocolHorseAppearance(protocolStallion.appearance, stallion.appearance);
-    });
+    response.stallions.insert(
+      response.stallions.end(),
+      page->stallions.begin(),
+      page->stallions.end());
   }
 
   _commandServer.QueueCommand<decltype(response)>(
@@ -1103,7 +1190,24 @@ void RanchDirector::HandleRegisterStallion(
   ClientId clientId,
   const protocol::AcCmdCRRegisterStallion& command)
 {
-  g_stallions.emplace_back(command.horseUid);
+  const auto& clientContext = GetClientContext(clientId);
+
+  try
+  {
+    GetServerInstance().GetBreedingMarketSystem().RegisterStallion(
+      command.horseUid,
+      clientContext.characterUid,
+      command.carrots);
+  }
+  catch (const std::exception& x)
+  {
+    spdlog::warn(
+      "Character {} failed to register stallion {}: {}",
+      clientContext.characterUid,
+      command.horseUid,
+      x.what());
+    return;
+  }
 
   protocol::AcCmdCRRegisterStallionOK response{
     .horseUid = command.horseUid};
@@ -1120,7 +1224,19 @@ void RanchDirector::HandleUnregisterStallion(
   ClientId clientId,
   const protocol::AcCmdCRUnregisterStallion& command)
 {
-  g_stallions.erase(std::ranges::find(g_stallions, command.horseUid));
+  const auto& clientContext = GetClientContext(clientId);
+
+  const bool isUnregistered = GetServerInstance().GetBreedingMarketSystem().UnregisterStallion(
+    command.horseUid,
+    clientContext.characterUid);
+  if (not isUnregistered)
+  {
+    spdlog::warn(
+      "Character {} failed to unregister stallion {} not listed by them",
+      clientContext.characterUid,
+      command.horseUid);
+    return;
+  }
 
   protocol::AcCmdCRUnregisterStallionOK response{};
 
@@ -1273,6 +1389,12 @@ void RanchDirector::HandleUpdateBusyState(
     .busyState = command.busyState};
 
   clientContext.busyState = command.busyState;
+  GetServerInstance().GetPresenceSystem().Update(
+    clientContext.characterUid,
+    [busyState = command.busyState](PresenceSystem::Presence& presence)
+    {
+      presence.busyState = busyState;
+    });
 
   for (auto ranchClientId : ranchInstance.clients)
   {
@@ -1859,6 +1981,13 @@ void RanchDirector::HandleCreateGuild(
     character.guildUid = response.uid;
   });
 
+  GetServerInstance().GetPresenceSystem().Update(
+    clientContext.characterUid,
+    [guildUid = response.uid](PresenceSystem::Presence& presence)
+    {
+      presence.guildUid = guildUid;
+    });
+
   _commandServer.QueueCommand<decltype(response)>(
     clientId,
     [response]()
@@ -1936,6 +2065,13 @@ void RanchDirector::HandleLeaveGuild(
     // otherwise guild stays soft locked forever if not deleted
   });
 
+  GetServerInstance().GetPresenceSystem().Update(
+    clientContext.characterUid,
+    [](PresenceSystem::Presence& presence)
+    {
+      presence.guildUid = data::InvalidUid;
+    });
+
   protocol::AcCmdCRWithdrawGuildMemberOK response{
     .unk0 = 0
   };
@@ -0,0 +1,148 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "server/system/BreedingMarketIndex.hpp"
+
+namespace server
+{
+
+void BreedingMarketIndex::Add(const Stallion& stallion, data::Tid coat)
+{
+  Remove(stallion.uid);
+
+  const auto& entry = _entries.try_emplace(
+    stallion.uid,
+    Entry{
+      .stallion = stallion,
+      .coat = coat}).first->second;
+
+  const PriceKey priceKey{entry.stallion.matePrice, entry.stallion.uid};
+  _priceIndex.emplace(priceKey);
+  _coatIndex[entry.coat].emplace(priceKey);
+  _gradeIndex[entry.stallion.grade].emplace(priceKey);
+
+  _pageCache.clear();
+}
+
+bool BreedingMarketIndex::Remove(data::Uid horseUid)
+{
+  const auto entryIter = _entries.find(horseUid);
+  if (entryIter == _entries.cend())
+    return false;
+
+  const auto& entry = entryIter->second;
+  const PriceKey priceKey{entry.stallion.matePrice, entry.stallion.uid};
+  _priceIndex.erase(priceKey);
+
+  const auto eraseFromIndex = [&priceKey](auto& index, const auto& indexKey)
+  {
+    const auto indexIter = index.find(indexKey);
+    if (indexIter == index.end())
+      return;
+
+    indexIter->second.erase(priceKey);
+    if (indexIter->second.empty())
+      index.erase(indexIter);
+  };
+
+  eraseFromIndex(_coatIndex, entry.coat);
+  eraseFromIndex(_gradeIndex, static_cast<uint32_t>(entry.stallion.grade));
+
+  _entries.erase(entryIter);
+  _pageCache.clear();
+  return true;
+}
+
+std::size_t BreedingMarketIndex::GetSize() const
+{
+  return _entries.size();
+}
+
+std::shared_ptr<const BreedingMarketIndex::Page> BreedingMarketIndex::Search(
+  const Query& query)
+{
+  const QueryKey queryKey{query.coat, query.grade, query.maxPrice};
+
+  auto pageCacheIter = _pageCache.find(queryKey);
+  if (pageCacheIter == _pageCache.cend())
+  {
+    pageCacheIter = _pageCache.try_emplace(queryKey, ComputePages(queryKey)).first;
+  }
+
+  const auto& pages = pageCacheIter->second;
+  if (query.page >= pages.size())
+    return std::make_shared<const Page>(Page{
+      .pageCount = static_cast<uint32_t>(pages.size())});
+
+  return pages[query.page];
+}
+
+std::vector<std::shared_ptr<const BreedingMarketIndex::Page>> BreedingMarketIndex::ComputePages(
+  const QueryKey& queryKey) const
+{
+  const auto& [coat, grade, maxPrice] = queryKey;
+
+  // Walk the most selective index of the ones the query filters by.
+  const std::set<PriceKey>* candidates = &_priceIndex;
+  const auto selectIndex = [&candidates](const auto& index, const auto& indexKey)
+  {
+    const auto indexIter = index.find(indexKey);
+    static const std::set<PriceKey> EmptyIndex;
+
+    const auto& indexed = indexIter == index.cend() ? EmptyIndex : indexIter->second;
+    if (indexed.size() < candidates->size())
+      candidates = &indexed;
+  };
+
+  if (coat)
+    selectIndex(_coatIndex, *coat);
+  if (grade)
+    selectIndex(_gradeIndex, *grade);
+
+  std::vector<Page> pages;
+  for (const auto& [matePrice, horseUid] : *candidates)
+  {
+    // The candidates are ordered by their price.
+    if (maxPrice && matePrice > *maxPrice)
+      break;
+
+    const auto& entry = _entries.at(horseUid);
+    if (coat && entry.coat != *coat)
+      continue;
+    if (grade && entry.stallion.grade != *grade)
+      continue;
+
+    if (pages.empty() || pages.back().stallions.size() == PageSize)
+      pages.emplace_back();
+
+    pages.back().stallions.emplace_back(entry.stallion);
+  }
+
+  std::vector<std::shared_ptr<const Page>> sharedPages;
+  sharedPages.reserve(pages.size());
+  for (auto& page : pages)
+  {
+    page.pageCount = static_cast<uint32_t>(pages.size());
+    sharedPages.emplace_back(std::make_shared<const Page>(std::move(page)));
+  }
+
+  return sharedPages;
+}
+
+} // namespace server
@@ -0,0 +1,237 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "server/system/BreedingMarketSystem.hpp"
+
+#include "server/ServerInstance.hpp"
+
+#include "libserver/data/helper/ProtocolHelper.hpp"
+#include "libserver/util/Util.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <ranges>
+
+namespace server
+{
+
+BreedingMarketSystem::BreedingMarketSystem(ServerInstance& serverInstance)
+  : _serverInstance(serverInstance)
+{
+}
+
+void BreedingMarketSystem::RegisterStallion(
+  data::Uid horseUid,
+  data::Uid ownerUid,
+  uint32_t matePrice)
+{
+  auto& dataDirector = _serverInstance.GetDataDirector();
+
+  const auto ownerRecord = dataDirector.GetCharacter(ownerUid);
+  if (not ownerRecord)
+    throw std::runtime_error("Owner not available");
+
+  bool isOwned = false;
+  ownerRecord.Immutable([horseUid, &isOwned](const data::Character& character)
+  {
+    isOwned = character.mountUid() == horseUid
+      || std::ranges::contains(character.horses(), horseUid);
+  });
+
+  if (not isOwned)
+    throw std::runtime_error("Stallion not in the stable of the owner");
+
+  const auto horseRecord = dataDirector.GetHorse(horseUid);
+  if (not horseRecord)
+    throw std::runtime_error("Stallion not available");
+
+  std::scoped_lock lock(_listingsMutex);
+
+  const auto [listingIter, inserted] = _listings.try_emplace(horseUid);
+  if (not inserted)
+    throw std::runtime_error("Stallion already listed");
+
+  auto& listing = listingIter->second;
+  listing.listing = data::BreedingMarket::Listing{
+    .horseUid = horseUid,
+    .ownerUid = ownerUid,
+    .matePrice = matePrice,
+    .expiresAt = data::Clock::now() + ListingDuration};
+
+  horseRecord.Immutable([this, &listing](const data::Horse& horse)
+  {
+    IndexListing(listing, horse);
+  });
+
+  _isDirty = true;
+}
+
+bool BreedingMarketSystem::UnregisterStallion(data::Uid horseUid, data::Uid ownerUid)
+{
+  std::scoped_lock lock(_listingsMutex);
+
+  // Only the owner of the listing may remove it.
+  const auto listingIter = _listings.find(horseUid);
+  if (listingIter == _listings.cend()
+    || listingIter->second.listing.ownerUid != ownerUid)
+    return false;
+
+  RemoveListing(horseUid);
+
+  _isDirty = true;
+  return true;
+}
+
+bool BreedingMarketSystem::IsListed(data::Uid horseUid)
+{
+  std::scoped_lock lock(_listingsMutex);
+  return _listings.contains(horseUid);
+}
+
+std::shared_ptr<const BreedingMarketSystem::Page> BreedingMarketSystem::Search(
+  const Query& query)
+{
+  std::scoped_lock lock(_listingsMutex);
+
+  return _index.Search(query);
+}
+
+void BreedingMarketSystem::Tick()
+{
+  auto& dataDirector = _serverInstance.GetDataDirector();
+  auto& breedingMarketCache = dataDirector.GetBreedingMarketCache();
+
+  std::scoped_lock lock(_listingsMutex);
+
+  // Load the persisted listings.
+  if (not _isLoaded)
+  {
+    const auto breedingMarketRecord = breedingMarketCache.Get(MarketKey);
+    if (not breedingMarketRecord)
+      return;
+
+    breedingMarketRecord->Immutable([this](const data::BreedingMarket& breedingMarket)
+    {
+      for (const auto& persistedListing : breedingMarket.listings())
+      {
+        _listings.try_emplace(persistedListing.horseUid, Listing{
+          .listing = persistedListing});
+      }
+    });
+
+    _isLoaded = true;
+    spdlog::debug("Loaded {} breeding market listings", _listings.size());
+  }
+
+  bool hasChanged = false;
+
+  const auto now = data::Clock::now();
+  for (auto listingIter = _listings.begin(); listingIter != _listings.end();)
+  {
+    auto& listing = listingIter->second;
+
+    // Remove the expired listings.
+    if (listing.listing.expiresAt < now)
+    {
+      _index.Remove(listing.listing.horseUid);
+      listingIter = _listings.erase(listingIter);
+      hasChanged = true;
+      continue;
+    }
+
+    // Index the loaded listings once their stallion is available.
+    if (not listing.isIndexed)
+    {
+      const auto horseRecord = dataDirector.GetHorse(listing.listing.horseUid);
+      if (horseRecord)
+      {
+        horseRecord.Immutable([this, &listing](const data::Horse& horse)
+        {
+          IndexListing(listing, horse);
+        });
+
+        hasChanged = true;
+      }
+    }
+
+    ++listingIter;
+  }
+
+  if (hasChanged)
+    _isDirty = true;
+
+  const auto tickTime = Clock::now();
+  if (not _isDirty || tickTime < _nextFlushTime)
+    return;
+
+  _nextFlushTime = tickTime + FlushInterval;
+
+  const auto breedingMarketRecord = breedingMarketCache.Get(MarketKey, false);
+  if (not breedingMarketRecord)
+    return;
+
+  // Flush all the listings at once.
+  breedingMarketRecord->Mutable([this](data::BreedingMarket& breedingMarket)
+  {
+    std::vector<data::BreedingMarket::Listing> persistedListings;
+    persistedListings.reserve(_listings.size());
+    for (const auto& listing : _listings | std::views::values)
+    {
+      persistedListings.emplace_back(listing.listing);
+    }
+
+    breedingMarket.listings = std::move(persistedListings);
+  });
+
+  breedingMarketCache.Flush(MarketKey);
+  _isDirty = false;
+}
+
+void BreedingMarketSystem::IndexListing(Listing& listing, const data::Horse& horse)
+{
+  Stallion stallion{};
+  stallion.member1 = "unknown";
+  stallion.uid = horse.uid();
+  stallion.tid = horse.tid();
+  stallion.name = horse.name();
+  stallion.grade = horse.grade();
+  stallion.matePrice = listing.listing.matePrice;
+  stallion.expiresAt = util::TimePointToAliciaTime(listing.listing.expiresAt);
+
+  protocol::BuildProtocolHorseStats(stallion.stats, horse.stats);
+  protocol::BuildProtocolHorseParts(stallion.parts, horse.parts);
+  protocol::BuildProtocolHorseAppearance(stallion.appearance, horse.appearance);
+
+  _index.Add(stallion, horse.parts.skinTid());
+  listing.isIndexed = true;
+}
+
+bool BreedingMarketSystem::RemoveListing(data::Uid horseUid)
+{
+  const auto listingIter = _listings.find(horseUid);
+  if (listingIter == _listings.cend())
+    return false;
+
+  _index.Remove(horseUid);
+  _listings.erase(listingIter);
+  return true;
+}
+
+} // namespace server
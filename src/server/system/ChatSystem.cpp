@@ -24,6 +24,9 @@
 
 #include <libserver/util/Util.hpp>
 
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+
 #include <regex>
 #include <format>
 
@@ -81,8 +84,28 @@ ChatSystem::ChatVerdict ChatSystem::ProcessChatMessage(
   }
   else
   {
-    // todo: moderation
-    verdict.message = message;
+    const auto moderation = GetModeration();
+    switch (moderation->action)
+    {
+      case Moderation::Action::Mask:
+      {
+        verdict.message = moderation->wordFilter.Mask(message);
+        break;
+      }
+      case Moderation::Action::Reject:
+      {
+        // The rejection is reported only to the author, as is the result of a command.
+        if (moderation->wordFilter.Contains(message))
+        {
+          verdict.commandVerdict = CommandVerdict{
+            .result = {"Your message was not sent as it contains a banned word."}};
+          break;
+        }
+
+        verdict.message = message;
+        break;
+      }
+    }
   }
 
   return verdict;
@@ -105,6 +128,42 @@ ChatSystem::CommandVerdict ChatSystem::ProcessCommandMessage(
   return verdict;
 }
 
+void ChatSystem::ReadModerationConfig(const std::filesystem::path& configPath)
+{
+  const auto root = YAML::LoadFile(configPath.string());
+  const auto moderationSection = root["moderation"];
+
+  Moderation::Action action = Moderation::Action::Mask;
+  const auto actionName = moderationSection["action"].as<std::string>("mask");
+  if (actionName == "reject")
+    action = Moderation::Action::Reject;
+  else if (actionName != "mask")
+    throw std::runtime_error(std::format("Unknown moderation action '{}'", actionName));
+
+  std::vector<std::string> words;
+  for (const auto& wordSection : moderationSection["words"])
+  {
+    words.emplace_back(wordSection.as<std::string>());
+  }
+
+  auto moderation = std::make_shared<const Moderation>(Moderation{
+    .action = action,
+    .wordFilter = WordFilter(words)});
+
+  spdlog::info(
+    "Chat moderation loaded {} banned words",
+    moderation->wordFilter.GetWordCount());
+
+  std::scoped_lock lock(_moderationMutex);
+  _moderation = std::move(moderation);
+}
+
+std::shared_ptr<const ChatSystem::Moderation> ChatSystem::GetModeration()
+{
+  std::scoped_lock lock(_moderationMutex);
+  return _moderation;
+}
+
 void ChatSystem::RegisterUserCommands()
 {
   // about command
@@ -174,32 +233,20 @@ void ChatSystem::RegisterUserCommands()
       const std::span<const std::string>& arguments,
       data::Uid characterUid) -> std::vector<std::string>
     {
-      // todo: better way to collect online players information,
-      //       maybe some kind of cental statistics collector
-      const auto onlineCharacters = _serverInstance.GetRanchDirector().GetOnlineCharacters();
+      const auto onlinePresences = _serverInstance.GetPresenceSystem().GetPresences(
+        PresenceSystem::Director::Ranch);
 
       std::vector<std::string> response;
       response.emplace_back() = std::format(
         "Online ({}):",
-        onlineCharacters.size());
+        onlinePresences.size());
 
-      for (const data::Uid& onlineCharacterUid : onlineCharacters)
+      for (const auto& onlinePresence : onlinePresences)
       {
-        const auto onlineCharacterRecord = _serverInstance.GetDataDirector().GetCharacter(
-          onlineCharacterUid);
-
-        if (not onlineCharacterRecord)
-          continue;
-
-        onlineCharacterRecord.Immutable(
-          [&response, characterUid](
-            const data::Character& character)
-          {
-            response.emplace_back() = std::format(
-              "{}{}",
-              character.name(),
-              character.uid() == characterUid ? " (you)" : "");
-          });
+        response.emplace_back() = std::format(
+          "{}{}",
+          onlinePresence.characterName,
+          onlinePresence.characterUid == characterUid ? " (you)" : "");
       }
 
       return response;
@@ -223,29 +270,29 @@ void ChatSystem::RegisterUserCommands()
       auto visitingCharacterUid = data::InvalidUid;
       bool visitingRanchLocked = true;
 
-      const auto onlineCharacters = _serverInstance.GetRanchDirector().GetOnlineCharacters();
+      const auto onlinePresences = _serverInstance.GetPresenceSystem().GetPresences(
+        PresenceSystem::Director::Ranch);
 
-      for (const data::Uid onlineCharacterUid : onlineCharacters)
+      const auto onlinePresenceIter = std::ranges::find(
+        onlinePresences,
+        visitingCharacterName,
+        &PresenceSystem::Presence::characterName);
+
+      if (onlinePresenceIter != onlinePresences.cend())
       {
         const auto onlineCharacterRecord = _serverInstance.GetDataDirector().GetCharacterCache().Get(
-          onlineCharacterUid, false);
-
-        if (not onlineCharacterRecord)
-          continue;
+          onlinePresenceIter->characterUid, false);
 
-        onlineCharacterRecord->Immutable(
-          [&visitingCharacterUid, &visitingCharacterName, &visitingRanchLocked](
-            const data::Character& character)
-          {
-            if (visitingCharacterName != character.name())
-              return;
-
-            visitingCharacterUid = character.uid();
-            visitingRanchLocked = character.isRanchLocked();
-          });
-
-        if (visitingCharacterUid != data::InvalidUid)
-          break;
+        if (onlineCharacterRecord)
+        {
+          onlineCharacterRecord->Immutable(
+            [&visitingCharacterUid, &visitingRanchLocked](
+              const data::Character& character)
+            {
+              visitingCharacterUid = character.uid();
+              visitingRanchLocked = character.isRanchLocked();
+            });
+        }
       }
 
       if (visitingCharacterUid != data::InvalidUid)
@@ -602,42 +649,30 @@ void ChatSystem::RegisterAdminCommands()
       }
 
       std::vector<std::string> userList;
-      const std::vector<std::string> users = _serverInstance.GetLobbyDirector()
-        .GetOnlineUsers();
+      const auto onlinePresences = _serverInstance.GetPresenceSystem().GetPresences(
+        PresenceSystem::Director::Lobby);
 
       userList.emplace_back("Users:");
       constexpr std::string_view UserLine = "  - {}, user: {}, uid: {}{}";
 
-      for (const auto& userName : users)
+      for (const auto& onlinePresence : onlinePresences)
       {
         bool hasInfractions = false;
-        std::string onlineCharacterName = "xxx";
-        data::Uid onlineCharacterUid{data::InvalidUid};
 
-        const auto userRecord = _serverInstance.GetDataDirector().GetUser(userName);
+        const auto userRecord = _serverInstance.GetDataDirector().GetUser(onlinePresence.userName);
         if (userRecord)
         {
-          userRecord.Immutable([&onlineCharacterUid, &hasInfractions](const data::User& user)
+          userRecord.Immutable([&hasInfractions](const data::User& user)
           {
-            onlineCharacterUid = user.characterUid();
             hasInfractions = not user.infractions().empty();
           });
-
-          const auto characterRecord = _serverInstance.GetDataDirector().GetCharacter(onlineCharacterUid);
-          if (characterRecord)
-          {
-            characterRecord.Immutable([&onlineCharacterName](const data::Character& character)
-            {
-              onlineCharacterName = character.name();
-            });
-          }
         }
 
         userList.emplace_back(std::format(
           UserLine,
-          onlineCharacterName,
-          userName,
-          onlineCharacterUid,
+          onlinePresence.characterName,
+          onlinePresence.userName,
+          onlinePresence.characterUid,
           hasInfractions ? " <font color=\"#FF0000\">(!)</font>" : ""));
       }
 
@@ -693,11 +728,12 @@ void ChatSystem::RegisterAdminCommands()
         return {"Notice sent to character"};
       }
 
-      for (const auto& onlineCharacterUid : _serverInstance.GetLobbyDirector().GetOnlineCharacters())
-      {
-        _serverInstance.GetLobbyDirector().Notice(onlineCharacterUid, message);
-      }
-      return {"Notice sent to all characters"};
+      const auto report = Broadcast(message, Audience{});
+      return {std::format(
+        "Notice sent to {} lobby, {} ranch and {} race sessions",
+        report.lobbySessions,
+        report.ranchSessions,
+        report.raceSessions)};
     });
 
   // promote command
@@ -1036,11 +1072,156 @@ void ChatSystem::RegisterAdminCommands()
 
       return {"Unknown sub literal"};
     });
+
+  // shop command
+  _commandManager.RegisterCommand(
+    "shop",
+    [this](
+      const std::span<const std::string>& arguments,
+      data::Uid characterUid) -> std::vector<std::string>
+    {
+      const auto invokerRecord = _serverInstance.GetDataDirector().GetCharacter(characterUid);
+      if (not invokerRecord)
+        return {"Server error"};
+
+      bool isAdmin = false;
+      invokerRecord.Immutable([&isAdmin](const data::Character& character)
+      {
+        isAdmin = character.role() != data::Character::Role::User;
+      });
+
+      if (not isAdmin)
+        return {};
+
+      if (arguments.empty() || arguments[0] != "reload")
+      {
+        return {"shop",
+          "  reload",
+          "  - Reloads the goods and recompiles the shop catalogue"};
+      }
+
+      try
+      {
+        _serverInstance.ReloadShopCatalogue();
+      }
+      catch (const std::exception& x)
+      {
+        return {std::format("Failed to reload the shop catalogue: {}", x.what())};
+      }
+
+      return {std::format(
+        "Shop catalogue reloaded, version {}",
+        _serverInstance.GetShopSystem().GetCatalogue()->version)};
+    });
+
+  // moderation command
+  _commandManager.RegisterCommand(
+    "moderation",
+    [this](
+      const std::span<const std::string>& arguments,
+      data::Uid characterUid) -> std::vector<std::string>
+    {
+      const auto invokerRecord = _serverInstance.GetDataDirector().GetCharacter(characterUid);
+      if (not invokerRecord)
+        return {"Server error"};
+
+      bool isAdmin = false;
+      invokerRecord.Immutable([&isAdmin](const data::Character& character)
+      {
+        isAdmin = character.role() != data::Character::Role::User;
+      });
+
+      if (not isAdmin)
+        return {};
+
+      if (arguments.empty() || arguments[0] != "reload")
+      {
+        return {"moderation",
+          "  reload",
+          "  - Reloads the banned words of the chat moderation"};
+      }
+
+      try
+      {
+        _serverInstance.ReloadChatModeration();
+      }
+      catch (const std::exception& x)
+      {
+        return {std::format("Failed to reload the chat moderation: {}", x.what())};
+      }
+
+      return {std::format(
+        "Chat moderation reloaded, {} banned words",
+        GetModeration()->wordFilter.GetWordCount())};
+    });
 }
 
-void ChatSystem::Broadcast(
-  std::string message)
+ChatSystem::BroadcastReport ChatSystem::Broadcast(
+  const std::string& message,
+  const Audience& audience)
 {
+  std::function<bool(const PresenceSystem::Presence&)> filter;
+  switch (audience.scope)
+  {
+    case Audience::Scope::Server:
+      break;
+    case Audience::Scope::Guild:
+      filter = [guildUid = audience.uid](const PresenceSystem::Presence& presence)
+      {
+        return presence.guildUid == guildUid;
+      };
+      break;
+    case Audience::Scope::Ranch:
+      filter = [ranchUid = audience.uid](const PresenceSystem::Presence& presence)
+      {
+        return presence.ranchUid == ranchUid;
+      };
+      break;
+    case Audience::Scope::Room:
+      filter = [roomUid = audience.uid](const PresenceSystem::Presence& presence)
+      {
+        return presence.roomUid == roomUid;
+      };
+      break;
+  }
+
+  using Director = PresenceSystem::Director;
+  const auto directorClients = _serverInstance.GetPresenceSystem().CollectClients(filter);
+  const auto& lobbyClients = directorClients[static_cast<std::size_t>(Director::Lobby)];
+  const auto& ranchClients = directorClients[static_cast<std::size_t>(Director::Ranch)];
+  const auto& raceClients = directorClients[static_cast<std::size_t>(Director::Race)];
+
+  // Characters in a ranch or a room are reached in there,
+  // the lobby only receives the broadcasts of the server and the guilds.
+  const bool isLobbyAudience = audience.scope == Audience::Scope::Server
+    || audience.scope == Audience::Scope::Guild;
+
+  BroadcastReport report{};
+  if (isLobbyAudience && not lobbyClients.empty())
+  {
+    _serverInstance.GetLobbyDirector().BroadcastNotice(lobbyClients, message);
+    report.lobbySessions = lobbyClients.size();
+  }
+
+  if (not ranchClients.empty())
+  {
+    _serverInstance.GetRanchDirector().BroadcastNotice(ranchClients, message);
+    report.ranchSessions = ranchClients.size();
+  }
+
+  if (not raceClients.empty())
+  {
+    _serverInstance.GetRaceDirector().BroadcastNotice(raceClients, message);
+    report.raceSessions = raceClients.size();
+  }
+
+  spdlog::debug(
+    "Broadcast delivered to {} lobby, {} ranch and {} race sessions",
+    report.lobbySessions,
+    report.ranchSessions,
+    report.raceSessions);
+
+  return report;
 }
 
 } // namespace server
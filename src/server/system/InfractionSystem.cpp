@@ -21,6 +21,8 @@
 
 #include "server/ServerInstance.hpp"
 
+#include "libserver/util/Trace.hpp"
+
 namespace server
 {
 
@@ -31,6 +33,8 @@ InfractionSystem::InfractionSystem(ServerInstance& serverInstance)
 
 InfractionSystem::Verdict InfractionSystem::CheckOutstandingPunishments(const std::string& userName)
 {
+  const trace::Span traceSpan("InfractionSystem::CheckOutstandingPunishments");
+
   const auto userRecord = _serverInstance.GetDataDirector().GetUser(userName);
   if (not userRecord)
     throw std::runtime_error("Couldn't check outstanding infractions, user not available");
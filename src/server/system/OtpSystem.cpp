@@ -9,17 +9,24 @@ namespace server
 
 uint32_t OtpSystem::GrantCode(const uint32_t key)
 {
+  std::scoped_lock lock(_codesMutex);
+
   const auto [iter, inserted] = _codes.try_emplace(
     key,
     Code{
-      .expiry = std::chrono::steady_clock::now() + std::chrono::seconds(30),
+      .expiry = std::chrono::steady_clock::now() + CodeValidity,
       .code = _rd()});
 
+  for (const auto& listener : _grantListeners)
+    listener(key, iter->second.code);
+
   return iter->second.code;
 }
 
 bool OtpSystem::AuthorizeCode(const uint32_t key, const uint32_t code)
 {
+  std::scoped_lock lock(_codesMutex);
+
   const auto codeIter = _codes.find(key);
   if (codeIter == _codes.cend())
     return false;
@@ -34,4 +41,20 @@ bool OtpSystem::AuthorizeCode(const uint32_t key, const uint32_t code)
   return authorized;
 }
 
+void OtpSystem::RestoreCode(const uint32_t key, const uint32_t code)
+{
+  std::scoped_lock lock(_codesMutex);
+  _codes.insert_or_assign(
+    key,
+    Code{
+      .expiry = std::chrono::steady_clock::now() + CodeValidity,
+      .code = code});
+}
+
+void OtpSystem::AddGrantListener(GrantListener listener)
+{
+  std::scoped_lock lock(_codesMutex);
+  _grantListeners.emplace_back(std::move(listener));
+}
+
 } // namespace server
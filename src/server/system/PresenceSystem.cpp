@@ -0,0 +1,264 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "server/system/PresenceSystem.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+namespace server
+{
+
+namespace
+{
+
+//! Returns the index of a director.
+//! @param director Director.
+//! @returns Index of the director.
+constexpr std::size_t GetDirectorIndex(PresenceSystem::Director director)
+{
+  return static_cast<std::size_t>(director);
+}
+
+} // anon namespace
+
+bool PresenceSystem::Presence::IsConnected(Director director) const
+{
+  return clients[GetDirectorIndex(director)].has_value();
+}
+
+void PresenceSystem::Connect(
+  data::Uid characterUid,
+  Director director,
+  network::ClientId clientId,
+  const Updater& updater)
+{
+  std::optional<Presence> changedPresence;
+
+  {
+    std::unique_lock lock(_presencesMutex);
+
+    auto& presence = _presences[characterUid];
+    presence.characterUid = characterUid;
+    presence.clients[GetDirectorIndex(director)] = clientId;
+    if (updater)
+      updater(presence);
+
+    _directorCharacters[GetDirectorIndex(director)].emplace(characterUid);
+    changedPresence = presence;
+  }
+
+  Notify(characterUid, changedPresence);
+}
+
+void PresenceSystem::Disconnect(data::Uid characterUid, Director director)
+{
+  std::optional<Presence> changedPresence;
+
+  {
+    std::unique_lock lock(_presencesMutex);
+
+    const auto presenceIter = _presences.find(characterUid);
+    if (presenceIter == _presences.cend())
+      return;
+
+    auto& presence = presenceIter->second;
+    presence.clients[GetDirectorIndex(director)].reset();
+    _directorCharacters[GetDirectorIndex(director)].erase(characterUid);
+
+    // Reset the location the director tracks.
+    switch (director)
+    {
+      case Director::Ranch:
+        presence.ranchUid = data::InvalidUid;
+        presence.busyState = 0;
+        break;
+      case Director::Race:
+        presence.roomUid = data::InvalidUid;
+        break;
+      default:
+        break;
+    }
+
+    // The character goes offline once it is not connected to any director.
+    const bool isConnected = std::ranges::any_of(
+      presence.clients,
+      [](const auto& client)
+      {
+        return client.has_value();
+      });
+
+    if (isConnected)
+      changedPresence = presence;
+    else
+      _presences.erase(presenceIter);
+  }
+
+  Notify(characterUid, changedPresence);
+}
+
+void PresenceSystem::Update(data::Uid characterUid, const Updater& updater)
+{
+  std::optional<Presence> changedPresence;
+
+  {
+    std::unique_lock lock(_presencesMutex);
+
+    const auto presenceIter = _presences.find(characterUid);
+    if (presenceIter == _presences.cend())
+      return;
+
+    updater(presenceIter->second);
+    changedPresence = presenceIter->second;
+  }
+
+  Notify(characterUid, changedPresence);
+}
+
+bool PresenceSystem::IsOnline(data::Uid characterUid) const
+{
+  std::shared_lock lock(_presencesMutex);
+  return _presences.contains(characterUid);
+}
+
+std::optional<PresenceSystem::Presence> PresenceSystem::GetPresence(
+  data::Uid characterUid) const
+{
+  std::shared_lock lock(_presencesMutex);
+
+  const auto presenceIter = _presences.find(characterUid);
+  if (presenceIter == _presences.cend())
+    return std::nullopt;
+
+  return presenceIter->second;
+}
+
+std::vector<data::Uid> PresenceSystem::GetOnlineCharacters(Director director) const
+{
+  std::shared_lock lock(_presencesMutex);
+
+  const auto& directorCharacters = _directorCharacters[GetDirectorIndex(director)];
+  return {directorCharacters.cbegin(), directorCharacters.cend()};
+}
+
+std::vector<PresenceSystem::Presence> PresenceSystem::GetPresences(Director director) const
+{
+  std::shared_lock lock(_presencesMutex);
+
+  std::vector<Presence> presences;
+  for (const auto& characterUid : _directorCharacters[GetDirectorIndex(director)])
+  {
+    presences.emplace_back(_presences.at(characterUid));
+  }
+
+  return presences;
+}
+
+PresenceSystem::DirectorClients PresenceSystem::CollectClients(
+  const std::function<bool(const Presence&)>& filter) const
+{
+  std::shared_lock lock(_presencesMutex);
+
+  DirectorClients directorClients;
+  for (const auto& presence : _presences | std::views::values)
+  {
+    if (filter && not filter(presence))
+      continue;
+
+    for (std::size_t directorIdx = 0; directorIdx < presence.clients.size(); ++directorIdx)
+    {
+      if (presence.clients[directorIdx])
+        directorClients[directorIdx].emplace_back(*presence.clients[directorIdx]);
+    }
+  }
+
+  return directorClients;
+}
+
+PresenceSystem::SubscriptionId PresenceSystem::Subscribe(
+  std::span<const data::Uid> characterUids,
+  Listener listener)
+{
+  std::scoped_lock lock(_subscriptionsMutex);
+
+  const auto subscriptionId = _nextSubscriptionId++;
+  _subscriptions.try_emplace(
+    subscriptionId,
+    Subscription{
+      .characterUids = {characterUids.begin(), characterUids.end()},
+      .listener = std::make_shared<const Listener>(std::move(listener))});
+
+  for (const auto& characterUid : characterUids)
+  {
+    _subscribers[characterUid].emplace_back(subscriptionId);
+  }
+
+  return subscriptionId;
+}
+
+void PresenceSystem::Unsubscribe(SubscriptionId subscriptionId)
+{
+  std::scoped_lock lock(_subscriptionsMutex);
+
+  const auto subscriptionIter = _subscriptions.find(subscriptionId);
+  if (subscriptionIter == _subscriptions.cend())
+    return;
+
+  for (const auto& characterUid : subscriptionIter->second.characterUids)
+  {
+    const auto subscribersIter = _subscribers.find(characterUid);
+    if (subscribersIter == _subscribers.cend())
+      continue;
+
+    std::erase(subscribersIter->second, subscriptionId);
+    if (subscribersIter->second.empty())
+      _subscribers.erase(subscribersIter);
+  }
+
+  _subscriptions.erase(subscriptionIter);
+}
+
+void PresenceSystem::Notify(
+  data::Uid characterUid,
+  const std::optional<Presence>& presence)
+{
+  // Collect the listeners and invoke them outside of the lock,
+  // so that they can subscribe or look up the presences.
+  std::vector<std::shared_ptr<const Listener>> listeners;
+
+  {
+    std::scoped_lock lock(_subscriptionsMutex);
+
+    const auto subscribersIter = _subscribers.find(characterUid);
+    if (subscribersIter == _subscribers.cend())
+      return;
+
+    for (const auto& subscriptionId : subscribersIter->second)
+    {
+      listeners.emplace_back(_subscriptions.at(subscriptionId).listener);
+    }
+  }
+
+  for (const auto& listener : listeners)
+  {
+    (*listener)(characterUid, presence);
+  }
+}
+
+} // namespace server
@@ -0,0 +1,233 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "server/system/RankingSystem.hpp"
+
+#include "server/ServerInstance.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace server
+{
+
+namespace
+{
+
+//! Min percentile of the platinum league.
+constexpr uint8_t PlatinumLeaguePercentile = 90;
+//! Min percentile of the gold league.
+constexpr uint8_t GoldLeaguePercentile = 70;
+//! Min percentile of the silver league.
+constexpr uint8_t SilverLeaguePercentile = 40;
+
+} // anon namespace
+
+RankingSystem::RankingSystem(ServerInstance& serverInstance)
+  : _serverInstance(serverInstance)
+{
+}
+
+void RankingSystem::RecordRaceResults(
+  uint16_t mapBlockId,
+  uint8_t gameMode,
+  const std::vector<RacerResult>& results)
+{
+  std::vector<RacerResult> placements = results;
+  std::ranges::stable_sort(placements, {}, &RacerResult::courseTime);
+
+  std::scoped_lock lock(_boardsMutex);
+
+  const auto courseBoardKey = GetCourseBoardKey(mapBlockId, gameMode);
+  for (std::size_t placement = 0; placement < placements.size(); ++placement)
+  {
+    const auto& result = placements[placement];
+    const uint32_t leaguePoints = (placements.size() - placement - 1) * LeaguePointsPerRacer;
+
+    ChangeBoard(courseBoardKey, [result](Ranking& ranking)
+    {
+      ranking.Submit(result.characterUid, result.courseTime);
+    });
+
+    ChangeBoard(LeagueBoardKey, [result, leaguePoints](Ranking& ranking)
+    {
+      ranking.Set(
+        result.characterUid,
+        ranking.GetScore(result.characterUid).value_or(0) + leaguePoints);
+    });
+  }
+}
+
+League RankingSystem::GetLeague(data::Uid characterUid)
+{
+  std::scoped_lock lock(_boardsMutex);
+
+  const auto percentile = GetBoard(LeagueBoardKey).ranking.GetPercentile(characterUid);
+  if (not percentile)
+  {
+    return League{
+      .type = League::Type::Bronze,
+      .rankingPercentile = 0};
+  }
+
+  League league{.rankingPercentile = *percentile};
+  if (*percentile >= PlatinumLeaguePercentile)
+    league.type = League::Type::Platinum;
+  else if (*percentile >= GoldLeaguePercentile)
+    league.type = League::Type::Gold;
+  else if (*percentile >= SilverLeaguePercentile)
+    league.type = League::Type::Silver;
+  else
+    league.type = League::Type::Bronze;
+
+  return league;
+}
+
+std::optional<uint32_t> RankingSystem::GetLeaguePoints(data::Uid characterUid)
+{
+  std::scoped_lock lock(_boardsMutex);
+  return GetBoard(LeagueBoardKey).ranking.GetScore(characterUid);
+}
+
+std::optional<uint32_t> RankingSystem::GetLeagueRank(data::Uid characterUid)
+{
+  std::scoped_lock lock(_boardsMutex);
+  return GetBoard(LeagueBoardKey).ranking.GetRank(characterUid);
+}
+
+std::optional<uint32_t> RankingSystem::GetCourseRank(
+  uint16_t mapBlockId,
+  uint8_t gameMode,
+  data::Uid characterUid)
+{
+  std::scoped_lock lock(_boardsMutex);
+  return GetBoard(GetCourseBoardKey(mapBlockId, gameMode)).ranking.GetRank(characterUid);
+}
+
+void RankingSystem::Tick()
+{
+  auto& leaderboardCache = _serverInstance.GetDataDirector().GetLeaderboardCache();
+
+  std::scoped_lock lock(_boardsMutex);
+
+  // The league leaderboard is loaded eagerly.
+  GetBoard(LeagueBoardKey);
+
+  // Load the requested leaderboards and apply the changes made in the meantime.
+  for (auto& [key, board] : _boards)
+  {
+    if (board.isLoaded)
+      continue;
+
+    const auto leaderboardRecord = leaderboardCache.Get(key);
+    if (not leaderboardRecord)
+      continue;
+
+    leaderboardRecord->Immutable([&board](const data::Leaderboard& leaderboard)
+    {
+      for (const auto& entry : leaderboard.entries())
+      {
+        board.ranking.Set(entry.characterUid, entry.score);
+      }
+    });
+
+    for (const auto& change : board.pendingChanges)
+    {
+      change(board.ranking);
+    }
+
+    board.isDirty = not board.pendingChanges.empty();
+    board.pendingChanges.clear();
+    board.isLoaded = true;
+  }
+
+  const auto now = Clock::now();
+  if (now < _nextFlushTime)
+    return;
+
+  _nextFlushTime = now + FlushInterval;
+
+  // Flush the changed leaderboards in one batch.
+  std::size_t flushedCount = 0;
+  for (auto& [key, board] : _boards)
+  {
+    if (not board.isLoaded || not board.isDirty)
+      continue;
+
+    const auto leaderboardRecord = leaderboardCache.Get(key, false);
+    if (not leaderboardRecord)
+      continue;
+
+    leaderboardRecord->Mutable([&board](data::Leaderboard& leaderboard)
+    {
+      std::vector<data::Leaderboard::Entry> entries;
+      entries.reserve(board.ranking.GetSize());
+      for (const auto& [characterUid, score] : board.ranking.GetScores())
+      {
+        entries.emplace_back(data::Leaderboard::Entry{
+          .characterUid = characterUid,
+          .score = score});
+      }
+
+      leaderboard.entries = std::move(entries);
+    });
+
+    leaderboardCache.Flush(key);
+    board.isDirty = false;
+    ++flushedCount;
+  }
+
+  if (flushedCount > 0)
+    spdlog::debug("Flushed {} leaderboards", flushedCount);
+}
+
+data::Uid RankingSystem::GetCourseBoardKey(uint16_t mapBlockId, uint8_t gameMode)
+{
+  // Course keys never collide with the league key.
+  return (1u << 24) | (static_cast<data::Uid>(mapBlockId) << 8) | gameMode;
+}
+
+RankingSystem::Board& RankingSystem::GetBoard(data::Uid key)
+{
+  const auto boardIter = _boards.find(key);
+  if (boardIter != _boards.end())
+    return boardIter->second;
+
+  auto ranking = key == LeagueBoardKey
+    ? Ranking(Ranking::Order::Descending, MaxLeaguePoints)
+    : Ranking(Ranking::Order::Ascending, MaxCourseTime, CourseTimeBucketSize);
+
+  return _boards.emplace(key, Board{.ranking = std::move(ranking)}).first->second;
+}
+
+void RankingSystem::ChangeBoard(data::Uid key, std::function<void(Ranking&)> change)
+{
+  auto& board = GetBoard(key);
+  if (not board.isLoaded)
+  {
+    board.pendingChanges.emplace_back(std::move(change));
+    return;
+  }
+
+  change(board.ranking);
+  board.isDirty = true;
+}
+
+} // namespace server
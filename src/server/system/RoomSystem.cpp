@@ -19,36 +19,151 @@
 
 #include "../../../include/server/system/RoomSystem.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <mutex>
 #include <stdexcept>
 
 namespace server
 {
 
-Room& RoomSystem::CreateRoom()
+Room RoomSystem::CreateRoom(const std::function<void(Room&)>& setup)
 {
+  std::scoped_lock lock(_roomsMutex);
+
   const auto [it, inserted] = _rooms.try_emplace(++_sequencedId);
   assert(inserted);
 
-  it->second.uid = _sequencedId;
+  auto& room = it->second;
+  setup(room);
+  room.uid = _sequencedId;
 
-  return it->second;
+  IndexRoom(room);
+
+  for (const auto& listener : _createListeners)
+    listener(room);
+
+  return room;
 }
 
-Room& RoomSystem::GetRoom(uint32_t uid)
+void RoomSystem::RestoreRoom(const Room& room)
 {
+  std::scoped_lock lock(_roomsMutex);
+
+  const auto [it, inserted] = _rooms.try_emplace(room.uid);
+  if (not inserted)
+    UnindexRoom(it->second);
+
+  it->second = room;
+  IndexRoom(room);
+
+  // The rooms created from now on must not take the UID of a restored room.
+  _sequencedId = std::max(_sequencedId, room.uid);
+}
+
+void RoomSystem::AddCreateListener(CreateListener listener)
+{
+  std::scoped_lock lock(_roomsMutex);
+  _createListeners.emplace_back(std::move(listener));
+}
+
+Room RoomSystem::GetRoom(uint32_t uid)
+{
+  std::shared_lock lock(_roomsMutex);
   const auto it = _rooms.find(uid);
   if (it == _rooms.end())
     throw std::runtime_error("room does not exist");
   return it->second;
 }
 
+void RoomSystem::UpdateRoom(uint32_t uid, const std::function<void(Room&)>& updater)
+{
+  std::scoped_lock lock(_roomsMutex);
+  const auto it = _rooms.find(uid);
+  if (it == _rooms.end())
+    throw std::runtime_error("room does not exist");
+
+  auto& room = it->second;
+  const auto indexKey = GetIndexKey(room.gameMode, room.teamMode);
+
+  updater(room);
+  room.uid = uid;
+
+  // Move the room in the index if its modes changed.
+  if (GetIndexKey(room.gameMode, room.teamMode) != indexKey)
+  {
+    auto& indexedUids = _roomIndex[indexKey];
+    std::erase(indexedUids, uid);
+    if (indexedUids.empty())
+      _roomIndex.erase(indexKey);
+
+    IndexRoom(room);
+  }
+}
+
 void RoomSystem::DeleteRoom(uint32_t uid)
 {
+  std::scoped_lock lock(_roomsMutex);
   const auto it = _rooms.find(uid);
   if (it == _rooms.end())
     throw std::runtime_error("room does not exist");
+
+  UnindexRoom(it->second);
   _rooms.erase(it);
 }
 
+std::vector<Room> RoomSystem::GetRoomPage(
+  uint8_t gameMode,
+  TeamMode teamMode,
+  std::size_t page)
+{
+  std::shared_lock lock(_roomsMutex);
+
+  const auto indexIter = _roomIndex.find(GetIndexKey(gameMode, teamMode));
+  if (indexIter == _roomIndex.cend())
+    return {};
+
+  const auto& indexedUids = indexIter->second;
+  const std::size_t pageBegin = std::min(page * RoomListPageSize, indexedUids.size());
+  const std::size_t pageEnd = std::min(pageBegin + RoomListPageSize, indexedUids.size());
+
+  std::vector<Room> rooms;
+  rooms.reserve(pageEnd - pageBegin);
+  for (std::size_t idx = pageBegin; idx < pageEnd; ++idx)
+  {
+    rooms.emplace_back(_rooms.at(indexedUids[idx]));
+  }
+
+  return rooms;
+}
+
+RoomSystem::IndexKey RoomSystem::GetIndexKey(uint8_t gameMode, TeamMode teamMode)
+{
+  return static_cast<IndexKey>(gameMode) << 8 | static_cast<uint8_t>(teamMode);
+}
+
+void RoomSystem::IndexRoom(const Room& room)
+{
+  auto& indexedUids = _roomIndex[GetIndexKey(room.gameMode, room.teamMode)];
+  // Keep the UIDs sorted, the room is most likely the newest one.
+  const auto position = std::upper_bound(indexedUids.cbegin(), indexedUids.cend(), room.uid);
+  indexedUids.insert(position, room.uid);
+}
+
+void RoomSystem::UnindexRoom(const Room& room)
+{
+  const auto indexKey = GetIndexKey(room.gameMode, room.teamMode);
+  const auto indexIter = _roomIndex.find(indexKey);
+  if (indexIter == _roomIndex.end())
+    return;
+
+  auto& indexedUids = indexIter->second;
+  const auto position = std::lower_bound(indexedUids.cbegin(), indexedUids.cend(), room.uid);
+  if (position != indexedUids.cend() && *position == room.uid)
+    indexedUids.erase(position);
+
+  if (indexedUids.empty())
+    _roomIndex.erase(indexIter);
+}
+
 } // namespace server
@@ -0,0 +1,170 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "server/system/ShopSystem.hpp"
+
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+
+#include <cstring>
+#include <format>
+#include <stdexcept>
+
+namespace server
+{
+
+namespace
+{
+
+//! Appends the text as an XML character data section.
+//! @param xml XML.
+//! @param text Text.
+void AppendCharacterData(std::string& xml, const std::string_view& text)
+{
+  constexpr std::string_view Terminator = "]]>";
+
+  xml += "<![CDATA[";
+
+  // The terminator cannot be a part of the section,
+  // split it between two sections.
+  std::size_t offset = 0;
+  for (auto position = text.find(Terminator);
+    position != std::string_view::npos;
+    position = text.find(Terminator, offset))
+  {
+    xml += text.substr(offset, position - offset);
+    xml += "]]]]><![CDATA[>";
+    offset = position + Terminator.size();
+  }
+
+  xml += text.substr(offset);
+  xml += "]]>";
+}
+
+//! Renders the catalogue XML of the goods.
+//! @param goods Goods.
+//! @returns Catalogue XML.
+std::string RenderCatalogue(const std::vector<registry::Goods>& goods)
+{
+  std::string xml = "<ShopList>\n";
+
+  for (const auto& entry : goods)
+  {
+    xml += "  <GoodsList>\n";
+    xml += std::format("    <GoodsSQ>{}</GoodsSQ>\n", entry.goodsSq);
+    xml += std::format("    <SetType>{}</SetType>\n", entry.setType);
+    xml += std::format("    <MoneyType>{}</MoneyType>\n", entry.moneyType);
+    xml += std::format("    <GoodsType>{}</GoodsType>\n", entry.goodsType);
+    xml += std::format("    <RecommendType>{}</RecommendType>\n", entry.recommendType);
+    xml += std::format("    <RecommendNO>{}</RecommendNO>\n", entry.recommendNo);
+    xml += std::format("    <GiftType>{}</GiftType>\n", entry.giftType);
+    xml += std::format("    <SalesRank>{}</SalesRank>\n", entry.salesRank);
+    xml += std::format("    <BonusGameMoney>{}</BonusGameMoney>\n", entry.bonusGameMoney);
+
+    xml += "    <GoodsNM>";
+    AppendCharacterData(xml, entry.name);
+    xml += "</GoodsNM>\n";
+    xml += "    <GoodsDesc>";
+    AppendCharacterData(xml, entry.description);
+    xml += "</GoodsDesc>\n";
+    xml += "    <ItemCapacityDesc>";
+    AppendCharacterData(xml, entry.capacityDescription);
+    xml += "</ItemCapacityDesc>\n";
+
+    xml += std::format("    <SellST>{}</SellST>\n", entry.sellState);
+    xml += std::format("    <ItemUID>{}</ItemUID>\n", entry.itemTid);
+
+    xml += "    <ItemElem>\n";
+    for (const auto& price : entry.prices)
+    {
+      xml += "      <Item>\n";
+      xml += std::format("        <PriceID>{}</PriceID>\n", price.priceId);
+      xml += std::format("        <PriceRange>{}</PriceRange>\n", price.priceRange);
+      xml += std::format("        <GoodsPrice>{}</GoodsPrice>\n", price.goodsPrice);
+      xml += "      </Item>\n";
+    }
+    xml += "    </ItemElem>\n";
+    xml += "  </GoodsList>\n";
+  }
+
+  xml += "</ShopList>\n";
+  return xml;
+}
+
+} // anon namespace
+
+void ShopSystem::CompileCatalogue(const std::vector<registry::Goods>& goods)
+{
+  const std::string xml = RenderCatalogue(goods);
+
+  std::vector<std::byte> compressedXml(compressBound(xml.size()));
+  uLongf compressedSize = compressedXml.size();
+  const auto result = compress(
+    reinterpret_cast<Bytef*>(compressedXml.data()),
+    &compressedSize,
+    reinterpret_cast<const Bytef*>(xml.data()),
+    xml.size());
+
+  if (result != Z_OK)
+    throw std::runtime_error(std::format("Failed to compress the shop catalogue: {}", result));
+
+  compressedXml.resize(compressedSize);
+
+  // The client is not known to accept the catalogue split between more commands.
+  if (compressedXml.size() > MaxDataSize)
+  {
+    throw std::runtime_error(std::format(
+      "The compressed shop catalogue of {} bytes exceeds {} bytes",
+      compressedXml.size(),
+      MaxDataSize));
+  }
+
+  auto catalogue = std::make_shared<Catalogue>();
+
+  std::scoped_lock lock(_catalogueMutex);
+
+  catalogue->version = ++_catalogueVersion;
+
+  const std::array<uint32_t, 3> signature{
+    static_cast<uint32_t>(crc32(
+      0,
+      reinterpret_cast<const Bytef*>(compressedXml.data()),
+      compressedXml.size())),
+    static_cast<uint32_t>(xml.size()),
+    static_cast<uint32_t>(compressedXml.size())};
+  static_assert(sizeof(signature) == sizeof(Catalogue::signature));
+  std::memcpy(catalogue->signature.data(), signature.data(), sizeof(signature));
+
+  catalogue->data = std::move(compressedXml);
+  _catalogue = std::move(catalogue);
+
+  spdlog::info(
+    "Shop catalogue version {} compiled, {} bytes compressed to {} bytes",
+    _catalogue->version,
+    xml.size(),
+    _catalogue->data.size());
+}
+
+std::shared_ptr<const ShopSystem::Catalogue> ShopSystem::GetCatalogue()
+{
+  std::scoped_lock lock(_catalogueMutex);
+  return _catalogue;
+}
+
+} // namespace server
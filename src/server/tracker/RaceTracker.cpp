@@ -19,65 +19,166 @@
 
 #include "server/tracker/RaceTracker.hpp"
 
+#include <stdexcept>
+
 namespace server::tracker
 {
 
 RaceTracker::Racer& RaceTracker::AddRacer(data::Uid characterUid)
 {
-  const auto [racerIter, created] = _racers.try_emplace(characterUid);
+  const auto [indexIter, created] = _racerIndices.try_emplace(
+    characterUid,
+    _racers.size());
   if (not created)
     throw std::runtime_error("Character is already a racer");
 
-  racerIter->second.oid = _nextObjectId++;
+  const Oid oid = _nextObjectId++;
+  if (_racerOidIndices.size() <= oid)
+    _racerOidIndices.resize(oid + 1, InvalidIndex);
+  _racerOidIndices[oid] = indexIter->second;
+
+  _kinematics.emplace_back();
+  _publishedKinematics.emplace_back();
+
+  auto& racer = _racers.emplace_back();
+  racer.oid = oid;
+  racer.characterUid = characterUid;
 
-  return racerIter->second;
+  return racer;
 }
 
 void RaceTracker::RemoveRacer(data::Uid characterUid)
 {
-  _racers.erase(characterUid);
+  const auto indexIter = _racerIndices.find(characterUid);
+  if (indexIter == _racerIndices.cend())
+    return;
+
+  const std::size_t index = indexIter->second;
+  const std::size_t lastIndex = _racers.size() - 1;
+
+  _racerOidIndices[_racers[index].oid] = InvalidIndex;
+  _racerIndices.erase(indexIter);
+
+  // Move the last racer in place of the removed one to keep the storage dense.
+  if (index != lastIndex)
+  {
+    _racers[index] = std::move(_racers[lastIndex]);
+    _kinematics[index] = _kinematics[lastIndex];
+    _publishedKinematics[index] = _publishedKinematics[lastIndex];
+
+    _racerIndices[_racers[index].characterUid] = index;
+    _racerOidIndices[_racers[index].oid] = index;
+  }
+
+  _racers.pop_back();
+  _kinematics.pop_back();
+  _publishedKinematics.pop_back();
+}
+
+bool RaceTracker::IsRacer(data::Uid characterUid) const
+{
+  return _racerIndices.contains(characterUid);
+}
+
+bool RaceTracker::IsRacerOid(Oid oid) const
+{
+  return oid < _racerOidIndices.size() && _racerOidIndices[oid] != InvalidIndex;
 }
 
 RaceTracker::Racer& RaceTracker::GetRacer(data::Uid characterUid)
 {
-  auto racerIter = _racers.find(characterUid);
-  if (racerIter == _racers.cend())
+  const auto indexIter = _racerIndices.find(characterUid);
+  if (indexIter == _racerIndices.cend())
     throw std::runtime_error("Character is not a racer");
 
-  return racerIter->second;
+  return _racers[indexIter->second];
 }
 
-RaceTracker::ObjectMap& RaceTracker::GetRacers()
+RaceTracker::Racer& RaceTracker::GetRacerByOid(Oid oid)
+{
+  if (not IsRacerOid(oid))
+    throw std::runtime_error("Object is not a racer");
+
+  return _racers[_racerOidIndices[oid]];
+}
+
+std::span<RaceTracker::Racer> RaceTracker::GetRacers()
 {
   return _racers;
 }
 
+RaceTracker::Kinematics& RaceTracker::GetKinematics(Oid oid)
+{
+  if (not IsRacerOid(oid))
+    throw std::runtime_error("Object is not a racer");
+
+  return _kinematics[_racerOidIndices[oid]];
+}
+
+std::span<RaceTracker::Kinematics> RaceTracker::GetKinematics()
+{
+  return _kinematics;
+}
+
+std::span<RaceTracker::Kinematics> RaceTracker::GetPublishedKinematics()
+{
+  return _publishedKinematics;
+}
+
 RaceTracker::Item& RaceTracker::AddItem()
 {
-  const auto [itemIter, created] = _items.try_emplace(_nextItemId);
-  if (not created)
+  const uint16_t itemId = _nextItemId++;
+  if (_itemIndices.size() <= itemId)
+    _itemIndices.resize(itemId + 1, InvalidIndex);
+  else if (_itemIndices[itemId] != InvalidIndex)
     throw std::runtime_error("Item is already added to the race map");
 
-  itemIter->second.itemId = _nextItemId++;
+  _itemIndices[itemId] = _items.size();
+
+  auto& item = _items.emplace_back();
+  item.itemId = itemId;
 
-  return itemIter->second;
+  return item;
 }
 
 void RaceTracker::RemoveItem(uint16_t itemId)
 {
-  _items.erase(itemId);
+  if (itemId >= _itemIndices.size() || _itemIndices[itemId] == InvalidIndex)
+    return;
+
+  const std::size_t index = _itemIndices[itemId];
+  const std::size_t lastIndex = _items.size() - 1;
+
+  _itemIndices[itemId] = InvalidIndex;
+
+  // Move the last item in place of the removed one to keep the storage dense.
+  if (index != lastIndex)
+  {
+    _items[index] = _items[lastIndex];
+    _itemIndices[_items[index].itemId] = index;
+  }
+
+  _items.pop_back();
+}
+
+void RaceTracker::ClearItems()
+{
+  _items.clear();
+  _itemIndices.clear();
+
+  // Start the item IDs over, so that the ID index does not grow across the races.
+  _nextItemId = 1;
 }
 
 RaceTracker::Item& RaceTracker::GetItem(uint16_t itemId)
 {
-  auto itemIter = _items.find(itemId);
-  if (itemIter == _items.cend())
+  if (itemId >= _itemIndices.size() || _itemIndices[itemId] == InvalidIndex)
     throw std::runtime_error("Item is not in the race map");
 
-  return itemIter->second;
+  return _items[_itemIndices[itemId]];
 }
 
-RaceTracker::ItemObjectMap& RaceTracker::GetItems()
+std::span<RaceTracker::Item> RaceTracker::GetItems()
 {
   return _items;
 }
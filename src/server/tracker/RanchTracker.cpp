@@ -19,6 +19,9 @@
 
 #include "server/tracker/RanchTracker.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace server::tracker
 {
 
@@ -30,7 +33,12 @@ Oid RanchTracker::AddCharacter(data::Uid character)
 
 void RanchTracker::RemoveCharacter(data::Uid character)
 {
-  _characters.erase(character);
+  const auto itr = _characters.find(character);
+  if (itr == _characters.cend())
+    return;
+
+  RemovePosition(itr->second);
+  _characters.erase(itr);
 }
 
 Oid RanchTracker::GetCharacterOid(data::Uid character) const
@@ -49,7 +57,12 @@ Oid RanchTracker::AddHorse(data::Uid horse)
 
 void RanchTracker::RemoveHorse(data::Uid horse)
 {
-  _horses.erase(horse);
+  const auto itr = _horses.find(horse);
+  if (itr == _horses.cend())
+    return;
+
+  RemovePosition(itr->second);
+  _horses.erase(itr);
 }
 
 Oid RanchTracker::GetHorseOid(data::Uid horse) const
@@ -60,6 +73,83 @@ Oid RanchTracker::GetHorseOid(data::Uid horse) const
   return itr->second;
 }
 
+void RanchTracker::SetPosition(Oid oid, const Position& position)
+{
+  const auto cell = GetCellKey(
+    GetCellCoordinate(position[0]),
+    GetCellCoordinate(position[2]));
+
+  const auto [itr, inserted] = _positionedObjects.try_emplace(oid);
+  auto& positionedObject = itr->second;
+  positionedObject.position = position;
+
+  // Move the object between the cells only when it leaves its cell.
+  if (not inserted)
+  {
+    if (positionedObject.cell == cell)
+      return;
+
+    std::erase(_cells[positionedObject.cell], oid);
+    if (_cells[positionedObject.cell].empty())
+      _cells.erase(positionedObject.cell);
+  }
+
+  positionedObject.cell = cell;
+  _cells[cell].emplace_back(oid);
+}
+
+std::optional<RanchTracker::Position> RanchTracker::GetPosition(Oid oid) const
+{
+  const auto itr = _positionedObjects.find(oid);
+  if (itr == _positionedObjects.cend())
+    return std::nullopt;
+  return itr->second.position;
+}
+
+std::vector<Oid> RanchTracker::GetObjectsInRadius(
+  const Position& center,
+  float radius) const
+{
+  std::vector<Oid> objects;
+
+  const float radiusSquared = radius * radius;
+  const auto isInRadius = [&center, radiusSquared](const Position& position)
+  {
+    float distanceSquared = 0.0f;
+    for (std::size_t idx = 0; idx < position.size(); ++idx)
+    {
+      const float delta = position[idx] - center[idx];
+      distanceSquared += delta * delta;
+    }
+
+    return distanceSquared <= radiusSquared;
+  };
+
+  // Visit only the cells overlapping the ground bounding box of the radius.
+  const int32_t minX = GetCellCoordinate(center[0] - radius);
+  const int32_t maxX = GetCellCoordinate(center[0] + radius);
+  const int32_t minZ = GetCellCoordinate(center[2] - radius);
+  const int32_t maxZ = GetCellCoordinate(center[2] + radius);
+
+  for (int32_t x = minX; x <= maxX; ++x)
+  {
+    for (int32_t z = minZ; z <= maxZ; ++z)
+    {
+      const auto cellItr = _cells.find(GetCellKey(x, z));
+      if (cellItr == _cells.cend())
+        continue;
+
+      for (const Oid oid : cellItr->second)
+      {
+        if (isInRadius(_positionedObjects.at(oid).position))
+          objects.emplace_back(oid);
+      }
+    }
+  }
+
+  return objects;
+}
+
 const RanchTracker::ObjectMap& RanchTracker::GetCharacters() const
 {
   return _characters;
@@ -70,4 +160,34 @@ const RanchTracker::ObjectMap& RanchTracker::GetHorses() const
   return _horses;
 }
 
+RanchTracker::CellKey RanchTracker::GetCellKey(int32_t x, int32_t z)
+{
+  return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32
+    | static_cast<uint64_t>(static_cast<uint32_t>(z));
+}
+
+int32_t RanchTracker::GetCellCoordinate(float coordinate)
+{
+  // Coordinates beyond the range of the grid share the border cells.
+  constexpr float MaxCellCoordinate = 1'000'000.0f;
+  return static_cast<int32_t>(std::clamp(
+    std::floor(coordinate / CellSize),
+    -MaxCellCoordinate,
+    MaxCellCoordinate));
+}
+
+void RanchTracker::RemovePosition(Oid oid)
+{
+  const auto itr = _positionedObjects.find(oid);
+  if (itr == _positionedObjects.cend())
+    return;
+
+  auto& cell = _cells[itr->second.cell];
+  std::erase(cell, oid);
+  if (cell.empty())
+    _cells.erase(itr->second.cell);
+
+  _positionedObjects.erase(itr);
+}
+
 } // namespace server::tracker
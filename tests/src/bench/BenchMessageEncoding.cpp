@@ -0,0 +1,125 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/network/command/proto/LobbyMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RaceMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RanchMessageDefinitions.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+//! Count of the encodings of a message.
+constexpr std::size_t EncodeCount = 100'000;
+
+//! Measures the average duration of an encoding of a message.
+//! @param message Message to encode.
+//! @returns Average duration of an encoding in nanoseconds.
+template <typename Message>
+double MeasureEncoding(const Message& message)
+{
+  static std::array<std::byte, 16384> buffer{};
+
+  const auto begin = std::chrono::steady_clock::now();
+  for (std::size_t encodeIdx = 0; encodeIdx < EncodeCount; ++encodeIdx)
+  {
+    server::SinkStream sink(buffer);
+    Message::Write(message, sink);
+  }
+  const auto duration = std::chrono::steady_clock::now() - begin;
+
+  return std::chrono::duration<double, std::nano>(duration).count()
+    / static_cast<double>(EncodeCount);
+}
+
+//! Creates a login response of a character.
+//! @param name Name of the character.
+//! @returns Login response.
+server::protocol::LobbyCommandLoginOK CreateLoginOK(const std::string& name)
+{
+  return server::protocol::LobbyCommandLoginOK{
+    .name = name,
+    .motd = "Welcome to Story of Alicia!",
+    .introduction = name + "'s introduction"};
+}
+
+//! Creates a ranch entry response with characters and horses.
+//! @param name Name of the characters and horses.
+//! @returns Ranch entry response.
+server::protocol::AcCmdCREnterRanchOK CreateEnterRanchOK(const std::string& name)
+{
+  server::protocol::AcCmdCREnterRanchOK response{
+    .rancherUid = 1,
+    .rancherName = name,
+    .ranchName = name + "'s ranch"};
+
+  // The max counts of the characters and the horses in a ranch.
+  for (uint32_t idx = 0; idx < 20; ++idx)
+  {
+    auto& character = response.characters.emplace_back();
+    character.uid = idx;
+    character.name = name;
+    character.introduction = name + "'s introduction";
+    character.mount.name = name + "'s horse";
+  }
+
+  for (uint16_t idx = 0; idx < 10; ++idx)
+  {
+    auto& horse = response.horses.emplace_back();
+    horse.horseOid = idx;
+    horse.horse.name = name + "'s horse";
+  }
+
+  return response;
+}
+
+} // namespace
+
+int main()
+{
+  // Names in UTF-8, the Korean one converts to EUC-KR.
+  const std::array<std::pair<const char*, std::string>, 2> names{{
+    {"ascii", "rgnter"},
+    {"korean", "\xea\xb5\xac\xeb\xa6\x84"}}};
+
+  std::printf("%-10s %-20s %-20s\n", "names", "login ns/msg", "enter ranch ns/msg");
+
+  for (const auto& [label, name] : names)
+  {
+    const auto loginDuration = MeasureEncoding(CreateLoginOK(name));
+    const auto enterRanchDuration = MeasureEncoding(CreateEnterRanchOK(name));
+
+    std::printf(
+      "%-10s %-20.1f %-20.1f\n",
+      label,
+      loginDuration,
+      enterRanchDuration);
+  }
+
+  const server::protocol::AcCmdUserRaceUpdatePos updatePos{
+    .oid = 1,
+    .member2 = {1.0f, 2.0f, 3.0f},
+    .member3 = {0.0f, 1.0f, 0.0f},
+    .member4 = 10.0f};
+  std::printf("\n%-20s %-20.1f\n", "race pos ns/msg", MeasureEncoding(updatePos));
+}
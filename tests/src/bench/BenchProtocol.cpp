@@ -0,0 +1,687 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/network/chatter/proto/ChatterMessageDefinitions.hpp>
+#include <libserver/network/command/CommandServer.hpp>
+#include <libserver/network/command/proto/LobbyMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RaceMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RanchMessageDefinitions.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+namespace protocol = server::protocol;
+
+//! Count of the iterations of a measurement.
+constexpr std::size_t IterationCount = 20'000;
+
+//! Size of the buffers the messages are encoded to.
+constexpr std::size_t BufferSize = 16384;
+
+//! A list of the message types.
+template <typename... Messages>
+struct MessageList
+{
+};
+
+using LobbyMessages = MessageList<
+  protocol::LobbyCommandLogin,
+  protocol::LobbyCommandLoginOK,
+  protocol::LobbyCommandLoginCancel,
+  protocol::LobbyCommandShowInventory,
+  protocol::LobbyCommandShowInventoryOK,
+  protocol::LobbyCommandShowInventoryCancel,
+  protocol::LobbyCommandCreateNicknameNotify,
+  protocol::LobbyCommandCreateNickname,
+  protocol::LobbyCommandCreateNicknameCancel,
+  protocol::LobbyCommandRequestLeagueInfo,
+  protocol::LobbyCommandRequestLeagueInfoOK,
+  protocol::LobbyCommandRequestLeagueInfoCancel,
+  protocol::LobbyCommandAchievementCompleteList,
+  protocol::LobbyCommandAchievementCompleteListOK,
+  protocol::LobbyCommandEnterChannel,
+  protocol::LobbyCommandEnterChannelOK,
+  protocol::LobbyCommandEnterChannelCancel,
+  protocol::LobbyCommandRoomList,
+  protocol::LobbyCommandRoomListOK,
+  protocol::LobbyCommandMakeRoom,
+  protocol::LobbyCommandMakeRoomOK,
+  protocol::LobbyCommandMakeRoomCancel,
+  protocol::LobbyCommandEnterRoom,
+  protocol::LobbyCommandEnterRoomOK,
+  protocol::LobbyCommandEnterRoomCancel,
+  protocol::LobbyCommandRequestQuestList,
+  protocol::LobbyCommandRequestQuestListOK,
+  protocol::LobbyCommandRequestDailyQuestList,
+  protocol::LobbyCommandRequestDailyQuestListOK,
+  protocol::LobbyCommandEnterRanch,
+  protocol::LobbyCommandEnterRanchOK,
+  protocol::LobbyCommandEnterRanchCancel,
+  protocol::LobbyCommandGetMessengerInfo,
+  protocol::LobbyCommandGetMessengerInfoOK,
+  protocol::LobbyCommandGetMessengerInfoCancel,
+  protocol::LobbyCommandRequestSpecialEventList,
+  protocol::LobbyCommandRequestSpecialEventListOK,
+  protocol::AcCmdCLHeartbeat,
+  protocol::AcCmdCLGoodsShopList,
+  protocol::AcCmdCLGoodsShopListOK,
+  protocol::AcCmdCLGoodsShopListCancel,
+  protocol::AcCmdLCGoodsShopListData,
+  protocol::AcCmdCLInquiryTreecash,
+  protocol::LobbyCommandInquiryTreecashOK,
+  protocol::LobbyCommandInquiryTreecashCancel,
+  protocol::LobbyCommandClientNotify,
+  protocol::LobbyCommandGuildPartyList,
+  protocol::LobbyCommandGuildPartyListOK,
+  protocol::LobbyCommandEnterRandomRanch,
+  protocol::LobbyCommandRequestPersonalInfo,
+  protocol::LobbyCommandPersonalInfo,
+  protocol::LobbyCommandSetIntroduction,
+  protocol::LobbyCommandUpdateSystemContent,
+  protocol::LobbyCommandUpdateSystemContentNotify,
+  protocol::LobbyCommandChangeRanchOption,
+  protocol::LobbyCommandChangeRanchOptionOK,
+  protocol::AcCmdLCOpKick,
+  protocol::AcCmdLCOpMute,
+  protocol::AcCmdLCNotice,
+  protocol::AcCmdCLRequestMountInfoOK>;
+
+using RanchMessages = MessageList<
+  protocol::RanchCommandHeartbeat,
+  protocol::AcCmdCREnterRanch,
+  protocol::AcCmdCREnterRanchOK,
+  protocol::RanchCommandEnterRanchCancel,
+  protocol::RanchCommandEnterRanchNotify,
+  protocol::AcCmdCRLeaveRanch,
+  protocol::AcCmdCRLeaveRanchOK,
+  protocol::AcCmdCRLeaveRanchNotify,
+  protocol::AcCmdCRRanchChat,
+  protocol::AcCmdCRRanchChatNotify,
+  protocol::AcCmdCRRanchSnapshot,
+  protocol::RanchCommandRanchSnapshotNotify,
+  protocol::AcCmdCREnterBreedingMarket,
+  protocol::RanchCommandEnterBreedingMarketOK,
+  protocol::RanchCommandEnterBreedingMarketCancel,
+  protocol::RanchCommandLeaveBreedingMarket,
+  protocol::AcCmdCRSearchStallion,
+  protocol::RanchCommandSearchStallionOK,
+  protocol::RanchCommandSearchStallionCancel,
+  protocol::AcCmdCRRegisterStallion,
+  protocol::AcCmdCRRegisterStallionOK,
+  protocol::RanchCommandRegisterStallionCancel,
+  protocol::AcCmdCRUnregisterStallion,
+  protocol::AcCmdCRUnregisterStallionOK,
+  protocol::RanchCommandUnregisterStallionCancel,
+  protocol::AcCmdCRUnregisterStallionEstimateInfo,
+  protocol::AcCmdCRUnregisterStallionEstimateInfoOK,
+  protocol::AcCmdCRUnregisterStallionEstimateInfoCancel,
+  protocol::AcCmdCRUpdateEquipmentNotify,
+  protocol::AcCmdCRRecoverMount,
+  protocol::AcCmdCRRecoverMountOK,
+  protocol::AcCmdCRRecoverMountCancel,
+  protocol::AcCmdCRStatusPointApply,
+  protocol::AcCmdCRStatusPointApplyOK,
+  protocol::AcCmdCRStatusPointApplyCancel,
+  protocol::AcCmdCRTryBreeding,
+  protocol::RanchCommandTryBreedingOK,
+  protocol::RanchCommandTryBreedingCancel,
+  protocol::AcCmdCRBreedingAbandon,
+  protocol::RanchCommandBreedingAbandonOK,
+  protocol::RanchCommandBreedingAbandonCancel,
+  protocol::RanchCommandAchievementUpdateProperty,
+  protocol::RanchCommandBreedingWishlist,
+  protocol::RanchCommandBreedingWishlistOK,
+  protocol::RanchCommandBreedingWishlistCancel,
+  protocol::AcCmdCRRanchCmdAction,
+  protocol::RanchCommandRanchCmdActionNotify,
+  protocol::RanchCommandRanchStuff,
+  protocol::RanchCommandRanchStuffOK,
+  protocol::RanchCommandUpdateBusyState,
+  protocol::RanchCommandUpdateBusyStateNotify,
+  protocol::RanchCommandUpdateMountNickname,
+  protocol::RanchCommandUpdateMountNicknameOK,
+  protocol::RanchCommandUpdateMountNicknameCancel,
+  protocol::AcCmdRCUpdateMountInfoNotify,
+  protocol::AcCmdCRRequestStorage,
+  protocol::AcCmdCRRequestStorageOK,
+  protocol::AcCmdCRRequestStorageCancel,
+  protocol::AcCmdCRGetItemFromStorage,
+  protocol::AcCmdCRGetItemFromStorageOK,
+  protocol::AcCmdCRGetItemFromStorageCancel,
+  protocol::RanchCommandRequestNpcDressList,
+  protocol::RanchCommandRequestNpcDressListOK,
+  protocol::RanchCommandRequestNpcDressListCancel,
+  protocol::AcCmdCRWearEquipment,
+  protocol::AcCmdCRWearEquipmentOK,
+  protocol::AcCmdCRWearEquipmentCancel,
+  protocol::AcCmdCRRemoveEquipment,
+  protocol::AcCmdCRRemoveEquipmentOK,
+  protocol::AcCmdCRRemoveEquipmentCancel,
+  protocol::RanchCommandSetIntroductionNotify,
+  protocol::RanchCommandCreateGuild,
+  protocol::RanchCommandCreateGuildOK,
+  protocol::RanchCommandCreateGuildCancel,
+  protocol::RanchCommandRequestGuildInfo,
+  protocol::RanchCommandRequestGuildInfoOK,
+  protocol::RanchCommandRequestGuildInfoCancel,
+  protocol::AcCmdCRWithdrawGuildMember,
+  protocol::AcCmdCRWithdrawGuildMemberOK,
+  protocol::AcCmdCRWithdrawGuildMemberCancel,
+  protocol::AcCmdCRUpdatePet,
+  protocol::AcCmdRCUpdatePet,
+  protocol::AcCmdRCUpdatePetCancel,
+  protocol::AcCmdCRRequestPetBirth,
+  protocol::AcCmdCRRequestPetBirthOK,
+  protocol::AcCmdCRRequestPetBirthNotify,
+  protocol::AcCmdCRRequestPetBirthCancel,
+  protocol::RanchCommandPetBirthNotify,
+  protocol::AcCmdCRIncubateEgg,
+  protocol::AcCmdCRIncubateEggOK,
+  protocol::AcCmdCRIncubateEggNotify,
+  protocol::AcCmdCRIncubateEggCancel,
+  protocol::AcCmdCRBoostIncubateInfoList,
+  protocol::AcCmdCRBoostIncubateInfoListOK,
+  protocol::AcCmdCRBoostIncubateEgg,
+  protocol::AcCmdCRBoostIncubateEggOK,
+  protocol::RanchCommandUserPetInfos,
+  protocol::RanchCommandUserPetInfosOK,
+  protocol::AcCmdCRHousingBuild,
+  protocol::AcCmdCRHousingBuildOK,
+  protocol::AcCmdCRHousingBuildCancel,
+  protocol::AcCmdCRHousingBuildNotify,
+  protocol::AcCmdCRHousingRepair,
+  protocol::AcCmdCRHousingRepairOK,
+  protocol::AcCmdCRHousingRepairCancel,
+  protocol::AcCmdCRHousingRepairNotify,
+  protocol::AcCmdRCMissionEvent,
+  protocol::RanchCommandKickRanch,
+  protocol::RanchCommandKickRanchOK,
+  protocol::RanchCommandKickRanchCancel,
+  protocol::RanchCommandKickRanchNotify,
+  protocol::RanchCommandOpCmd,
+  protocol::RanchCommandOpCmdOK,
+  protocol::RanchCommandRequestLeagueTeamList,
+  protocol::RanchCommandRequestLeagueTeamListOK,
+  protocol::RanchCommandRequestLeagueTeamListCancel,
+  protocol::AcCmdCRUseItem,
+  protocol::AcCmdCRUseItemOK,
+  protocol::AcCmdCRUseItemCancel,
+  protocol::RanchCommandMountFamilyTree,
+  protocol::RanchCommandMountFamilyTreeOK,
+  protocol::RanchCommandMountFamilyTreeCancel,
+  protocol::AcCmdCRCheckStorageItem,
+  protocol::AcCmdCRChangeAgeCancel,
+  protocol::AcCmdCRChangeAge,
+  protocol::AcCmdCRChangeAgeOK,
+  protocol::AcCmdRCChangeAgeNotify,
+  protocol::AcCmdCRHideAge,
+  protocol::AcCmdCRHideAgeCancel,
+  protocol::AcCmdCRHideAgeOK,
+  protocol::AcCmdRCHideAgeNotify>;
+
+using RaceMessages = MessageList<
+  protocol::AcCmdCREnterRoom,
+  protocol::AcCmdCREnterRoomOK,
+  protocol::AcCmdCREnterRoomCancel,
+  protocol::AcCmdCREnterRoomNotify,
+  protocol::AcCmdCRChangeRoomOptions,
+  protocol::AcCmdCRChangeRoomOptionsNotify,
+  protocol::AcCmdCRChangeTeam,
+  protocol::AcCmdCRChangeTeamOK,
+  protocol::AcCmdCRChangeTeamNotify,
+  protocol::AcCmdCRLeaveRoom,
+  protocol::AcCmdCRLeaveRoomOK,
+  protocol::AcCmdCRLeaveRoomNotify,
+  protocol::AcCmdCRStartRace,
+  protocol::AcCmdCRStartRaceNotify,
+  protocol::AcCmdCRStartRaceCancel,
+  protocol::AcCmdUserRaceTimer,
+  protocol::AcCmdUserRaceTimerOK,
+  protocol::AcCmdCRLoadingComplete,
+  protocol::AcCmdCRLoadingCompleteNotify,
+  protocol::AcCmdCRChat,
+  protocol::AcCmdCRChatNotify,
+  protocol::AcCmdCRReadyRace,
+  protocol::AcCmdCRReadyRaceNotify,
+  protocol::AcCmdUserRaceCountdown,
+  protocol::AcCmdUserRaceFinal,
+  protocol::AcCmdUserRaceFinalNotify,
+  protocol::AcCmdCRRaceResult,
+  protocol::AcCmdCRRaceResultOK,
+  protocol::AcCmdRCRaceResultNotify,
+  protocol::AcCmdCRP2PResult,
+  protocol::AcCmdUserRaceP2PResult,
+  protocol::AcCmdGameRaceP2PResult,
+  protocol::AcCmdCRAwardStart,
+  protocol::AcCmdCRAwardEnd,
+  protocol::AcCmdRCAwardNotify,
+  protocol::AcCmdCRAwardEndNotify,
+  protocol::AcCmdCRStarPointGet,
+  protocol::AcCmdCRStarPointGetOK,
+  protocol::AcCmdCRRequestSpur,
+  protocol::AcCmdCRRequestSpurOK,
+  protocol::AcCmdCRHurdleClearResult,
+  protocol::AcCmdCRHurdleClearResultOK,
+  protocol::AcCmdCRStartingRate,
+  protocol::AcCmdCRRequestMagicItem,
+  protocol::AcCmdCRRequestMagicItemOK,
+  protocol::AcCmdCRRequestMagicItemNotify,
+  protocol::AcCmdUserRaceUpdatePos,
+  protocol::AcCmdRCRoomCountdown,
+  protocol::AcCmdRCRoomCountdownCancel,
+  protocol::AcCmdCRChangeMasterNotify,
+  protocol::AcCmdCRRelayCommand,
+  protocol::AcCmdCRRelayCommandNotify,
+  protocol::AcCmdCRRelay,
+  protocol::AcCmdCRRelayNotify,
+  protocol::AcCmdRCTeamSpurGauge,
+  protocol::AcCmdUserRaceActivateInteractiveEvent,
+  protocol::AcCmdUserRaceActivateEvent,
+  protocol::AcCmdCRUseMagicItem,
+  protocol::AcCmdCRUseMagicItemCancel,
+  protocol::AcCmdCRUseMagicItemOK,
+  protocol::AcCmdCRUseMagicItemNotify,
+  protocol::AcCmdGameRaceItemSpawn,
+  protocol::AcCmdUserRaceItemGet,
+  protocol::AcCmdGameRaceItemGet,
+  protocol::AcCmdCRStartMagicTarget,
+  protocol::AcCmdCRChangeMagicTargetNotify,
+  protocol::AcCmdCRChangeMagicTargetOK,
+  protocol::AcCmdCRChangeMagicTargetCancel,
+  protocol::AcCmdRCRemoveMagicTarget,
+  protocol::AcCmdRCMagicExpire,
+  protocol::AcCmdRCTriggerActivate,
+  protocol::AcCmdCRActivateSkillEffect,
+  protocol::AcCmdRCAddSkillEffect>;
+
+using ChatterMessages = MessageList<
+  protocol::ChatCmdLogin,
+  protocol::ChatCmdLoginAckOK,
+  protocol::ChatCmdLoginAckCancel>;
+
+//! Prevents the compiler from discarding the result of a measured operation.
+volatile uint64_t sink = 0;
+
+//! Measures the average duration of an operation.
+//! @param operation Operation to measure.
+//! @returns Average duration of the operation in nanoseconds.
+template <typename Operation>
+double Measure(Operation&& operation)
+{
+  const auto begin = std::chrono::steady_clock::now();
+  for (std::size_t iterationIdx = 0; iterationIdx < IterationCount; ++iterationIdx)
+  {
+    operation(iterationIdx);
+  }
+  const auto duration = std::chrono::steady_clock::now() - begin;
+
+  return std::chrono::duration<double, std::nano>(duration).count()
+    / static_cast<double>(IterationCount);
+}
+
+std::string_view GetMessageName(protocol::Command command)
+{
+  return protocol::GetCommandName(command);
+}
+
+std::string_view GetMessageName(protocol::ChatterCommand command)
+{
+  switch (command)
+  {
+    case protocol::ChatterCommand::ChatCmdLogin:
+      return "ChatCmdLogin";
+    case protocol::ChatterCommand::ChatCmdLoginAckOK:
+      return "ChatCmdLoginAckOK";
+    case protocol::ChatterCommand::ChatCmdLoginAckCancel:
+      return "ChatCmdLoginAckCancel";
+  }
+
+  return "Unknown";
+}
+
+//! Creates a login response.
+//! @returns Login response.
+protocol::LobbyCommandLoginOK CreateLoginOK()
+{
+  return protocol::LobbyCommandLoginOK{
+    .name = "rgnter",
+    .motd = "Welcome to Story of Alicia!",
+    .introduction = "rgnter's introduction"};
+}
+
+//! Creates a ranch entry response with the max counts of characters and horses.
+//! @returns Ranch entry response.
+protocol::AcCmdCREnterRanchOK CreateEnterRanchOK()
+{
+  protocol::AcCmdCREnterRanchOK response{
+    .rancherUid = 1,
+    .rancherName = "rgnter",
+    .ranchName = "rgnter's ranch"};
+
+  for (uint32_t idx = 0; idx < 20; ++idx)
+  {
+    auto& character = response.characters.emplace_back();
+    character.uid = idx;
+    character.name = "rgnter";
+    character.introduction = "rgnter's introduction";
+    character.mount.name = "rgnter's horse";
+  }
+
+  for (uint16_t idx = 0; idx < 10; ++idx)
+  {
+    auto& horse = response.horses.emplace_back();
+    horse.horseOid = idx;
+    horse.horse.name = "rgnter's horse";
+  }
+
+  return response;
+}
+
+//! Creates a ranch chat message.
+//! @returns Ranch chat message.
+protocol::AcCmdCRRanchChat CreateRanchChat()
+{
+  return protocol::AcCmdCRRanchChat{
+    .message = "Has anyone seen my horse?"};
+}
+
+//! Creates a race position update.
+//! @returns Race position update.
+protocol::AcCmdUserRaceUpdatePos CreateUpdatePos()
+{
+  return protocol::AcCmdUserRaceUpdatePos{
+    .oid = 1,
+    .member2 = {1.0f, 2.0f, 3.0f},
+    .member3 = {0.0f, 1.0f, 0.0f},
+    .member4 = 10.0f};
+}
+
+//! Creates a sample of a message.
+//! Messages without a representative sample are default constructed.
+//! @returns Sample of the message.
+template <typename Message>
+Message CreateSample()
+{
+  if constexpr (std::same_as<Message, protocol::LobbyCommandLoginOK>)
+    return CreateLoginOK();
+  else if constexpr (std::same_as<Message, protocol::AcCmdCREnterRanchOK>)
+    return CreateEnterRanchOK();
+  else if constexpr (std::same_as<Message, protocol::AcCmdCRRanchChat>)
+    return CreateRanchChat();
+  else if constexpr (std::same_as<Message, protocol::AcCmdUserRaceUpdatePos>)
+    return CreateUpdatePos();
+  else
+    return Message{};
+}
+
+//! Measures the encoding and the decoding of a message.
+//! Operations which are not implemented by the message are reported as null.
+//! @returns Results of the message.
+template <typename Message>
+nlohmann::json MeasureMessage()
+{
+  nlohmann::json result{
+    {"name", GetMessageName(Message{}.GetCommand())},
+    {"size", nullptr},
+    {"encodeNs", nullptr},
+    {"decodeNs", nullptr}};
+
+  constexpr bool IsWritable = requires(const Message& message, server::SinkStream& stream)
+  {
+    Message::Write(message, stream);
+  };
+  constexpr bool IsReadable = requires(Message& message, server::SourceStream& stream)
+  {
+    Message::Read(message, stream);
+  };
+
+  static std::array<std::byte, BufferSize> buffer{};
+  std::size_t size = 0;
+
+  try
+  {
+    if constexpr (IsWritable)
+    {
+      const auto sample = CreateSample<Message>();
+
+      server::SinkStream sampleSink(buffer);
+      Message::Write(sample, sampleSink);
+      size = sampleSink.GetCursor();
+      result["size"] = size;
+
+      result["encodeNs"] = Measure([&sample](std::size_t)
+      {
+        server::SinkStream sink(buffer);
+        Message::Write(sample, sink);
+      });
+    }
+  }
+  catch (const std::exception& x)
+  {
+    result["encodeError"] = x.what();
+  }
+
+  try
+  {
+    // Decode the encoded sample, or an empty message if the message can't be encoded.
+    if constexpr (IsReadable)
+    {
+      result["decodeNs"] = Measure([size](std::size_t)
+      {
+        Message message;
+        server::SourceStream source(std::span(buffer.data(), size));
+        Message::Read(message, source);
+        sink = sink + source.GetCursor();
+      });
+    }
+  }
+  catch (const std::exception& x)
+  {
+    result["decodeError"] = x.what();
+  }
+
+  return result;
+}
+
+//! Measures the encoding and the decoding of every message in the list.
+//! @returns Results of the messages.
+template <typename... Messages>
+nlohmann::json MeasureMessages(MessageList<Messages...>)
+{
+  nlohmann::json results = nlohmann::json::array();
+  (results.emplace_back(MeasureMessage<Messages>()), ...);
+  return results;
+}
+
+//! Measures the encoding and the decoding of the message magic.
+//! @returns Results of the message magic.
+nlohmann::json MeasureMagic()
+{
+  const auto encodeNs = Measure([](std::size_t iterationIdx)
+  {
+    sink = sink + protocol::encode_message_magic({
+      .id = static_cast<uint16_t>(iterationIdx % 0x1000),
+      .length = static_cast<uint16_t>(iterationIdx % 0x1000)});
+  });
+
+  const auto decodeNs = Measure([](std::size_t iterationIdx)
+  {
+    const auto magic = protocol::decode_message_magic(
+      static_cast<uint32_t>(iterationIdx * 0x9E3779B9));
+    sink = sink + magic.id + magic.length;
+  });
+
+  return {
+    {"encodeNs", encodeNs},
+    {"decodeNs", decodeNs}};
+}
+
+//! Measures the XOR scrambling of a command of the max size.
+//! @returns Results of the XOR scrambling.
+nlohmann::json MeasureXor()
+{
+  std::vector<std::byte> data(4092);
+  const protocol::XorCode code{
+    std::byte{0xCB}, std::byte{0x91}, std::byte{0x01}, std::byte{0xA2}};
+
+  const auto scrambleNs = Measure([&data, &code](std::size_t)
+  {
+    protocol::ApplyXorCode(code, data);
+  });
+  sink = sink + static_cast<uint64_t>(data.front());
+
+  return {
+    {"size", data.size()},
+    {"scrambleNs", scrambleNs},
+    {"megabytesPerSecond", static_cast<double>(data.size()) * 1'000.0 / scrambleNs}};
+}
+
+//! Command server events which are ignored.
+class NullEventHandler final
+  : public server::CommandServer::EventHandlerInterface
+{
+public:
+  void HandleClientConnected(server::ClientId) override {}
+  void HandleClientDisconnected(server::ClientId) override {}
+};
+
+//! Writes a command the way a client does, scrambled with the rolling code of the client.
+//! @param client Client sending the command.
+//! @param message Message of the command.
+//! @param data Data the command is appended to.
+template <typename Message>
+void WriteClientCommand(
+  server::CommandClient& client,
+  const Message& message,
+  std::vector<std::byte>& data)
+{
+  std::array<std::byte, BufferSize> buffer{};
+  server::SinkStream commandSink(buffer);
+  Message::Write(message, commandSink);
+
+  client.RollCode();
+  const auto padding = static_cast<uint32_t>(client.GetRollingCodeInt()) & 7;
+  const auto commandDataSize = commandSink.GetCursor() + padding;
+
+  protocol::ApplyXorCode(
+    client.GetRollingCode(),
+    std::span(buffer.data(), commandDataSize));
+
+  const uint32_t magic = protocol::encode_message_magic({
+    .id = static_cast<uint16_t>(Message::GetCommand()),
+    .length = static_cast<uint16_t>(sizeof(uint32_t) + commandDataSize)});
+
+  const auto offset = data.size();
+  data.resize(offset + sizeof(magic) + commandDataSize);
+  std::memcpy(data.data() + offset, &magic, sizeof(magic));
+  std::memcpy(data.data() + offset + sizeof(magic), buffer.data(), commandDataSize);
+}
+
+//! Measures the full framing of a message by the command server,
+//! that is the magic, the scrambling, the padding and the dispatch to the handler.
+//! @returns Results of the framing of the message.
+template <typename Message>
+nlohmann::json MeasureFraming()
+{
+  constexpr server::ClientId ClientId = 1;
+  constexpr std::size_t CommandCount = 1'000;
+  const protocol::XorCode code{
+    std::byte{0xCB}, std::byte{0x91}, std::byte{0x01}, std::byte{0xA2}};
+
+  NullEventHandler eventHandler;
+  server::CommandServer commandServer(eventHandler);
+
+  std::size_t handledCount = 0;
+  commandServer.RegisterCommandHandler<Message>(
+    [&handledCount](server::ClientId, const Message&)
+    {
+      ++handledCount;
+    });
+
+  // Commands of one connection, each is scrambled with the next rolling code.
+  const auto sample = CreateSample<Message>();
+  server::CommandClient client;
+  client.SetCode(code);
+
+  std::vector<std::byte> clientData;
+  for (std::size_t commandIdx = 0; commandIdx < CommandCount; ++commandIdx)
+  {
+    WriteClientCommand(client, sample, clientData);
+  }
+
+  const auto receiveBegin = std::chrono::steady_clock::now();
+  for (std::size_t iterationIdx = 0; iterationIdx < IterationCount / 100; ++iterationIdx)
+  {
+    commandServer.SetCode(ClientId, code);
+    commandServer.HandleClientData(ClientId, clientData);
+  }
+  const auto receiveDuration = std::chrono::steady_clock::now() - receiveBegin;
+
+  if (handledCount != CommandCount * (IterationCount / 100))
+    throw std::runtime_error("Not every framed command was handled");
+
+  server::asio::streambuf writeBuffer;
+  const auto sendNs = Measure([&commandServer, &writeBuffer, &sample](std::size_t)
+  {
+    const auto size = commandServer.WriteCommand(
+      writeBuffer,
+      Message::GetCommand(),
+      [&sample](server::SinkStream& stream)
+      {
+        Message::Write(sample, stream);
+      });
+    writeBuffer.consume(size);
+  });
+
+  return {
+    {"name", GetMessageName(Message::GetCommand())},
+    {"receiveNs", std::chrono::duration<double, std::nano>(receiveDuration).count()
+      / static_cast<double>(handledCount)},
+    {"sendNs", sendNs}};
+}
+
+} // namespace
+
+int main()
+{
+  const nlohmann::json results{
+    {"iterations", IterationCount},
+    {"messages", {
+      {"lobby", MeasureMessages(LobbyMessages{})},
+      {"ranch", MeasureMessages(RanchMessages{})},
+      {"race", MeasureMessages(RaceMessages{})},
+      {"chatter", MeasureMessages(ChatterMessages{})}}},
+    {"magic", MeasureMagic()},
+    {"xor", MeasureXor()},
+    {"framing", {
+      MeasureFraming<protocol::AcCmdCRRanchChat>(),
+      MeasureFraming<protocol::AcCmdUserRaceUpdatePos>()}}};
+
+  std::printf("%s\n", results.dump(2).c_str());
+}
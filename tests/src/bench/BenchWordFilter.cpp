@@ -0,0 +1,110 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/WordFilter.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//! Count of the scanned messages.
+constexpr std::size_t MessageCount = 10'000;
+//! Count of the passes over the messages.
+constexpr std::size_t PassCount = 10;
+
+//! Generates random lowercase words.
+//! @param generator Random number generator.
+//! @param count Count of the words.
+//! @returns Words.
+std::vector<std::string> GenerateWords(std::mt19937& generator, std::size_t count)
+{
+  std::uniform_int_distribution<std::size_t> lengthDistribution(4, 10);
+  std::uniform_int_distribution<int> letterDistribution('a', 'z');
+
+  std::vector<std::string> words(count);
+  for (auto& word : words)
+  {
+    word.resize(lengthDistribution(generator));
+    for (auto& letter : word)
+      letter = static_cast<char>(letterDistribution(generator));
+  }
+
+  return words;
+}
+
+} // namespace
+
+int main()
+{
+  std::mt19937 generator(0);
+
+  // Chat messages are shorter than the max length of a message the client sends.
+  std::vector<std::string> messages;
+  for (const auto& word : GenerateWords(generator, MessageCount))
+  {
+    messages.emplace_back("hello there, let's race on " + word + " map, are you ready?");
+  }
+
+  std::printf("%-10s %-10s %-15s %-15s\n", "words", "matched", "scan ns/msg", "mask ns/msg");
+
+  for (const std::size_t wordCount : {10uz, 100uz, 1'000uz, 10'000uz, 100'000uz})
+  {
+    const server::WordFilter wordFilter(GenerateWords(generator, wordCount));
+
+    // Measures the average duration of a filter operation on a message.
+    const auto measure = [&messages](const auto& operation)
+    {
+      const auto begin = std::chrono::steady_clock::now();
+      for (std::size_t passIdx = 0; passIdx < PassCount; ++passIdx)
+      {
+        for (const auto& message : messages)
+        {
+          operation(message);
+        }
+      }
+      const auto duration = std::chrono::steady_clock::now() - begin;
+
+      return std::chrono::duration<double, std::nano>(duration).count()
+        / static_cast<double>(MessageCount * PassCount);
+    };
+
+    std::size_t matchedCount = 0;
+    const auto scanDuration = measure([&wordFilter, &matchedCount](const std::string& message)
+    {
+      if (wordFilter.Contains(message))
+        ++matchedCount;
+    });
+    const auto maskDuration = measure([&wordFilter](const std::string& message)
+    {
+      [[maybe_unused]] const auto maskedMessage = wordFilter.Mask(message);
+    });
+
+    std::printf(
+      "%-10zu %-10zu %-15.1f %-15.1f\n",
+      wordFilter.GetWordCount(),
+      matchedCount / PassCount,
+      scanDuration,
+      maskDuration);
+  }
+}
@@ -0,0 +1,268 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/network/Server.hpp>
+#include <libserver/network/command/CommandServer.hpp>
+#include <libserver/network/command/proto/LobbyMessageDefinitions.hpp>
+#include <libserver/network/command/proto/RaceMessageDefinitions.hpp>
+#include <libserver/util/Metrics.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+//! A network event handler consuming the data in blocks of four bytes.
+class BlockEventHandler
+  : public server::network::EventHandlerInterface
+{
+public:
+  void OnClientConnected(server::network::ClientId clientId) override
+  {
+    ++connectedCount;
+  }
+
+  void OnClientDisconnected(server::network::ClientId clientId) override
+  {
+    ++disconnectedCount;
+  }
+
+  size_t OnClientData(
+    server::network::ClientId clientId,
+    const std::span<const std::byte>& data) override
+  {
+    const std::size_t consumedSize = data.size() - data.size() % 4;
+    consumedData.insert(consumedData.end(), data.begin(), data.begin() + consumedSize);
+    return consumedSize;
+  }
+
+  std::size_t connectedCount = 0;
+  std::size_t disconnectedCount = 0;
+  std::vector<std::byte> consumedData;
+};
+
+//! A command server event handler doing nothing.
+class NullCommandEventHandler
+  : public server::CommandServer::EventHandlerInterface
+{
+public:
+  void HandleClientConnected(server::ClientId clientId) override {}
+  void HandleClientDisconnected(server::ClientId clientId) override {}
+};
+
+//! Perform test of the loopback client reads and writes.
+void TestLoopbackClient()
+{
+  BlockEventHandler eventHandler;
+  server::network::Server networkServer(eventHandler);
+
+  const auto client = networkServer.ConnectLoopback();
+  assert(client->IsConnected());
+  assert(eventHandler.connectedCount == 1);
+  assert(networkServer.GetClient(client->GetId()) == client);
+
+  // Expect the data not consumed by the handler to be passed again with the next send.
+  const std::array<std::byte, 6> data{
+    std::byte{0}, std::byte{1}, std::byte{2}, std::byte{3}, std::byte{4}, std::byte{5}};
+  client->Send(data);
+  assert(eventHandler.consumedData.size() == 4);
+  client->Send(std::span(data).first(2));
+  assert(eventHandler.consumedData.size() == 8);
+  assert(eventHandler.consumedData[4] == std::byte{4});
+  assert(eventHandler.consumedData[7] == std::byte{1});
+
+  // Queue the writes from multiple threads at once.
+  constexpr uint16_t ThreadCount = 4;
+  constexpr uint16_t WriteCount = 1000;
+
+  std::vector<std::thread> threads;
+  for (uint16_t threadIdx = 0; threadIdx < ThreadCount; ++threadIdx)
+  {
+    threads.emplace_back([&networkServer, clientId = client->GetId(), threadIdx]()
+    {
+      for (uint16_t writeIdx = 0; writeIdx < WriteCount; ++writeIdx)
+      {
+        networkServer.GetClient(clientId)->QueueWrite(
+          [threadIdx, writeIdx](server::network::asio::streambuf& writeBuffer)
+          {
+            const std::array<uint16_t, 2> value{threadIdx, writeIdx};
+            const auto buffer = writeBuffer.prepare(sizeof(value));
+            std::memcpy(buffer.data(), value.data(), sizeof(value));
+            writeBuffer.commit(sizeof(value));
+            return sizeof(value);
+          });
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  // Expect every write to be received in the order it was queued in by its thread.
+  const auto receivedData = client->Receive();
+  assert(receivedData.size() == ThreadCount * WriteCount * sizeof(uint16_t) * 2);
+
+  std::array<uint16_t, ThreadCount> nextWriteIdx{};
+  for (std::size_t offset = 0; offset < receivedData.size(); offset += sizeof(uint16_t) * 2)
+  {
+    std::array<uint16_t, 2> value{};
+    std::memcpy(value.data(), receivedData.data() + offset, sizeof(value));
+    assert(value[0] < ThreadCount);
+    assert(value[1] == nextWriteIdx[value[0]]);
+    ++nextWriteIdx[value[0]];
+  }
+
+  assert(client->Receive().empty());
+
+  client->End();
+  assert(not client->IsConnected());
+  assert(eventHandler.disconnectedCount == 1);
+
+  bool isClientRemoved = false;
+  try
+  {
+    std::ignore = networkServer.GetClient(client->GetId());
+  }
+  catch (const std::exception&)
+  {
+    isClientRemoved = true;
+  }
+  assert(isClientRemoved);
+}
+
+//! Perform test of a command round trip through the loopback transport.
+void TestCommandServerLoopback()
+{
+  NullCommandEventHandler eventHandler;
+  server::CommandServer commandServer(eventHandler);
+
+  std::size_t handledCount = 0;
+  commandServer.RegisterCommandHandler<server::protocol::AcCmdCLHeartbeat>(
+    [&commandServer, &handledCount](server::ClientId clientId, const auto& command)
+    {
+      ++handledCount;
+      commandServer.QueueCommand<server::protocol::AcCmdCLHeartbeat>(
+        clientId,
+        []()
+        {
+          return server::protocol::AcCmdCLHeartbeat{};
+        });
+    });
+
+  const auto client = commandServer.ConnectLoopback();
+
+  // The command without data is sent as a bare message magic.
+  const uint32_t magic = server::protocol::encode_message_magic({
+    .id = static_cast<uint16_t>(server::protocol::Command::AcCmdCLHeartbeat),
+    .length = sizeof(server::protocol::MessageMagic)});
+  client->Send(std::as_bytes(std::span(&magic, 1)));
+  assert(handledCount == 1);
+
+  const auto receivedData = client->Receive();
+  assert(receivedData.size() == sizeof(uint32_t));
+
+  uint32_t receivedMagic{};
+  std::memcpy(&receivedMagic, receivedData.data(), sizeof(receivedMagic));
+  const auto decodedMagic = server::protocol::decode_message_magic(receivedMagic);
+  assert(decodedMagic.id == static_cast<uint16_t>(server::protocol::Command::AcCmdCLHeartbeat));
+  assert(decodedMagic.length == sizeof(server::protocol::MessageMagic));
+
+  // Expect the handler and the supplier invocations to be profiled.
+  auto& registry = server::metrics::GetRegistry();
+  const server::metrics::Labels labels{{"command", "AcCmdCLHeartbeat"}};
+  assert(registry.GetHistogram("alicia_command_handler_seconds", {}, labels).GetSnapshot().count == 1);
+  assert(registry.GetHistogram("alicia_command_supplier_seconds", {}, labels).GetSnapshot().count == 1);
+
+  client->End();
+}
+
+//! Perform test of the conflated commands of multiple senders.
+void TestConflatedCommands()
+{
+  NullCommandEventHandler eventHandler;
+  server::CommandServer commandServer(eventHandler);
+
+  const auto client = commandServer.ConnectLoopback();
+
+  const auto makeUpdate = [](uint16_t oid, float speed)
+  {
+    return server::protocol::AcCmdUserRaceUpdatePos{
+      .oid = oid,
+      .member4 = speed};
+  };
+
+  // A snapshot of two senders, the update of the second one is replaced before it is sent.
+  const std::array snapshot{
+    server::SenderCommandSupplier{1, commandServer.ShareCommand(makeUpdate(1, 1.0f))},
+    server::SenderCommandSupplier{2, commandServer.ShareCommand(makeUpdate(2, 1.0f))}};
+  commandServer.QueueConflatedCommands<server::protocol::AcCmdUserRaceUpdatePos>(
+    client->GetId(),
+    snapshot);
+  commandServer.QueueConflatedCommand<server::protocol::AcCmdUserRaceUpdatePos>(
+    client->GetId(),
+    2,
+    [&makeUpdate]()
+    {
+      return makeUpdate(2, 2.0f);
+    });
+
+  // Expect the latest update of every sender, ordered by the sender, in a single write.
+  const auto receivedData = client->Receive();
+
+  std::vector<server::protocol::AcCmdUserRaceUpdatePos> updates;
+  std::size_t offset = 0;
+  while (offset < receivedData.size())
+  {
+    uint32_t receivedMagic{};
+    std::memcpy(&receivedMagic, receivedData.data() + offset, sizeof(receivedMagic));
+    const auto decodedMagic = server::protocol::decode_message_magic(receivedMagic);
+    assert(decodedMagic.id == static_cast<uint16_t>(server::protocol::Command::AcCmdUserRaceUpdatePos));
+
+    server::SourceStream commandStream(receivedData.subspan(
+      offset + sizeof(receivedMagic),
+      decodedMagic.length - sizeof(receivedMagic)));
+    server::protocol::AcCmdUserRaceUpdatePos::Read(updates.emplace_back(), commandStream);
+
+    offset += decodedMagic.length;
+  }
+
+  assert(updates.size() == 2);
+  assert(updates[0].oid == 1 && updates[0].member4 == 1.0f);
+  assert(updates[1].oid == 2 && updates[1].member4 == 2.0f);
+
+  // Nothing is left to send.
+  assert(client->Receive().empty());
+
+  client->End();
+}
+
+} // namespace
+
+int main()
+{
+  TestLoopbackClient();
+  TestCommandServerLoopback();
+  TestConflatedCommands();
+}
@@ -0,0 +1,269 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/network/relay/RelayServer.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+namespace asio = boost::asio;
+
+using server::network::RelayServer;
+
+//! Port of the tested relay.
+constexpr uint16_t RelayPort = 10580;
+//! Size of the header prefixed to the relayed datagrams.
+constexpr std::size_t RelayHeaderSize = 6;
+
+//! Waits for the relay thread to handle the requests and datagrams.
+void Settle()
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+}
+
+//! A P2P peer of the relay.
+class RelayPeer
+{
+public:
+  explicit RelayPeer(const asio::ip::address& address = asio::ip::address_v4::loopback())
+    : _socket(_ioContext, asio::ip::udp::endpoint(address, 0))
+  {
+    _socket.non_blocking(true);
+  }
+
+  //! Sends a datagram beginning with the member ID to the relay.
+  void Send(RelayServer::MemberId memberId, uint8_t payload)
+  {
+    std::array<std::byte, sizeof(memberId) + 1> datagram{};
+    std::memcpy(datagram.data(), &memberId, sizeof(memberId));
+    datagram.back() = static_cast<std::byte>(payload);
+
+    _socket.send_to(
+      asio::buffer(datagram),
+      asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), RelayPort));
+    Settle();
+  }
+
+  //! Receives a relayed datagram.
+  //! @returns Payload of the relayed datagram, or empty if none was relayed.
+  std::optional<uint8_t> Receive()
+  {
+    std::array<std::byte, 64> datagram{};
+    asio::ip::udp::endpoint sender;
+    boost::system::error_code error;
+
+    const auto receivedSize = _socket.receive_from(
+      asio::buffer(datagram),
+      sender,
+      0,
+      error);
+    if (error)
+      return std::nullopt;
+
+    assert(receivedSize == RelayHeaderSize + sizeof(RelayServer::MemberId) + 1);
+    return static_cast<uint8_t>(datagram[receivedSize - 1]);
+  }
+
+private:
+  asio::io_context _ioContext;
+  asio::ip::udp::socket _socket;
+};
+
+void TestClaim()
+{
+  RelayServer relay;
+  relay.BeginHost(asio::ip::address_v4::loopback(), RelayPort, std::chrono::seconds(30));
+
+  relay.ReserveMember(1, 1, asio::ip::address_v4::loopback());
+  relay.ReserveMember(1, 2, asio::ip::address_v4::loopback());
+  relay.ReserveMember(2, 5, asio::ip::make_address_v4("10.0.0.1"));
+  Settle();
+
+  RelayPeer first, second, intruder;
+  first.Send(1, 'a');
+  second.Send(2, 'b');
+
+  // The datagram of the second member is relayed to the first one.
+  assert(first.Receive() == 'b');
+  assert(not second.Receive());
+
+  // The datagrams claiming no reservation of their address are dropped.
+  intruder.Send(3, 'x');
+  intruder.Send(5, 'x');
+  first.Send(1, 'c');
+  assert(second.Receive() == 'c');
+  assert(not intruder.Receive());
+  assert(not first.Receive());
+
+  relay.EndHost();
+}
+
+void TestAddressBinding()
+{
+  RelayServer relay;
+  relay.BeginHost(asio::ip::address_v4::loopback(), RelayPort, std::chrono::seconds(30));
+
+  const auto firstAddress = asio::ip::make_address_v4("127.0.0.1");
+  const auto secondAddress = asio::ip::make_address_v4("127.0.0.2");
+  relay.ReserveMember(1, 1, firstAddress);
+  relay.ReserveMember(1, 2, secondAddress);
+  Settle();
+
+  // The addresses with a single reservation are bound on the address alone.
+  RelayPeer first(firstAddress), second(secondAddress);
+  first.Send(7, 'a');
+  second.Send(9, 'b');
+  assert(first.Receive() == 'b');
+
+  first.Send(5, 'c');
+  assert(second.Receive() == 'c');
+
+  relay.EndHost();
+}
+
+void TestNotHosting()
+{
+  RelayServer relay;
+
+  // The reservations made before hosting are ignored.
+  relay.ReserveMember(1, 1, asio::ip::address_v4::loopback());
+  relay.ReserveMember(1, 2, asio::ip::address_v4::loopback());
+  relay.RemoveRoom(2);
+
+  relay.BeginHost(asio::ip::address_v4::loopback(), RelayPort, std::chrono::seconds(30));
+  Settle();
+
+  RelayPeer first, second;
+  first.Send(1, 'a');
+  second.Send(2, 'b');
+  assert(not first.Receive());
+  assert(not second.Receive());
+
+  relay.EndHost();
+}
+
+void TestRebind()
+{
+  RelayServer relay;
+  relay.BeginHost(asio::ip::address_v4::loopback(), RelayPort, std::chrono::seconds(30));
+
+  relay.ReserveMember(1, 1, asio::ip::address_v4::loopback());
+  relay.ReserveMember(1, 2, asio::ip::address_v4::loopback());
+  Settle();
+
+  RelayPeer first, second, rebound;
+  first.Send(1, 'a');
+  second.Send(2, 'b');
+  assert(first.Receive() == 'b');
+
+  // The member changed its endpoint.
+  rebound.Send(2, 'c');
+  assert(first.Receive() == 'c');
+
+  first.Send(1, 'd');
+  assert(rebound.Receive() == 'd');
+  assert(not second.Receive());
+
+  // The member left the room.
+  relay.RemoveMember(1, 2);
+  Settle();
+
+  first.Send(1, 'e');
+  rebound.Send(2, 'f');
+  assert(not rebound.Receive());
+  assert(not first.Receive());
+
+  // The member joined another room.
+  relay.ReserveMember(2, 2, asio::ip::address_v4::loopback());
+  Settle();
+
+  rebound.Send(2, 'g');
+  first.Send(1, 'h');
+  assert(not first.Receive());
+  assert(not rebound.Receive());
+
+  relay.EndHost();
+}
+
+void TestExpiry()
+{
+  RelayServer relay;
+  relay.BeginHost(asio::ip::address_v4::loopback(), RelayPort, std::chrono::milliseconds(200));
+
+  relay.ReserveMember(1, 1, asio::ip::address_v4::loopback());
+  relay.ReserveMember(1, 2, asio::ip::address_v4::loopback());
+  Settle();
+
+  RelayPeer first, second;
+  first.Send(1, 'a');
+  second.Send(2, 'b');
+  assert(first.Receive() == 'b');
+
+  // The members and their reservations are forgotten after the idle timeout.
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+
+  first.Send(1, 'c');
+  second.Send(2, 'd');
+  assert(not first.Receive());
+  assert(not second.Receive());
+
+  relay.EndHost();
+}
+
+void TestNoExpiry()
+{
+  RelayServer relay;
+  relay.BeginHost(asio::ip::address_v4::loopback(), RelayPort, std::chrono::milliseconds(0));
+
+  relay.ReserveMember(1, 1, asio::ip::address_v4::loopback());
+  relay.ReserveMember(1, 2, asio::ip::address_v4::loopback());
+  Settle();
+
+  RelayPeer first, second;
+  first.Send(1, 'a');
+  second.Send(2, 'b');
+  assert(first.Receive() == 'b');
+
+  // The members are never forgotten without an idle timeout.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+  first.Send(1, 'c');
+  assert(second.Receive() == 'c');
+
+  relay.EndHost();
+}
+
+} // namespace
+
+int main()
+{
+  TestClaim();
+  TestAddressBinding();
+  TestNotHosting();
+  TestRebind();
+  TestExpiry();
+  TestNoExpiry();
+}
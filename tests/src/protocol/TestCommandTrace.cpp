@@ -0,0 +1,93 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include "libserver/network/command/CommandTrace.hpp"
+
+#include <array>
+#include <cassert>
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+
+//! Perform test of writing and reading a command trace.
+void TestTraceRoundTrip()
+{
+  const auto tracePath = std::filesystem::temp_directory_path() / "alicia_test_command_trace.bin";
+
+  // Data large enough for a multi-byte size.
+  std::array<std::byte, 300> data{};
+  for (std::size_t idx = 0; idx < data.size(); ++idx)
+  {
+    data[idx] = static_cast<std::byte>(idx);
+  }
+
+  {
+    server::CommandTraceWriter writer(tracePath);
+    writer.RecordConnected(1);
+    writer.RecordCommand(1, server::protocol::Command::AcCmdCRRanchChat, data);
+    writer.RecordCommand(70000, server::protocol::Command::AcCmdCLHeartbeat, {});
+    writer.RecordState(7, std::span(data).first(8));
+    writer.RecordDisconnected(1);
+  }
+
+  server::CommandTraceReader reader(tracePath);
+  server::CommandTraceRecord record;
+
+  assert(reader.Read(record));
+  assert(record.type == server::CommandTraceRecord::Type::Connected);
+  assert(record.clientId == 1);
+
+  const auto connectedTimestamp = record.timestamp;
+
+  assert(reader.Read(record));
+  assert(record.type == server::CommandTraceRecord::Type::Command);
+  assert(record.clientId == 1);
+  assert(record.commandId == server::protocol::Command::AcCmdCRRanchChat);
+  assert(std::ranges::equal(record.data, data));
+  assert(record.timestamp >= connectedTimestamp);
+
+  assert(reader.Read(record));
+  assert(record.type == server::CommandTraceRecord::Type::Command);
+  assert(record.clientId == 70000);
+  assert(record.commandId == server::protocol::Command::AcCmdCLHeartbeat);
+  assert(record.data.empty());
+
+  assert(reader.Read(record));
+  assert(record.type == server::CommandTraceRecord::Type::State);
+  assert(record.stateId == 7);
+  assert(std::ranges::equal(record.data, std::span(data).first(8)));
+
+  assert(reader.Read(record));
+  assert(record.type == server::CommandTraceRecord::Type::Disconnected);
+  assert(record.clientId == 1);
+
+  // Expect the end of the trace.
+  assert(not reader.Read(record));
+
+  std::filesystem::remove(tracePath);
+}
+
+} // namespace
+
+int main()
+{
+  TestTraceRoundTrip();
+}
@@ -19,6 +19,7 @@
 
 #include "libserver/network/command/CommandProtocol.hpp"
 
+#include <array>
 #include <cassert>
 
 namespace
@@ -41,9 +42,38 @@ void TestMagic()
   assert(decoded_magic.length == magic.length);
 }
 
+//! Perform test of XOR scrambling.
+void TestXorCode()
+{
+  const server::protocol::XorCode code{
+    std::byte{0xCB}, std::byte{0x91}, std::byte{0x01}, std::byte{0xA2}};
+
+  // Data not aligned to the size of the code.
+  std::array<std::byte, 11> data{};
+  for (std::size_t idx = 0; idx < data.size(); ++idx)
+  {
+    data[idx] = static_cast<std::byte>(idx);
+  }
+
+  // Test that every byte is XORed with the byte of the code at the same offset.
+  server::protocol::ApplyXorCode(code, data);
+  for (std::size_t idx = 0; idx < data.size(); ++idx)
+  {
+    assert(data[idx] == (static_cast<std::byte>(idx) ^ code[idx % code.size()]));
+  }
+
+  // Test that applying the code again restores the data.
+  server::protocol::ApplyXorCode(code, data);
+  for (std::size_t idx = 0; idx < data.size(); ++idx)
+  {
+    assert(data[idx] == static_cast<std::byte>(idx));
+  }
+}
+
 } // namespace
 
 int main()
 {
   TestMagic();
+  TestXorCode();
 }
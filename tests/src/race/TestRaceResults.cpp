@@ -0,0 +1,81 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <server/ServerInstance.hpp>
+
+#include <cassert>
+#include <filesystem>
+
+namespace
+{
+
+using server::RaceDirector;
+using server::ServerInstance;
+using server::tracker::RaceTracker;
+
+void TestResultsRecordedOnce()
+{
+  const auto resourceDirectory = std::filesystem::temp_directory_path() / "alicia-test-race-results";
+  std::filesystem::remove_all(resourceDirectory);
+
+  constexpr server::data::Uid WinnerUid = 1;
+  constexpr server::data::Uid LoserUid = 2;
+
+  {
+    ServerInstance serverInstance(resourceDirectory);
+    auto& rankingSystem = serverInstance.GetRankingSystem();
+
+    // Load the league leaderboard.
+    rankingSystem.Tick();
+    serverInstance.GetDataDirector().Tick();
+    rankingSystem.Tick();
+
+    RaceDirector::RoomInstance roomInstance;
+    roomInstance.raceMapBlockId = 1;
+    for (const auto characterUid : {WinnerUid, LoserUid})
+    {
+      auto& racer = roomInstance.tracker.AddRacer(characterUid);
+      racer.state = RaceTracker::Racer::State::Finished;
+      racer.courseTime = characterUid * 1000;
+    }
+
+    // Both racers report the result of the finished race.
+    auto& raceDirector = serverInstance.GetRaceDirector();
+    assert(raceDirector.RecordRaceResults(roomInstance));
+    assert(not raceDirector.RecordRaceResults(roomInstance));
+
+    // The league points are granted once.
+    assert(rankingSystem.GetLeaguePoints(WinnerUid) == 10);
+    assert(rankingSystem.GetLeaguePoints(LoserUid) == 0);
+
+    // The next race is recorded again.
+    roomInstance.resultsRecorded = false;
+    assert(raceDirector.RecordRaceResults(roomInstance));
+    assert(rankingSystem.GetLeaguePoints(WinnerUid) == 20);
+  }
+
+  std::filesystem::remove_all(resourceDirectory);
+}
+
+} // namespace
+
+int main()
+{
+  TestResultsRecordedOnce();
+}
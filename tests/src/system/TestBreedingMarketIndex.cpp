@@ -0,0 +1,133 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <server/system/BreedingMarketIndex.hpp>
+
+#include <cassert>
+
+namespace
+{
+
+using server::BreedingMarketIndex;
+
+//! Creates a stallion.
+BreedingMarketIndex::Stallion MakeStallion(uint32_t uid, uint32_t matePrice, uint8_t grade)
+{
+  BreedingMarketIndex::Stallion stallion{};
+  stallion.uid = uid;
+  stallion.matePrice = matePrice;
+  stallion.grade = grade;
+  return stallion;
+}
+
+void TestIndexes()
+{
+  BreedingMarketIndex index;
+
+  index.Add(MakeStallion(1, 300, 4), 10);
+  index.Add(MakeStallion(2, 100, 4), 20);
+  index.Add(MakeStallion(3, 200, 5), 10);
+  index.Add(MakeStallion(4, 100, 5), 20);
+  assert(index.GetSize() == 4);
+
+  // The stallions are ordered by their price, then by their UID.
+  auto page = index.Search({});
+  assert(page->pageCount == 1);
+  assert(page->stallions.size() == 4);
+  assert(page->stallions[0].uid == 2);
+  assert(page->stallions[1].uid == 4);
+  assert(page->stallions[2].uid == 3);
+  assert(page->stallions[3].uid == 1);
+
+  page = index.Search({.coat = 10});
+  assert(page->stallions.size() == 2);
+  assert(page->stallions[0].uid == 3 && page->stallions[1].uid == 1);
+
+  page = index.Search({.grade = 5});
+  assert(page->stallions.size() == 2);
+  assert(page->stallions[0].uid == 4 && page->stallions[1].uid == 3);
+
+  page = index.Search({.coat = 20, .grade = 5});
+  assert(page->stallions.size() == 1 && page->stallions[0].uid == 4);
+
+  page = index.Search({.maxPrice = 150});
+  assert(page->stallions.size() == 2);
+
+  page = index.Search({.coat = 30});
+  assert(page->pageCount == 0 && page->stallions.empty());
+
+  // Replacing a stallion re-indexes it.
+  index.Add(MakeStallion(1, 50, 5), 20);
+  assert(index.GetSize() == 4);
+  assert(index.Search({.coat = 10})->stallions.size() == 1);
+  assert(index.Search({.grade = 5})->stallions.front().uid == 1);
+
+  // Removed stallions are not found, the cached pages are invalidated.
+  assert(index.Remove(4));
+  assert(not index.Remove(4));
+  page = index.Search({.coat = 20, .grade = 5});
+  assert(page->stallions.size() == 1 && page->stallions[0].uid == 1);
+  assert(index.GetSize() == 3);
+}
+
+void TestPagination()
+{
+  BreedingMarketIndex index;
+
+  const uint32_t stallionCount = BreedingMarketIndex::PageSize * 2 + 5;
+  for (uint32_t uid = 1; uid <= stallionCount; ++uid)
+  {
+    index.Add(MakeStallion(uid, uid * 10, 1), 1);
+  }
+
+  const auto firstPage = index.Search({.page = 0});
+  assert(firstPage->pageCount == 3);
+  assert(firstPage->stallions.size() == BreedingMarketIndex::PageSize);
+  assert(firstPage->stallions.front().uid == 1);
+
+  const auto lastPage = index.Search({.page = 2});
+  assert(lastPage->pageCount == 3);
+  assert(lastPage->stallions.size() == 5);
+  assert(lastPage->stallions.back().uid == stallionCount);
+
+  // A page past the results is empty and reports the page count.
+  const auto pastPage = index.Search({.page = 3});
+  assert(pastPage->pageCount == 3 && pastPage->stallions.empty());
+
+  // The pages are cached until the index changes.
+  assert(index.Search({.page = 0}) == firstPage);
+
+  index.Remove(1);
+  const auto changedPage = index.Search({.page = 0});
+  assert(changedPage != firstPage);
+  assert(changedPage->stallions.front().uid == 2);
+
+  // The pages of the filtered results are paginated too.
+  const auto filteredPage = index.Search({.maxPrice = 100, .page = 0});
+  assert(filteredPage->pageCount == 1);
+  assert(filteredPage->stallions.size() == 9);
+}
+
+} // namespace
+
+int main()
+{
+  TestIndexes();
+  TestPagination();
+}
@@ -0,0 +1,159 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <server/system/ShopSystem.hpp>
+
+#include <zlib.h>
+
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+
+using server::ShopSystem;
+using server::registry::Goods;
+
+//! Reads the signature of a catalogue.
+std::array<uint32_t, 3> ReadSignature(const ShopSystem::Catalogue& catalogue)
+{
+  std::array<uint32_t, 3> signature{};
+  std::memcpy(signature.data(), catalogue.signature.data(), sizeof(signature));
+  return signature;
+}
+
+//! Decompresses the XML of a catalogue.
+std::string DecompressCatalogue(const ShopSystem::Catalogue& catalogue)
+{
+  const auto [checksum, xmlSize, compressedSize] = ReadSignature(catalogue);
+  assert(compressedSize == catalogue.data.size());
+  assert(checksum == crc32(
+    0,
+    reinterpret_cast<const Bytef*>(catalogue.data.data()),
+    catalogue.data.size()));
+
+  std::string xml(xmlSize, '\0');
+  uLongf decompressedSize = xml.size();
+  const auto result = uncompress(
+    reinterpret_cast<Bytef*>(xml.data()),
+    &decompressedSize,
+    reinterpret_cast<const Bytef*>(catalogue.data.data()),
+    catalogue.data.size());
+
+  assert(result == Z_OK);
+  assert(decompressedSize == xmlSize);
+  return xml;
+}
+
+void TestCompile()
+{
+  ShopSystem shopSystem;
+  assert(not shopSystem.GetCatalogue());
+
+  const std::vector<Goods> goods{
+    Goods{
+      .goodsSq = 1,
+      .name = "Carrot",
+      .description = "Tasty ]]> carrot",
+      .itemTid = 30013,
+      .prices = {
+        {.priceId = 1, .priceRange = 1, .goodsPrice = 100},
+        {.priceId = 2, .priceRange = 10, .goodsPrice = 900}}},
+    Goods{
+      .goodsSq = 2,
+      .name = "Apple",
+      .itemTid = 30014}};
+
+  shopSystem.CompileCatalogue(goods);
+
+  const auto catalogue = shopSystem.GetCatalogue();
+  assert(catalogue);
+  assert(catalogue->version == 1);
+
+  const auto xml = DecompressCatalogue(*catalogue);
+  assert(xml.starts_with("<ShopList>\n"));
+  assert(xml.ends_with("</ShopList>\n"));
+  assert(xml.find("<GoodsSQ>1</GoodsSQ>") < xml.find("<GoodsSQ>2</GoodsSQ>"));
+  assert(xml.contains("<GoodsNM><![CDATA[Carrot]]></GoodsNM>"));
+  assert(xml.contains("<ItemUID>30014</ItemUID>"));
+  assert(xml.contains("<GoodsPrice>900</GoodsPrice>"));
+
+  // The terminator of the character data is split between two sections.
+  assert(xml.contains("<GoodsDesc><![CDATA[Tasty ]]]]><![CDATA[> carrot]]></GoodsDesc>"));
+
+  // Every compilation is a new version of the catalogue,
+  // the signature changes only with the content of the catalogue.
+  shopSystem.CompileCatalogue(goods);
+  const auto recompiledCatalogue = shopSystem.GetCatalogue();
+  assert(recompiledCatalogue->version == 2);
+  assert(recompiledCatalogue->signature == catalogue->signature);
+  assert(recompiledCatalogue->data == catalogue->data);
+
+  // A server restart compiles the same signature.
+  ShopSystem restartedShopSystem;
+  restartedShopSystem.CompileCatalogue(goods);
+  assert(restartedShopSystem.GetCatalogue()->signature == catalogue->signature);
+
+  auto changedGoods = goods;
+  changedGoods.back().name = "Green apple";
+  shopSystem.CompileCatalogue(changedGoods);
+  assert(shopSystem.GetCatalogue()->signature != catalogue->signature);
+}
+
+void TestOversizedCatalogue()
+{
+  ShopSystem shopSystem;
+  shopSystem.CompileCatalogue({Goods{.goodsSq = 1}});
+
+  // Random names which can't be compressed below the max data size.
+  std::mt19937 generator(1);
+  std::uniform_int_distribution<int> letterDistribution('a', 'z');
+
+  std::vector<Goods> goods(16);
+  for (auto& entry : goods)
+  {
+    for (std::size_t idx = 0; idx < ShopSystem::MaxDataSize / 4; ++idx)
+      entry.name += static_cast<char>(letterDistribution(generator));
+  }
+
+  bool isRejected = false;
+  try
+  {
+    shopSystem.CompileCatalogue(goods);
+  }
+  catch (const std::runtime_error&)
+  {
+    isRejected = true;
+  }
+
+  // The current catalogue is kept.
+  assert(isRejected);
+  assert(shopSystem.GetCatalogue()->version == 1);
+}
+
+} // namespace
+
+int main()
+{
+  TestCompile();
+  TestOversizedCatalogue();
+}
@@ -0,0 +1,125 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/FieldList.hpp>
+
+#include <array>
+#include <cassert>
+#include <string>
+
+namespace
+{
+
+struct Position
+{
+  uint16_t oid{};
+  std::array<float, 3> position{};
+  uint8_t flags{};
+
+  static void Write(const Position& value, server::SinkStream& stream);
+  static void Read(Position& value, server::SourceStream& stream);
+};
+
+using PositionFields = server::FieldList<
+  &Position::oid,
+  &Position::position,
+  &Position::flags>;
+
+void Position::Write(const Position& value, server::SinkStream& stream)
+{
+  PositionFields::Write(value, stream);
+}
+
+void Position::Read(Position& value, server::SourceStream& stream)
+{
+  PositionFields::Read(value, stream);
+}
+
+struct Datum
+{
+  uint32_t uid{};
+  uint8_t type{};
+  std::string name{};
+  Position position{};
+  uint64_t time{};
+};
+
+using DatumFields = server::FieldList<
+  &Datum::uid,
+  &Datum::type,
+  &Datum::name,
+  &Datum::position,
+  &Datum::time>;
+
+static_assert(PositionFields::IsFixedSize);
+static_assert(PositionFields::FixedSize == 2 + 3 * 4 + 1);
+static_assert(not DatumFields::IsFixedSize);
+
+void TestFieldList()
+{
+  const Datum written{
+    .uid = 0xCAFE,
+    .type = 0x02,
+    .name = "rgnter",
+    .position = {
+      .oid = 0xBABE,
+      .position = {1.0f, 2.0f, 3.0f},
+      .flags = 0x01},
+    .time = 0xBAADF00D};
+
+  // Expect the fields to be written the same as with the stream.
+  std::array<std::byte, 64> expectedBuffer{};
+  server::SinkStream expectedSink(expectedBuffer);
+  expectedSink.Write(written.uid)
+    .Write(written.type)
+    .Write(written.name)
+    .Write(written.position.oid);
+  for (const float element : written.position.position)
+    expectedSink.Write(element);
+  expectedSink.Write(written.position.flags)
+    .Write(written.time);
+
+  std::array<std::byte, 64> buffer{};
+  server::SinkStream sink(buffer);
+  DatumFields::Write(written, sink);
+
+  assert(sink.GetCursor() == expectedSink.GetCursor());
+  assert(buffer == expectedBuffer);
+
+  // Expect the fields to be read back.
+  server::SourceStream source(std::span(buffer.data(), sink.GetCursor()));
+  Datum read{};
+  DatumFields::Read(read, source);
+
+  assert(source.GetCursor() == sink.GetCursor());
+  assert(read.uid == written.uid);
+  assert(read.type == written.type);
+  assert(read.name == written.name);
+  assert(read.position.oid == written.position.oid);
+  assert(read.position.position == written.position.position);
+  assert(read.position.flags == written.position.flags);
+  assert(read.time == written.time);
+}
+
+} // namespace
+
+int main()
+{
+  TestFieldList();
+}
@@ -34,6 +34,34 @@ void TestLocale()
   assert(utfOutput == utfSource);
   const std::string eucOutput = server::locale::FromUtf8(utfSource);
   assert(eucOutput == eucSource);
+
+  // Expect the cached conversions to match the converted ones.
+  assert(server::locale::ToUtf8(eucSource) == utfSource);
+  assert(server::locale::FromUtf8(utfSource) == eucSource);
+
+  // Expect the mixed strings to be converted.
+  assert(server::locale::ToUtf8("rgnter " + eucSource) == "rgnter " + utfSource);
+}
+
+void TestAscii()
+{
+  // Non-ASCII bytes at every offset of the vectorized and the scalar scan.
+  const std::string asciiSource = "Story of Alicia, the horse racing game.";
+  assert(server::locale::IsAscii(asciiSource));
+  for (std::size_t offset = 0; offset < asciiSource.length(); ++offset)
+  {
+    std::string source = asciiSource;
+    source[offset] = '\xb1';
+    assert(not server::locale::IsAscii(source));
+  }
+
+  assert(server::locale::ToUtf8(asciiSource) == asciiSource);
+  assert(server::locale::FromUtf8(asciiSource) == asciiSource);
+
+  // Expect the conversions to stop at the terminator.
+  const std::string terminatedSource("rgnter\0rest", 11);
+  assert(server::locale::ToUtf8(terminatedSource) == "rgnter");
+  assert(server::locale::FromUtf8(terminatedSource) == "rgnter");
 }
 
 } // namespace
@@ -41,4 +69,5 @@ void TestLocale()
 int main()
 {
   TestLocale();
+  TestAscii();
 }
@@ -0,0 +1,134 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/Metrics.hpp>
+
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void TestCounter()
+{
+  server::metrics::Registry registry;
+  auto& counter = registry.GetCounter("test_total", "Test counter.");
+
+  // Expect the increments of all the threads to be counted.
+  std::vector<std::thread> threads;
+  for (uint32_t threadIdx = 0; threadIdx < 16; ++threadIdx)
+  {
+    threads.emplace_back([&counter]()
+    {
+      for (uint32_t incrementIdx = 0; incrementIdx < 10'000; ++incrementIdx)
+      {
+        counter.Increment();
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  assert(counter.GetValue() == 160'000);
+
+  // Expect the same labels to return the same counter.
+  assert(&registry.GetCounter("test_total", "Test counter.") == &counter);
+  assert(&registry.GetCounter("test_total", "Test counter.", {{"kind", "other"}}) != &counter);
+}
+
+void TestHistogram()
+{
+  using server::metrics::Histogram;
+
+  // Expect the buckets to be contiguous and every value to fit its bucket.
+  for (uint64_t value = 0; value < 100'000; ++value)
+  {
+    const auto bucket = Histogram::GetBucket(value);
+    assert(value <= Histogram::GetBucketHighestValue(bucket));
+    assert(bucket == 0 || value > Histogram::GetBucketHighestValue(bucket - 1));
+  }
+
+  // Expect the relative error to be bounded by the sub-bucket count.
+  for (const uint64_t value : {1'000ull, 123'456ull, 987'654'321ull, 1ull << 39})
+  {
+    const auto highestValue = Histogram::GetBucketHighestValue(Histogram::GetBucket(value));
+    assert(highestValue - value <= value / 16);
+  }
+
+  // Expect the values over the max value to be counted in the last bucket.
+  assert(Histogram::GetBucket(~0ull) == Histogram::BucketCount - 1);
+
+  Histogram histogram;
+  for (uint32_t value = 1; value <= 1000; ++value)
+  {
+    histogram.Observe(std::chrono::microseconds(value));
+  }
+
+  const auto snapshot = histogram.GetSnapshot();
+  assert(snapshot.count == 1000);
+  assert(snapshot.sum == 500'500'000);
+
+  const auto median = snapshot.GetQuantile(0.5);
+  assert(median >= 500'000 && median <= 500'000 + 500'000 / 16);
+  const auto max = snapshot.GetQuantile(1.0);
+  assert(max >= 1'000'000 && max <= 1'000'000 + 1'000'000 / 16);
+}
+
+void TestExposition()
+{
+  server::metrics::Registry registry;
+  registry.GetCounter("test_commands_total", "Test commands.", {{"command", "Login"}}).Increment(3);
+  registry.GetGauge("test_clients", "Test clients.").Set(-2);
+  registry.GetHistogram("test_tick_seconds", "Test ticks.").Observe(std::chrono::milliseconds(2));
+
+  const auto exposition = registry.Expose();
+  assert(exposition.contains("# TYPE test_commands_total counter\n"));
+  assert(exposition.contains("test_commands_total{command=\"Login\"} 3\n"));
+  assert(exposition.contains("# TYPE test_clients gauge\n"));
+  assert(exposition.contains("test_clients -2\n"));
+  assert(exposition.contains("# TYPE test_tick_seconds summary\n"));
+  assert(exposition.contains("test_tick_seconds{quantile=\"0.5\"} "));
+  assert(exposition.contains("test_tick_seconds_count 1\n"));
+
+  // Expect a metric to keep the type it was registered with.
+  bool isTypeMismatchRejected = false;
+  try
+  {
+    std::ignore = registry.GetGauge("test_commands_total", "Test commands.");
+  }
+  catch (const std::logic_error&)
+  {
+    isTypeMismatchRejected = true;
+  }
+  assert(isTypeMismatchRejected);
+}
+
+} // namespace
+
+int main()
+{
+  TestCounter();
+  TestHistogram();
+  TestExposition();
+}
@@ -0,0 +1,83 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/RandomSet.hpp>
+
+#include <cassert>
+#include <cstdint>
+#include <set>
+
+namespace
+{
+
+void TestInsertRemove()
+{
+  server::RandomSet<uint32_t> randomSet;
+
+  assert(randomSet.Insert(1));
+  assert(randomSet.Insert(2));
+  assert(randomSet.Insert(3));
+  assert(not randomSet.Insert(2));
+  assert(randomSet.GetSize() == 3);
+
+  // Expect the last value to take the place of the removed one.
+  assert(randomSet.Remove(1));
+  assert(not randomSet.Remove(1));
+  assert(not randomSet.Contains(1));
+  assert(randomSet.Contains(2));
+  assert(randomSet.Contains(3));
+
+  assert(randomSet.Remove(3));
+  assert(randomSet.Remove(2));
+  assert(randomSet.IsEmpty());
+}
+
+void TestPick()
+{
+  server::RandomSet<uint32_t> randomSet;
+  std::mt19937 generator(0);
+
+  assert(not randomSet.Pick(generator));
+
+  randomSet.Insert(1);
+  assert(randomSet.Pick(generator) == 1);
+  assert(not randomSet.Pick(generator, 1));
+
+  randomSet.Insert(2);
+  randomSet.Insert(3);
+
+  // Expect every value but the excluded one to be picked.
+  std::set<uint32_t> pickedValues;
+  for (uint32_t pickIdx = 0; pickIdx < 100; ++pickIdx)
+  {
+    const auto pickedValue = randomSet.Pick(generator, 2);
+    assert(pickedValue);
+    pickedValues.emplace(*pickedValue);
+  }
+
+  assert((pickedValues == std::set<uint32_t>{1, 3}));
+}
+
+} // namespace
+
+int main()
+{
+  TestInsertRemove();
+  TestPick();
+}
@@ -0,0 +1,86 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/Ranking.hpp>
+
+#include <cassert>
+
+namespace
+{
+
+void TestAscending()
+{
+  server::Ranking ranking(server::Ranking::Order::Ascending, 1000, 10);
+
+  ranking.Set(1, 500);
+  ranking.Set(2, 200);
+  ranking.Set(3, 800);
+  ranking.Set(4, 205);
+
+  assert(ranking.GetSize() == 4);
+  assert(not ranking.GetRank(5));
+
+  // Scores of the same bucket share the rank.
+  assert(ranking.GetRank(2) == 1);
+  assert(ranking.GetRank(4) == 1);
+  assert(ranking.GetRank(1) == 3);
+  assert(ranking.GetRank(3) == 4);
+
+  assert(ranking.GetPercentile(2) == 100);
+  assert(ranking.GetPercentile(1) == 50);
+  assert(ranking.GetPercentile(3) == 25);
+
+  // Expect only better scores to be submitted.
+  assert(not ranking.Submit(3, 900));
+  assert(ranking.GetScore(3) == 800);
+  assert(ranking.Submit(3, 100));
+  assert(ranking.GetRank(3) == 1);
+  assert(ranking.GetRank(2) == 2);
+
+  ranking.Remove(3);
+  assert(ranking.GetSize() == 3);
+  assert(ranking.GetRank(2) == 1);
+  assert(ranking.GetRank(1) == 3);
+}
+
+void TestDescending()
+{
+  server::Ranking ranking(server::Ranking::Order::Descending, 100);
+
+  ranking.Set(1, 10);
+  ranking.Set(2, 50);
+  // Scores greater than the max score are counted as the max score.
+  ranking.Set(3, 1000);
+
+  assert(ranking.GetRank(3) == 1);
+  assert(ranking.GetRank(2) == 2);
+  assert(ranking.GetRank(1) == 3);
+
+  ranking.Set(1, 60);
+  assert(ranking.GetRank(1) == 2);
+  assert(ranking.GetRank(2) == 3);
+}
+
+} // namespace
+
+int main()
+{
+  TestAscending();
+  TestDescending();
+}
@@ -20,7 +20,9 @@
 #include <libserver/util/Scheduler.hpp>
 
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <thread>
 
 namespace
 {
@@ -87,10 +89,62 @@ void TestScheduledTasks()
   assert(delayedTaskExecuted && "Task queued for execution with a delay not executed within a timeout");
 }
 
+void TestConcurrentQueue()
+{
+  constexpr uint32_t TaskCount = 10'000;
+
+  server::Scheduler scheduler;
+  std::atomic_uint32_t executedCount = 0;
+
+  // Queue the tasks from another thread while the scheduler ticks.
+  std::thread producer([&scheduler, &executedCount]()
+  {
+    for (uint32_t taskIdx = 0; taskIdx < TaskCount; ++taskIdx)
+    {
+      scheduler.Queue([&executedCount]()
+      {
+        executedCount.fetch_add(1, std::memory_order::relaxed);
+      });
+    }
+  });
+
+  const auto timeout = server::Scheduler::Clock::now() + std::chrono::seconds(5);
+  while (executedCount.load(std::memory_order::relaxed) < TaskCount
+    && server::Scheduler::Clock::now() < timeout)
+  {
+    scheduler.Tick();
+  }
+
+  producer.join();
+  assert(executedCount.load() == TaskCount);
+}
+
+void TestReentrantQueue()
+{
+  server::Scheduler scheduler;
+
+  // The task queues another task, which is executed in the next tick.
+  bool innerTaskExecuted = false;
+  scheduler.Queue([&scheduler, &innerTaskExecuted]()
+  {
+    scheduler.Queue([&innerTaskExecuted]()
+    {
+      innerTaskExecuted = true;
+    });
+  });
+
+  scheduler.Tick();
+  assert(not innerTaskExecuted);
+  scheduler.Tick();
+  assert(innerTaskExecuted);
+}
+
 } // namespace
 
 int main()
 {
   TestSequencedTasks();
   TestScheduledTasks();
+  TestConcurrentQueue();
+  TestReentrantQueue();
 }
@@ -0,0 +1,222 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/ShardPool.hpp>
+
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+namespace
+{
+
+//! Waits until the condition is met or until the timeout.
+template <typename Condition>
+bool WaitFor(Condition condition)
+{
+  const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (not condition())
+  {
+    if (std::chrono::steady_clock::now() > timeout)
+      return false;
+    std::this_thread::yield();
+  }
+
+  return true;
+}
+
+void TestPartitionOrder()
+{
+  constexpr uint32_t PartitionCount = 8;
+  constexpr uint32_t TaskCount = 1000;
+
+  server::ShardPool shardPool;
+  shardPool.Start(4);
+
+  // Tasks of a partition are not synchronized with each other,
+  // they rely on the pool to execute them in order and never concurrently.
+  std::array<std::vector<uint32_t>, PartitionCount> partitionResults{};
+  std::atomic_uint32_t executedTaskCount{0};
+
+  for (uint32_t taskIdx = 0; taskIdx < TaskCount; ++taskIdx)
+  {
+    for (uint32_t partitionIdx = 0; partitionIdx < PartitionCount; ++partitionIdx)
+    {
+      shardPool.Queue(partitionIdx, [&partitionResults, &executedTaskCount, partitionIdx, taskIdx]()
+      {
+        partitionResults[partitionIdx].emplace_back(taskIdx);
+        executedTaskCount.fetch_add(1);
+      });
+    }
+  }
+
+  const bool allExecuted = WaitFor([&executedTaskCount]()
+  {
+    return executedTaskCount.load() == PartitionCount * TaskCount;
+  });
+  assert(allExecuted && "Tasks not executed within a timeout");
+
+  // Expect the tasks to finish in an order they were submitted in.
+  for (const auto& partitionResult : partitionResults)
+  {
+    assert(partitionResult.size() == TaskCount);
+    for (uint32_t taskIdx = 0; taskIdx < TaskCount; ++taskIdx)
+    {
+      assert(partitionResult[taskIdx] == taskIdx);
+    }
+  }
+
+  shardPool.Stop();
+}
+
+void TestBalance()
+{
+  constexpr uint32_t TaskCount = 1000;
+
+  server::ShardPool shardPool;
+  shardPool.Start(2);
+
+  // Partitions are pinned to the least loaded shards.
+  std::atomic_uint32_t executedTaskCount{0};
+  for (uint32_t partitionIdx = 0; partitionIdx < 4; ++partitionIdx)
+  {
+    shardPool.Queue(partitionIdx, [&executedTaskCount]()
+    {
+      executedTaskCount.fetch_add(1);
+    });
+  }
+
+  assert(shardPool.GetShard(0) != shardPool.GetShard(1));
+  assert(shardPool.GetShard(0) == shardPool.GetShard(2));
+  assert(shardPool.GetShard(1) == shardPool.GetShard(3));
+
+  // Load the two partitions of the first shard.
+  for (uint32_t taskIdx = 0; taskIdx < TaskCount; ++taskIdx)
+  {
+    for (const uint32_t partitionIdx : {0u, 2u})
+    {
+      shardPool.Queue(partitionIdx, [&executedTaskCount]()
+      {
+        executedTaskCount.fetch_add(1);
+      });
+    }
+  }
+
+  const bool allExecuted = WaitFor([&executedTaskCount]()
+  {
+    return executedTaskCount.load() == 4 + TaskCount * 2;
+  });
+  assert(allExecuted && "Tasks not executed within a timeout");
+
+  // Expect one of the loaded partitions to migrate to the idle shard.
+  const auto loadedShard = shardPool.GetShard(0);
+  assert(shardPool.Balance());
+  assert(shardPool.GetShard(0) != loadedShard || shardPool.GetShard(2) != loadedShard);
+  assert(shardPool.GetShard(0) != shardPool.GetShard(2));
+
+  // Expect the shards to be balanced without any further load.
+  assert(not shardPool.Balance());
+
+  shardPool.Stop();
+}
+
+void TestRemove()
+{
+  server::ShardPool shardPool;
+  shardPool.Start(4);
+
+  // A partition removed by its own task, like a room instance destroyed
+  // when the last client leaves, must not execute the tasks queued
+  // with the same key in the meantime concurrently.
+  std::atomic_bool isRemoved{false};
+  std::atomic_uint32_t runningTaskCount{0};
+  std::atomic_uint32_t executedTaskCount{0};
+  bool wasConcurrent = false;
+
+  // Occupy every shard, so that a new partition would be pinned to another shard
+  // than the removed one once the second shard is freed.
+  for (uint32_t partitionIdx = 2; partitionIdx < 6; ++partitionIdx)
+  {
+    shardPool.Queue(partitionIdx, []()
+    {
+    });
+  }
+
+  shardPool.Queue(1, [&]()
+  {
+    runningTaskCount.fetch_add(1);
+    shardPool.Remove(1);
+    isRemoved.store(true);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    runningTaskCount.fetch_sub(1);
+    executedTaskCount.fetch_add(1);
+  });
+
+  const bool removed = WaitFor([&isRemoved]()
+  {
+    return isRemoved.load();
+  });
+  assert(removed && "Task not executed within a timeout");
+
+  shardPool.Remove(3);
+  const bool freed = WaitFor([&shardPool]()
+  {
+    return shardPool.GetShard(3) == shardPool.GetShardCount();
+  });
+  assert(freed && "Partition not forgotten within a timeout");
+
+  shardPool.Queue(1, [&]()
+  {
+    wasConcurrent = runningTaskCount.fetch_add(1) != 0;
+    runningTaskCount.fetch_sub(1);
+    executedTaskCount.fetch_add(1);
+  });
+
+  const bool allExecuted = WaitFor([&executedTaskCount]()
+  {
+    return executedTaskCount.load() == 2;
+  });
+  assert(allExecuted && "Tasks not executed within a timeout");
+  assert(not wasConcurrent);
+
+  // The partition queued again after the removal is kept.
+  assert(shardPool.GetShard(1) != shardPool.GetShardCount());
+
+  // The removed partition is forgotten once it runs out of tasks.
+  shardPool.Remove(1);
+  const bool forgotten = WaitFor([&shardPool]()
+  {
+    return shardPool.GetShard(1) == shardPool.GetShardCount();
+  });
+  assert(forgotten && "Partition not forgotten within a timeout");
+
+  shardPool.Stop();
+}
+
+} // namespace
+
+int main()
+{
+  TestPartitionOrder();
+  TestBalance();
+  TestRemove();
+}
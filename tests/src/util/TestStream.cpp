@@ -21,7 +21,9 @@
 
 #include <boost/asio/streambuf.hpp>
 
+#include <array>
 #include <cassert>
+#include <vector>
 
 namespace
 {
@@ -48,6 +50,87 @@ struct Datum
   }
 };
 
+//! Perform test of string encoding/decoding.
+void TestStrings()
+{
+  std::array<std::byte, 32> buffer{};
+  server::SinkStream sink(buffer);
+
+  sink.Write(std::string("rgnter"))
+    .Write(std::string("\xea\xb5\xac"))
+    .Write(std::string());
+
+  // Expect the strings to be written with their terminator, the second one in EUC-KR.
+  assert(sink.GetCursor() == 7 + 3 + 1);
+
+  server::SourceStream source(std::span(buffer.data(), sink.GetCursor()));
+
+  std::string ascii;
+  std::string korean;
+  std::string empty = "not empty";
+  source.Read(ascii)
+    .Read(korean)
+    .Read(empty);
+
+  assert(ascii == "rgnter");
+  assert(korean == "\xea\xb5\xac");
+  assert(empty.empty());
+  assert(source.GetCursor() == sink.GetCursor());
+
+  // Expect a string without a terminator to fail.
+  server::SourceStream unterminatedSource(std::span(buffer.data(), 3));
+  bool hasFailed = false;
+  try
+  {
+    unterminatedSource.Read(ascii);
+  }
+  catch (const std::overflow_error&)
+  {
+    hasFailed = true;
+  }
+  assert(hasFailed);
+}
+
+//! Perform test of bulk encoding/decoding.
+void TestBulk()
+{
+  std::array<std::byte, 32> buffer{};
+  server::SinkStream sink(buffer);
+
+  const std::array<float, 3> position{1.0f, 2.0f, 3.0f};
+  const std::vector<uint8_t> payload{0xCA, 0xFE, 0xBA, 0xBE};
+  sink.Write(position)
+    .Write(std::span(payload));
+
+  // Expect the reserved bytes to follow the bulk written ones.
+  auto* reserved = sink.Reserve(sizeof(uint32_t));
+  assert(reserved == buffer.data() + sizeof(position) + payload.size());
+  assert(sink.GetCursor() == sizeof(position) + payload.size() + sizeof(uint32_t));
+
+  // Expect a reservation past the end to fail.
+  bool hasFailed = false;
+  try
+  {
+    [[maybe_unused]] auto* overflown = sink.Reserve(buffer.size());
+  }
+  catch (const std::overflow_error&)
+  {
+    hasFailed = true;
+  }
+  assert(hasFailed);
+
+  server::SourceStream source(std::span(buffer.data(), sink.GetCursor()));
+
+  std::array<float, 3> readPosition{};
+  std::vector<uint8_t> readPayload(payload.size());
+  source.Read(readPosition)
+    .Read(std::span(readPayload));
+
+  assert(readPosition == position);
+  assert(readPayload == payload);
+  assert(source.Reserve(sizeof(uint32_t)) == buffer.data() + sizeof(position) + payload.size());
+}
+
 //! Perform test of magic encoding/decoding.
 void TestStreams()
 {
@@ -97,5 +180,7 @@ void TestStreams()
 
 int main()
 {
+  TestStrings();
+  TestBulk();
   TestStreams();
 }
@@ -0,0 +1,113 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/Scheduler.hpp>
+#include <libserver/util/Trace.hpp>
+
+#include <cassert>
+#include <format>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+
+//! Returns the count of the occurrences of a pattern in a value.
+std::size_t CountOccurrences(std::string_view value, std::string_view pattern)
+{
+  std::size_t count = 0;
+  for (auto position = value.find(pattern);
+    position != std::string_view::npos;
+    position = value.find(pattern, position + pattern.size()))
+  {
+    ++count;
+  }
+
+  return count;
+}
+
+void TestSpanOutsideOfTrace()
+{
+  assert(server::trace::GetCurrentTraceId() == server::trace::InvalidTraceId);
+
+  {
+    const server::trace::Span span("Test::Untraced");
+  }
+
+  // Expect the span outside of a trace not to be recorded.
+  std::stringstream stream;
+  server::trace::WriteChromeTrace(stream);
+  assert(CountOccurrences(stream.str(), "Test::Untraced") == 0);
+}
+
+void TestTracePropagation()
+{
+  const auto traceId = server::trace::GenerateTraceId();
+  assert(traceId != server::trace::InvalidTraceId);
+
+  server::Scheduler scheduler;
+  server::trace::TraceId taskTraceId = server::trace::InvalidTraceId;
+
+  // Queue a task within the trace.
+  {
+    const server::trace::Scope scope(traceId);
+    const server::trace::Span span("Test::Queue");
+
+    scheduler.Queue([&taskTraceId]()
+    {
+      const server::trace::Span span("Test::Task");
+      taskTraceId = server::trace::GetCurrentTraceId();
+    });
+  }
+
+  // Expect the previous trace ID to be restored at the end of the scope.
+  assert(server::trace::GetCurrentTraceId() == server::trace::InvalidTraceId);
+
+  // Execute the task on another thread, expect it to continue the trace.
+  std::thread thread([&scheduler]()
+  {
+    server::trace::SetThreadName("test scheduler");
+    scheduler.Tick();
+  });
+  thread.join();
+
+  assert(taskTraceId == traceId);
+
+  std::stringstream stream;
+  const auto spanCount = server::trace::WriteChromeTrace(stream);
+  const auto trace = stream.str();
+
+  // Expect both spans to be exported and linked by a flow.
+  assert(spanCount == 2);
+  assert(trace.starts_with("{") && trace.ends_with("}"));
+  assert(CountOccurrences(trace, std::format(R"("args":{{"trace":{}}})", traceId)) == 2);
+  assert(CountOccurrences(trace, R"("name":"Test::Queue")") == 1);
+  assert(CountOccurrences(trace, R"("name":"Test::Task")") == 1);
+  assert(CountOccurrences(trace, R"("ph":"s")") == 1);
+  assert(CountOccurrences(trace, R"("ph":"f")") == 1);
+  assert(CountOccurrences(trace, R"("args":{"name":"test scheduler"})") == 1);
+}
+
+} // namespace
+
+int main()
+{
+  TestSpanOutsideOfTrace();
+  TestTracePropagation();
+}
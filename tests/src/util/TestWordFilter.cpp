@@ -0,0 +1,73 @@
+/**
+ * Alicia Server - dedicated server software
+ * Copyright (C) 2024 Story Of Alicia
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ **/
+
+#include <libserver/util/WordFilter.hpp>
+
+#include <array>
+#include <cassert>
+#include <string>
+
+namespace
+{
+
+void TestScan()
+{
+  const std::array<std::string, 4> words{"he", "she", "his", "hers"};
+  const server::WordFilter wordFilter(words);
+
+  assert(wordFilter.GetWordCount() == 4);
+
+  // Expect the longest word ending at a character to match.
+  const auto matches = wordFilter.Scan("ushers");
+  assert(matches.size() == 2);
+  assert(matches[0].offset == 1 && matches[0].length == 3);
+  assert(matches[1].offset == 2 && matches[1].length == 4);
+
+  assert(wordFilter.Contains("this"));
+  assert(not wordFilter.Contains("tree"));
+  assert(not server::WordFilter().Contains("she"));
+}
+
+void TestMask()
+{
+  const std::array<std::string, 3> words{"bad", "worse", "나쁜"};
+  const server::WordFilter wordFilter(words);
+
+  assert(wordFilter.Mask("not bad at all") == "not *** at all");
+  assert(wordFilter.Mask("badworse") == "********");
+  assert(wordFilter.Mask("nothing") == "nothing");
+
+  // Expect the case and the full-width forms to be normalized.
+  assert(wordFilter.Mask("BaD") == "***");
+  assert(wordFilter.Mask("\xEF\xBD\x82\xEF\xBD\x81\xEF\xBD\x84!") == "***!");
+
+  // Expect every masked character to be replaced with a single mask.
+  assert(wordFilter.Mask("정말 나쁜 말") == "정말 ** 말");
+
+  // Expect the invalid sequences to be preserved.
+  assert(wordFilter.Mask("\xFF" "bad\xC3") == "\xFF***\xC3");
+}
+
+} // namespace
+
+int main()
+{
+  TestScan();
+  TestMask();
+}